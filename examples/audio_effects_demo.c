@@ -9,8 +9,13 @@
 #include "audio_filters.h"
 #include "delay_effects.h"
 #include "reverb.h"
+#include "convolution.h"
+#include "stft.h"
 #include "distortion.h"
 #include "modulation_effects.h"
+#include "effect_chain.h"
+#include "fast_math.h"
+#include "cpu_features.h"
 
 // Demo functions
 void generate_test_tone(AudioBuffer* buffer, float frequency, float duration, float sample_rate);
@@ -23,6 +28,8 @@ void demo_reverb_effects(void);
 void demo_distortion_effects(void);
 void demo_modulation_effects(void);
 void demo_effect_chain(void);
+int report_fast_math_accuracy(void);
+int report_block_consistency(void);
 
 void print_menu(void);
 void print_separator(void);
@@ -43,6 +50,12 @@ int main(int argc, char* argv[]) {
             demo_effect_chain();
             return 0;
         }
+        if (strcmp(argv[1], "--accuracy") == 0) {
+            return report_fast_math_accuracy();
+        }
+        if (strcmp(argv[1], "--consistency") == 0) {
+            return report_block_consistency();
+        }
     }
     
     int choice;
@@ -181,6 +194,17 @@ void generate_sweep(AudioBuffer* buffer, float start_freq, float end_freq, float
     }
 }
 
+// STFT callback for the spectral filter demo: clear every bin from the
+// cutoff bin (passed through user) up to Nyquist
+static void spectral_brickwall(void* user, float* spectrum, const FftPlan* plan) {
+    const size_t cutoff = *(const size_t*)user;
+    for (size_t k = cutoff; k < plan->half; k++) {
+        spectrum[k] = 0.0f;
+        spectrum[plan->half + k] = 0.0f;
+    }
+    spectrum[plan->half] = 0.0f; // Nyquist
+}
+
 void demo_filters(void) {
     printf("\n=== FILTER EFFECTS DEMO ===\n");
     
@@ -227,11 +251,24 @@ void demo_filters(void) {
     eq_process_buffer(&eq, filtered);
     wav_save("eq_filtered.wav", filtered);
     
+    // Spectral filter demo: STFT with 75% overlap, bins above 1 kHz cleared
+    printf("Applying spectral brick-wall filter (1000Hz cutoff)...\n");
+    audio_buffer_copy(filtered, buffer);
+    
+    size_t cutoff_bin = (size_t)(1000.0f * 2048 / sample_rate);
+    Stft* stft = stft_create(2048, 512, STFT_WINDOW_HANN, spectral_brickwall, &cutoff_bin);
+    if (stft) {
+        stft_process_buffer(stft, filtered);
+        wav_save("spectral_filtered.wav", filtered);
+        stft_destroy(stft);
+    }
+    
     printf("Filter demo complete! Generated files:\n");
     printf("  - original_sweep.wav\n");
     printf("  - lowpass_filtered.wav\n");
     printf("  - highpass_filtered.wav\n");
     printf("  - eq_filtered.wav\n");
+    printf("  - spectral_filtered.wav\n");
     
     audio_buffer_destroy(buffer);
     audio_buffer_destroy(filtered);
@@ -342,6 +379,17 @@ void demo_reverb_effects(void) {
     plate_reverb_set_params(plate, 3.0f, 0.4f, 0.02f, sample_rate);
     plate_reverb_process_buffer(plate, processed);
     wav_save("plate_reverb.wav", processed);
+    
+    // Stereo: each channel sums its own set of tank taps
+    AudioBuffer* plate_stereo = audio_buffer_create(buffer->length, 2, buffer->sample_rate);
+    if (plate_stereo) {
+        audio_buffer_write_channel(plate_stereo, 0, 0, buffer->data, buffer->length);
+        audio_buffer_write_channel(plate_stereo, 1, 0, buffer->data, buffer->length);
+        plate_reverb_reset(plate);
+        plate_reverb_process_buffer(plate, plate_stereo);
+        wav_save("plate_stereo.wav", plate_stereo);
+        audio_buffer_destroy(plate_stereo);
+    }
     plate_reverb_destroy(plate);
     
     // Freeverb demo
@@ -352,13 +400,64 @@ void demo_reverb_effects(void) {
     freeverb_set_params(freeverb, 0.8f, 0.4f, 0.3f, 1.0f);
     freeverb_process_buffer(freeverb, processed);
     wav_save("freeverb_processed.wav", processed);
+    
+    // Same source through the stereo path: each channel gets its own comb set
+    AudioBuffer* stereo = audio_buffer_create(buffer->length, 2, buffer->sample_rate);
+    if (stereo) {
+        audio_buffer_write_channel(stereo, 0, 0, buffer->data, buffer->length);
+        audio_buffer_write_channel(stereo, 1, 0, buffer->data, buffer->length);
+        freeverb_reset(freeverb);
+        freeverb_process_buffer(freeverb, stereo);
+        wav_save("freeverb_stereo.wav", stereo);
+        audio_buffer_destroy(stereo);
+    }
     freeverb_destroy(freeverb);
     
+    // FDN reverb demo
+    printf("Applying FDN reverb...\n");
+    audio_buffer_copy(processed, buffer);
+    
+    FdnReverb* fdn = fdn_reverb_create(FDN_MAX_LINES, sample_rate);
+    fdn_reverb_set_params(fdn, 2.5f, 1.0f, 3000.0f, 0.3f);
+    fdn_reverb_process_buffer(fdn, processed);
+    wav_save("fdn_reverb.wav", processed);
+    fdn_reverb_destroy(fdn);
+    
+    // Convolution reverb demo: synthesize a decaying noise impulse
+    // response, save it and load it back as a sampled room would be
+    printf("Applying convolution reverb...\n");
+    audio_buffer_copy(processed, buffer);
+    
+    AudioBuffer* impulse = audio_buffer_create((size_t)(1.5f * sample_rate), 1, (size_t)sample_rate);
+    uint32_t seed = 1; // Own generator, so later demos see the same rand() sequence
+    for (size_t i = 0; i < impulse->length; i++) {
+        seed = seed * 1664525u + 1013904223u;
+        float noise = (float)(seed >> 8) / 8388608.0f - 1.0f;
+        impulse->data[i] = 0.1f * noise * expf(-4.6f * i / (1.5f * sample_rate)); // -40 dB at the end
+    }
+    wav_save("impulse_response.wav", impulse);
+    audio_buffer_destroy(impulse);
+    
+    ConvolutionReverb* convolution = convolution_reverb_load("impulse_response.wav", 0,
+                                                             CONVOLUTION_DEFAULT_HEAD_BLOCK,
+                                                             CONVOLUTION_DEFAULT_TAIL_BLOCK, sample_rate);
+    if (convolution) {
+        convolution_reverb_set_params(convolution, 0.3f);
+        convolution_reverb_process_buffer(convolution, processed);
+        wav_save("convolution_reverb.wav", processed);
+        convolution_reverb_destroy(convolution);
+    }
+    
     printf("Reverb effects demo complete! Generated files:\n");
     printf("  - reverb_original.wav\n");
     printf("  - schroeder_reverb.wav\n");
     printf("  - plate_reverb.wav\n");
+    printf("  - plate_stereo.wav\n");
     printf("  - freeverb_processed.wav\n");
+    printf("  - freeverb_stereo.wav\n");
+    printf("  - fdn_reverb.wav\n");
+    printf("  - impulse_response.wav\n");
+    printf("  - convolution_reverb.wav\n");
     
     audio_buffer_destroy(buffer);
     audio_buffer_destroy(processed);
@@ -502,10 +601,7 @@ void demo_modulation_effects(void) {
     
     Tremolo* tremolo = tremolo_create(sample_rate);
     tremolo_set_params(tremolo, 6.0f, 0.8f, 0);
-    
-    for (size_t i = 0; i < processed->capacity; i++) {
-        processed->data[i] = tremolo_process(tremolo, processed->data[i]);
-    }
+    tremolo_process_buffer(tremolo, processed);
     wav_save("tremolo_processed.wav", processed);
     tremolo_destroy(tremolo);
     
@@ -557,29 +653,77 @@ void demo_effect_chain(void) {
     
     printf("Applying effect chain: Overdrive -> Chorus -> Delay -> Reverb...\n");
     
-    // Step 1: Overdrive
+    // One chain runs every stage on cache-sized blocks
     Overdrive* overdrive = overdrive_create(sample_rate);
-    overdrive_set_params(overdrive, 4.0f, 0.6f, 0.9f, 1.0f);
-    overdrive_process_buffer(overdrive, buffer);
-    wav_save("chain_step1_overdrive.wav", buffer);
-    
-    // Step 2: Chorus
     Chorus* chorus = chorus_create(30.0f, sample_rate);
-    chorus_set_params(chorus, 1.0f, 0.4f, 0.1f, 0.3f);
-    chorus_process_buffer(chorus, buffer);
-    wav_save("chain_step2_chorus.wav", buffer);
-    
-    // Step 3: Echo
     Echo* echo = echo_create(1.0f, sample_rate);
-    echo_set_params(echo, 0.25f, 0.3f, 0.3f, sample_rate);
-    echo_process_buffer(echo, buffer);
-    wav_save("chain_step3_echo.wav", buffer);
-    
-    // Step 4: Reverb
     SchroederReverb* reverb = schroeder_reverb_create(sample_rate);
+    EffectChain* chain = effect_chain_create(sample_rate);
+    AudioBuffer* output = audio_buffer_create(buffer->length, 1, (size_t)sample_rate);
+    if (!overdrive || !chorus || !echo || !reverb || !chain || !output) {
+        printf("Error: Could not create effect chain\n");
+        overdrive_destroy(overdrive);
+        chorus_destroy(chorus);
+        echo_destroy(echo);
+        schroeder_reverb_destroy(reverb);
+        effect_chain_destroy(chain);
+        audio_buffer_destroy(output);
+        audio_buffer_destroy(buffer);
+        return;
+    }
+    
+    overdrive_set_params(overdrive, 4.0f, 0.6f, 0.9f, 1.0f);
+    chorus_set_params(chorus, 1.0f, 0.4f, 0.1f, 0.3f);
+    echo_set_params(echo, 0.25f, 0.3f, 0.3f, sample_rate);
     schroeder_reverb_set_params(reverb, 0.6f, 0.3f, 0.25f);
-    schroeder_reverb_process_buffer(reverb, buffer);
-    wav_save("chain_final.wav", buffer);
+    
+    effect_chain_add(chain, overdrive_effect(overdrive));
+    effect_chain_add(chain, chorus_effect(chorus));
+    effect_chain_add(chain, echo_effect(echo));
+    effect_chain_add(chain, schroeder_reverb_effect(reverb));
+    
+    // Render each step by bypassing the stages after it
+    const char* step_files[] = {"chain_step1_overdrive.wav", "chain_step2_chorus.wav",
+                                "chain_step3_echo.wav", "chain_final.wav"};
+    for (int step = 0; step < chain->num_nodes; step++) {
+        for (int node = 0; node < chain->num_nodes; node++) {
+            effect_chain_set_bypass(chain, node, node > step);
+        }
+        effect_chain_reset(chain);
+        effect_chain_process_block(chain, buffer->data, output->data, buffer->capacity);
+        wav_save(step_files[step], output);
+    }
+    effect_chain_destroy(chain);
+    
+    // Parallel branches and a send/return bus
+    printf("Applying graph: Overdrive -> (dry + Chorus) -> send -> Freeverb return...\n");
+    chain = effect_chain_create(sample_rate);
+    overdrive = overdrive_create(sample_rate);
+    chorus = chorus_create(30.0f, sample_rate);
+    Freeverb* freeverb = freeverb_create(sample_rate);
+    if (chain && overdrive && chorus && freeverb) {
+        overdrive_set_params(overdrive, 3.0f, 0.5f, 0.9f, 1.0f);
+        chorus_set_params(chorus, 0.8f, 0.5f, 0.2f, 1.0f);
+        freeverb_set_params(freeverb, 0.8f, 0.4f, 1.0f, 1.0f); // Wet-only on the bus
+        
+        Effect branches[2] = { {NULL, NULL}, chorus_effect(chorus) };
+        float gains[2] = {0.6f, 0.4f};
+        
+        effect_chain_add(chain, overdrive_effect(overdrive));
+        effect_chain_add_parallel(chain, branches, gains, 2);
+        effect_chain_add_send(chain, 0, 0.5f);
+        effect_chain_add_return(chain, 0, freeverb_effect(freeverb), 0.4f);
+        
+        effect_chain_process_block(chain, buffer->data, output->data, buffer->capacity);
+        wav_save("chain_parallel.wav", output);
+        effect_chain_destroy(chain);
+    } else {
+        printf("Error: Could not create effect graph\n");
+        effect_chain_destroy(chain);
+        overdrive_destroy(overdrive);
+        chorus_destroy(chorus);
+        freeverb_destroy(freeverb);
+    }
     
     printf("Effect chain demo complete! Generated files:\n");
     printf("  - chain_original.wav (dry signal)\n");
@@ -587,11 +731,113 @@ void demo_effect_chain(void) {
     printf("  - chain_step2_chorus.wav\n");
     printf("  - chain_step3_echo.wav\n");
     printf("  - chain_final.wav (full chain)\n");
+    printf("  - chain_parallel.wav (parallel branches + reverb send)\n");
     
-    // Cleanup
-    overdrive_destroy(overdrive);
-    chorus_destroy(chorus);
-    echo_destroy(echo);
-    schroeder_reverb_destroy(reverb);
+    // Cleanup (the chains destroyed their effects)
+    audio_buffer_destroy(output);
     audio_buffer_destroy(buffer);
-}
\ No newline at end of file
+}
+
+// Compare the fast_math approximations with libm; fails when one exceeds
+// its documented bound
+int report_fast_math_accuracy(void) {
+    const FastMathFunction functions[3] = {FAST_MATH_TANH, FAST_MATH_EXP, FAST_MATH_SIGMOID};
+    const float ranges[3][2] = {{-10.0f, 10.0f}, {-80.0f, 80.0f}, {-30.0f, 30.0f}};
+    int failures = 0;
+    
+    printf("Fast math accuracy against libm (SIMD level %s)\n", cpu_simd_level_name(cpu_simd_level()));
+    print_separator();
+    printf("%-8s %-7s %12s %12s %12s %12s\n", "function", "tier", "max abs", "max rel", "worst at", "bound");
+    
+    for (int f = 0; f < 3; f++) {
+        for (int tier = FAST_MATH_LOW; tier <= FAST_MATH_HIGH; tier++) {
+            FastMathError error = fast_math_measure(functions[f], (FastMathTier)tier,
+                                                    ranges[f][0], ranges[f][1], 1000001);
+            double bound = fast_math_error_bound(functions[f], (FastMathTier)tier);
+            double measured = functions[f] == FAST_MATH_EXP ? error.max_rel_error : error.max_abs_error;
+            int ok = measured <= bound;
+            
+            printf("%-8s %-7s %12.3e %12.3e %12.5g %12.1e %s\n", fast_math_function_name(functions[f]),
+                   fast_math_tier_name((FastMathTier)tier), error.max_abs_error, error.max_rel_error,
+                   error.worst_input, bound, ok ? "ok" : "FAIL");
+            failures += !ok;
+        }
+    }
+    
+    return failures ? 1 : 0;
+}
+
+// Largest difference between two renders of the same signal
+static float max_difference(const sample_t* a, const sample_t* b, size_t n) {
+    float worst = 0.0f;
+    for (size_t i = 0; i < n; i++) {
+        float d = fabsf(a[i] - b[i]);
+        if (d > worst) worst = d;
+    }
+    return worst;
+}
+
+// Render the plate per sample and in irregular chunks; the output must not
+// depend on how the host splits the signal into blocks
+int report_block_consistency(void) {
+    const float sample_rate = 44100.0f;
+    const size_t n = 22050;
+    const size_t chunks[5] = {1, 7, 64, 129, 1000};
+    sample_t* in = malloc(2 * n * sizeof(sample_t));
+    sample_t* reference = malloc(2 * n * sizeof(sample_t));
+    sample_t* out = malloc(2 * n * sizeof(sample_t));
+    int failures = 0;
+    
+    if (!in || !reference || !out) {
+        free(in);
+        free(reference);
+        free(out);
+        return 1;
+    }
+    
+    // Noise burst followed by silence so the tail is compared as well
+    srand(1);
+    for (size_t i = 0; i < 2 * n; i++) {
+        in[i] = (i % n) < n / 8 ? ((float)rand() / RAND_MAX * 2.0f - 1.0f) * 0.5f : 0.0f;
+    }
+    
+    printf("Plate reverb block consistency (SIMD level %s)\n", cpu_simd_level_name(cpu_simd_level()));
+    print_separator();
+    printf("%-8s %-10s %12s\n", "mode", "chunk", "max diff");
+    
+    PlateReverb* reverb = plate_reverb_create(sample_rate);
+    for (size_t i = 0; i < n; i++) {
+        reference[i] = plate_reverb_process(reverb, in[i]);
+    }
+    
+    for (int c = 0; c < 5; c++) {
+        plate_reverb_reset(reverb);
+        for (size_t i = 0; i < n; i += chunks[c]) {
+            size_t count = n - i < chunks[c] ? n - i : chunks[c];
+            plate_reverb_process_block(reverb, in + i, out + i, count);
+        }
+        float diff = max_difference(reference, out, n);
+        printf("%-8s %-10zu %12.3e %s\n", "mono", chunks[c], diff, diff == 0.0f ? "ok" : "FAIL");
+        failures += diff != 0.0f;
+    }
+    
+    // Stereo: one block of the whole signal against the chunked renders
+    plate_reverb_reset(reverb);
+    plate_reverb_process_stereo_block(reverb, in, in + n, reference, reference + n, n);
+    for (int c = 0; c < 5; c++) {
+        plate_reverb_reset(reverb);
+        for (size_t i = 0; i < n; i += chunks[c]) {
+            size_t count = n - i < chunks[c] ? n - i : chunks[c];
+            plate_reverb_process_stereo_block(reverb, in + i, in + n + i, out + i, out + n + i, count);
+        }
+        float diff = max_difference(reference, out, 2 * n);
+        printf("%-8s %-10zu %12.3e %s\n", "stereo", chunks[c], diff, diff == 0.0f ? "ok" : "FAIL");
+        failures += diff != 0.0f;
+    }
+    
+    plate_reverb_destroy(reverb);
+    free(in);
+    free(reference);
+    free(out);
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,180 @@
+// Batch example: render many WAV files through one preset on all cores
+// Build with: make batch
+//
+// Usage: batch_process [-j workers] [-c] [-p chain|reverb] output_dir input.wav...
+// Each input is written to output_dir under its own file name, in the
+// same sample format. Every worker builds the preset once and reuses it.
+
+#define _POSIX_C_SOURCE 200112L // clock_gettime
+#include "audio_core.h"
+#include "batch_render.h"
+#include "distortion.h"
+#include "modulation_effects.h"
+#include "delay_effects.h"
+#include "reverb.h"
+#include <stdio.h>
+#include <time.h>
+
+// Overdrive -> Chorus -> Echo -> Reverb, as in the effect chain demo
+static EffectChain* preset_chain(void* user, float sample_rate) {
+    (void)user;
+    
+    EffectChain* chain = effect_chain_create(sample_rate);
+    Overdrive* overdrive = overdrive_create(sample_rate);
+    Chorus* chorus = chorus_create(30.0f, sample_rate);
+    Echo* echo = echo_create(1.0f, sample_rate);
+    SchroederReverb* reverb = schroeder_reverb_create(sample_rate);
+    if (!chain || !overdrive || !chorus || !echo || !reverb) {
+        effect_chain_destroy(chain);
+        overdrive_destroy(overdrive);
+        chorus_destroy(chorus);
+        echo_destroy(echo);
+        schroeder_reverb_destroy(reverb);
+        return NULL;
+    }
+    
+    overdrive_set_params(overdrive, 4.0f, 0.6f, 0.9f, 1.0f);
+    chorus_set_params(chorus, 1.0f, 0.4f, 0.1f, 0.3f);
+    echo_set_params(echo, 0.25f, 0.3f, 0.3f, sample_rate);
+    schroeder_reverb_set_params(reverb, 0.6f, 0.3f, 0.25f);
+    
+    effect_chain_add(chain, overdrive_effect(overdrive));
+    effect_chain_add(chain, chorus_effect(chorus));
+    effect_chain_add(chain, echo_effect(echo));
+    effect_chain_add(chain, schroeder_reverb_effect(reverb));
+    return chain;
+}
+
+// Reverb only, as in simple_reverb
+static EffectChain* preset_reverb(void* user, float sample_rate) {
+    (void)user;
+    
+    EffectChain* chain = effect_chain_create(sample_rate);
+    SchroederReverb* reverb = schroeder_reverb_create(sample_rate);
+    if (!chain || !reverb) {
+        effect_chain_destroy(chain);
+        schroeder_reverb_destroy(reverb);
+        return NULL;
+    }
+    
+    schroeder_reverb_set_params(reverb, 0.8f, 0.3f, 0.4f);
+    effect_chain_add(chain, schroeder_reverb_effect(reverb));
+    return chain;
+}
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+static void print_usage(const char* program) {
+    printf("Usage: %s [-j workers] [-c] [-p chain|reverb] output_dir input.wav...\n", program);
+    printf("  -c  also give every channel of a file its own thread (long multichannel stems)\n");
+}
+
+int main(int argc, char* argv[]) {
+    BatchConfig config = {preset_chain, NULL, 0, 0, 0, 0};
+    
+    int arg = 1;
+    while (arg < argc && argv[arg][0] == '-') {
+        if (strcmp(argv[arg], "-c") == 0) {
+            config.channel_threads = 1;
+            arg++;
+            continue;
+        }
+        if (strcmp(argv[arg], "-j") == 0 && arg + 1 < argc) {
+            config.num_workers = atoi(argv[arg + 1]);
+        } else if (strcmp(argv[arg], "-p") == 0 && arg + 1 < argc) {
+            if (strcmp(argv[arg + 1], "reverb") == 0) {
+                config.factory = preset_reverb;
+            } else if (strcmp(argv[arg + 1], "chain") != 0) {
+                printf("Error: Unknown preset %s\n", argv[arg + 1]);
+                return 1;
+            }
+        } else {
+            print_usage(argv[0]);
+            return 1;
+        }
+        arg += 2;
+    }
+    
+    if (argc - arg < 2) {
+        print_usage(argv[0]);
+        return 1;
+    }
+    
+    const char* output_dir = argv[arg++];
+    size_t num_jobs = (size_t)(argc - arg);
+    BatchJob* jobs = calloc(num_jobs, sizeof(BatchJob));
+    char** outputs = calloc(num_jobs, sizeof(char*));
+    if (!jobs || !outputs) {
+        printf("Error: Out of memory\n");
+        free(jobs);
+        free(outputs);
+        return 1;
+    }
+    
+    // Output name: output_dir/<input file name>
+    for (size_t i = 0; i < num_jobs; i++) {
+        const char* input = argv[arg + i];
+        const char* name = strrchr(input, '/');
+        name = name ? name + 1 : input;
+        
+        size_t length = strlen(output_dir) + strlen(name) + 2;
+        outputs[i] = malloc(length);
+        if (!outputs[i]) break;
+        snprintf(outputs[i], length, "%s/%s", output_dir, name);
+        
+        jobs[i].input = input;
+        jobs[i].output = outputs[i];
+    }
+    
+    BatchRenderer* renderer = batch_renderer_create(&config);
+    int workers = batch_renderer_workers(renderer);
+    if (!renderer) {
+        printf("Error: Could not start batch renderer\n");
+    } else {
+        printf("Rendering %zu files on %d workers...\n", num_jobs, workers);
+    }
+    
+    double start = now_seconds();
+    for (size_t i = 0; renderer && i < num_jobs && outputs[i]; i++) {
+        batch_renderer_submit(renderer, &jobs[i]);
+    }
+    batch_renderer_destroy(renderer); // Waits for every queued file
+    double wall = now_seconds() - start;
+    
+    // Per-file report
+    size_t succeeded = 0;
+    double audio_seconds = 0.0;
+    double busy_seconds = 0.0;
+    for (size_t i = 0; i < num_jobs; i++) {
+        const BatchJob* job = &jobs[i];
+        if (!job->ok) {
+            printf("  FAILED  %s\n", job->input);
+            continue;
+        }
+        
+        double duration = job->sample_rate ? (double)job->frames / job->sample_rate : 0.0;
+        printf("  %-40s %8.1f ms  %7.1fx realtime  (worker %d)\n", job->input, job->seconds * 1000.0,
+               job->seconds > 0.0 ? duration / job->seconds : 0.0, job->worker);
+        
+        succeeded++;
+        audio_seconds += duration;
+        busy_seconds += job->seconds;
+    }
+    
+    printf("%zu/%zu files in %.2f s (%.1fx realtime, %.1f files/s, parallel efficiency %.0f%%)\n",
+           succeeded, num_jobs, wall, wall > 0.0 ? audio_seconds / wall : 0.0,
+           wall > 0.0 ? succeeded / wall : 0.0,
+           wall > 0.0 ? 100.0 * busy_seconds / (wall * workers) : 0.0);
+    
+    for (size_t i = 0; i < num_jobs; i++) {
+        free(outputs[i]);
+    }
+    free(outputs);
+    free(jobs);
+    
+    return succeeded == num_jobs ? 0 : 1;
+}
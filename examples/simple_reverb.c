@@ -1,49 +1,86 @@
 // Simple example: Apply reverb to an audio file
-// Compile with: gcc -Iinclude -o simple_reverb simple_reverb.c src/*.c -lm
+// Compile with: gcc -Iinclude -o simple_reverb simple_reverb.c src/*.c -lm -pthread
+//
+// The input is memory-mapped and streamed through the reverb one block at
+// a time, so memory use stays constant no matter how long the recording is.
 
 #include "audio_core.h"
 #include "wav_io.h"
 #include "reverb.h"
 #include <stdio.h>
 
+#define BLOCK_FRAMES 4096
+
 int main(int argc, char* argv[]) {
     if (argc != 3) {
         printf("Usage: %s input.wav output.wav\n", argv[0]);
         return 1;
     }
     
-    // Load input audio file
-    AudioBuffer* buffer = wav_load(argv[1]);
-    if (!buffer) {
+    // Open input audio file (mapped; falls back to buffered reads)
+    WavReader* reader = wav_reader_open_mapped(argv[1]);
+    if (!reader) {
         printf("Error: Could not load %s\n", argv[1]);
         return 1;
     }
     
-    // Create reverb effect
-    SchroederReverb* reverb = schroeder_reverb_create((float)buffer->sample_rate);
-    if (!reverb) {
-        printf("Error: Could not create reverb\n");
-        audio_buffer_destroy(buffer);
+    // Create one reverb per channel so stereo files keep separate tails
+    SchroederReverb* reverbs[MAX_CHANNELS] = {NULL};
+    if (reader->channels > MAX_CHANNELS) {
+        printf("Error: At most %d channels are supported\n", MAX_CHANNELS);
+        wav_reader_close(reader);
         return 1;
     }
     
-    // Set reverb parameters (room_size, damping, wet_level)
-    schroeder_reverb_set_params(reverb, 0.8f, 0.3f, 0.4f);
+    for (size_t ch = 0; ch < reader->channels; ch++) {
+        reverbs[ch] = schroeder_reverb_create((float)reader->sample_rate);
+        if (!reverbs[ch]) {
+            printf("Error: Could not create reverb\n");
+            for (size_t j = 0; j < ch; j++) {
+                schroeder_reverb_destroy(reverbs[j]);
+            }
+            wav_reader_close(reader);
+            return 1;
+        }
+        
+        // Set reverb parameters (room_size, damping, wet_level)
+        schroeder_reverb_set_params(reverbs[ch], 0.8f, 0.3f, 0.4f);
+    }
+    
+    AudioBuffer* block = audio_buffer_create(BLOCK_FRAMES, reader->channels, reader->sample_rate);
+    WavWriter* writer = wav_writer_open(argv[2], reader->channels, reader->sample_rate);
+    int ok = (block && writer);
     
-    // Process audio
-    printf("Processing audio with reverb...\n");
-    schroeder_reverb_process_buffer(reverb, buffer);
+    // Process audio block by block
+    if (ok) {
+        printf("Processing audio with reverb...\n");
+        size_t frames;
+        while ((frames = wav_reader_read_buffer(reader, block)) > 0) {
+            schroeder_reverb_process_channels(reverbs, block);
+            if (wav_writer_write_buffer(writer, block, frames) != frames) {
+                ok = 0;
+                break;
+            }
+        }
+    }
     
-    // Save output
-    if (wav_save(argv[2], buffer)) {
+    // Finish the output file (patches the WAV header sizes)
+    if (writer && !wav_writer_close(writer)) {
+        ok = 0;
+    }
+    
+    if (ok) {
         printf("Reverb applied successfully! Output saved to %s\n", argv[2]);
     } else {
         printf("Error: Could not save output file\n");
     }
     
     // Cleanup
-    schroeder_reverb_destroy(reverb);
-    audio_buffer_destroy(buffer);
+    for (size_t ch = 0; ch < reader->channels; ch++) {
+        schroeder_reverb_destroy(reverbs[ch]);
+    }
+    audio_buffer_destroy(block);
+    wav_reader_close(reader);
     
-    return 0;
-}
\ No newline at end of file
+    return ok ? 0 : 1;
+}
@@ -8,9 +8,10 @@
 #include <string.h>
 
 // Audio format constants
-#define MAX_CHANNELS 2
+#define MAX_CHANNELS 8
 #define DEFAULT_SAMPLE_RATE 44100
 #define MAX_BUFFER_SIZE 8192
+#define AUDIO_ALIGNMENT 64      // Byte alignment of sample storage (one cache line)
 
 // Math constants
 #define PI 3.14159265358979323846
@@ -18,14 +19,33 @@
 
 // Audio data types
 typedef float sample_t;
+
+// Sample layout of an AudioBuffer
+typedef enum {
+    AUDIO_LAYOUT_INTERLEAVED,   // Frames stored as L R L R ...
+    AUDIO_LAYOUT_PLANAR         // One contiguous, aligned plane per channel
+} AudioLayout;
+
 typedef struct {
     sample_t* data;
     size_t length;
     size_t channels;
     size_t sample_rate;
-    size_t capacity;
+    size_t capacity;            // Valid samples (length * channels)
+    AudioLayout layout;
+    size_t channel_stride;      // Samples between plane starts (planar only)
+    sample_t* planes[MAX_CHANNELS]; // Per-channel pointers (planar only)
 } AudioBuffer;
 
+// Non-owning view of one channel (or a range of it) inside a buffer.
+// stride is 1 for planar buffers, so views can be handed straight to
+// the *_process_block functions without copying.
+typedef struct {
+    sample_t* data;
+    size_t length;
+    size_t stride;
+} AudioView;
+
 typedef struct {
     uint16_t format;        // Audio format (1 = PCM)
     uint16_t channels;      // Number of channels
@@ -37,19 +57,175 @@ typedef struct {
 
 // Core audio buffer functions
 AudioBuffer* audio_buffer_create(size_t length, size_t channels, size_t sample_rate);
+AudioBuffer* audio_buffer_create_planar(size_t length, size_t channels, size_t sample_rate);
 void audio_buffer_destroy(AudioBuffer* buffer);
 void audio_buffer_clear(AudioBuffer* buffer);
 void audio_buffer_copy(AudioBuffer* dest, AudioBuffer* src);
 void audio_buffer_mix(AudioBuffer* dest, AudioBuffer* src, float gain);
 
+// Block helpers
+void audio_block_bypass(const sample_t* in, sample_t* out, size_t n);
+
+// Per-channel processing of interleaved buffers.
+// A BlockProcessFn runs one effect instance over a contiguous mono block;
+// audio_buffer_process_channels gives every channel its own instance so
+// channels never share filter or delay history.
+#define AUDIO_CHANNEL_CHUNK 256
+typedef void (*BlockProcessFn)(void* effect, const sample_t* in, sample_t* out, size_t n);
+
+void audio_buffer_read_channel(const AudioBuffer* buffer, size_t channel, size_t start_frame,
+                               sample_t* dest, size_t frames);
+void audio_buffer_write_channel(AudioBuffer* buffer, size_t channel, size_t start_frame,
+                                const sample_t* src, size_t frames);
+void audio_buffer_process_channels(AudioBuffer* buffer, BlockProcessFn process, void* const* effects);
+
+// Uniform effect interface, filled in by each effect's *_effect() wrapper
+// and driven by the effect chain (effect_chain.h). process_block follows the
+// BlockProcessFn contract. set_param indices follow the argument order of the
+// effect's *_set_params function (sample_rate excluded) and return 0 for an
+// unknown index. latency and destroy may be NULL: no latency, and state owned
+// by the caller.
+typedef struct {
+    const char* name;
+    BlockProcessFn process_block;
+    void (*reset)(void* effect);
+    int (*set_param)(void* effect, int param, float value);
+    size_t (*latency)(const void* effect);
+    void (*destroy)(void* effect);
+} EffectVTable;
+
+typedef struct {
+    const EffectVTable* vtable;
+    void* state;
+} Effect;
+
+// Channel views
+AudioView audio_buffer_channel_view(AudioBuffer* buffer, size_t channel);
+AudioView audio_view_range(AudioView view, size_t start, size_t length);
+void audio_view_process(AudioView view, BlockProcessFn process, void* effect);
+
+// Layout conversion (SIMD for stereo)
+void audio_interleave(sample_t* const* planes, size_t channels, sample_t* dest, size_t frames);
+void audio_deinterleave(const sample_t* src, size_t channels, sample_t* const* planes, size_t frames);
+
+// Allocation hooks. Every library allocation (effect state, delay lines,
+// buffers) goes through audio_malloc/audio_calloc/audio_free, so state can
+// be carved from preallocated memory (AudioArena in rt_safe.h). Install the
+// allocator before creating objects and free objects under the same one.
+typedef void* (*AudioAllocFn)(void* user, size_t size);
+typedef void (*AudioFreeFn)(void* user, void* ptr);
+
+void audio_set_allocator(AudioAllocFn alloc, AudioFreeFn release, void* user);
+void* audio_malloc(size_t size);
+void* audio_calloc(size_t count, size_t size);
+void audio_free(void* ptr);
+
+// Diagnostics. Library messages go through audio_log; by default they are
+// printed to stdout ("Error: " prefixed for errors).
+typedef enum {
+    AUDIO_LOG_INFO,
+    AUDIO_LOG_ERROR
+} AudioLogLevel;
+
+typedef void (*AudioLogFn)(AudioLogLevel level, const char* message, void* user);
+
+void audio_set_log_handler(AudioLogFn handler, void* user);
+void audio_log(AudioLogLevel level, const char* format, ...);
+
+// Real-time guard. Between audio_rt_enter and audio_rt_leave the calling
+// thread is treated as the audio thread: any library allocation, free or
+// log call there is a violation. The default handler asserts (debug builds);
+// violations are always counted.
+typedef enum {
+    AUDIO_RT_ALLOCATION,
+    AUDIO_RT_FREE,
+    AUDIO_RT_LOG
+} AudioRtViolation;
+
+typedef void (*AudioRtViolationFn)(AudioRtViolation violation, void* user);
+
+void audio_rt_enter(void);
+void audio_rt_leave(void);
+int audio_rt_active(void);
+void audio_rt_set_violation_handler(AudioRtViolationFn handler, void* user);
+size_t audio_rt_violations(void);
+
+// Parameter smoothing. A control thread publishes a new target with
+// param_smoother_set_target (one atomic store, no lock). The audio thread
+// picks it up with param_smoother_update at the start of each block and
+// then calls param_smoother_next per sample while a ramp is active; with
+// no ramp the value is constant and costs nothing per sample. Until the
+// first update, and after param_smoother_snap, targets apply immediately,
+// so parameters set before processing starts do not ramp.
+#define PARAM_SMOOTH_DEFAULT_MS 20.0f
+
+typedef enum {
+    PARAM_SMOOTH_LINEAR,      // Straight line over the ramp time
+    PARAM_SMOOTH_ONE_POLE     // Exponential glide, within 0.1% at the ramp time
+} ParamSmoothMode;
+
+typedef struct {
+    float current;
+    float target;
+    float step;               // Linear increment for the active ramp
+    float coefficient;        // One-pole coefficient
+    uint32_t remaining;       // Samples left in the active ramp
+    uint32_t ramp_samples;
+    ParamSmoothMode mode;
+    int running;              // Set once the audio thread has taken over
+    uint32_t published;       // Target bits, written atomically by any thread
+} ParamSmoother;
+
+void param_smoother_init(ParamSmoother* smoother, float value, float ramp_ms, float sample_rate,
+                         ParamSmoothMode mode);
+void param_smoother_set_target(ParamSmoother* smoother, float target);
+int param_smoother_update(ParamSmoother* smoother);   // Nonzero if the value changed or is ramping
+void param_smoother_snap(ParamSmoother* smoother);
+void param_smoother_fill(ParamSmoother* smoother, float* dest, size_t n);
+void param_smoother_skip(ParamSmoother* smoother, size_t n);   // Advance n samples
+
+static inline int param_smoother_active(const ParamSmoother* smoother) {
+    return smoother->remaining != 0;
+}
+
+// Advance one sample
+static inline float param_smoother_next(ParamSmoother* smoother) {
+    if (smoother->remaining == 0) return smoother->current;
+    
+    if (--smoother->remaining == 0) {
+        smoother->current = smoother->target;
+    } else if (smoother->mode == PARAM_SMOOTH_LINEAR) {
+        smoother->current += smoother->step;
+    } else {
+        smoother->current += (smoother->target - smoother->current) * smoother->coefficient;
+    }
+    return smoother->current;
+}
+
+// Aligned sample storage
+void* audio_aligned_calloc(size_t count, size_t size);
+void audio_aligned_free(void* ptr);
+
 // Utility functions
 float db_to_linear(float db);
 float linear_to_db(float linear);
-float clamp(float value, float min, float max);
 float lerp(float a, float b, float t);
 
-// Sample conversion functions
-int16_t float_to_int16(float sample);
-float int16_to_float(int16_t sample);
+// Clamp value between min and max (inline so per-sample loops can vectorize)
+static inline float clamp(float value, float min, float max) {
+    if (value < min) return min;
+    if (value > max) return max;
+    return value;
+}
+
+// Sample conversion functions (single samples; see sample_convert.h for blocks)
+static inline int16_t float_to_int16(float sample) {
+    sample = clamp(sample, -1.0f, 1.0f);
+    return (int16_t)(sample * 32767.0f);
+}
+
+static inline float int16_to_float(int16_t sample) {
+    return (float)sample / 32767.0f;
+}
 
 #endif // AUDIO_CORE_H
\ No newline at end of file
@@ -26,6 +26,29 @@ typedef struct {
     float prev_output; // Previous output
 } OnePoleFilter;
 
+// Inline single-sample kernels used by the block processors.
+// No NULL checks: callers validate once per block and keep the filter
+// in a local copy so its state stays in registers across the loop.
+static inline float biquad_tick(BiquadFilter* filter, float input) {
+    float output = filter->b0 * input + filter->b1 * filter->x1 + filter->b2 * filter->x2
+                   - filter->a1 * filter->y1 - filter->a2 * filter->y2;
+    filter->x2 = filter->x1;
+    filter->x1 = input;
+    filter->y2 = filter->y1;
+    filter->y1 = output;
+    return output;
+}
+
+static inline float onepole_tick_lowpass(OnePoleFilter* filter, float input) {
+    filter->prev_output += filter->alpha * (input - filter->prev_output);
+    return filter->prev_output;
+}
+
+static inline float onepole_tick_highpass(OnePoleFilter* filter, float input) {
+    filter->prev_output = filter->alpha * (filter->prev_output + input - filter->prev_output);
+    return input - filter->prev_output;
+}
+
 // Filter design functions
 void biquad_lowpass(BiquadFilter* filter, float freq, float q, float sample_rate);
 void biquad_highpass(BiquadFilter* filter, float freq, float q, float sample_rate);
@@ -35,14 +58,148 @@ void biquad_notch(BiquadFilter* filter, float freq, float q, float sample_rate);
 // Filter processing functions
 float biquad_process(BiquadFilter* filter, float input);
 void biquad_reset(BiquadFilter* filter);
+void biquad_process_block(BiquadFilter* filter, const sample_t* in, sample_t* out, size_t n);
 void biquad_process_buffer(BiquadFilter* filter, AudioBuffer* buffer);
+void biquad_process_channels(BiquadFilter* filters, AudioBuffer* buffer);
+Effect biquad_effect(BiquadFilter* filter);
 
 // One-pole filter functions
 void onepole_lowpass(OnePoleFilter* filter, float freq, float sample_rate);
 void onepole_highpass(OnePoleFilter* filter, float freq, float sample_rate);
 float onepole_process(OnePoleFilter* filter, float input, int highpass);
+void onepole_process_block(OnePoleFilter* filter, const sample_t* in, sample_t* out, size_t n, int highpass);
 void onepole_reset(OnePoleFilter* filter);
 
+// State-variable filter in topology-preserving (trapezoidal) form. The
+// cutoff only enters through a1..a3, never the integrator state, so it can
+// be swept without clicks or state resets. Every FilterType is a fixed mix
+// of the input, band and low outputs (bandpass at 0 dB peak, like
+// biquad_bandpass).
+typedef struct {
+    float a1, a2, a3;  // From g = tan(pi * freq / fs) and k = 1 / q
+    float k;
+    float m0, m1, m2;  // Output mix of input, band and low
+    float ic1eq, ic2eq; // Integrator state
+} SVFilter;
+
+static inline float svf_tick(SVFilter* filter, float input) {
+    float v3 = input - filter->ic2eq;
+    float v1 = filter->a1 * filter->ic1eq + filter->a2 * v3;
+    float v2 = filter->ic2eq + filter->a2 * filter->ic1eq + filter->a3 * v3;
+    filter->ic1eq = 2.0f * v1 - filter->ic1eq;
+    filter->ic2eq = 2.0f * v2 - filter->ic2eq;
+    return filter->m0 * input + filter->m1 * v1 + filter->m2 * v2;
+}
+
+void svf_design(SVFilter* filter, FilterType type, float freq, float q, float sample_rate); // Keeps state
+void svf_reset(SVFilter* filter);
+
+// Modulated filter: an SVF whose cutoff is retargeted once per control
+// period of MOD_FILTER_CONTROL_RATE samples. a1..a3 ramp linearly to the
+// new target across the period, so a sweep costs one tanf and one division
+// per period instead of a full redesign per sample.
+#define MOD_FILTER_CONTROL_RATE 16
+
+typedef struct {
+    SVFilter svf;
+    float da1, da2, da3;   // Per-sample coefficient steps
+    size_t remaining;      // Samples left in the current control period
+    float sample_rate;
+} ModulatedFilter;
+
+void modfilter_init(ModulatedFilter* filter, FilterType type, float freq, float q, float sample_rate);
+void modfilter_set_q(ModulatedFilter* filter, float q);   // Takes effect at the next target
+void modfilter_target(ModulatedFilter* filter, float freq);
+void modfilter_reset(ModulatedFilter* filter);
+
+// Nonzero once the current control period is over and a new target is due
+static inline int modfilter_control_due(const ModulatedFilter* filter) {
+    return filter->remaining == 0;
+}
+
+static inline float modfilter_tick(ModulatedFilter* filter, float input) {
+    if (filter->remaining) {
+        filter->svf.a1 += filter->da1;
+        filter->svf.a2 += filter->da2;
+        filter->svf.a3 += filter->da3;
+        filter->remaining--;
+    }
+    return svf_tick(&filter->svf, input);
+}
+
+// Bank of up to 8 biquads in transposed Direct Form II, stored as
+// structure-of-arrays so one SIMD register holds the same coefficient or
+// state for every lane. Lanes can run in parallel on one input (EQ bands),
+// on the channels of interleaved frames, or in series (cascade).
+#define BIQUAD_BANK_LANES 8
+
+typedef struct {
+    float b0[BIQUAD_BANK_LANES];
+    float b1[BIQUAD_BANK_LANES];
+    float b2[BIQUAD_BANK_LANES];
+    float a1[BIQUAD_BANK_LANES];
+    float a2[BIQUAD_BANK_LANES];
+    float s1[BIQUAD_BANK_LANES];   // TDF-II state
+    float s2[BIQUAD_BANK_LANES];
+    float gain[BIQUAD_BANK_LANES]; // Per-lane output gain
+    int num_lanes;
+} BiquadBank;
+
+// Biquad bank functions (SSE/AVX2 kernels picked at runtime, scalar fallback)
+void biquad_bank_init(BiquadBank* bank, int num_lanes);
+void biquad_bank_set_lane(BiquadBank* bank, int lane, const BiquadFilter* design, float gain);
+void biquad_bank_set_gain(BiquadBank* bank, int lane, float gain);
+void biquad_bank_reset(BiquadBank* bank);
+void biquad_bank_process_parallel(BiquadBank* bank, const sample_t* in, sample_t* out, size_t n);
+void biquad_bank_process_interleaved(BiquadBank* bank, const sample_t* in, sample_t* out, size_t frames);
+void biquad_bank_process_cascade(BiquadBank* bank, const sample_t* in, sample_t* out,
+                                 const float* stage_gains, size_t n);
+
+// Polyphase half-band oversampler for running nonlinearities at 2x, 4x or
+// 8x the base rate. Each 2x stage is a linear-phase half-band FIR whose
+// centre tap is 1/2 and whose other odd-offset taps are zero, so the
+// upsampler filters one polyphase branch (the other is a plain delay) and
+// the downsampler filters only the even samples. Later stages only have to
+// reject images far above the audio band and use shorter filters. The
+// top rate is padded so the latency is a whole number of base samples.
+#define OVERSAMPLE_MAX_FACTOR 8
+#define OVERSAMPLE_MAX_STAGES 3
+#define HALFBAND_MAX_TAPS 24       // Nonzero side taps of the first stage
+#define OVERSAMPLE_MAX_LATENCY 31  // Base-rate samples, reached at 8x
+
+typedef struct {
+    float coeffs[HALFBAND_MAX_TAPS];
+    float history[2 * HALFBAND_MAX_TAPS]; // Mirrored so the taps read one contiguous window
+    int taps;
+    int pos;
+} HalfbandFir;
+
+typedef struct {
+    HalfbandFir up;
+    HalfbandFir down;              // Runs on the even high-rate samples
+    float odd_delay[HALFBAND_MAX_TAPS / 2]; // Odd samples waiting for the centre tap
+    int odd_pos;
+} HalfbandStage;
+
+typedef struct {
+    HalfbandStage stages[OVERSAMPLE_MAX_STAGES];
+    float pad[OVERSAMPLE_MAX_FACTOR];      // Top-rate delay rounding the latency up
+    int pad_length;
+    int pad_pos;
+    int num_stages;
+    int factor;
+    size_t latency;                // Base-rate samples, up and down combined
+} Oversampler;
+
+// Oversampler functions (SSE kernels picked at runtime, scalar fallback).
+// up writes n * factor samples; down reads n * factor samples and uses its
+// input as scratch. in and out must not overlap.
+int oversampler_init(Oversampler* os, int factor);   // 1, 2, 4 or 8; 0 otherwise
+void oversampler_reset(Oversampler* os);
+size_t oversampler_latency(const Oversampler* os);
+void oversampler_up(Oversampler* os, const sample_t* in, sample_t* out, size_t n);
+void oversampler_down(Oversampler* os, sample_t* in, sample_t* out, size_t n);
+
 // EQ bands structure
 typedef struct {
     BiquadFilter low_shelf;
@@ -53,12 +210,18 @@ typedef struct {
     float low_mid_gain;
     float high_mid_gain;
     float high_gain;
+    BiquadBank bank;   // The four bands run side by side in one bank
+    ParamSmoother gain_smoothers[4]; // Linear band gains, low to high
 } FourBandEQ;
 
 // EQ functions
 void eq_init(FourBandEQ* eq, float sample_rate);
 void eq_set_gains(FourBandEQ* eq, float low, float low_mid, float high_mid, float high);
 float eq_process(FourBandEQ* eq, float input);
+void eq_process_block(FourBandEQ* eq, const sample_t* in, sample_t* out, size_t n);
 void eq_process_buffer(FourBandEQ* eq, AudioBuffer* buffer);
+void eq_process_channels(FourBandEQ* eqs, AudioBuffer* buffer);
+void eq_reset(FourBandEQ* eq);
+Effect eq_effect(FourBandEQ* eq);
 
 #endif // AUDIO_FILTERS_H
\ No newline at end of file
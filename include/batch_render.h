@@ -0,0 +1,63 @@
+#ifndef BATCH_RENDER_H
+#define BATCH_RENDER_H
+
+#include "audio_core.h"
+#include "effect_chain.h"
+
+// Batch renderer: a pool of worker threads pulls files from a bounded job
+// queue and streams each one through its own effect chains (one per
+// channel). Workers keep their chains between files and only rebuild them
+// when the channel count or sample rate changes, so a preset is built
+// once per worker rather than once per file.
+#define BATCH_DEFAULT_BLOCK_FRAMES 4096
+#define BATCH_DEFAULT_QUEUE_DEPTH 64
+
+// Builds one channel's chain for the preset; must be callable from any worker
+typedef EffectChain* (*ChainFactory)(void* user, float sample_rate);
+
+// One file to render. The worker fills in the results.
+typedef struct {
+    const char* input;
+    const char* output;
+    size_t frames;            // Frames rendered
+    size_t channels;
+    size_t sample_rate;
+    double seconds;           // Wall time spent on this file
+    int worker;               // Index of the worker that rendered it
+    int ok;
+} BatchJob;
+
+typedef struct {
+    ChainFactory factory;
+    void* user;
+    int num_workers;          // <= 0 uses cpu_core_count()
+    size_t queue_depth;       // Jobs waiting before submit blocks (0 for the default)
+    size_t block_frames;      // Frames per read/process/write pass (0 for the default)
+    int channel_threads;      // Also split multichannel files across ChannelRenderer threads
+} BatchConfig;
+
+typedef struct BatchRenderer BatchRenderer;
+
+// Channel renderer: runs each channel's chain on its own thread over a
+// planar buffer. Channel 0 runs on the calling thread; the others wake
+// once per process call, work on their own plane and report back, so a
+// block costs one handoff and one join regardless of its length. Chains
+// stay owned by the caller.
+typedef struct ChannelRenderer ChannelRenderer;
+
+ChannelRenderer* channel_renderer_create(EffectChain* const* chains, size_t channels);
+void channel_renderer_process(ChannelRenderer* renderer, AudioBuffer* buffer, size_t frames);
+void channel_renderer_destroy(ChannelRenderer* renderer);
+
+// Batch renderer functions. Submitted jobs must stay valid until
+// batch_renderer_finish returns; submit blocks while the queue is full.
+BatchRenderer* batch_renderer_create(const BatchConfig* config);
+int batch_renderer_submit(BatchRenderer* renderer, BatchJob* job);
+void batch_renderer_finish(BatchRenderer* renderer);   // Drain the queue and join the workers
+void batch_renderer_destroy(BatchRenderer* renderer);  // Finishes first if needed
+int batch_renderer_workers(const BatchRenderer* renderer);
+
+// Render a list of jobs; returns the number that succeeded
+size_t batch_render(const BatchConfig* config, BatchJob* jobs, size_t num_jobs);
+
+#endif // BATCH_RENDER_H
@@ -0,0 +1,73 @@
+#ifndef CONVOLUTION_H
+#define CONVOLUTION_H
+
+#include "audio_core.h"
+#include "fft.h"
+
+// Convolution reverb for sampled impulse responses, using uniformly
+// partitioned overlap-save convolution. The IR is cut into partitions of
+// one block, each transformed once. Every block of input is transformed
+// once into a frequency-domain delay line, and one output block is the
+// inverse transform of the sum of delayed input spectra times partition
+// spectra.
+//
+// With a tail block the partitioning is non-uniform (head-tail): the first
+// tail_block - head_block samples of the IR run at the head block size,
+// which sets the latency, and the rest at the tail block size, where the
+// per-sample cost of a partition is much lower. The head length makes the
+// tail output line up with no extra delay. Between tail blocks the tail sum
+// over older spectra is accumulated a slice per head block, so only one
+// partition and the two transforms fall on the block boundary.
+#define CONVOLUTION_DEFAULT_HEAD_BLOCK 128
+#define CONVOLUTION_DEFAULT_TAIL_BLOCK 4096
+#define CONVOLUTION_MAX_BLOCK 16384
+
+// One uniformly partitioned segment of the IR
+typedef struct {
+    FftPlan* plan;            // Shared plan of 2 * block points
+    size_t block;
+    size_t partitions;
+    float* ir_spectra;        // partitions spectra of 2 * block floats, scaled by 1 / (2 * block)
+    float* fdl;               // Frequency-domain delay line, partitions spectra
+    size_t fdl_pos;           // Slot of the newest input spectrum
+    float* frame;             // Last two input blocks (2 * block)
+    float* accum;             // Output spectrum being summed (2 * block)
+    float* output;            // Time-domain scratch, then the last output block
+    size_t fill;              // Samples of the current input block received (tail only)
+    size_t next_partition;    // Next partition of the spread tail sum (tail only)
+} ConvolutionSegment;
+
+typedef struct {
+    ConvolutionSegment head;
+    ConvolutionSegment tail;  // partitions == 0 when the IR fits in the head
+    size_t block;             // Head block: latency in samples
+    size_t ticks;             // Head blocks per tail block
+    size_t tick;              // Head blocks since the last tail block
+    float* input;             // Head block being collected
+    float* output;            // Mixed block being played out
+    size_t fifo_pos;
+    size_t ir_length;
+    float wet_level;
+    float dry_level;
+    ParamSmoother wet_smoother;
+} ConvolutionReverb;
+
+// Convolution reverb functions. head_block and tail_block are powers of two
+// up to CONVOLUTION_MAX_BLOCK; tail_block 0 keeps the partitioning uniform,
+// otherwise it must exceed head_block. The output (dry and wet) is delayed
+// by head_block samples.
+ConvolutionReverb* convolution_reverb_create(const float* ir, size_t length, size_t head_block, size_t tail_block,
+                                             float sample_rate);
+ConvolutionReverb* convolution_reverb_load(const char* filename, int channel, size_t head_block, size_t tail_block,
+                                           float sample_rate);   // channel < 0 mixes every channel down
+void convolution_reverb_destroy(ConvolutionReverb* reverb);
+void convolution_reverb_set_params(ConvolutionReverb* reverb, float wet_level);
+size_t convolution_reverb_latency(const ConvolutionReverb* reverb);
+sample_t convolution_reverb_process(ConvolutionReverb* reverb, sample_t input);
+void convolution_reverb_process_block(ConvolutionReverb* reverb, const sample_t* in, sample_t* out, size_t n);
+void convolution_reverb_process_buffer(ConvolutionReverb* reverb, AudioBuffer* buffer);
+void convolution_reverb_process_channels(ConvolutionReverb** reverbs, AudioBuffer* buffer);
+void convolution_reverb_reset(ConvolutionReverb* reverb);
+Effect convolution_reverb_effect(ConvolutionReverb* reverb);
+
+#endif // CONVOLUTION_H
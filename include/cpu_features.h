@@ -0,0 +1,40 @@
+#ifndef CPU_FEATURES_H
+#define CPU_FEATURES_H
+
+// Runtime CPU feature detection used to pick SIMD kernels.
+// Kernels for wider instruction sets are compiled with per-function
+// target attributes, so the library itself still builds for the
+// baseline ISA and only uses AVX2 when the running CPU supports it.
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define AUDIO_X86_DISPATCH 1
+#define AUDIO_TARGET_AVX2 __attribute__((target("avx2,fma")))
+#endif
+
+// SIMD kernel levels, lowest to highest
+typedef enum {
+    SIMD_LEVEL_SCALAR = 0,
+    SIMD_LEVEL_SSE2,
+    SIMD_LEVEL_NEON,
+    SIMD_LEVEL_AVX2
+} SimdLevel;
+
+typedef struct {
+    int sse2;
+    int sse41;
+    int avx;
+    int avx2;
+    int fma;
+    int neon;
+} CpuFeatures;
+
+// Feature detection
+const CpuFeatures* cpu_get_features(void);
+SimdLevel cpu_simd_level(void);
+void cpu_set_simd_level(SimdLevel level); // Cap the level (e.g. to compare kernels)
+const char* cpu_simd_level_name(SimdLevel level);
+
+// Core count used to size worker pools
+int cpu_core_count(void);
+
+#endif // CPU_FEATURES_H
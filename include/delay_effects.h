@@ -4,21 +4,45 @@
 #include "audio_core.h"
 #include "audio_filters.h"
 
-// Simple delay line structure
+// Simple delay line structure. The ring holds a power-of-two number of
+// samples (mask + 1) so positions wrap with a mask instead of a modulo;
+// size is the usable length (max delay + 1).
 typedef struct {
     sample_t* buffer;
     size_t size;
+    size_t mask;
     size_t write_pos;
     size_t read_pos;
 } DelayLine;
 
-// Echo effect structure
+// Fractional delay interpolators for modulated reads. The 4-point kernels
+// keep the high end that linear interpolation loses; the allpass is flat
+// in magnitude but its phase is only exact at low frequencies; the
+// windowed sinc is the most accurate and the most expensive.
+typedef enum {
+    DELAY_INTERP_LINEAR,
+    DELAY_INTERP_LAGRANGE3,   // 4-point, third-order Lagrange
+    DELAY_INTERP_HERMITE4,    // 4-point, third-order Hermite (Catmull-Rom)
+    DELAY_INTERP_ALLPASS,     // First-order allpass (keeps state)
+    DELAY_INTERP_SINC         // 8-tap Blackman-windowed sinc
+} DelayInterpolation;
+
+typedef struct {
+    DelayInterpolation mode;
+    float allpass_state;      // Previous allpass output
+} DelayInterpolator;
+
+// Echo effect structure. The public fields hold the last values set; the
+// block loop reads the smoothers.
 typedef struct {
     DelayLine delay;
     float feedback;
     float wet_level;
     float dry_level;
     OnePoleFilter feedback_filter;
+    float sample_rate;
+    ParamSmoother feedback_smoother;
+    ParamSmoother wet_smoother;
 } Echo;
 
 // Multi-tap delay structure
@@ -30,6 +54,8 @@ typedef struct {
     float feedback;
     float wet_level;
     float dry_level;
+    ParamSmoother feedback_smoother;
+    ParamSmoother wet_smoother;
 } MultiTapDelay;
 
 // Ping-pong delay structure (stereo)
@@ -42,8 +68,37 @@ typedef struct {
     float dry_level;
     OnePoleFilter left_filter;
     OnePoleFilter right_filter;
+    ParamSmoother feedback_smoother;
+    ParamSmoother cross_feedback_smoother;
+    ParamSmoother wet_smoother;
 } PingPongDelay;
 
+// Inline delay line access for inner loops. Unchecked: the caller must
+// guarantee delay_samples < delay->size and validate the line once per block.
+// A delay of 0 names the slot about to be overwritten, which holds the sample
+// written size pushes ago.
+static inline sample_t delay_line_tap(const DelayLine* delay, size_t delay_samples) {
+    size_t back = delay_samples ? delay_samples : delay->size;
+    return delay->buffer[(delay->write_pos - back) & delay->mask];
+}
+
+static inline sample_t delay_line_tap_interpolated(const DelayLine* delay, float delay_samples) {
+    size_t delay_int = (size_t)delay_samples;
+    float delay_frac = delay_samples - delay_int;
+    
+    if (delay_int >= delay->size - 1) return 0.0f;
+    
+    size_t pos1 = (delay->write_pos - (delay_int ? delay_int : delay->size)) & delay->mask;
+    size_t pos2 = (delay->write_pos - delay_int - 1) & delay->mask;
+    
+    return delay->buffer[pos1] + delay_frac * (delay->buffer[pos2] - delay->buffer[pos1]);
+}
+
+static inline void delay_line_push(DelayLine* delay, sample_t sample) {
+    delay->buffer[delay->write_pos] = sample;
+    delay->write_pos = (delay->write_pos + 1) & delay->mask;
+}
+
 // Delay line functions
 DelayLine* delay_line_create(size_t max_delay_samples);
 void delay_line_destroy(DelayLine* delay);
@@ -52,12 +107,34 @@ sample_t delay_line_read(DelayLine* delay, size_t delay_samples);
 sample_t delay_line_read_interpolated(DelayLine* delay, float delay_samples);
 void delay_line_clear(DelayLine* delay);
 
+// Block access: copy contiguous spans (at most two per call) instead of
+// wrapping per sample. read_block returns the n samples starting delay_samples
+// back from the write position; keep n <= delay_samples so it only sees
+// samples that were already written.
+void delay_line_write_block(DelayLine* delay, const sample_t* in, size_t n);
+void delay_line_read_block(const DelayLine* delay, size_t delay_samples, sample_t* out, size_t n);
+
+// Modulated block reads. delays[i] is measured from the write position as
+// it will be after i more pushes, i.e. sample i is read before the i-th
+// push of a read-then-push loop. Delays are clamped to the range the
+// interpolator can serve. The read stops before the first sample that
+// would need data not yet written and returns how many samples it read
+// (at least one when n > 0), so feedback loops push those and call again.
+void delay_interp_init(DelayInterpolator* interp, DelayInterpolation mode);
+void delay_interp_reset(DelayInterpolator* interp);
+size_t delay_line_read_modulated(const DelayLine* delay, DelayInterpolator* interp, const float* delays,
+                                 sample_t* out, size_t n);
+
 // Echo effect functions
 Echo* echo_create(float max_delay_seconds, float sample_rate);
 void echo_destroy(Echo* echo);
 void echo_set_params(Echo* echo, float delay_seconds, float feedback, float wet_level, float sample_rate);
 sample_t echo_process(Echo* echo, sample_t input);
+void echo_process_block(Echo* echo, const sample_t* in, sample_t* out, size_t n);
 void echo_process_buffer(Echo* echo, AudioBuffer* buffer);
+void echo_process_channels(Echo** echoes, AudioBuffer* buffer);
+void echo_reset(Echo* echo);
+Effect echo_effect(Echo* echo);
 
 // Multi-tap delay functions
 MultiTapDelay* multitap_create(float max_delay_seconds, float sample_rate);
@@ -65,7 +142,11 @@ void multitap_destroy(MultiTapDelay* multitap);
 void multitap_set_tap(MultiTapDelay* multitap, int tap_index, float delay_seconds, float gain, float sample_rate);
 void multitap_set_feedback(MultiTapDelay* multitap, float feedback, float wet_level);
 sample_t multitap_process(MultiTapDelay* multitap, sample_t input);
+void multitap_process_block(MultiTapDelay* multitap, const sample_t* in, sample_t* out, size_t n);
 void multitap_process_buffer(MultiTapDelay* multitap, AudioBuffer* buffer);
+void multitap_process_channels(MultiTapDelay** multitaps, AudioBuffer* buffer);
+void multitap_reset(MultiTapDelay* multitap);
+Effect multitap_effect(MultiTapDelay* multitap);
 
 // Ping-pong delay functions (for stereo processing)
 PingPongDelay* pingpong_create(float max_delay_seconds, float sample_rate);
@@ -74,5 +155,8 @@ void pingpong_set_params(PingPongDelay* pingpong, float delay_seconds, float fee
                         float cross_feedback, float wet_level, float sample_rate);
 void pingpong_process_stereo(PingPongDelay* pingpong, sample_t* left_in, sample_t* right_in,
                            sample_t* left_out, sample_t* right_out);
+void pingpong_process_block(PingPongDelay* pingpong, const sample_t* left_in, const sample_t* right_in,
+                            sample_t* left_out, sample_t* right_out, size_t n);
+void pingpong_process_buffer(PingPongDelay* pingpong, AudioBuffer* buffer);
 
 #endif // DELAY_EFFECTS_H
\ No newline at end of file
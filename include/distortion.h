@@ -3,6 +3,7 @@
 
 #include "audio_core.h"
 #include "audio_filters.h"
+#include "fast_math.h"
 
 // Distortion types
 typedef enum {
@@ -13,6 +14,27 @@ typedef enum {
     DISTORTION_OVERDRIVE
 } DistortionType;
 
+// Oversampling around the waveshapers. Filters and gates stay at the base
+// rate; only the nonlinear part of each effect runs at factor times the
+// rate, between an Oversampler's up and down stages, so harmonics above
+// Nyquist are filtered out instead of folding back as aliases. The wet
+// path is late by the oversampler latency; the dry path is delayed to match
+// and the latency is reported to effect chains (add the effect to a
+// parallel branch after choosing the factor).
+#define DISTORTION_DEFAULT_OVERSAMPLING 2
+#define DISTORTION_BLOCK 64          // Base-rate samples per oversampled pass
+
+typedef struct {
+    Oversampler oversampler;
+    float dry_delay[OVERSAMPLE_MAX_LATENCY];
+    size_t dry_pos;
+} DistortionOversampling;
+
+// The effects below keep the last values set in their public fields and
+// read per-sample ramps of them from the smoothers. While a waveshaper
+// parameter ramps, each base-rate sample's group of oversampled samples is
+// shaped with that sample's value.
+
 // Basic distortion structure
 typedef struct {
     DistortionType type;
@@ -22,6 +44,11 @@ typedef struct {
     BiquadFilter pre_filter;
     BiquadFilter post_filter;
     float sample_rate;
+    DistortionOversampling oversampling;
+    FastMathTier accuracy;
+    ParamSmoother drive_smoother;
+    ParamSmoother output_gain_smoother;
+    ParamSmoother mix_smoother;
 } Distortion;
 
 // Tube distortion structure with asymmetric clipping
@@ -33,6 +60,12 @@ typedef struct {
     BiquadFilter input_filter;
     BiquadFilter output_filter;
     OnePoleFilter dc_blocker;
+    DistortionOversampling oversampling;
+    FastMathTier accuracy;
+    ParamSmoother drive_smoother;
+    ParamSmoother bias_smoother;
+    ParamSmoother output_gain_smoother;
+    ParamSmoother mix_smoother;
 } TubeDistortion;
 
 // Fuzz distortion structure
@@ -44,6 +77,13 @@ typedef struct {
     BiquadFilter pre_emphasis;
     BiquadFilter de_emphasis;
     OnePoleFilter gate_filter;
+    DistortionOversampling oversampling;
+    float gate_delay[OVERSAMPLE_MAX_LATENCY]; // Gate held back to meet the oversampled path
+    size_t gate_pos;
+    ParamSmoother fuzz_amount_smoother;
+    ParamSmoother gate_threshold_smoother;
+    ParamSmoother output_gain_smoother;
+    ParamSmoother mix_smoother;
 } FuzzDistortion;
 
 // Overdrive structure with multi-stage clipping
@@ -56,6 +96,12 @@ typedef struct {
     BiquadFilter tone_filter;
     BiquadFilter output_filter;
     float stage_gains[3];
+    DistortionOversampling oversampling;
+    FastMathTier accuracy;
+    ParamSmoother drive_smoother;
+    ParamSmoother tone_smoother;
+    ParamSmoother output_gain_smoother;
+    ParamSmoother mix_smoother;
 } Overdrive;
 
 // Basic distortion functions
@@ -63,30 +109,58 @@ Distortion* distortion_create(DistortionType type, float sample_rate);
 void distortion_destroy(Distortion* dist);
 void distortion_set_params(Distortion* dist, float drive, float output_gain, float mix);
 sample_t distortion_process(Distortion* dist, sample_t input);
+void distortion_process_block(Distortion* dist, const sample_t* in, sample_t* out, size_t n);
 void distortion_process_buffer(Distortion* dist, AudioBuffer* buffer);
+void distortion_process_channels(Distortion** dists, AudioBuffer* buffer);
+int distortion_set_oversampling(Distortion* dist, int factor); // 1, 2, 4 or 8; clears the state
+void distortion_set_accuracy(Distortion* dist, FastMathTier accuracy);
+size_t distortion_latency(const Distortion* dist);
+void distortion_reset(Distortion* dist);
+Effect distortion_effect(Distortion* dist);
 
 // Tube distortion functions
 TubeDistortion* tube_distortion_create(float sample_rate);
 void tube_distortion_destroy(TubeDistortion* tube);
 void tube_distortion_set_params(TubeDistortion* tube, float drive, float bias, float output_gain, float mix);
 sample_t tube_distortion_process(TubeDistortion* tube, sample_t input);
+void tube_distortion_process_block(TubeDistortion* tube, const sample_t* in, sample_t* out, size_t n);
 void tube_distortion_process_buffer(TubeDistortion* tube, AudioBuffer* buffer);
+void tube_distortion_process_channels(TubeDistortion** tubes, AudioBuffer* buffer);
+int tube_distortion_set_oversampling(TubeDistortion* tube, int factor); // 1, 2, 4 or 8; clears the state
+void tube_distortion_set_accuracy(TubeDistortion* tube, FastMathTier accuracy);
+size_t tube_distortion_latency(const TubeDistortion* tube);
+void tube_distortion_reset(TubeDistortion* tube);
+Effect tube_distortion_effect(TubeDistortion* tube);
 
 // Fuzz distortion functions
 FuzzDistortion* fuzz_distortion_create(float sample_rate);
 void fuzz_distortion_destroy(FuzzDistortion* fuzz);
 void fuzz_distortion_set_params(FuzzDistortion* fuzz, float fuzz_amount, float gate_threshold, float output_gain, float mix);
 sample_t fuzz_distortion_process(FuzzDistortion* fuzz, sample_t input);
+void fuzz_distortion_process_block(FuzzDistortion* fuzz, const sample_t* in, sample_t* out, size_t n);
 void fuzz_distortion_process_buffer(FuzzDistortion* fuzz, AudioBuffer* buffer);
+void fuzz_distortion_process_channels(FuzzDistortion** fuzzes, AudioBuffer* buffer);
+int fuzz_distortion_set_oversampling(FuzzDistortion* fuzz, int factor); // 1, 2, 4 or 8; clears the state
+size_t fuzz_distortion_latency(const FuzzDistortion* fuzz);
+void fuzz_distortion_reset(FuzzDistortion* fuzz);
+Effect fuzz_distortion_effect(FuzzDistortion* fuzz);
 
 // Overdrive functions
 Overdrive* overdrive_create(float sample_rate);
 void overdrive_destroy(Overdrive* overdrive);
 void overdrive_set_params(Overdrive* overdrive, float drive, float tone, float output_gain, float mix);
 sample_t overdrive_process(Overdrive* overdrive, sample_t input);
+void overdrive_process_block(Overdrive* overdrive, const sample_t* in, sample_t* out, size_t n);
 void overdrive_process_buffer(Overdrive* overdrive, AudioBuffer* buffer);
+void overdrive_process_channels(Overdrive** overdrives, AudioBuffer* buffer);
+int overdrive_set_oversampling(Overdrive* overdrive, int factor); // 1, 2, 4 or 8; clears the state
+void overdrive_set_accuracy(Overdrive* overdrive, FastMathTier accuracy);
+size_t overdrive_latency(const Overdrive* overdrive);
+void overdrive_reset(Overdrive* overdrive);
+Effect overdrive_effect(Overdrive* overdrive);
 
-// Waveshaping functions
+// Waveshaping functions (per-sample libm versions; the effects shape whole
+// oversampled blocks with the fast_math kernels)
 sample_t hard_clip(sample_t input, float threshold);
 sample_t soft_clip(sample_t input, float amount);
 sample_t tube_saturation(sample_t input, float drive, float bias);
@@ -0,0 +1,95 @@
+#ifndef EFFECT_CHAIN_H
+#define EFFECT_CHAIN_H
+
+#include "audio_core.h"
+#include "delay_effects.h"
+
+// Effect chain: runs a list of nodes over cache-resident blocks of
+// EFFECT_CHAIN_BLOCK samples, so every stage touches a chunk while it is
+// still in L1 instead of streaming the whole buffer once per effect.
+// Nodes are effects (Effect from any *_effect() wrapper), parallel
+// branches that are summed, and send/return pairs sharing a bus.
+#define EFFECT_CHAIN_BLOCK AUDIO_CHANNEL_CHUNK
+#define EFFECT_CHAIN_MAX_NODES 16
+#define EFFECT_CHAIN_MAX_BRANCHES 4
+#define EFFECT_CHAIN_MAX_BUSES 4
+
+typedef enum {
+    CHAIN_NODE_EFFECT,      // Process the signal in place
+    CHAIN_NODE_PARALLEL,    // Feed the signal to every branch and sum them
+    CHAIN_NODE_SEND,        // Add the signal (scaled) to a bus, pass it on
+    CHAIN_NODE_RETURN       // Process a bus and mix it back into the signal
+} ChainNodeType;
+
+typedef struct {
+    ChainNodeType type;
+    Effect effect;                                   // Effect, or the return's bus processor
+    Effect branches[EFFECT_CHAIN_MAX_BRANCHES];
+    float branch_gains[EFFECT_CHAIN_MAX_BRANCHES];
+    DelayLine* branch_delays[EFFECT_CHAIN_MAX_BRANCHES]; // Latency compensation (NULL if aligned)
+    size_t branch_offsets[EFFECT_CHAIN_MAX_BRANCHES];
+    int num_branches;
+    int bus;
+    float level;                                     // Send/return level
+    int bypass;
+} ChainNode;
+
+typedef struct {
+    ChainNode nodes[EFFECT_CHAIN_MAX_NODES];
+    int num_nodes;
+    float sample_rate;
+    sample_t buses[EFFECT_CHAIN_MAX_BUSES][EFFECT_CHAIN_BLOCK];
+    sample_t branch_in[EFFECT_CHAIN_BLOCK];          // Parallel node input copy
+    sample_t branch_out[EFFECT_CHAIN_BLOCK];         // One branch's output
+} EffectChain;
+
+// Parameter change at a frame offset inside the block being processed
+typedef struct {
+    size_t frame;
+    int node;
+    int param;
+    float value;
+} AutomationEvent;
+
+// Effect chain functions. The chain owns added effects and destroys them
+// with their vtable destroy; when an add fails the caller keeps ownership.
+// Add functions return the node index, or -1.
+EffectChain* effect_chain_create(float sample_rate);
+void effect_chain_destroy(EffectChain* chain);
+int effect_chain_add(EffectChain* chain, Effect effect);
+
+// Branches run on the same input and are summed with their gains. A branch
+// with a NULL vtable is a dry path. Branches with less latency than the
+// slowest one are delayed to line up (measured when the node is added).
+int effect_chain_add_parallel(EffectChain* chain, const Effect* branches, const float* gains, int num_branches);
+
+// Sends accumulate into a bus; the return processes it (wet-only effects
+// suit this) and adds it back, then clears the bus. A send placed after
+// its return feeds the next block.
+int effect_chain_add_send(EffectChain* chain, int bus, float level);
+int effect_chain_add_return(EffectChain* chain, int bus, Effect effect, float level);
+
+// Every effect smooths its parameters and only publishes a target here, so
+// set_param may be called from a control thread while the chain runs.
+// Levels, bypass and reset still belong on the audio thread.
+int effect_chain_set_param(EffectChain* chain, int node, int param, float value);
+void effect_chain_set_level(EffectChain* chain, int node, float level);
+void effect_chain_set_bypass(EffectChain* chain, int node, int bypass);
+void effect_chain_reset(EffectChain* chain);
+size_t effect_chain_latency(const EffectChain* chain);
+
+void effect_chain_process_block(EffectChain* chain, const sample_t* in, sample_t* out, size_t n);
+void effect_chain_process_buffer(EffectChain* chain, AudioBuffer* buffer);
+void effect_chain_process_channels(EffectChain** chains, AudioBuffer* buffer);
+
+// Process a block with sample-accurate automation: the block is split at
+// each event's frame and the change applied before that sample. Events
+// must be sorted by frame; frames at or past n are applied after the
+// block. Returns the number of events the chain accepted.
+size_t effect_chain_process_automated(EffectChain* chain, const sample_t* in, sample_t* out, size_t n,
+                                      const AutomationEvent* events, size_t num_events);
+
+// A chain is itself an effect, so it can be a parallel branch or a bus processor
+Effect effect_chain_effect(EffectChain* chain);
+
+#endif // EFFECT_CHAIN_H
@@ -0,0 +1,64 @@
+#ifndef FAST_MATH_H
+#define FAST_MATH_H
+
+#include "audio_core.h"
+
+// Fast approximations of the transcendental functions used by the
+// waveshapers, in three accuracy tiers. All of them are branchless
+// (clamps and selects only), so the block versions run four samples per
+// SSE2 register; the scalar fallback performs the same operations in the
+// same order, so both give identical results. Errors against libm (see
+// fast_math_measure and fast_math_error_bound):
+//
+//   tier     tanh (absolute)             exp (relative)
+//   LOW      Pade [5/4], 1.1e-3          cubic 2^f, 7.5e-5
+//   MEDIUM   minimax [7/6], 1.2e-6       quartic 2^f, 2.7e-6
+//   HIGH     minimax [13/6], 4e-7        sextic 2^f, 1.3e-7
+//
+// The logistic sigmoid is 1 / (1 + e^-x) on top of the exp kernel.
+typedef enum {
+    FAST_MATH_LOW,
+    FAST_MATH_MEDIUM,
+    FAST_MATH_HIGH
+} FastMathTier;
+
+#define FAST_MATH_DEFAULT_TIER FAST_MATH_MEDIUM
+
+// Single values
+float fast_tanh(float x, FastMathTier tier);
+float fast_exp(float x, FastMathTier tier);       // Inputs clamped to about [-87, 88]
+float fast_sigmoid(float x, FastMathTier tier);   // 1 / (1 + e^-x)
+
+// Blocks (in and out may be the same buffer)
+void fast_tanh_block(const float* in, float* out, size_t n, FastMathTier tier);
+void fast_exp_block(const float* in, float* out, size_t n, FastMathTier tier);
+void fast_sigmoid_block(const float* in, float* out, size_t n, FastMathTier tier);
+
+// Waveshapers. The symmetric one computes scale * tanh(gain * in); the
+// asymmetric one picks a gain and scale per sample from the sign of
+// in + bias, without branching.
+void fast_tanh_shape_block(const float* in, float* out, size_t n, float gain, float scale, FastMathTier tier);
+void fast_asym_shape_block(const float* in, float* out, size_t n, float bias,
+                           float pos_gain, float pos_scale, float neg_gain, float neg_scale,
+                           FastMathTier tier);
+
+// Accuracy against libm over an input range
+typedef enum {
+    FAST_MATH_TANH,
+    FAST_MATH_EXP,
+    FAST_MATH_SIGMOID
+} FastMathFunction;
+
+typedef struct {
+    double max_abs_error;
+    double max_rel_error;
+    float worst_input;        // Input with the largest absolute error
+} FastMathError;
+
+// Evaluate points inputs spread evenly over [lo, hi] with the block kernel
+FastMathError fast_math_measure(FastMathFunction function, FastMathTier tier, float lo, float hi, size_t points);
+double fast_math_error_bound(FastMathFunction function, FastMathTier tier); // Relative for exp, absolute otherwise
+const char* fast_math_tier_name(FastMathTier tier);
+const char* fast_math_function_name(FastMathFunction function);
+
+#endif // FAST_MATH_H
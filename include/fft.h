@@ -0,0 +1,53 @@
+#ifndef FFT_H
+#define FFT_H
+
+#include "audio_core.h"
+
+// Real FFT of power-of-two length N, built on an N/2-point complex FFT
+// (radix-4 passes, plus one radix-2 pass when log2(N/2) is odd) over
+// separate real and imaginary arrays. A plan holds the bit-reversal table
+// and twiddles and is never written by a transform, so one plan can serve
+// any number of threads. The passes run on SSE or AVX2 when available
+// (scalar fallback); each pass vectorizes across butterflies, so no data
+// is shuffled between passes.
+//
+// Spectra are N floats in split order: re[0..N/2) then im[0..N/2), where
+// the imaginary slot of bin 0 (always zero) carries the real Nyquist bin.
+// The transforms are unnormalized: inverse(forward(x)) = N * x.
+#define FFT_MIN_SIZE 4
+#define FFT_MAX_SIZE (1 << 20)
+
+typedef struct {
+    size_t size;              // Real length N
+    size_t half;              // Complex length N / 2
+    int bits;                 // log2(half)
+    uint32_t* bitrev;         // Bit-reversal permutation of half entries
+    float* twiddles;          // Radix-4 pass twiddles, w1 w2 w3 as re/im arrays per pass
+    float* real_cos;          // cos(2 pi k / N) for the real split, k <= half / 2
+    float* real_sin;
+    int users;                // References held through the plan cache (0 for private plans)
+} FftPlan;
+
+// Private plans
+FftPlan* fft_plan_create(size_t size);   // NULL unless a power of two in range
+void fft_plan_destroy(FftPlan* plan);
+
+// Shared plans: one plan per size, created on first acquire and freed on
+// the last release. Both lock, so call them where *_create is allowed.
+FftPlan* fft_plan_acquire(size_t size);
+void fft_plan_release(FftPlan* plan);
+
+void fft_real_forward(const FftPlan* plan, const float* in, float* spectrum);   // in and spectrum must not overlap
+void fft_real_inverse(const FftPlan* plan, float* spectrum, float* out);        // Uses spectrum as scratch
+
+// Complex transforms of plan->half points, in place on split arrays in
+// natural order (inverse unnormalized: scaled by plan->half)
+void fft_complex_forward(const FftPlan* plan, float* re, float* im);
+void fft_complex_inverse(const FftPlan* plan, float* re, float* im);
+
+// acc += a * b over split spectra of an N-point real transform
+void fft_spectrum_mac(const FftPlan* plan, const float* a, const float* b, float* acc);
+// Magnitudes of bins 0..N/2 (N/2 + 1 values)
+void fft_spectrum_magnitude(const FftPlan* plan, const float* spectrum, float* magnitude);
+
+#endif // FFT_H
@@ -5,18 +5,49 @@
 #include "delay_effects.h"
 #include "audio_filters.h"
 
-// LFO (Low Frequency Oscillator) structure
+// LFO (Low Frequency Oscillator) structure. The phase is a 32-bit
+// fixed-point fraction of a cycle that wraps on overflow, so it never
+// drifts over long renders; the sine is a polynomial (error below 1e-6).
+// Change frequency with lfo_set_frequency or lfo_set_params so the phase
+// increment follows.
 typedef struct {
     float frequency;
-    float phase;
+    uint32_t phase;
+    uint32_t increment;       // Phase advance per sample
     float sample_rate;
     float amplitude;
     float offset;
 } LFO;
 
-// Chorus effect structure
+typedef enum {
+    LFO_SINE,
+    LFO_TRIANGLE,
+    LFO_SAWTOOTH,
+    LFO_SQUARE
+} LfoWaveform;
+
+#define LFO_BLOCK 64   // Control buffer length used by the effect block loops
+
+// Interpolator used by the delay-based effects unless changed
+#define MODULATION_DEFAULT_INTERPOLATION DELAY_INTERP_HERMITE4
+
+// Several LFOs driven by one clock: every voice shares the frequency and
+// phase of the clock plus a fixed phase offset (e.g. 0.25 cycle for
+// quadrature, 0.5 for stereo inversion), so they can never drift apart.
+#define LFO_BANK_MAX_VOICES 8
+
+typedef struct {
+    LFO clock;
+    uint32_t offsets[LFO_BANK_MAX_VOICES];
+    int num_voices;
+} LfoBank;
+
+// Chorus effect structure. depth, rate, feedback and the levels hold the
+// values last requested by chorus_set_params; processing follows them
+// through the smoothers, so they may be set while audio is running.
 typedef struct {
     DelayLine delay;
+    DelayInterpolator interpolator;
     LFO lfo;
     float depth;
     float rate;
@@ -24,11 +55,16 @@ typedef struct {
     float wet_level;
     float dry_level;
     OnePoleFilter feedback_filter;
+    ParamSmoother rate_smoother;
+    ParamSmoother depth_smoother;
+    ParamSmoother feedback_smoother;
+    ParamSmoother wet_smoother;
 } Chorus;
 
-// Flanger effect structure
+// Flanger effect structure. The parameters are smoothed as for Chorus.
 typedef struct {
     DelayLine delay;
+    DelayInterpolator interpolator;
     LFO lfo;
     float depth;
     float rate;
@@ -37,11 +73,38 @@ typedef struct {
     float dry_level;
     float manual; // Manual delay offset
     OnePoleFilter feedback_filter;
+    ParamSmoother rate_smoother;
+    ParamSmoother depth_smoother;
+    ParamSmoother feedback_smoother;
+    ParamSmoother manual_smoother;
+    ParamSmoother wet_smoother;
 } Flanger;
 
-// Phaser effect structure
+// Phaser effect structure. num_stages first-order allpasses share one
+// break frequency, swept by the LFO around PHASER_CENTER_HZ and updated
+// once per control period. Without feedback the stages run as a pipeline
+// (stage k works on sample t - k) so one SIMD register advances four stages
+// per sample; the output is therefore num_stages - 1 samples late, the dry
+// path is delayed to match and the latency is reported. With feedback the
+// stages run serially so the loop is one sample long, and the output is
+// held back by the same latency. Switching modes hands the stage states
+// over exactly: the pipeline is drained into the serial cascade, or
+// refilled stage by stage over num_stages - 1 samples.
+#define PHASER_MAX_STAGES 24
+#define PHASER_CENTER_HZ 800.0f
+#define PHASER_SWEEP_OCTAVES 3.0f   // Each way at full depth
+
 typedef struct {
-    BiquadFilter allpass_stages[6];
+    float pipe[PHASER_MAX_STAGES + 1];      // pipe[k] is the input of stage k
+    float state[PHASER_MAX_STAGES];
+    float dry_delay[PHASER_MAX_STAGES];
+    float wet_delay[PHASER_MAX_STAGES];     // Serial outputs held back to the latency
+    size_t dry_pos;
+    int serial;                             // Stages run serially (feedback > 0)
+    size_t fill_remaining;                  // Steps until a refilled pipeline is complete
+    float coefficient;                      // Allpass coefficient of every stage
+    float coefficient_step;                 // Per-sample ramp to the next target
+    size_t control_remaining;
     LFO lfo;
     float depth;
     float rate;
@@ -49,28 +112,42 @@ typedef struct {
     float wet_level;
     float dry_level;
     int num_stages;
+    float sample_rate;
+    ParamSmoother rate_smoother;            // Rate and depth are read per control period
+    ParamSmoother depth_smoother;
+    ParamSmoother feedback_smoother;
+    ParamSmoother wet_smoother;
 } Phaser;
 
-// Tremolo effect structure
+// Tremolo effect structure. Rate and depth are smoothed as for Chorus;
+// stereo_phase is a switch and is published with an atomic store.
 typedef struct {
     LFO lfo;
     float depth;
     float rate;
     int stereo_phase; // Phase offset for stereo tremolo
+    ParamSmoother rate_smoother;
+    ParamSmoother depth_smoother;
 } Tremolo;
 
-// Vibrato effect structure
+// Vibrato effect structure (rate, depth and wet level are smoothed)
 typedef struct {
     DelayLine delay;
+    DelayInterpolator interpolator;
     LFO lfo;
     float depth;
     float rate;
     float wet_level;
+    ParamSmoother rate_smoother;
+    ParamSmoother depth_smoother;
+    ParamSmoother wet_smoother;
 } Vibrato;
 
-// Auto-wah effect structure
+// Auto-wah effect structure. The bandpass cutoff is recomputed once per
+// control period (MOD_FILTER_CONTROL_RATE samples) from the smoothed
+// parameters; rate 0 follows the envelope instead of the LFO.
 typedef struct {
-    BiquadFilter filter;
+    ModulatedFilter filter;
     LFO lfo;
     float sensitivity;
     float frequency_min;
@@ -79,6 +156,11 @@ typedef struct {
     float rate;
     OnePoleFilter envelope_follower;
     float sample_rate;
+    ParamSmoother sensitivity_smoother;
+    ParamSmoother frequency_min_smoother;
+    ParamSmoother frequency_max_smoother;
+    ParamSmoother resonance_smoother;
+    ParamSmoother rate_smoother;
 } AutoWah;
 
 // LFO functions
@@ -88,47 +170,87 @@ float lfo_process(LFO* lfo); // Returns sine wave
 float lfo_triangle(LFO* lfo); // Returns triangle wave
 float lfo_sawtooth(LFO* lfo); // Returns sawtooth wave
 float lfo_square(LFO* lfo);   // Returns square wave
+void lfo_set_frequency(LFO* lfo, float frequency);
+void lfo_set_phase(LFO* lfo, float cycles);
+void lfo_render(LFO* lfo, LfoWaveform waveform, float* out, size_t n);   // n values, then advance
+
+// LFO bank functions. Tempo sync sets the clock to beats_per_cycle beats
+// per LFO cycle; lfo_bank_sync locks the phase to a transport position.
+void lfo_bank_init(LfoBank* bank, int num_voices, float frequency, float sample_rate);
+void lfo_bank_set_offset(LfoBank* bank, int voice, float cycles);
+void lfo_bank_set_tempo(LfoBank* bank, float bpm, float beats_per_cycle);
+void lfo_bank_sync(LfoBank* bank, double beats, float beats_per_cycle);
+void lfo_bank_render(LfoBank* bank, LfoWaveform waveform, float* const* outputs, size_t n);
 
 // Chorus functions
 Chorus* chorus_create(float max_delay_ms, float sample_rate);
 void chorus_destroy(Chorus* chorus);
 void chorus_set_params(Chorus* chorus, float rate, float depth, float feedback, float wet_level);
+void chorus_set_interpolation(Chorus* chorus, DelayInterpolation mode);
 sample_t chorus_process(Chorus* chorus, sample_t input);
+void chorus_process_block(Chorus* chorus, const sample_t* in, sample_t* out, size_t n);
 void chorus_process_buffer(Chorus* chorus, AudioBuffer* buffer);
+void chorus_process_channels(Chorus** choruses, AudioBuffer* buffer);
+void chorus_reset(Chorus* chorus);
+Effect chorus_effect(Chorus* chorus);
 
 // Flanger functions
 Flanger* flanger_create(float max_delay_ms, float sample_rate);
 void flanger_destroy(Flanger* flanger);
 void flanger_set_params(Flanger* flanger, float rate, float depth, float feedback, float manual, float wet_level);
+void flanger_set_interpolation(Flanger* flanger, DelayInterpolation mode);
 sample_t flanger_process(Flanger* flanger, sample_t input);
+void flanger_process_block(Flanger* flanger, const sample_t* in, sample_t* out, size_t n);
 void flanger_process_buffer(Flanger* flanger, AudioBuffer* buffer);
+void flanger_process_channels(Flanger** flangers, AudioBuffer* buffer);
+void flanger_reset(Flanger* flanger);
+Effect flanger_effect(Flanger* flanger);
 
 // Phaser functions
 Phaser* phaser_create(int num_stages, float sample_rate);
 void phaser_destroy(Phaser* phaser);
 void phaser_set_params(Phaser* phaser, float rate, float depth, float feedback, float wet_level);
 sample_t phaser_process(Phaser* phaser, sample_t input);
+void phaser_process_block(Phaser* phaser, const sample_t* in, sample_t* out, size_t n);
 void phaser_process_buffer(Phaser* phaser, AudioBuffer* buffer);
+void phaser_process_channels(Phaser** phasers, AudioBuffer* buffer);
+void phaser_reset(Phaser* phaser);
+size_t phaser_latency(const Phaser* phaser);
+Effect phaser_effect(Phaser* phaser);
 
 // Tremolo functions
 Tremolo* tremolo_create(float sample_rate);
 void tremolo_destroy(Tremolo* tremolo);
 void tremolo_set_params(Tremolo* tremolo, float rate, float depth, int stereo_phase);
 sample_t tremolo_process(Tremolo* tremolo, sample_t input);
+void tremolo_process_block(Tremolo* tremolo, const sample_t* in, sample_t* out, size_t n);
+void tremolo_process_buffer(Tremolo* tremolo, AudioBuffer* buffer);
+void tremolo_process_channels(Tremolo** tremolos, AudioBuffer* buffer);
+void tremolo_reset(Tremolo* tremolo);
+Effect tremolo_effect(Tremolo* tremolo);
 void tremolo_process_stereo(Tremolo* tremolo, sample_t* left, sample_t* right);
 
 // Vibrato functions
 Vibrato* vibrato_create(float max_delay_ms, float sample_rate);
 void vibrato_destroy(Vibrato* vibrato);
 void vibrato_set_params(Vibrato* vibrato, float rate, float depth, float wet_level);
+void vibrato_set_interpolation(Vibrato* vibrato, DelayInterpolation mode);
 sample_t vibrato_process(Vibrato* vibrato, sample_t input);
+void vibrato_process_block(Vibrato* vibrato, const sample_t* in, sample_t* out, size_t n);
 void vibrato_process_buffer(Vibrato* vibrato, AudioBuffer* buffer);
+void vibrato_process_channels(Vibrato** vibratos, AudioBuffer* buffer);
+void vibrato_reset(Vibrato* vibrato);
+Effect vibrato_effect(Vibrato* vibrato);
 
 // Auto-wah functions
 AutoWah* autowah_create(float sample_rate);
 void autowah_destroy(AutoWah* autowah);
 void autowah_set_params(AutoWah* autowah, float sensitivity, float freq_min, float freq_max, float resonance, float rate);
 sample_t autowah_process(AutoWah* autowah, sample_t input);
+void autowah_process_block(AutoWah* autowah, const sample_t* in, sample_t* out, size_t n);
 void autowah_process_buffer(AutoWah* autowah, AudioBuffer* buffer);
+void autowah_process_channels(AutoWah** autowahs, AudioBuffer* buffer);
+void autowah_reset(AutoWah* autowah);
+Effect autowah_effect(AutoWah* autowah);
 
 #endif // MODULATION_EFFECTS_H
\ No newline at end of file
@@ -4,6 +4,11 @@
 #include "audio_core.h"
 #include "delay_effects.h"
 #include "audio_filters.h"
+#include "modulation_effects.h"
+
+// The reverbs keep the values last passed to *_set_params in their public
+// fields; processing follows them through a smoother for the feedback gain
+// scale and one for the wet level, so they may be set while audio runs.
 
 // Schroeder reverb structure
 typedef struct {
@@ -16,52 +21,160 @@ typedef struct {
     float room_size;
     float damping;
     OnePoleFilter damping_filters[4];
+    ParamSmoother room_smoother;   // Scales the comb gains
+    ParamSmoother wet_smoother;
 } SchroederReverb;
 
-// Simple plate reverb structure
+// Plate reverb after Dattorro's figure-eight tank ("Effect Design, Part 1",
+// JAES 1997). The input goes through a pre-delay line, a bandwidth lowpass
+// and four allpass diffusers into a tank of two halves, each a modulated
+// allpass, a delay, a damping lowpass, a second allpass and a second delay,
+// with the end of each half feeding the start of the other. Each output
+// channel sums PLATE_TAPS taps spread over both halves, so left and right
+// are decorrelated; mono processing computes the left taps only. Every
+// line is read a chunk at a time before the chunk is written, so only the
+// one-pole filters run sample by sample. The modulation is interpolated
+// between LFO values every LFO_BLOCK samples of a fixed grid, so the output
+// does not depend on how the input is split into blocks.
+#define PLATE_DIFFUSERS 4
+#define PLATE_TAPS 7                 // Output taps per channel
+#define PLATE_MAX_PRE_DELAY 0.1f     // Seconds
+
 typedef struct {
-    DelayLine delays[8];
-    float gains[8];
-    BiquadFilter input_filter;
-    BiquadFilter output_filter;
+    DelayLine pre_delay_line;
+    DelayLine diffusers[PLATE_DIFFUSERS];
+    DelayLine tank[2][4];            // [half][modulated allpass, delay, allpass, delay]
+    size_t diffuser_delays[PLATE_DIFFUSERS];
+    size_t tank_delays[2][4];        // Centre delay for the modulated allpass
+    size_t taps[2][PLATE_TAPS];      // [channel][tap], scaled from plate_taps in reverb.c
+    size_t pre_delay_samples;
+    size_t chunk;                    // Longest chunk every line can serve
+    OnePoleFilter bandwidth_filter;
+    OnePoleFilter damping_filters[2];
+    float excursion;                 // Modulation depth in samples
+    LfoBank lfo;                     // Quadrature voices at the control rate (one step per LFO_BLOCK)
+    float lfo_start[2];              // LFO at the current and next control points
+    float lfo_end[2];
+    size_t lfo_pos;                  // Samples into the control interval
     float decay_time;
     float wet_level;
     float dry_level;
     float pre_delay;
+    float sample_rate;
+    ParamSmoother decay_smoother;    // Tank gain, applied twice per half
+    ParamSmoother wet_smoother;
 } PlateReverb;
 
-// Freeverb-style reverb structure
+// Freeverb-style reverb. The left and right channels have their own sets
+// of 8 combs and 4 allpasses, the right set FREEVERB_STEREO_SPREAD samples
+// longer, both fed the mono sum of the input; width blends each set's
+// output into the other channel (1 keeps them apart, 0 gives mono). Comb
+// damping state is kept as one array per set, so the 8 combs of a set run
+// side by side in one AVX register (two SSE registers) per sample. Mono
+// processing runs the left set only.
+#define FREEVERB_COMBS 8
+#define FREEVERB_ALLPASSES 4
+#define FREEVERB_STEREO_SPREAD 23     // Samples at 44.1kHz
+
 typedef struct {
-    DelayLine comb_delays[8];
-    float comb_feedbacks[8];
-    OnePoleFilter comb_filters[8];
-    DelayLine allpass_delays[4];
+    DelayLine comb_delays[2][FREEVERB_COMBS];         // [channel][comb]
+    DelayLine allpass_delays[2][FREEVERB_ALLPASSES];
+    float comb_state[2][FREEVERB_COMBS];              // Damping lowpass outputs
+    float comb_alpha;                                 // Damping lowpass coefficient
     float room_size;
     float damping;
     float wet_level;
     float dry_level;
     float width; // Stereo width
+    ParamSmoother feedback_smoother;  // Comb feedback, from the room size
+    ParamSmoother wet_smoother;
+    ParamSmoother width_smoother;
 } Freeverb;
 
+// Feedback delay network reverb. 8 or 16 delay lines are fed back through
+// an orthogonal matrix, so every line excites every other and the echo
+// density grows much faster than with parallel combs. Each line has a
+// first-order shelving absorption filter set from its length so that the
+// tail decays by 60 dB in rt60_low seconds below the crossover and in
+// rt60_high seconds above it. The network runs a block at a time: lines
+// are read as spans, and the matrix is applied with butterflies (Hadamard)
+// or one sum (Householder) vectorized across samples.
+#define FDN_MAX_LINES 16
+
+typedef enum {
+    FDN_MATRIX_HADAMARD,      // Fast Walsh-Hadamard transform, log2(N) butterfly passes
+    FDN_MATRIX_HOUSEHOLDER    // I - 2/N * ones, cheaper but mixes less per pass
+} FdnMatrix;
+
+typedef struct {
+    DelayLine lines[FDN_MAX_LINES];
+    float b0[FDN_MAX_LINES];        // Absorption filters (transposed direct form II)
+    float b1[FDN_MAX_LINES];
+    float a1[FDN_MAX_LINES];
+    float state[FDN_MAX_LINES];
+    float input_gains[FDN_MAX_LINES];
+    float output_gains[FDN_MAX_LINES];
+    int num_lines;
+    FdnMatrix matrix;
+    float rt60_low;
+    float rt60_high;
+    float crossover;
+    float wet_level;
+    float dry_level;
+    float sample_rate;
+    ParamSmoother rt60_low_smoother;
+    ParamSmoother rt60_high_smoother;
+    ParamSmoother crossover_smoother;
+    ParamSmoother wet_smoother;
+} FdnReverb;
+
 // Schroeder reverb functions
 SchroederReverb* schroeder_reverb_create(float sample_rate);
 void schroeder_reverb_destroy(SchroederReverb* reverb);
 void schroeder_reverb_set_params(SchroederReverb* reverb, float room_size, float damping, float wet_level);
 sample_t schroeder_reverb_process(SchroederReverb* reverb, sample_t input);
+void schroeder_reverb_process_block(SchroederReverb* reverb, const sample_t* in, sample_t* out, size_t n);
 void schroeder_reverb_process_buffer(SchroederReverb* reverb, AudioBuffer* buffer);
+void schroeder_reverb_process_channels(SchroederReverb** reverbs, AudioBuffer* buffer);
+void schroeder_reverb_reset(SchroederReverb* reverb);
+Effect schroeder_reverb_effect(SchroederReverb* reverb);
 
 // Plate reverb functions
 PlateReverb* plate_reverb_create(float sample_rate);
 void plate_reverb_destroy(PlateReverb* reverb);
 void plate_reverb_set_params(PlateReverb* reverb, float decay_time, float wet_level, float pre_delay, float sample_rate);
 sample_t plate_reverb_process(PlateReverb* reverb, sample_t input);
+void plate_reverb_process_block(PlateReverb* reverb, const sample_t* in, sample_t* out, size_t n);
+void plate_reverb_process_stereo_block(PlateReverb* reverb, const sample_t* left_in, const sample_t* right_in,
+                                       sample_t* left_out, sample_t* right_out, size_t n);
 void plate_reverb_process_buffer(PlateReverb* reverb, AudioBuffer* buffer);
+void plate_reverb_process_channels(PlateReverb** reverbs, AudioBuffer* buffer);
+void plate_reverb_reset(PlateReverb* reverb);
+Effect plate_reverb_effect(PlateReverb* reverb);
 
 // Freeverb functions
 Freeverb* freeverb_create(float sample_rate);
 void freeverb_destroy(Freeverb* reverb);
 void freeverb_set_params(Freeverb* reverb, float room_size, float damping, float wet_level, float width);
 sample_t freeverb_process(Freeverb* reverb, sample_t input);
-void freeverb_process_buffer(Freeverb* reverb, AudioBuffer* buffer);
+void freeverb_process_block(Freeverb* reverb, const sample_t* in, sample_t* out, size_t n);
+void freeverb_process_stereo_block(Freeverb* reverb, const sample_t* left_in, const sample_t* right_in,
+                                   sample_t* left_out, sample_t* right_out, size_t n);
+void freeverb_process_buffer(Freeverb* reverb, AudioBuffer* buffer);   // True stereo for 2-channel buffers
+void freeverb_process_channels(Freeverb** reverbs, AudioBuffer* buffer);
+void freeverb_reset(Freeverb* reverb);
+Effect freeverb_effect(Freeverb* reverb);
+
+// FDN reverb functions (SSE kernels picked at runtime, scalar fallback)
+FdnReverb* fdn_reverb_create(int num_lines, float sample_rate);   // 8 or 16 lines; NULL otherwise
+void fdn_reverb_destroy(FdnReverb* reverb);
+void fdn_reverb_set_params(FdnReverb* reverb, float rt60_low, float rt60_high, float crossover, float wet_level);
+void fdn_reverb_set_matrix(FdnReverb* reverb, FdnMatrix matrix);  // Not while audio runs
+sample_t fdn_reverb_process(FdnReverb* reverb, sample_t input);
+void fdn_reverb_process_block(FdnReverb* reverb, const sample_t* in, sample_t* out, size_t n);
+void fdn_reverb_process_buffer(FdnReverb* reverb, AudioBuffer* buffer);
+void fdn_reverb_process_channels(FdnReverb** reverbs, AudioBuffer* buffer);
+void fdn_reverb_reset(FdnReverb* reverb);
+Effect fdn_reverb_effect(FdnReverb* reverb);
 
 #endif // REVERB_H
\ No newline at end of file
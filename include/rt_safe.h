@@ -0,0 +1,82 @@
+#ifndef RT_SAFE_H
+#define RT_SAFE_H
+
+#include "audio_core.h"
+#include "effect_chain.h"
+
+// Real-time safe processing
+//
+// The audio-thread subset is: *_process / *_process_block,
+// effect_chain_process_block, the *_reset functions, rt_apply_params and
+// the push/pop calls below. None of them allocate, lock or print. Every
+// *_create, *_destroy, effect_chain_add* and wav_io call belongs on a
+// non-real-time thread. Run the audio callback between audio_rt_enter and
+// audio_rt_leave to have stray allocations and log calls reported.
+
+// Bump allocator over caller-supplied memory. Install it with
+// audio_arena_install, build the effects, then uninstall; the state of
+// every effect then lives in one preallocated block. Frees are ignored and
+// the whole arena is released at once.
+typedef struct {
+    unsigned char* base;
+    size_t size;
+    size_t used;
+    size_t failed;            // Allocations that did not fit
+} AudioArena;
+
+void audio_arena_init(AudioArena* arena, void* memory, size_t size);
+void* audio_arena_alloc(void* arena, size_t size);
+void audio_arena_free(void* arena, void* ptr);
+void audio_arena_install(AudioArena* arena);   // NULL restores malloc/free
+void audio_arena_reset(AudioArena* arena);
+
+// Single-producer single-consumer ring of fixed-size items. The producer
+// only writes tail and the consumer only writes head, so push and pop need
+// no lock; both are wait-free. Capacity is rounded up to a power of two.
+typedef struct {
+    unsigned char* items;
+    size_t item_size;
+    size_t mask;
+    size_t head;              // Next item to pop (consumer)
+    size_t tail;              // Next slot to fill (producer)
+    size_t dropped;           // Pushes refused because the ring was full
+} SpscQueue;
+
+SpscQueue* spsc_queue_create(size_t capacity, size_t item_size);
+void spsc_queue_destroy(SpscQueue* queue);
+int spsc_queue_push(SpscQueue* queue, const void* item);   // 0 when full
+int spsc_queue_pop(SpscQueue* queue, void* item);          // 0 when empty
+size_t spsc_queue_dropped(const SpscQueue* queue);
+
+// Parameter changes for an effect chain, pushed by a control thread
+typedef struct {
+    int node;
+    int param;
+    float value;
+} ParamChange;
+
+// Errors raised on the audio thread, drained elsewhere
+typedef enum {
+    RT_ERROR_PARAM_REJECTED,  // Unknown node or parameter in a ParamChange
+    RT_ERROR_OVERLOAD,        // Callback missed its deadline (raised by the host)
+    RT_ERROR_USER             // Application-defined
+} RtErrorCode;
+
+typedef struct {
+    RtErrorCode code;
+    int node;
+    int param;
+    float value;
+} RtError;
+
+SpscQueue* param_queue_create(size_t capacity);   // Items are ParamChange
+SpscQueue* rt_error_queue_create(size_t capacity); // Items are RtError
+int param_queue_push(SpscQueue* queue, int node, int param, float value);
+int rt_error_push(SpscQueue* errors, RtErrorCode code, int node, int param, float value);
+const char* rt_error_name(RtErrorCode code);
+
+// Apply every queued change to the chain (audio thread); rejected changes
+// go to errors when it is not NULL. Returns the number applied.
+size_t rt_apply_params(EffectChain* chain, SpscQueue* params, SpscQueue* errors);
+
+#endif // RT_SAFE_H
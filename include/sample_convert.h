@@ -0,0 +1,63 @@
+#ifndef SAMPLE_CONVERT_H
+#define SAMPLE_CONVERT_H
+
+#include "audio_core.h"
+
+// Stored sample formats (WAV data chunk encodings)
+typedef enum {
+    SAMPLE_FORMAT_U8,   // 8-bit unsigned PCM
+    SAMPLE_FORMAT_S16,  // 16-bit signed PCM
+    SAMPLE_FORMAT_S24,  // 24-bit signed PCM, packed in 3 bytes
+    SAMPLE_FORMAT_S32,  // 32-bit signed PCM
+    SAMPLE_FORMAT_F32,  // 32-bit IEEE float
+    SAMPLE_FORMAT_F64   // 64-bit IEEE float
+} SampleFormat;
+
+// Dither applied when requantizing to 16 bits
+typedef enum {
+    DITHER_NONE,         // Plain truncation (same as float_to_int16)
+    DITHER_TPDF,         // Triangular dither of +-1 LSB, rounded
+    DITHER_TPDF_SHAPED   // TPDF plus second-order error-feedback noise shaping
+} DitherMode;
+
+// Dither state. Noise shaping keeps its error history per channel, so the
+// state must follow one interleaved stream across consecutive blocks.
+typedef struct {
+    DitherMode mode;
+    size_t channels;                 // Interleave stride for noise shaping
+    size_t next_channel;             // Channel of the next sample
+    uint32_t rng[4];                 // xorshift32 generators (one per SIMD lane)
+    float error[MAX_CHANNELS][2];    // Past quantization errors, in LSBs
+} Dither;
+
+// Bytes per stored sample
+size_t sample_format_bytes(SampleFormat format);
+const char* sample_format_name(SampleFormat format);
+
+// Block converters between stored little-endian samples and sample_t.
+// Integer formats use the same symmetric scaling as int16_to_float and
+// float_to_int16; encoding clamps to [-1, 1] and truncates. Sources and
+// destinations of the stored side need no particular alignment.
+void convert_u8_to_f32(const void* src, sample_t* dest, size_t count);
+void convert_s16_to_f32(const void* src, sample_t* dest, size_t count);
+void convert_s24_to_f32(const void* src, sample_t* dest, size_t count);
+void convert_s32_to_f32(const void* src, sample_t* dest, size_t count);
+void convert_f64_to_f32(const void* src, sample_t* dest, size_t count);
+
+void convert_f32_to_u8(const sample_t* src, void* dest, size_t count);
+void convert_f32_to_s16(const sample_t* src, void* dest, size_t count);
+void convert_f32_to_s24(const sample_t* src, void* dest, size_t count);
+void convert_f32_to_s32(const sample_t* src, void* dest, size_t count);
+void convert_f32_to_f64(const sample_t* src, void* dest, size_t count);
+
+// Requantize to 16 bits with optional dither (NULL or DITHER_NONE gives
+// convert_f32_to_s16). TPDF runs in SIMD; noise shaping is a per-channel
+// recursion and runs one sample at a time.
+void dither_init(Dither* dither, DitherMode mode, size_t channels);
+void convert_f32_to_s16_block(const sample_t* src, int16_t* dest, size_t count, Dither* dither);
+
+// Dispatch on format (F32 is a plain copy)
+void convert_to_float(SampleFormat format, const void* src, sample_t* dest, size_t count);
+void convert_from_float(SampleFormat format, const sample_t* src, void* dest, size_t count);
+
+#endif // SAMPLE_CONVERT_H
@@ -0,0 +1,62 @@
+#ifndef STFT_H
+#define STFT_H
+
+#include "audio_core.h"
+#include "fft.h"
+
+// Short-time Fourier transform with weighted overlap-add resynthesis. Input
+// is windowed into frames of size samples every hop samples, each frame is
+// transformed, handed to the process callback as a split spectrum (fft.h),
+// transformed back, windowed again and overlap-added. The synthesis window
+// is the analysis window divided by the sum of squared analysis windows
+// overlapping each position, so the input is reconstructed exactly when the
+// callback leaves the spectrum alone (for tapered windows, as long as hop
+// is below size so no sample falls only on a window's zero).
+//
+// Output is delayed by size samples. Frames are computed on block
+// boundaries only, so the cost is one forward and one inverse transform
+// per hop regardless of how the input is split into blocks.
+#define STFT_MAX_SIZE 65536
+
+typedef enum {
+    STFT_WINDOW_HANN,           // Periodic windows, so overlaps sum evenly
+    STFT_WINDOW_SQRT_HANN,
+    STFT_WINDOW_HAMMING,
+    STFT_WINDOW_BLACKMAN,
+    STFT_WINDOW_RECTANGULAR
+} StftWindow;
+
+// Called once per frame with the windowed frame's spectrum (size floats,
+// split order), which may be modified in place. Runs on the audio thread.
+typedef void (*StftProcessFn)(void* user, float* spectrum, const FftPlan* plan);
+
+typedef struct {
+    size_t size;              // Frame length (power of two)
+    size_t hop;               // Samples between frames
+    StftWindow window_type;
+    FftPlan* plan;            // Shared plan of size points
+    float* analysis_window;
+    float* synthesis_window;  // Includes the 1 / size of the inverse transform
+    float* input;             // Last size input samples
+    float* output;            // Overlap-add accumulator (size)
+    float* frame;             // Windowed frame, then the resynthesized frame
+    float* spectrum;
+    size_t fill;              // Samples of the current hop received
+    StftProcessFn process_fn; // May be NULL: pass-through
+    void* user;
+} Stft;
+
+// STFT functions. hop must be between 1 and size.
+Stft* stft_create(size_t size, size_t hop, StftWindow window, StftProcessFn process_fn, void* user);
+void stft_destroy(Stft* stft);
+void stft_window_fill(StftWindow window, float* dest, size_t size);
+size_t stft_latency(const Stft* stft);
+sample_t stft_process(Stft* stft, sample_t input);
+void stft_process_block(Stft* stft, const sample_t* in, sample_t* out, size_t n);
+void stft_analyze_block(Stft* stft, const sample_t* in, size_t n);   // Callback only, no resynthesis
+void stft_process_buffer(Stft* stft, AudioBuffer* buffer);
+void stft_process_channels(Stft** stfts, AudioBuffer* buffer);
+void stft_reset(Stft* stft);
+Effect stft_effect(Stft* stft);
+
+#endif // STFT_H
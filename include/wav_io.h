@@ -2,29 +2,78 @@
 #define WAV_IO_H
 
 #include "audio_core.h"
+#include "sample_convert.h"
 
-// WAV file header structure
-#pragma pack(push, 1)
+// Parsed WAV stream description. Filled by walking the RIFF chunks, so
+// LIST/fact/bext chunks before the data are skipped, WAVE_FORMAT_EXTENSIBLE
+// is unwrapped and RF64/BW64 files take their sizes from the ds64 chunk.
 typedef struct {
-    char riff_id[4];        // "RIFF"
-    uint32_t file_size;     // File size - 8
-    char wave_id[4];        // "WAVE"
-    char fmt_id[4];         // "fmt "
-    uint32_t fmt_size;      // Format chunk size
-    uint16_t format;        // Audio format
-    uint16_t channels;      // Number of channels
-    uint32_t sample_rate;   // Sample rate
-    uint32_t byte_rate;     // Bytes per second
-    uint16_t block_align;   // Bytes per sample frame
-    uint16_t bits_per_sample; // Bits per sample
-    char data_id[4];        // "data"
-    uint32_t data_size;     // Data chunk size
-} WavHeader;
-#pragma pack(pop)
+    SampleFormat sample_format;
+    size_t channels;
+    size_t sample_rate;
+    int bits_per_sample;      // Container bits per sample
+    int valid_bits;           // Significant bits (EXTENSIBLE), else bits_per_sample
+    uint32_t channel_mask;    // Speaker mask (EXTENSIBLE), else 0
+    size_t block_align;       // Bytes per sample frame
+    uint64_t data_offset;     // File offset of the first sample frame
+    uint64_t data_size;       // Bytes in the data chunk
+    int rf64;                 // Sizes came from a ds64 chunk
+} WavFormat;
+
+// Streaming WAV reader: decodes a file a block of frames at a time so
+// memory use does not depend on the file length
+typedef struct {
+    FILE* file;
+    WavFormat format;
+    size_t channels;
+    size_t sample_rate;
+    size_t total_frames;      // Frames in the data chunk
+    size_t frames_remaining;  // Frames not yet read
+    const uint8_t* mapped;    // Data chunk when memory-mapped, else NULL
+    void* map_base;           // Whole-file mapping (mapped readers only)
+    size_t map_size;
+} WavReader;
+
+// Streaming WAV writer: the RIFF and data sizes are patched on close.
+// Room for a ds64 chunk is reserved up front so files past 4 GB are
+// finished as RF64.
+typedef struct {
+    FILE* file;
+    size_t channels;
+    size_t sample_rate;
+    SampleFormat sample_format;
+    size_t block_align;
+    size_t header_size;       // Bytes before the first sample frame
+    size_t frames_written;
+    int error;                // Set when a write failed
+    Dither dither;            // Applied to 16-bit output (off by default)
+} WavWriter;
+
+// Chunk parser: on success the file is positioned at the first sample frame
+int wav_read_format(FILE* file, WavFormat* format);
+
+// Streaming I/O functions (frames are interleaved floats)
+WavReader* wav_reader_open(const char* filename);
+WavReader* wav_reader_open_mapped(const char* filename);
+const void* wav_reader_frames(const WavReader* reader, size_t* frames_available);
+size_t wav_reader_read(WavReader* reader, sample_t* dest, size_t frames);
+size_t wav_reader_read_buffer(WavReader* reader, AudioBuffer* block);
+void wav_reader_close(WavReader* reader);
+
+WavWriter* wav_writer_open(const char* filename, size_t channels, size_t sample_rate);
+WavWriter* wav_writer_open_format(const char* filename, size_t channels, size_t sample_rate,
+                                  SampleFormat format);
+void wav_writer_set_dither(WavWriter* writer, DitherMode mode);
+size_t wav_writer_write(WavWriter* writer, const sample_t* src, size_t frames);
+size_t wav_writer_write_buffer(WavWriter* writer, const AudioBuffer* block, size_t frames);
+int wav_writer_close(WavWriter* writer);
 
 // WAV file I/O functions
 AudioBuffer* wav_load(const char* filename);
+AudioBuffer* wav_load_planar(const char* filename);
+AudioBuffer* wav_load_mapped(const char* filename);
 int wav_save(const char* filename, AudioBuffer* buffer);
+int wav_save_format(const char* filename, AudioBuffer* buffer, SampleFormat format);
 void print_wav_info(const char* filename);
 
-#endif // WAV_IO_H
\ No newline at end of file
+#endif // WAV_IO_H
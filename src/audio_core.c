@@ -1,21 +1,217 @@
 #include "audio_core.h"
+#include <assert.h>
+#include <stdarg.h>
+
+#if defined(__SSE__) || defined(_M_X64)
+#include <xmmintrin.h>
+#define AUDIO_CORE_SSE 1
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#define AUDIO_CORE_NEON 1
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#define AUDIO_THREAD_LOCAL __thread
+#else
+#define AUDIO_THREAD_LOCAL
+#endif
+
+// Allocation, logging and real-time guard hooks
+
+static AudioAllocFn alloc_fn = NULL;
+static AudioFreeFn free_fn = NULL;
+static void* alloc_user = NULL;
+
+static AudioLogFn log_fn = NULL;
+static void* log_user = NULL;
+
+static AudioRtViolationFn violation_fn = NULL;
+static void* violation_user = NULL;
+static size_t violation_count = 0;
+
+static AUDIO_THREAD_LOCAL int rt_depth = 0;
+
+// Default violation handler: stop debug builds at the offending call
+static void audio_rt_default_violation(AudioRtViolation violation, void* user) {
+    (void)user;
+    (void)violation;
+    assert(!"allocation, free or log call on a real-time audio thread");
+}
+
+static void audio_rt_violation(AudioRtViolation violation) {
+    __atomic_add_fetch(&violation_count, 1, __ATOMIC_RELAXED);
+    if (violation_fn) {
+        violation_fn(violation, violation_user);
+    } else {
+        audio_rt_default_violation(violation, NULL);
+    }
+}
+
+// Route library allocations (NULL functions restore malloc/free)
+void audio_set_allocator(AudioAllocFn alloc, AudioFreeFn release, void* user) {
+    if (alloc && release) {
+        alloc_fn = alloc;
+        free_fn = release;
+        alloc_user = user;
+    } else {
+        alloc_fn = NULL;
+        free_fn = NULL;
+        alloc_user = NULL;
+    }
+}
+
+void* audio_malloc(size_t size) {
+    if (rt_depth) audio_rt_violation(AUDIO_RT_ALLOCATION);
+    
+    return alloc_fn ? alloc_fn(alloc_user, size) : malloc(size);
+}
+
+void* audio_calloc(size_t count, size_t size) {
+    if (rt_depth) audio_rt_violation(AUDIO_RT_ALLOCATION);
+    if (!alloc_fn) return calloc(count, size);
+    
+    if (size && count > SIZE_MAX / size) return NULL;
+    void* ptr = alloc_fn(alloc_user, count * size);
+    if (ptr) memset(ptr, 0, count * size);
+    return ptr;
+}
+
+void audio_free(void* ptr) {
+    if (!ptr) return;
+    if (rt_depth) audio_rt_violation(AUDIO_RT_FREE);
+    
+    if (free_fn) {
+        free_fn(alloc_user, ptr);
+    } else {
+        free(ptr);
+    }
+}
+
+// Redirect diagnostics (NULL restores printing to stdout)
+void audio_set_log_handler(AudioLogFn handler, void* user) {
+    log_fn = handler;
+    log_user = handler ? user : NULL;
+}
+
+// Format and deliver a diagnostic. On a real-time thread the message is
+// dropped and reported as a violation instead, since formatting and stdio
+// may lock or allocate.
+void audio_log(AudioLogLevel level, const char* format, ...) {
+    if (rt_depth) {
+        audio_rt_violation(AUDIO_RT_LOG);
+        return;
+    }
+    
+    char message[512];
+    va_list args;
+    va_start(args, format);
+    vsnprintf(message, sizeof(message), format, args);
+    va_end(args);
+    
+    if (log_fn) {
+        log_fn(level, message, log_user);
+    } else if (level == AUDIO_LOG_ERROR) {
+        printf("Error: %s\n", message);
+    } else {
+        printf("%s\n", message);
+    }
+}
+
+// Mark the calling thread as a real-time audio thread (calls nest)
+void audio_rt_enter(void) {
+    rt_depth++;
+}
+
+void audio_rt_leave(void) {
+    if (rt_depth > 0) rt_depth--;
+}
+
+int audio_rt_active(void) {
+    return rt_depth > 0;
+}
+
+// Install the handler called on every violation (NULL restores the assert)
+void audio_rt_set_violation_handler(AudioRtViolationFn handler, void* user) {
+    violation_fn = handler;
+    violation_user = handler ? user : NULL;
+}
+
+size_t audio_rt_violations(void) {
+    return __atomic_load_n(&violation_count, __ATOMIC_RELAXED);
+}
+
+// Allocate zeroed memory aligned to AUDIO_ALIGNMENT
+void* audio_aligned_calloc(size_t count, size_t size) {
+    if (size && count > (SIZE_MAX - AUDIO_ALIGNMENT - sizeof(void*)) / size) return NULL;
+    
+    size_t bytes = count * size;
+    unsigned char* raw = audio_calloc(1, bytes + AUDIO_ALIGNMENT + sizeof(void*));
+    if (!raw) return NULL;
+    
+    // Keep the original pointer just below the aligned block for audio_free()
+    uintptr_t addr = (uintptr_t)(raw + sizeof(void*));
+    addr = (addr + AUDIO_ALIGNMENT - 1) & ~(uintptr_t)(AUDIO_ALIGNMENT - 1);
+    ((void**)addr)[-1] = raw;
+    
+    return (void*)addr;
+}
+
+// Free memory from audio_aligned_calloc
+void audio_aligned_free(void* ptr) {
+    if (ptr) {
+        audio_free(((void**)ptr)[-1]);
+    }
+}
 
 // Create a new audio buffer
 AudioBuffer* audio_buffer_create(size_t length, size_t channels, size_t sample_rate) {
-    AudioBuffer* buffer = malloc(sizeof(AudioBuffer));
+    AudioBuffer* buffer = audio_malloc(sizeof(AudioBuffer));
+    if (!buffer) return NULL;
+    
+    memset(buffer, 0, sizeof(AudioBuffer));
+    buffer->length = length;
+    buffer->channels = channels;
+    buffer->sample_rate = sample_rate;
+    buffer->capacity = length * channels;
+    buffer->layout = AUDIO_LAYOUT_INTERLEAVED;
+    
+    buffer->data = audio_aligned_calloc(buffer->capacity, sizeof(sample_t));
+    if (!buffer->data) {
+        audio_free(buffer);
+        return NULL;
+    }
+    
+    return buffer;
+}
+
+// Create a planar audio buffer: one 64-byte aligned plane per channel
+AudioBuffer* audio_buffer_create_planar(size_t length, size_t channels, size_t sample_rate) {
+    if (channels == 0 || channels > MAX_CHANNELS) return NULL;
+    
+    AudioBuffer* buffer = audio_malloc(sizeof(AudioBuffer));
     if (!buffer) return NULL;
     
+    // Round each plane up to a whole number of cache lines
+    const size_t align_samples = AUDIO_ALIGNMENT / sizeof(sample_t);
+    
+    memset(buffer, 0, sizeof(AudioBuffer));
     buffer->length = length;
     buffer->channels = channels;
     buffer->sample_rate = sample_rate;
     buffer->capacity = length * channels;
+    buffer->layout = AUDIO_LAYOUT_PLANAR;
+    buffer->channel_stride = (length + align_samples - 1) / align_samples * align_samples;
     
-    buffer->data = calloc(buffer->capacity, sizeof(sample_t));
+    buffer->data = audio_aligned_calloc(buffer->channel_stride * channels, sizeof(sample_t));
     if (!buffer->data) {
-        free(buffer);
+        audio_free(buffer);
         return NULL;
     }
     
+    for (size_t ch = 0; ch < channels; ch++) {
+        buffer->planes[ch] = buffer->data + ch * buffer->channel_stride;
+    }
+    
     return buffer;
 }
 
@@ -23,35 +219,365 @@ AudioBuffer* audio_buffer_create(size_t length, size_t channels, size_t sample_r
 void audio_buffer_destroy(AudioBuffer* buffer) {
     if (buffer) {
         if (buffer->data) {
-            free(buffer->data);
+            audio_aligned_free(buffer->data);
         }
-        free(buffer);
+        audio_free(buffer);
     }
 }
 
 // Clear audio buffer (set all samples to zero)
 void audio_buffer_clear(AudioBuffer* buffer) {
     if (buffer && buffer->data) {
-        memset(buffer->data, 0, buffer->capacity * sizeof(sample_t));
+        size_t samples = (buffer->layout == AUDIO_LAYOUT_PLANAR)
+                         ? buffer->channel_stride * buffer->channels
+                         : buffer->capacity;
+        memset(buffer->data, 0, samples * sizeof(sample_t));
     }
 }
 
-// Copy audio buffer
+// Copy audio buffer (converts between layouts when they differ)
 void audio_buffer_copy(AudioBuffer* dest, AudioBuffer* src) {
     if (!dest || !src || !dest->data || !src->data) return;
     
-    size_t samples_to_copy = (dest->capacity < src->capacity) ? dest->capacity : src->capacity;
-    memcpy(dest->data, src->data, samples_to_copy * sizeof(sample_t));
+    if (dest->layout == AUDIO_LAYOUT_INTERLEAVED && src->layout == AUDIO_LAYOUT_INTERLEAVED) {
+        size_t samples_to_copy = (dest->capacity < src->capacity) ? dest->capacity : src->capacity;
+        memcpy(dest->data, src->data, samples_to_copy * sizeof(sample_t));
+        return;
+    }
+    
+    size_t frames = (dest->length < src->length) ? dest->length : src->length;
+    size_t channels = (dest->channels < src->channels) ? dest->channels : src->channels;
+    
+    if (dest->channels == src->channels) {
+        if (dest->layout == AUDIO_LAYOUT_PLANAR && src->layout == AUDIO_LAYOUT_INTERLEAVED) {
+            audio_deinterleave(src->data, channels, dest->planes, frames);
+            return;
+        }
+        if (dest->layout == AUDIO_LAYOUT_INTERLEAVED && src->layout == AUDIO_LAYOUT_PLANAR) {
+            audio_interleave(src->planes, channels, dest->data, frames);
+            return;
+        }
+    }
+    
+    sample_t scratch[AUDIO_CHANNEL_CHUNK];
+    for (size_t ch = 0; ch < channels; ch++) {
+        for (size_t start = 0; start < frames; start += AUDIO_CHANNEL_CHUNK) {
+            size_t n = (frames - start < AUDIO_CHANNEL_CHUNK) ? frames - start : AUDIO_CHANNEL_CHUNK;
+            audio_buffer_read_channel(src, ch, start, scratch, n);
+            audio_buffer_write_channel(dest, ch, start, scratch, n);
+        }
+    }
 }
 
 // Mix two audio buffers
 void audio_buffer_mix(AudioBuffer* dest, AudioBuffer* src, float gain) {
     if (!dest || !src || !dest->data || !src->data) return;
     
-    size_t samples_to_mix = (dest->capacity < src->capacity) ? dest->capacity : src->capacity;
+    if (dest->layout == AUDIO_LAYOUT_INTERLEAVED && src->layout == AUDIO_LAYOUT_INTERLEAVED) {
+        size_t samples_to_mix = (dest->capacity < src->capacity) ? dest->capacity : src->capacity;
+        
+        for (size_t i = 0; i < samples_to_mix; i++) {
+            dest->data[i] += src->data[i] * gain;
+        }
+        return;
+    }
+    
+    size_t frames = (dest->length < src->length) ? dest->length : src->length;
+    size_t channels = (dest->channels < src->channels) ? dest->channels : src->channels;
+    
+    for (size_t ch = 0; ch < channels; ch++) {
+        AudioView d = audio_view_range(audio_buffer_channel_view(dest, ch), 0, frames);
+        AudioView s = audio_view_range(audio_buffer_channel_view(src, ch), 0, frames);
+        for (size_t i = 0; i < frames; i++) {
+            d.data[i * d.stride] += s.data[i * s.stride] * gain;
+        }
+    }
+}
+
+// Pass a block through unchanged (used when an effect is missing)
+void audio_block_bypass(const sample_t* in, sample_t* out, size_t n) {
+    if (!in || !out || in == out) return;
+    memmove(out, in, n * sizeof(sample_t));
+}
+
+// Copy frames of one channel out of an interleaved buffer
+void audio_buffer_read_channel(const AudioBuffer* buffer, size_t channel, size_t start_frame,
+                               sample_t* dest, size_t frames) {
+    if (!buffer || !buffer->data || !dest || channel >= buffer->channels) return;
+    if (start_frame >= buffer->length) return;
+    if (frames > buffer->length - start_frame) frames = buffer->length - start_frame;
+    
+    if (buffer->layout == AUDIO_LAYOUT_PLANAR) {
+        memcpy(dest, buffer->planes[channel] + start_frame, frames * sizeof(sample_t));
+        return;
+    }
+    
+    const size_t stride = buffer->channels;
+    const sample_t* src = buffer->data + start_frame * stride + channel;
+    for (size_t i = 0; i < frames; i++) {
+        dest[i] = src[i * stride];
+    }
+}
+
+// Copy frames of one channel back into an interleaved buffer
+void audio_buffer_write_channel(AudioBuffer* buffer, size_t channel, size_t start_frame,
+                                const sample_t* src, size_t frames) {
+    if (!buffer || !buffer->data || !src || channel >= buffer->channels) return;
+    if (start_frame >= buffer->length) return;
+    if (frames > buffer->length - start_frame) frames = buffer->length - start_frame;
+    
+    if (buffer->layout == AUDIO_LAYOUT_PLANAR) {
+        memcpy(buffer->planes[channel] + start_frame, src, frames * sizeof(sample_t));
+        return;
+    }
+    
+    const size_t stride = buffer->channels;
+    sample_t* dest = buffer->data + start_frame * stride + channel;
+    for (size_t i = 0; i < frames; i++) {
+        dest[i * stride] = src[i];
+    }
+}
+
+// Run one effect instance per channel over an interleaved buffer
+void audio_buffer_process_channels(AudioBuffer* buffer, BlockProcessFn process, void* const* effects) {
+    if (!buffer || !buffer->data || !process || !effects) return;
+    
+    // Planar and mono buffers are processed in place without copying
+    if (buffer->layout == AUDIO_LAYOUT_PLANAR || buffer->channels == 1) {
+        for (size_t ch = 0; ch < buffer->channels; ch++) {
+            audio_view_process(audio_buffer_channel_view(buffer, ch), process, effects[ch]);
+        }
+        return;
+    }
+    
+    // Walk the buffer in small chunks so each deinterleaved channel block
+    // stays in cache while the interleaved frames are gathered and scattered
+    sample_t scratch[AUDIO_CHANNEL_CHUNK];
+    for (size_t start = 0; start < buffer->length; start += AUDIO_CHANNEL_CHUNK) {
+        size_t frames = buffer->length - start;
+        if (frames > AUDIO_CHANNEL_CHUNK) frames = AUDIO_CHANNEL_CHUNK;
+        
+        for (size_t ch = 0; ch < buffer->channels; ch++) {
+            audio_buffer_read_channel(buffer, ch, start, scratch, frames);
+            process(effects[ch], scratch, scratch, frames);
+            audio_buffer_write_channel(buffer, ch, start, scratch, frames);
+        }
+    }
+}
+
+// Get a view of one channel of a buffer
+AudioView audio_buffer_channel_view(AudioBuffer* buffer, size_t channel) {
+    AudioView view = {NULL, 0, 1};
+    if (!buffer || !buffer->data || channel >= buffer->channels) return view;
+    
+    view.length = buffer->length;
+    if (buffer->layout == AUDIO_LAYOUT_PLANAR) {
+        view.data = buffer->planes[channel];
+        view.stride = 1;
+    } else {
+        view.data = buffer->data + channel;
+        view.stride = buffer->channels;
+    }
+    
+    return view;
+}
+
+// Narrow a view to [start, start + length)
+AudioView audio_view_range(AudioView view, size_t start, size_t length) {
+    if (start > view.length) start = view.length;
+    if (length > view.length - start) length = view.length - start;
+    
+    view.data = view.data ? view.data + start * view.stride : NULL;
+    view.length = length;
+    return view;
+}
+
+// Run an effect over a view in place (zero-copy for contiguous views)
+void audio_view_process(AudioView view, BlockProcessFn process, void* effect) {
+    if (!view.data || !process) return;
+    
+    if (view.stride == 1) {
+        process(effect, view.data, view.data, view.length);
+        return;
+    }
+    
+    sample_t scratch[AUDIO_CHANNEL_CHUNK];
+    for (size_t start = 0; start < view.length; start += AUDIO_CHANNEL_CHUNK) {
+        size_t n = (view.length - start < AUDIO_CHANNEL_CHUNK) ? view.length - start : AUDIO_CHANNEL_CHUNK;
+        sample_t* p = view.data + start * view.stride;
+        
+        for (size_t i = 0; i < n; i++) scratch[i] = p[i * view.stride];
+        process(effect, scratch, scratch, n);
+        for (size_t i = 0; i < n; i++) p[i * view.stride] = scratch[i];
+    }
+}
+
+// Interleave planar channels into frames
+void audio_interleave(sample_t* const* planes, size_t channels, sample_t* dest, size_t frames) {
+    if (!planes || !dest || channels == 0) return;
+    
+    size_t i = 0;
+    if (channels == 2) {
+        const sample_t* left = planes[0];
+        const sample_t* right = planes[1];
+#if defined(AUDIO_CORE_SSE)
+        for (; i + 4 <= frames; i += 4) {
+            __m128 l = _mm_loadu_ps(left + i);
+            __m128 r = _mm_loadu_ps(right + i);
+            _mm_storeu_ps(dest + 2 * i, _mm_unpacklo_ps(l, r));
+            _mm_storeu_ps(dest + 2 * i + 4, _mm_unpackhi_ps(l, r));
+        }
+#elif defined(AUDIO_CORE_NEON)
+        for (; i + 4 <= frames; i += 4) {
+            float32x4x2_t lr = { { vld1q_f32(left + i), vld1q_f32(right + i) } };
+            vst2q_f32(dest + 2 * i, lr);
+        }
+#endif
+        for (; i < frames; i++) {
+            dest[2 * i] = left[i];
+            dest[2 * i + 1] = right[i];
+        }
+        return;
+    }
+    
+    for (size_t ch = 0; ch < channels; ch++) {
+        const sample_t* src = planes[ch];
+        for (i = 0; i < frames; i++) {
+            dest[i * channels + ch] = src[i];
+        }
+    }
+}
+
+// Split interleaved frames into planar channels
+void audio_deinterleave(const sample_t* src, size_t channels, sample_t* const* planes, size_t frames) {
+    if (!src || !planes || channels == 0) return;
+    
+    size_t i = 0;
+    if (channels == 2) {
+        sample_t* left = planes[0];
+        sample_t* right = planes[1];
+#if defined(AUDIO_CORE_SSE)
+        for (; i + 4 <= frames; i += 4) {
+            __m128 a = _mm_loadu_ps(src + 2 * i);
+            __m128 b = _mm_loadu_ps(src + 2 * i + 4);
+            _mm_storeu_ps(left + i, _mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0)));
+            _mm_storeu_ps(right + i, _mm_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1)));
+        }
+#elif defined(AUDIO_CORE_NEON)
+        for (; i + 4 <= frames; i += 4) {
+            float32x4x2_t lr = vld2q_f32(src + 2 * i);
+            vst1q_f32(left + i, lr.val[0]);
+            vst1q_f32(right + i, lr.val[1]);
+        }
+#endif
+        for (; i < frames; i++) {
+            left[i] = src[2 * i];
+            right[i] = src[2 * i + 1];
+        }
+        return;
+    }
+    
+    for (size_t ch = 0; ch < channels; ch++) {
+        sample_t* dest = planes[ch];
+        for (i = 0; i < frames; i++) {
+            dest[i] = src[i * channels + ch];
+        }
+    }
+}
+
+// Parameter smoothing
+
+static uint32_t param_bits(float value) {
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+static float param_value(uint32_t bits) {
+    float value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+// Initialize a smoother resting at value
+void param_smoother_init(ParamSmoother* smoother, float value, float ramp_ms, float sample_rate,
+                         ParamSmoothMode mode) {
+    if (!smoother) return;
+    
+    float samples = ramp_ms > 0.0f && sample_rate > 0.0f ? ramp_ms * 0.001f * sample_rate : 0.0f;
+    
+    smoother->current = value;
+    smoother->target = value;
+    smoother->step = 0.0f;
+    smoother->ramp_samples = (uint32_t)samples;
+    smoother->coefficient = smoother->ramp_samples ? 1.0f - expf(-6.9f / samples) : 1.0f; // ln(1000)
+    smoother->remaining = 0;
+    smoother->mode = mode;
+    smoother->running = 0;
+    smoother->published = param_bits(value);
+}
+
+// Publish a new target (any thread)
+void param_smoother_set_target(ParamSmoother* smoother, float target) {
+    if (!smoother) return;
+    
+    __atomic_store_n(&smoother->published, param_bits(target), __ATOMIC_RELEASE);
+}
+
+// Pick up the published target (audio thread, once per block)
+int param_smoother_update(ParamSmoother* smoother) {
+    if (!smoother) return 0;
+    
+    float target = param_value(__atomic_load_n(&smoother->published, __ATOMIC_ACQUIRE));
+    
+    if (!smoother->running || smoother->ramp_samples == 0) {
+        int changed = !smoother->running || target != smoother->current;
+        smoother->running = 1;
+        smoother->current = target;
+        smoother->target = target;
+        smoother->remaining = 0;
+        return changed;
+    }
+    
+    if (target != smoother->target) {
+        smoother->target = target;
+        smoother->remaining = smoother->ramp_samples;
+        smoother->step = (target - smoother->current) / (float)smoother->ramp_samples;
+    }
+    return smoother->remaining != 0;
+}
+
+// Jump to the published target and apply later targets immediately until
+// the next update (used by the effects' reset functions)
+void param_smoother_snap(ParamSmoother* smoother) {
+    if (!smoother) return;
+    
+    float target = param_value(__atomic_load_n(&smoother->published, __ATOMIC_ACQUIRE));
+    smoother->current = target;
+    smoother->target = target;
+    smoother->remaining = 0;
+    smoother->running = 0;
+}
+
+// Write the next n values
+void param_smoother_fill(ParamSmoother* smoother, float* dest, size_t n) {
+    if (!smoother || !dest) return;
+    
+    size_t i = 0;
+    for (; i < n && smoother->remaining; i++) {
+        dest[i] = param_smoother_next(smoother);
+    }
+    for (; i < n; i++) {
+        dest[i] = smoother->current;
+    }
+}
+
+// Advance n samples (for values read once per control period)
+void param_smoother_skip(ParamSmoother* smoother, size_t n) {
+    if (!smoother) return;
     
-    for (size_t i = 0; i < samples_to_mix; i++) {
-        dest->data[i] += src->data[i] * gain;
+    for (size_t i = 0; i < n && smoother->remaining; i++) {
+        param_smoother_next(smoother);
     }
 }
 
@@ -66,25 +592,7 @@ float linear_to_db(float linear) {
     return 20.0f * log10f(linear);
 }
 
-// Clamp value between min and max
-float clamp(float value, float min, float max) {
-    if (value < min) return min;
-    if (value > max) return max;
-    return value;
-}
-
 // Linear interpolation
 float lerp(float a, float b, float t) {
     return a + t * (b - a);
 }
-
-// Convert float sample to 16-bit integer
-int16_t float_to_int16(float sample) {
-    sample = clamp(sample, -1.0f, 1.0f);
-    return (int16_t)(sample * 32767.0f);
-}
-
-// Convert 16-bit integer to float sample
-float int16_to_float(int16_t sample) {
-    return (float)sample / 32767.0f;
-}
\ No newline at end of file
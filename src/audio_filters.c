@@ -1,4 +1,13 @@
 #include "audio_filters.h"
+#include "cpu_features.h"
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define FILTERS_SSE 1
+#endif
+#if defined(AUDIO_X86_DISPATCH)
+#include <immintrin.h>
+#endif
 
 // Design a lowpass biquad filter
 void biquad_lowpass(BiquadFilter* filter, float freq, float q, float sample_rate) {
@@ -98,16 +107,7 @@ void biquad_notch(BiquadFilter* filter, float freq, float q, float sample_rate)
 
 // Process one sample through biquad filter
 float biquad_process(BiquadFilter* filter, float input) {
-    float output = filter->b0 * input + filter->b1 * filter->x1 + filter->b2 * filter->x2
-                   - filter->a1 * filter->y1 - filter->a2 * filter->y2;
-    
-    // Update history
-    filter->x2 = filter->x1;
-    filter->x1 = input;
-    filter->y2 = filter->y1;
-    filter->y1 = output;
-    
-    return output;
+    return biquad_tick(filter, input);
 }
 
 // Reset biquad filter state
@@ -116,15 +116,107 @@ void biquad_reset(BiquadFilter* filter) {
     filter->y1 = filter->y2 = 0.0f;
 }
 
+// Process a block through biquad filter (in and out may be the same buffer)
+void biquad_process_block(BiquadFilter* filter, const sample_t* in, sample_t* out, size_t n) {
+    if (!filter) {
+        audio_block_bypass(in, out, n);
+        return;
+    }
+    if (!in || !out) return;
+    
+    BiquadFilter f = *filter;
+    for (size_t i = 0; i < n; i++) {
+        out[i] = biquad_tick(&f, in[i]);
+    }
+    *filter = f;
+}
+
 // Process entire buffer through biquad filter
 void biquad_process_buffer(BiquadFilter* filter, AudioBuffer* buffer) {
     if (!buffer || !buffer->data) return;
     
-    for (size_t i = 0; i < buffer->capacity; i++) {
-        buffer->data[i] = biquad_process(filter, buffer->data[i]);
+    biquad_process_block(filter, buffer->data, buffer->data, buffer->capacity);
+}
+
+// Block adapter used for per-channel processing
+static void biquad_channel_block(void* effect, const sample_t* in, sample_t* out, size_t n) {
+    biquad_process_block((BiquadFilter*)effect, in, out, n);
+}
+
+// Filter all channels of an interleaved buffer at once, one bank lane per
+// channel. The filters' direct-form history is converted to the bank's
+// transposed state on entry and rebuilt from the last two frames on exit.
+static void biquad_process_interleaved(BiquadFilter* filters, AudioBuffer* buffer) {
+    const size_t channels = buffer->channels;
+    const size_t frames = buffer->length;
+    BiquadBank bank;
+    
+    biquad_bank_init(&bank, (int)channels);
+    for (size_t ch = 0; ch < channels; ch++) {
+        const BiquadFilter* f = &filters[ch];
+        biquad_bank_set_lane(&bank, (int)ch, f, 1.0f);
+        bank.s1[ch] = f->b1 * f->x1 - f->a1 * f->y1 + f->b2 * f->x2 - f->a2 * f->y2;
+        bank.s2[ch] = f->b2 * f->x1 - f->a2 * f->y1;
+    }
+    
+    // Keep the input history before the buffer is overwritten in place
+    float x_tail[2][MAX_CHANNELS];
+    for (size_t ch = 0; ch < channels; ch++) {
+        x_tail[0][ch] = frames >= 1 ? buffer->data[(frames - 1) * channels + ch] : filters[ch].x1;
+        x_tail[1][ch] = frames >= 2 ? buffer->data[(frames - 2) * channels + ch]
+                                    : (frames == 1 ? filters[ch].x1 : filters[ch].x2);
+    }
+    
+    biquad_bank_process_interleaved(&bank, buffer->data, buffer->data, frames);
+    
+    for (size_t ch = 0; ch < channels; ch++) {
+        BiquadFilter* f = &filters[ch];
+        float y1 = frames >= 1 ? buffer->data[(frames - 1) * channels + ch] : f->y1;
+        float y2 = frames >= 2 ? buffer->data[(frames - 2) * channels + ch]
+                               : (frames == 1 ? f->y1 : f->y2);
+        f->x1 = x_tail[0][ch];
+        f->x2 = x_tail[1][ch];
+        f->y1 = y1;
+        f->y2 = y2;
     }
 }
 
+// Process each channel of an interleaved buffer with its own filter (filters[channel])
+void biquad_process_channels(BiquadFilter* filters, AudioBuffer* buffer) {
+    if (!filters || !buffer || !buffer->data || buffer->channels > MAX_CHANNELS) return;
+    
+    if (buffer->layout == AUDIO_LAYOUT_INTERLEAVED && buffer->channels > 1) {
+        biquad_process_interleaved(filters, buffer);
+        return;
+    }
+    
+    void* instances[MAX_CHANNELS];
+    for (size_t ch = 0; ch < buffer->channels; ch++) {
+        instances[ch] = &filters[ch];
+    }
+    audio_buffer_process_channels(buffer, biquad_channel_block, instances);
+}
+
+// Effect interface adapters (filters are embedded by value, so the caller owns them)
+static void biquad_effect_reset(void* effect) {
+    biquad_reset((BiquadFilter*)effect);
+}
+
+static const EffectVTable biquad_vtable = {
+    .name = "biquad",
+    .process_block = biquad_channel_block,
+    .reset = biquad_effect_reset,
+    .set_param = NULL,
+    .latency = NULL,
+    .destroy = NULL
+};
+
+// Wrap in the effect interface (no params; redesign the filter directly)
+Effect biquad_effect(BiquadFilter* filter) {
+    Effect effect = { &biquad_vtable, filter };
+    return effect;
+}
+
 // Design a lowpass one-pole filter
 void onepole_lowpass(OnePoleFilter* filter, float freq, float sample_rate) {
     filter->alpha = 1.0f - expf(-TWO_PI * freq / sample_rate);
@@ -140,19 +232,789 @@ void onepole_highpass(OnePoleFilter* filter, float freq, float sample_rate) {
 // Process one sample through one-pole filter
 float onepole_process(OnePoleFilter* filter, float input, int highpass) {
     if (highpass) {
-        filter->prev_output = filter->alpha * (filter->prev_output + input - filter->prev_output);
-        return input - filter->prev_output;
+        return onepole_tick_highpass(filter, input);
     } else {
-        filter->prev_output += filter->alpha * (input - filter->prev_output);
-        return filter->prev_output;
+        return onepole_tick_lowpass(filter, input);
     }
 }
 
+// Process a block through one-pole filter (in and out may be the same buffer)
+void onepole_process_block(OnePoleFilter* filter, const sample_t* in, sample_t* out, size_t n, int highpass) {
+    if (!filter) {
+        audio_block_bypass(in, out, n);
+        return;
+    }
+    if (!in || !out) return;
+    
+    OnePoleFilter f = *filter;
+    if (highpass) {
+        for (size_t i = 0; i < n; i++) {
+            out[i] = onepole_tick_highpass(&f, in[i]);
+        }
+    } else {
+        for (size_t i = 0; i < n; i++) {
+            out[i] = onepole_tick_lowpass(&f, in[i]);
+        }
+    }
+    *filter = f;
+}
+
 // Reset one-pole filter state
 void onepole_reset(OnePoleFilter* filter) {
     filter->prev_output = 0.0f;
 }
 
+// State-variable filter functions
+
+// Coefficients for a cutoff (kept below Nyquist so tan stays finite)
+static void svf_coefficients(float k, float freq, float sample_rate, float* a1, float* a2, float* a3) {
+    float limit = 0.49f * sample_rate;
+    float g = tanf((float)PI * clamp(freq, 1.0f, limit) / sample_rate);
+    
+    *a1 = 1.0f / (1.0f + g * (g + k));
+    *a2 = g * *a1;
+    *a3 = g * *a2;
+}
+
+// Output mix that turns the band/low outputs into the requested response
+static void svf_set_mix(SVFilter* filter, FilterType type) {
+    float k = filter->k;
+    
+    switch (type) {
+        case FILTER_LOWPASS:  filter->m0 = 0.0f; filter->m1 = 0.0f;       filter->m2 = 1.0f;  break;
+        case FILTER_HIGHPASS: filter->m0 = 1.0f; filter->m1 = -k;         filter->m2 = -1.0f; break;
+        case FILTER_BANDPASS: filter->m0 = 0.0f; filter->m1 = k;          filter->m2 = 0.0f;  break;
+        case FILTER_NOTCH:    filter->m0 = 1.0f; filter->m1 = -k;         filter->m2 = 0.0f;  break;
+        case FILTER_ALLPASS:  filter->m0 = 1.0f; filter->m1 = -2.0f * k;  filter->m2 = 0.0f;  break;
+    }
+}
+
+// Design a state-variable filter without touching its state
+void svf_design(SVFilter* filter, FilterType type, float freq, float q, float sample_rate) {
+    if (!filter) return;
+    
+    filter->k = 1.0f / clamp(q, 0.1f, 100.0f);
+    svf_coefficients(filter->k, freq, sample_rate, &filter->a1, &filter->a2, &filter->a3);
+    svf_set_mix(filter, type);
+}
+
+// Reset state-variable filter state
+void svf_reset(SVFilter* filter) {
+    if (!filter) return;
+    
+    filter->ic1eq = 0.0f;
+    filter->ic2eq = 0.0f;
+}
+
+// Modulated filter functions
+
+// Initialize at a fixed cutoff with cleared state
+void modfilter_init(ModulatedFilter* filter, FilterType type, float freq, float q, float sample_rate) {
+    if (!filter) return;
+    
+    filter->sample_rate = sample_rate;
+    svf_design(&filter->svf, type, freq, q, sample_rate);
+    svf_reset(&filter->svf);
+    filter->da1 = 0.0f;
+    filter->da2 = 0.0f;
+    filter->da3 = 0.0f;
+    filter->remaining = 0;
+}
+
+// Change the resonance; the output mix follows k so the response shape holds
+void modfilter_set_q(ModulatedFilter* filter, float q) {
+    if (!filter) return;
+    
+    float k = 1.0f / clamp(q, 0.1f, 100.0f);
+    float scale = k / filter->svf.k;
+    filter->svf.m1 *= scale;
+    filter->svf.k = k;
+}
+
+// Start a control period ramping towards freq
+void modfilter_target(ModulatedFilter* filter, float freq) {
+    if (!filter) return;
+    
+    float a1, a2, a3;
+    svf_coefficients(filter->svf.k, freq, filter->sample_rate, &a1, &a2, &a3);
+    
+    const float step = 1.0f / MOD_FILTER_CONTROL_RATE;
+    filter->da1 = (a1 - filter->svf.a1) * step;
+    filter->da2 = (a2 - filter->svf.a2) * step;
+    filter->da3 = (a3 - filter->svf.a3) * step;
+    filter->remaining = MOD_FILTER_CONTROL_RATE;
+}
+
+// Clear state (the cutoff is kept)
+void modfilter_reset(ModulatedFilter* filter) {
+    if (!filter) return;
+    
+    svf_reset(&filter->svf);
+    filter->remaining = 0;
+}
+
+// Biquad bank functions
+
+// Initialize a bank with all lanes passing audio through unchanged
+void biquad_bank_init(BiquadBank* bank, int num_lanes) {
+    if (!bank) return;
+    
+    memset(bank, 0, sizeof(BiquadBank));
+    if (num_lanes < 1) num_lanes = 1;
+    if (num_lanes > BIQUAD_BANK_LANES) num_lanes = BIQUAD_BANK_LANES;
+    bank->num_lanes = num_lanes;
+    
+    // Unused lanes keep all-zero coefficients so they output silence
+    for (int k = 0; k < num_lanes; k++) {
+        bank->b0[k] = 1.0f;
+        bank->gain[k] = 1.0f;
+    }
+}
+
+// Load one lane's coefficients from a designed biquad
+void biquad_bank_set_lane(BiquadBank* bank, int lane, const BiquadFilter* design, float gain) {
+    if (!bank || !design || lane < 0 || lane >= bank->num_lanes) return;
+    
+    bank->b0[lane] = design->b0;
+    bank->b1[lane] = design->b1;
+    bank->b2[lane] = design->b2;
+    bank->a1[lane] = design->a1;
+    bank->a2[lane] = design->a2;
+    bank->gain[lane] = gain;
+}
+
+// Set one lane's output gain
+void biquad_bank_set_gain(BiquadBank* bank, int lane, float gain) {
+    if (!bank || lane < 0 || lane >= bank->num_lanes) return;
+    
+    bank->gain[lane] = gain;
+}
+
+// Clear the state of every lane
+void biquad_bank_reset(BiquadBank* bank) {
+    if (!bank) return;
+    
+    memset(bank->s1, 0, sizeof(bank->s1));
+    memset(bank->s2, 0, sizeof(bank->s2));
+}
+
+// Scalar kernels (reference and fallback)
+
+static void bank_parallel_scalar(BiquadBank* bank, const sample_t* in, sample_t* out, size_t n) {
+    const int lanes = bank->num_lanes;
+    float s1[BIQUAD_BANK_LANES], s2[BIQUAD_BANK_LANES];
+    memcpy(s1, bank->s1, sizeof(s1));
+    memcpy(s2, bank->s2, sizeof(s2));
+    
+    for (size_t i = 0; i < n; i++) {
+        float x = in[i];
+        float sum = 0.0f;
+        for (int k = 0; k < lanes; k++) {
+            float y = bank->b0[k] * x + s1[k];
+            s1[k] = bank->b1[k] * x - bank->a1[k] * y + s2[k];
+            s2[k] = bank->b2[k] * x - bank->a2[k] * y;
+            sum += y * bank->gain[k];
+        }
+        out[i] = sum;
+    }
+    
+    memcpy(bank->s1, s1, sizeof(s1));
+    memcpy(bank->s2, s2, sizeof(s2));
+}
+
+static void bank_interleaved_scalar(BiquadBank* bank, const sample_t* in, sample_t* out, size_t frames) {
+    const int lanes = bank->num_lanes;
+    float s1[BIQUAD_BANK_LANES], s2[BIQUAD_BANK_LANES];
+    memcpy(s1, bank->s1, sizeof(s1));
+    memcpy(s2, bank->s2, sizeof(s2));
+    
+    for (size_t i = 0; i < frames; i++) {
+        for (int k = 0; k < lanes; k++) {
+            float x = in[i * lanes + k];
+            float y = bank->b0[k] * x + s1[k];
+            s1[k] = bank->b1[k] * x - bank->a1[k] * y + s2[k];
+            s2[k] = bank->b2[k] * x - bank->a2[k] * y;
+            out[i * lanes + k] = y * bank->gain[k];
+        }
+    }
+    
+    memcpy(bank->s1, s1, sizeof(s1));
+    memcpy(bank->s2, s2, sizeof(s2));
+}
+
+static void bank_cascade_scalar(BiquadBank* bank, const sample_t* in, sample_t* out,
+                                const float* stage_gains, size_t n) {
+    const int lanes = bank->num_lanes;
+    float s1[BIQUAD_BANK_LANES], s2[BIQUAD_BANK_LANES];
+    memcpy(s1, bank->s1, sizeof(s1));
+    memcpy(s2, bank->s2, sizeof(s2));
+    
+    for (size_t i = 0; i < n; i++) {
+        float x = in[i];
+        for (int k = 0; k < lanes; k++) {
+            float y = bank->b0[k] * x + s1[k];
+            s1[k] = bank->b1[k] * x - bank->a1[k] * y + s2[k];
+            s2[k] = bank->b2[k] * x - bank->a2[k] * y;
+            x = y * (stage_gains ? stage_gains[i] : bank->gain[k]);
+        }
+        out[i] = x;
+    }
+    
+    memcpy(bank->s1, s1, sizeof(s1));
+    memcpy(bank->s2, s2, sizeof(s2));
+}
+
+#if defined(FILTERS_SSE)
+// SSE kernels: lanes 0-3 in one register, lanes 4-7 in a second
+
+static inline __m128 tdf2_step_sse(__m128 x, __m128* s1, __m128* s2,
+                                   __m128 b0, __m128 b1, __m128 b2, __m128 a1, __m128 a2) {
+    __m128 y = _mm_add_ps(_mm_mul_ps(b0, x), *s1);
+    *s1 = _mm_add_ps(_mm_sub_ps(_mm_mul_ps(b1, x), _mm_mul_ps(a1, y)), *s2);
+    *s2 = _mm_sub_ps(_mm_mul_ps(b2, x), _mm_mul_ps(a2, y));
+    return y;
+}
+
+static inline float hsum_sse(__m128 v) {
+    v = _mm_add_ps(v, _mm_movehl_ps(v, v));
+    v = _mm_add_ss(v, _mm_shuffle_ps(v, v, 1));
+    return _mm_cvtss_f32(v);
+}
+
+static inline __m128 select_sse(__m128 mask, __m128 a, __m128 b) {
+    return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+}
+
+// Shift lanes up by one across the register pair, inserting x into lane 0
+static inline void shift_in_sse(__m128* lo, __m128* hi, float x) {
+    __m128 carry = _mm_shuffle_ps(*lo, *lo, _MM_SHUFFLE(3, 3, 3, 3));
+    *hi = _mm_move_ss(_mm_castsi128_ps(_mm_slli_si128(_mm_castps_si128(*hi), 4)), carry);
+    *lo = _mm_move_ss(_mm_castsi128_ps(_mm_slli_si128(_mm_castps_si128(*lo), 4)), _mm_set_ss(x));
+}
+
+static void bank_parallel_sse(BiquadBank* bank, const sample_t* in, sample_t* out, size_t n) {
+    const int wide = bank->num_lanes > 4;
+    __m128 b0l = _mm_loadu_ps(bank->b0), b0h = _mm_loadu_ps(bank->b0 + 4);
+    __m128 b1l = _mm_loadu_ps(bank->b1), b1h = _mm_loadu_ps(bank->b1 + 4);
+    __m128 b2l = _mm_loadu_ps(bank->b2), b2h = _mm_loadu_ps(bank->b2 + 4);
+    __m128 a1l = _mm_loadu_ps(bank->a1), a1h = _mm_loadu_ps(bank->a1 + 4);
+    __m128 a2l = _mm_loadu_ps(bank->a2), a2h = _mm_loadu_ps(bank->a2 + 4);
+    __m128 gl = _mm_loadu_ps(bank->gain), gh = _mm_loadu_ps(bank->gain + 4);
+    __m128 s1l = _mm_loadu_ps(bank->s1), s1h = _mm_loadu_ps(bank->s1 + 4);
+    __m128 s2l = _mm_loadu_ps(bank->s2), s2h = _mm_loadu_ps(bank->s2 + 4);
+    
+    for (size_t i = 0; i < n; i++) {
+        __m128 x = _mm_set1_ps(in[i]);
+        __m128 acc = _mm_mul_ps(tdf2_step_sse(x, &s1l, &s2l, b0l, b1l, b2l, a1l, a2l), gl);
+        if (wide) {
+            acc = _mm_add_ps(acc, _mm_mul_ps(tdf2_step_sse(x, &s1h, &s2h, b0h, b1h, b2h, a1h, a2h), gh));
+        }
+        out[i] = hsum_sse(acc);
+    }
+    
+    _mm_storeu_ps(bank->s1, s1l); _mm_storeu_ps(bank->s1 + 4, s1h);
+    _mm_storeu_ps(bank->s2, s2l); _mm_storeu_ps(bank->s2 + 4, s2h);
+}
+
+static void bank_interleaved_sse(BiquadBank* bank, const sample_t* in, sample_t* out, size_t frames) {
+    const int lanes = bank->num_lanes;
+    const int wide = lanes > 4;
+    const int direct = (lanes == 4 || lanes == 8);
+    __m128 b0l = _mm_loadu_ps(bank->b0), b0h = _mm_loadu_ps(bank->b0 + 4);
+    __m128 b1l = _mm_loadu_ps(bank->b1), b1h = _mm_loadu_ps(bank->b1 + 4);
+    __m128 b2l = _mm_loadu_ps(bank->b2), b2h = _mm_loadu_ps(bank->b2 + 4);
+    __m128 a1l = _mm_loadu_ps(bank->a1), a1h = _mm_loadu_ps(bank->a1 + 4);
+    __m128 a2l = _mm_loadu_ps(bank->a2), a2h = _mm_loadu_ps(bank->a2 + 4);
+    __m128 gl = _mm_loadu_ps(bank->gain), gh = _mm_loadu_ps(bank->gain + 4);
+    __m128 s1l = _mm_loadu_ps(bank->s1), s1h = _mm_loadu_ps(bank->s1 + 4);
+    __m128 s2l = _mm_loadu_ps(bank->s2), s2h = _mm_loadu_ps(bank->s2 + 4);
+    float frame[BIQUAD_BANK_LANES] = {0};
+    
+    for (size_t i = 0; i < frames; i++) {
+        const sample_t* src = in + i * lanes;
+        sample_t* dst = out + i * lanes;
+        
+        // Odd channel counts go through a padded frame to avoid over-reading
+        if (!direct) {
+            memcpy(frame, src, lanes * sizeof(float));
+            src = frame;
+        }
+        
+        __m128 yl = _mm_mul_ps(tdf2_step_sse(_mm_loadu_ps(src), &s1l, &s2l, b0l, b1l, b2l, a1l, a2l), gl);
+        if (direct) {
+            _mm_storeu_ps(dst, yl);
+            if (wide) {
+                __m128 yh = tdf2_step_sse(_mm_loadu_ps(src + 4), &s1h, &s2h, b0h, b1h, b2h, a1h, a2h);
+                _mm_storeu_ps(dst + 4, _mm_mul_ps(yh, gh));
+            }
+        } else {
+            _mm_storeu_ps(frame, yl);
+            if (wide) {
+                __m128 yh = tdf2_step_sse(_mm_loadu_ps(src + 4), &s1h, &s2h, b0h, b1h, b2h, a1h, a2h);
+                _mm_storeu_ps(frame + 4, _mm_mul_ps(yh, gh));
+            }
+            memcpy(dst, frame, lanes * sizeof(float));
+        }
+    }
+    
+    _mm_storeu_ps(bank->s1, s1l); _mm_storeu_ps(bank->s1 + 4, s1h);
+    _mm_storeu_ps(bank->s2, s2l); _mm_storeu_ps(bank->s2 + 4, s2h);
+}
+
+// Cascade as a wavefront: at step t lane k runs stage k on sample t - k,
+// so all stages advance together in SIMD. Stage states are only committed
+// while a lane holds a real sample, so the block adds no latency.
+static void bank_cascade_sse(BiquadBank* bank, const sample_t* in, sample_t* out,
+                             const float* stage_gains, size_t n) {
+    if (n == 0) return;
+    
+    const size_t last = (size_t)bank->num_lanes - 1;
+    __m128 b0l = _mm_loadu_ps(bank->b0), b0h = _mm_loadu_ps(bank->b0 + 4);
+    __m128 b1l = _mm_loadu_ps(bank->b1), b1h = _mm_loadu_ps(bank->b1 + 4);
+    __m128 b2l = _mm_loadu_ps(bank->b2), b2h = _mm_loadu_ps(bank->b2 + 4);
+    __m128 a1l = _mm_loadu_ps(bank->a1), a1h = _mm_loadu_ps(bank->a1 + 4);
+    __m128 a2l = _mm_loadu_ps(bank->a2), a2h = _mm_loadu_ps(bank->a2 + 4);
+    __m128 gl = _mm_loadu_ps(bank->gain), gh = _mm_loadu_ps(bank->gain + 4);
+    __m128 s1l = _mm_loadu_ps(bank->s1), s1h = _mm_loadu_ps(bank->s1 + 4);
+    __m128 s2l = _mm_loadu_ps(bank->s2), s2h = _mm_loadu_ps(bank->s2 + 4);
+    const __m128 idx_l = _mm_setr_ps(0.0f, 1.0f, 2.0f, 3.0f);
+    const __m128 idx_h = _mm_setr_ps(4.0f, 5.0f, 6.0f, 7.0f);
+    __m128 yl = _mm_setzero_ps(), yh = _mm_setzero_ps();
+    float out_lanes[BIQUAD_BANK_LANES];
+    
+    for (size_t t = 0; t < n + last; t++) {
+        float x = (t < n) ? in[t] : 0.0f;
+        __m128 xl = yl, xh = yh;
+        shift_in_sse(&xl, &xh, x);
+        
+        if (stage_gains) {
+            float g = (t < n) ? stage_gains[t] : 0.0f;
+            shift_in_sse(&gl, &gh, g);
+        }
+        
+        __m128 n1l = s1l, n2l = s2l, n1h = s1h, n2h = s2h;
+        yl = _mm_mul_ps(tdf2_step_sse(xl, &n1l, &n2l, b0l, b1l, b2l, a1l, a2l), gl);
+        yh = _mm_mul_ps(tdf2_step_sse(xh, &n1h, &n2h, b0h, b1h, b2h, a1h, a2h), gh);
+        
+        if (t >= last && t < n) {
+            s1l = n1l; s2l = n2l; s1h = n1h; s2h = n2h;
+        } else {
+            // Lane k is live when it holds sample t - k of this block
+            __m128 hi_t = _mm_set1_ps((float)t);
+            __m128 lo_t = _mm_set1_ps((float)t - (float)n);
+            __m128 ml = _mm_and_ps(_mm_cmple_ps(idx_l, hi_t), _mm_cmpgt_ps(idx_l, lo_t));
+            __m128 mh = _mm_and_ps(_mm_cmple_ps(idx_h, hi_t), _mm_cmpgt_ps(idx_h, lo_t));
+            s1l = select_sse(ml, n1l, s1l); s2l = select_sse(ml, n2l, s2l);
+            s1h = select_sse(mh, n1h, s1h); s2h = select_sse(mh, n2h, s2h);
+        }
+        
+        if (t >= last) {
+            _mm_storeu_ps(out_lanes, yl);
+            _mm_storeu_ps(out_lanes + 4, yh);
+            out[t - last] = out_lanes[last];
+        }
+    }
+    
+    _mm_storeu_ps(bank->s1, s1l); _mm_storeu_ps(bank->s1 + 4, s1h);
+    _mm_storeu_ps(bank->s2, s2l); _mm_storeu_ps(bank->s2 + 4, s2h);
+}
+#endif // FILTERS_SSE
+
+#if defined(AUDIO_X86_DISPATCH)
+// AVX2 kernels: all eight lanes in one register
+
+AUDIO_TARGET_AVX2
+static inline __m256 tdf2_step_avx2(__m256 x, __m256* s1, __m256* s2,
+                                    __m256 b0, __m256 b1, __m256 b2, __m256 a1, __m256 a2) {
+    __m256 y = _mm256_fmadd_ps(b0, x, *s1);
+    *s1 = _mm256_fmadd_ps(b1, x, _mm256_fnmadd_ps(a1, y, *s2));
+    *s2 = _mm256_fnmadd_ps(a2, y, _mm256_mul_ps(b2, x));
+    return y;
+}
+
+AUDIO_TARGET_AVX2
+static void bank_parallel_avx2(BiquadBank* bank, const sample_t* in, sample_t* out, size_t n) {
+    __m256 b0 = _mm256_loadu_ps(bank->b0), b1 = _mm256_loadu_ps(bank->b1), b2 = _mm256_loadu_ps(bank->b2);
+    __m256 a1 = _mm256_loadu_ps(bank->a1), a2 = _mm256_loadu_ps(bank->a2), g = _mm256_loadu_ps(bank->gain);
+    __m256 s1 = _mm256_loadu_ps(bank->s1), s2 = _mm256_loadu_ps(bank->s2);
+    
+    for (size_t i = 0; i < n; i++) {
+        __m256 y = _mm256_mul_ps(tdf2_step_avx2(_mm256_set1_ps(in[i]), &s1, &s2, b0, b1, b2, a1, a2), g);
+        __m128 v = _mm_add_ps(_mm256_castps256_ps128(y), _mm256_extractf128_ps(y, 1));
+        v = _mm_add_ps(v, _mm_movehl_ps(v, v));
+        v = _mm_add_ss(v, _mm_shuffle_ps(v, v, 1));
+        out[i] = _mm_cvtss_f32(v);
+    }
+    
+    _mm256_storeu_ps(bank->s1, s1);
+    _mm256_storeu_ps(bank->s2, s2);
+}
+
+AUDIO_TARGET_AVX2
+static void bank_interleaved_avx2(BiquadBank* bank, const sample_t* in, sample_t* out, size_t frames) {
+    const int lanes = bank->num_lanes;
+    __m256 b0 = _mm256_loadu_ps(bank->b0), b1 = _mm256_loadu_ps(bank->b1), b2 = _mm256_loadu_ps(bank->b2);
+    __m256 a1 = _mm256_loadu_ps(bank->a1), a2 = _mm256_loadu_ps(bank->a2), g = _mm256_loadu_ps(bank->gain);
+    __m256 s1 = _mm256_loadu_ps(bank->s1), s2 = _mm256_loadu_ps(bank->s2);
+    const __m256i mask = _mm256_cmpgt_epi32(_mm256_set1_epi32(lanes), _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7));
+    
+    for (size_t i = 0; i < frames; i++) {
+        __m256 x = _mm256_maskload_ps(in + i * lanes, mask);
+        __m256 y = _mm256_mul_ps(tdf2_step_avx2(x, &s1, &s2, b0, b1, b2, a1, a2), g);
+        _mm256_maskstore_ps(out + i * lanes, mask, y);
+    }
+    
+    _mm256_storeu_ps(bank->s1, s1);
+    _mm256_storeu_ps(bank->s2, s2);
+}
+
+AUDIO_TARGET_AVX2
+static void bank_cascade_avx2(BiquadBank* bank, const sample_t* in, sample_t* out,
+                              const float* stage_gains, size_t n) {
+    if (n == 0) return;
+    
+    const size_t last = (size_t)bank->num_lanes - 1;
+    __m256 b0 = _mm256_loadu_ps(bank->b0), b1 = _mm256_loadu_ps(bank->b1), b2 = _mm256_loadu_ps(bank->b2);
+    __m256 a1 = _mm256_loadu_ps(bank->a1), a2 = _mm256_loadu_ps(bank->a2), g = _mm256_loadu_ps(bank->gain);
+    __m256 s1 = _mm256_loadu_ps(bank->s1), s2 = _mm256_loadu_ps(bank->s2);
+    const __m256i rotate = _mm256_setr_epi32(0, 0, 1, 2, 3, 4, 5, 6);
+    const __m256i lane_idx = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+    const __m256i last_idx = _mm256_set1_epi32((int)last);
+    __m256 y = _mm256_setzero_ps();
+    
+    for (size_t t = 0; t < n + last; t++) {
+        float x_in = (t < n) ? in[t] : 0.0f;
+        __m256 x = _mm256_blend_ps(_mm256_permutevar8x32_ps(y, rotate), _mm256_set1_ps(x_in), 0x01);
+        
+        if (stage_gains) {
+            float g_in = (t < n) ? stage_gains[t] : 0.0f;
+            g = _mm256_blend_ps(_mm256_permutevar8x32_ps(g, rotate), _mm256_set1_ps(g_in), 0x01);
+        }
+        
+        __m256 n1 = s1, n2 = s2;
+        y = _mm256_mul_ps(tdf2_step_avx2(x, &n1, &n2, b0, b1, b2, a1, a2), g);
+        
+        if (t >= last && t < n) {
+            s1 = n1; s2 = n2;
+        } else {
+            // Lane k is live when t - n < k <= t
+            __m256i hi_t = _mm256_set1_epi32((int)(t < 0x7fffffff ? t : 0x7fffffff));
+            __m256i k_le_t = _mm256_cmpgt_epi32(_mm256_add_epi32(hi_t, _mm256_set1_epi32(1)), lane_idx);
+            __m256i k_gt = (t >= n)
+                           ? _mm256_cmpgt_epi32(lane_idx, _mm256_set1_epi32((int)(t - n)))
+                           : _mm256_set1_epi32(-1);
+            __m256 m = _mm256_castsi256_ps(_mm256_and_si256(k_le_t, k_gt));
+            s1 = _mm256_blendv_ps(s1, n1, m);
+            s2 = _mm256_blendv_ps(s2, n2, m);
+        }
+        
+        if (t >= last) {
+            __m256 picked = _mm256_permutevar8x32_ps(y, last_idx);
+            out[t - last] = _mm_cvtss_f32(_mm256_castps256_ps128(picked));
+        }
+    }
+    
+    _mm256_storeu_ps(bank->s1, s1);
+    _mm256_storeu_ps(bank->s2, s2);
+}
+#endif // AUDIO_X86_DISPATCH
+
+// Run every lane on the same input and sum the weighted outputs
+void biquad_bank_process_parallel(BiquadBank* bank, const sample_t* in, sample_t* out, size_t n) {
+    if (!bank) {
+        audio_block_bypass(in, out, n);
+        return;
+    }
+    if (!in || !out) return;
+    
+    SimdLevel level = cpu_simd_level();
+#if defined(AUDIO_X86_DISPATCH)
+    if (level >= SIMD_LEVEL_AVX2) {
+        bank_parallel_avx2(bank, in, out, n);
+        return;
+    }
+#endif
+#if defined(FILTERS_SSE)
+    if (level >= SIMD_LEVEL_SSE2) {
+        bank_parallel_sse(bank, in, out, n);
+        return;
+    }
+#endif
+    (void)level;
+    bank_parallel_scalar(bank, in, out, n);
+}
+
+// Run lane k on channel k of interleaved frames (num_lanes channels)
+void biquad_bank_process_interleaved(BiquadBank* bank, const sample_t* in, sample_t* out, size_t frames) {
+    if (!bank || !in || !out) return;
+    
+    SimdLevel level = cpu_simd_level();
+#if defined(AUDIO_X86_DISPATCH)
+    if (level >= SIMD_LEVEL_AVX2) {
+        bank_interleaved_avx2(bank, in, out, frames);
+        return;
+    }
+#endif
+#if defined(FILTERS_SSE)
+    if (level >= SIMD_LEVEL_SSE2) {
+        bank_interleaved_sse(bank, in, out, frames);
+        return;
+    }
+#endif
+    (void)level;
+    bank_interleaved_scalar(bank, in, out, frames);
+}
+
+// Run the lanes in series. stage_gains (optional, one per sample) scales
+// every stage output; without it each stage uses its lane gain.
+void biquad_bank_process_cascade(BiquadBank* bank, const sample_t* in, sample_t* out,
+                                 const float* stage_gains, size_t n) {
+    if (!bank) {
+        audio_block_bypass(in, out, n);
+        return;
+    }
+    if (!in || !out) return;
+    
+    SimdLevel level = cpu_simd_level();
+#if defined(AUDIO_X86_DISPATCH)
+    if (level >= SIMD_LEVEL_AVX2) {
+        bank_cascade_avx2(bank, in, out, stage_gains, n);
+        return;
+    }
+#endif
+#if defined(FILTERS_SSE)
+    if (level >= SIMD_LEVEL_SSE2 && bank->num_lanes > 1) {
+        bank_cascade_sse(bank, in, out, stage_gains, n);
+        return;
+    }
+#endif
+    (void)level;
+    bank_cascade_scalar(bank, in, out, stage_gains, n);
+}
+
+// Oversampler functions
+
+#define HALFBAND_KAISER_BETA 7.0
+
+// Nonzero side taps per stage. The first stage guards the audio band; the
+// later ones run with wide transition bands and get by with fewer taps.
+static const int halfband_stage_taps[OVERSAMPLE_MAX_STAGES] = {24, 12, 8};
+
+// Zeroth-order modified Bessel function (for the Kaiser window)
+static double bessel_i0(double x) {
+    double sum = 1.0;
+    double term = 1.0;
+    for (int k = 1; k < 64 && term > 1e-12 * sum; k++) {
+        double half = x / (2.0 * k);
+        term *= half * half;
+        sum += term;
+    }
+    return sum;
+}
+
+// Kaiser-windowed half-band design. Of the 2 * taps - 1 taps only the
+// centre (1/2) and the even-indexed ones are nonzero; coeffs holds the even
+// ones, scaled so the response is exactly 1 at DC.
+static void halfband_fir_init(HalfbandFir* fir, int taps, float gain) {
+    const int center = taps - 1;
+    const double span = 2.0 * taps - 2.0;
+    const double norm = bessel_i0(HALFBAND_KAISER_BETA);
+    double design[HALFBAND_MAX_TAPS];
+    double sum = 0.0;
+    
+    for (int j = 0; j < taps; j++) {
+        double t = (double)(2 * j - center);
+        double r = 4.0 * j / span - 1.0;
+        double window = bessel_i0(HALFBAND_KAISER_BETA * sqrt(1.0 - r * r)) / norm;
+        design[j] = sin(PI * t / 2.0) / (PI * t) * window;
+        sum += design[j];
+    }
+    
+    for (int j = 0; j < taps; j++) {
+        fir->coeffs[j] = (float)(design[j] * 0.5 / sum) * gain;
+    }
+    fir->taps = taps;
+    fir->pos = 0;
+    memset(fir->history, 0, sizeof(fir->history));
+}
+
+// Push one sample and return the last taps samples, oldest first
+static inline const float* halfband_push(HalfbandFir* fir, float x) {
+    int pos = fir->pos;
+    fir->history[pos] = x;
+    fir->history[pos + fir->taps] = x;
+    fir->pos = pos + 1 == fir->taps ? 0 : pos + 1;
+    return fir->history + fir->pos;
+}
+
+// FIR dot product (taps is a multiple of 4). The scalar path sums in the
+// same order as the SSE one.
+static inline float halfband_dot(const float* coeffs, const float* window, int taps, int simd) {
+#if defined(FILTERS_SSE)
+    if (simd) {
+        __m128 acc = _mm_mul_ps(_mm_loadu_ps(coeffs), _mm_loadu_ps(window));
+        for (int i = 4; i < taps; i += 4) {
+            acc = _mm_add_ps(acc, _mm_mul_ps(_mm_loadu_ps(coeffs + i), _mm_loadu_ps(window + i)));
+        }
+        return hsum_sse(acc);
+    }
+#endif
+    (void)simd;
+    float acc[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+    for (int i = 0; i < taps; i += 4) {
+        acc[0] += coeffs[i] * window[i];
+        acc[1] += coeffs[i + 1] * window[i + 1];
+        acc[2] += coeffs[i + 2] * window[i + 2];
+        acc[3] += coeffs[i + 3] * window[i + 3];
+    }
+    return (acc[0] + acc[2]) + (acc[1] + acc[3]);
+}
+
+// 2x upsampling stage: even outputs filter the input (the coefficients
+// carry the zero-stuffing gain of 2), odd outputs are the input delayed to
+// the centre tap. out may start below in; it never overtakes the reads.
+static void halfband_up(HalfbandFir* fir, const sample_t* in, sample_t* out, size_t n, int simd) {
+    const int taps = fir->taps;
+    const int center = taps / 2;
+    
+    for (size_t i = 0; i < n; i++) {
+        const float* window = halfband_push(fir, in[i]);
+        out[2 * i] = halfband_dot(fir->coeffs, window, taps, simd);
+        out[2 * i + 1] = window[center];
+    }
+}
+
+// 2x downsampling stage: the even samples go through the FIR, the odd ones
+// wait for the centre tap (out may be in)
+static void halfband_down(HalfbandStage* stage, const sample_t* in, sample_t* out, size_t n, int simd) {
+    HalfbandFir* fir = &stage->down;
+    const int taps = fir->taps;
+    const int delay = taps / 2;
+    int odd_pos = stage->odd_pos;
+    
+    for (size_t i = 0; i < n; i++) {
+        const float* window = halfband_push(fir, in[2 * i]);
+        float centre = stage->odd_delay[odd_pos];
+        stage->odd_delay[odd_pos] = in[2 * i + 1];
+        odd_pos = odd_pos + 1 == delay ? 0 : odd_pos + 1;
+        out[i] = halfband_dot(fir->coeffs, window, taps, simd) + 0.5f * centre;
+    }
+    
+    stage->odd_pos = odd_pos;
+}
+
+// Set up for factor 1 (bypass), 2, 4 or 8 with cleared state
+int oversampler_init(Oversampler* os, int factor) {
+    if (!os) return 0;
+    
+    int num_stages;
+    switch (factor) {
+        case 1: num_stages = 0; break;
+        case 2: num_stages = 1; break;
+        case 4: num_stages = 2; break;
+        case 8: num_stages = 3; break;
+        default: return 0;
+    }
+    
+    // Each stage delays by its centre tap twice (up and down) at its
+    // output rate; count everything in top-rate samples
+    size_t top_delay = 0;
+    for (int s = 0; s < num_stages; s++) {
+        int taps = halfband_stage_taps[s];
+        halfband_fir_init(&os->stages[s].up, taps, 2.0f);
+        halfband_fir_init(&os->stages[s].down, taps, 1.0f);
+        top_delay += (size_t)(2 * (taps - 1)) << (num_stages - 1 - s);
+    }
+    
+    os->num_stages = num_stages;
+    os->factor = factor;
+    os->pad_length = (int)((factor - top_delay % factor) % factor);
+    os->latency = (top_delay + os->pad_length) / factor;
+    oversampler_reset(os);
+    return 1;
+}
+
+// Clear filter and delay state
+void oversampler_reset(Oversampler* os) {
+    if (!os) return;
+    
+    for (int s = 0; s < os->num_stages; s++) {
+        HalfbandStage* stage = &os->stages[s];
+        memset(stage->up.history, 0, sizeof(stage->up.history));
+        memset(stage->down.history, 0, sizeof(stage->down.history));
+        memset(stage->odd_delay, 0, sizeof(stage->odd_delay));
+        stage->up.pos = 0;
+        stage->down.pos = 0;
+        stage->odd_pos = 0;
+    }
+    memset(os->pad, 0, sizeof(os->pad));
+    os->pad_pos = 0;
+}
+
+// Round-trip latency (up then down) in base-rate samples
+size_t oversampler_latency(const Oversampler* os) {
+    return os ? os->latency : 0;
+}
+
+// Upsample n samples to n * factor. Each stage writes to the tail of out
+// so the next one can expand it in place towards the front.
+void oversampler_up(Oversampler* os, const sample_t* in, sample_t* out, size_t n) {
+    if (!os || !in || !out) return;
+    if (os->num_stages == 0) {
+        memmove(out, in, n * sizeof(sample_t));
+        return;
+    }
+    
+    const int simd = cpu_simd_level() >= SIMD_LEVEL_SSE2;
+    const size_t total = n * (size_t)os->factor;
+    const sample_t* src = in;
+    size_t length = n;
+    
+    for (int s = 0; s < os->num_stages; s++) {
+        sample_t* dst = out + total - 2 * length;
+        halfband_up(&os->stages[s].up, src, dst, length, simd);
+        src = dst;
+        length *= 2;
+    }
+}
+
+// Downsample n * factor samples from in (overwritten) to n samples in out
+void oversampler_down(Oversampler* os, sample_t* in, sample_t* out, size_t n) {
+    if (!os || !in || !out) return;
+    if (os->num_stages == 0) {
+        memmove(out, in, n * sizeof(sample_t));
+        return;
+    }
+    
+    const int simd = cpu_simd_level() >= SIMD_LEVEL_SSE2;
+    size_t length = n * (size_t)os->factor;
+    
+    if (os->pad_length) {
+        int pos = os->pad_pos;
+        for (size_t i = 0; i < length; i++) {
+            float x = in[i];
+            in[i] = os->pad[pos];
+            os->pad[pos] = x;
+            pos = pos + 1 == os->pad_length ? 0 : pos + 1;
+        }
+        os->pad_pos = pos;
+    }
+    
+    for (int s = os->num_stages - 1; s >= 0; s--) {
+        length /= 2;
+        halfband_down(&os->stages[s], in, s == 0 ? out : in, length, simd);
+    }
+}
+
+// Copy band designs and gains into the EQ's bank (0.25 averages the bands)
+static void eq_load_bank(FourBandEQ* eq) {
+    biquad_bank_init(&eq->bank, 4);
+    biquad_bank_set_lane(&eq->bank, 0, &eq->low_shelf, eq->low_gain * 0.25f);
+    biquad_bank_set_lane(&eq->bank, 1, &eq->low_mid, eq->low_mid_gain * 0.25f);
+    biquad_bank_set_lane(&eq->bank, 2, &eq->high_mid, eq->high_mid_gain * 0.25f);
+    biquad_bank_set_lane(&eq->bank, 3, &eq->high_shelf, eq->high_gain * 0.25f);
+}
+
 // Initialize 4-band EQ
 void eq_init(FourBandEQ* eq, float sample_rate) {
     // Low shelf at 100 Hz
@@ -172,6 +1034,13 @@ void eq_init(FourBandEQ* eq, float sample_rate) {
     eq->low_mid_gain = 1.0f;
     eq->high_mid_gain = 1.0f;
     eq->high_gain = 1.0f;
+    
+    for (int band = 0; band < 4; band++) {
+        param_smoother_init(&eq->gain_smoothers[band], 1.0f, PARAM_SMOOTH_DEFAULT_MS, sample_rate,
+                            PARAM_SMOOTH_LINEAR);
+    }
+    
+    eq_load_bank(eq);
 }
 
 // Set EQ band gains in dB
@@ -180,23 +1049,115 @@ void eq_set_gains(FourBandEQ* eq, float low, float low_mid, float high_mid, floa
     eq->low_mid_gain = db_to_linear(low_mid);
     eq->high_mid_gain = db_to_linear(high_mid);
     eq->high_gain = db_to_linear(high);
+    
+    param_smoother_set_target(&eq->gain_smoothers[0], eq->low_gain);
+    param_smoother_set_target(&eq->gain_smoothers[1], eq->low_mid_gain);
+    param_smoother_set_target(&eq->gain_smoothers[2], eq->high_mid_gain);
+    param_smoother_set_target(&eq->gain_smoothers[3], eq->high_gain);
 }
 
 // Process one sample through 4-band EQ
 float eq_process(FourBandEQ* eq, float input) {
-    float low = biquad_process(&eq->low_shelf, input) * eq->low_gain;
-    float low_mid = biquad_process(&eq->low_mid, input) * eq->low_mid_gain;
-    float high_mid = biquad_process(&eq->high_mid, input) * eq->high_mid_gain;
-    float high = biquad_process(&eq->high_shelf, input) * eq->high_gain;
+    float output;
+    eq_process_block(eq, &input, &output, 1);
+    return output;
+}
+
+// Process a block through 4-band EQ (in and out may be the same buffer).
+// The four bands run as lanes of one biquad bank and are summed per sample.
+// While a gain ramps the bank runs one sample at a time with the lane gains
+// stepped in between.
+void eq_process_block(FourBandEQ* eq, const sample_t* in, sample_t* out, size_t n) {
+    if (!eq) {
+        audio_block_bypass(in, out, n);
+        return;
+    }
     
-    return (low + low_mid + high_mid + high) * 0.25f; // Average the bands
+    int changed = 0;
+    for (int band = 0; band < 4; band++) {
+        changed |= param_smoother_update(&eq->gain_smoothers[band]);
+    }
+    
+    size_t i = 0;
+    while (changed && i < n) {
+        changed = 0;
+        for (int band = 0; band < 4; band++) {
+            biquad_bank_set_gain(&eq->bank, band, param_smoother_next(&eq->gain_smoothers[band]) * 0.25f);
+            changed |= param_smoother_active(&eq->gain_smoothers[band]);
+        }
+        biquad_bank_process_parallel(&eq->bank, in + i, out + i, 1);
+        i++;
+    }
+    
+    biquad_bank_process_parallel(&eq->bank, in + i, out + i, n - i);
 }
 
 // Process entire buffer through 4-band EQ
 void eq_process_buffer(FourBandEQ* eq, AudioBuffer* buffer) {
     if (!buffer || !buffer->data) return;
     
-    for (size_t i = 0; i < buffer->capacity; i++) {
-        buffer->data[i] = eq_process(eq, buffer->data[i]);
+    eq_process_block(eq, buffer->data, buffer->data, buffer->capacity);
+}
+
+// Block adapter used for per-channel processing
+static void eq_channel_block(void* effect, const sample_t* in, sample_t* out, size_t n) {
+    eq_process_block((FourBandEQ*)effect, in, out, n);
+}
+
+// Process each channel of an interleaved buffer with its own EQ (eqs[channel])
+void eq_process_channels(FourBandEQ* eqs, AudioBuffer* buffer) {
+    if (!eqs || !buffer || !buffer->data || buffer->channels > MAX_CHANNELS) return;
+    
+    void* instances[MAX_CHANNELS];
+    for (size_t ch = 0; ch < buffer->channels; ch++) {
+        instances[ch] = &eqs[ch];
+    }
+    audio_buffer_process_channels(buffer, eq_channel_block, instances);
+}
+
+// Clear EQ history (gains are kept)
+void eq_reset(FourBandEQ* eq) {
+    if (!eq) return;
+    
+    biquad_reset(&eq->low_shelf);
+    biquad_reset(&eq->low_mid);
+    biquad_reset(&eq->high_mid);
+    biquad_reset(&eq->high_shelf);
+    biquad_bank_reset(&eq->bank);
+    
+    for (int band = 0; band < 4; band++) {
+        param_smoother_snap(&eq->gain_smoothers[band]);
+        biquad_bank_set_gain(&eq->bank, band, eq->gain_smoothers[band].current * 0.25f);
     }
-}
\ No newline at end of file
+}
+
+// Effect interface adapters
+static void eq_effect_reset(void* effect) {
+    eq_reset((FourBandEQ*)effect);
+}
+
+static int eq_effect_set_param(void* effect, int param, float value) {
+    FourBandEQ* eq = (FourBandEQ*)effect;
+    if (param < 0 || param >= 4) return 0;
+    
+    float p[4] = {linear_to_db(eq->low_gain), linear_to_db(eq->low_mid_gain),
+                  linear_to_db(eq->high_mid_gain), linear_to_db(eq->high_gain)};
+    p[param] = value;
+    eq_set_gains(eq, p[0], p[1], p[2], p[3]);
+    return 1;
+}
+
+static const EffectVTable eq_vtable = {
+    .name = "4-band EQ",
+    .process_block = eq_channel_block,
+    .reset = eq_effect_reset,
+    .set_param = eq_effect_set_param,
+    .latency = NULL,
+    .destroy = NULL
+};
+
+// Wrap in the effect interface (params: band gains in dB; caller owns the EQ)
+Effect eq_effect(FourBandEQ* eq) {
+    Effect effect = { &eq_vtable, eq };
+    return effect;
+}
@@ -0,0 +1,451 @@
+#define _POSIX_C_SOURCE 200112L // pthreads, clock_gettime
+#include "batch_render.h"
+#include "cpu_features.h"
+#include "wav_io.h"
+#include <pthread.h>
+#include <time.h>
+
+#define BATCH_MAX_WORKERS 256
+
+struct ChannelRenderer;
+
+// One helper thread per channel after the first
+typedef struct {
+    struct ChannelRenderer* renderer;
+    size_t channel;
+    pthread_t thread;
+} ChannelThread;
+
+struct ChannelRenderer {
+    EffectChain* chains[MAX_CHANNELS];
+    size_t channels;
+    ChannelThread threads[MAX_CHANNELS];
+    size_t num_threads;       // Helpers started (channels - 1 when all succeeded)
+    pthread_mutex_t lock;
+    pthread_cond_t start;
+    pthread_cond_t done;
+    unsigned long generation; // Bumped once per process call
+    size_t pending;           // Helpers still working on this generation
+    int quit;
+    sample_t* planes[MAX_CHANNELS];
+    size_t frames;
+};
+
+// Per-thread state: the chains survive from one file to the next
+typedef struct {
+    BatchRenderer* renderer;
+    pthread_t thread;
+    int index;
+    EffectChain* chains[MAX_CHANNELS];
+    size_t channels;          // Channels the chains were built for (0 = none)
+    size_t sample_rate;
+    AudioBuffer* block;
+    ChannelRenderer* channel_renderer; // Set when channel_threads is on and channels > 1
+} BatchWorker;
+
+struct BatchRenderer {
+    BatchConfig config;
+    BatchJob** queue;         // Ring of pending jobs
+    size_t queue_head;
+    size_t queue_count;
+    int closed;
+    int joined;
+    pthread_mutex_t lock;
+    pthread_cond_t not_empty;
+    pthread_cond_t not_full;
+    BatchWorker* workers;
+    int num_workers;
+};
+
+static double batch_now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+// Channel renderer functions
+
+static void* channel_thread_main(void* arg) {
+    ChannelThread* self = (ChannelThread*)arg;
+    ChannelRenderer* renderer = self->renderer;
+    
+    unsigned long seen = 0; // Generations start at 0, so a block posted before we wait is not missed
+    
+    pthread_mutex_lock(&renderer->lock);
+    
+    for (;;) {
+        while (renderer->generation == seen && !renderer->quit) {
+            pthread_cond_wait(&renderer->start, &renderer->lock);
+        }
+        if (renderer->quit) break;
+        
+        seen = renderer->generation;
+        sample_t* plane = renderer->planes[self->channel];
+        size_t frames = renderer->frames;
+        pthread_mutex_unlock(&renderer->lock);
+        
+        effect_chain_process_block(renderer->chains[self->channel], plane, plane, frames);
+        
+        pthread_mutex_lock(&renderer->lock);
+        if (--renderer->pending == 0) {
+            pthread_cond_signal(&renderer->done);
+        }
+    }
+    
+    pthread_mutex_unlock(&renderer->lock);
+    return NULL;
+}
+
+// Start one helper thread per extra channel
+ChannelRenderer* channel_renderer_create(EffectChain* const* chains, size_t channels) {
+    if (!chains || channels == 0 || channels > MAX_CHANNELS) return NULL;
+    
+    ChannelRenderer* renderer = audio_malloc(sizeof(ChannelRenderer));
+    if (!renderer) return NULL;
+    
+    memset(renderer, 0, sizeof(ChannelRenderer));
+    renderer->channels = channels;
+    for (size_t ch = 0; ch < channels; ch++) {
+        renderer->chains[ch] = chains[ch];
+    }
+    
+    pthread_mutex_init(&renderer->lock, NULL);
+    pthread_cond_init(&renderer->start, NULL);
+    pthread_cond_init(&renderer->done, NULL);
+    
+    for (size_t ch = 1; ch < channels; ch++) {
+        ChannelThread* thread = &renderer->threads[renderer->num_threads];
+        thread->renderer = renderer;
+        thread->channel = ch;
+        
+        if (pthread_create(&thread->thread, NULL, channel_thread_main, thread) != 0) {
+            audio_log(AUDIO_LOG_ERROR, "Could not start channel thread %zu", ch);
+            channel_renderer_destroy(renderer);
+            return NULL;
+        }
+        renderer->num_threads++;
+    }
+    
+    return renderer;
+}
+
+// Process the first frames of every plane, one channel per thread.
+// Interleaved buffers are processed on the calling thread instead.
+void channel_renderer_process(ChannelRenderer* renderer, AudioBuffer* buffer, size_t frames) {
+    if (!renderer || !buffer || !buffer->data || buffer->channels != renderer->channels) return;
+    
+    if (frames > buffer->length) frames = buffer->length;
+    
+    if (buffer->layout != AUDIO_LAYOUT_PLANAR) {
+        effect_chain_process_channels(renderer->chains, buffer);
+        return;
+    }
+    
+    // Hand the planes to the helpers, then do channel 0 here
+    pthread_mutex_lock(&renderer->lock);
+    for (size_t ch = 0; ch < renderer->channels; ch++) {
+        renderer->planes[ch] = buffer->planes[ch];
+    }
+    renderer->frames = frames;
+    renderer->pending = renderer->num_threads;
+    renderer->generation++;
+    pthread_cond_broadcast(&renderer->start);
+    pthread_mutex_unlock(&renderer->lock);
+    
+    effect_chain_process_block(renderer->chains[0], buffer->planes[0], buffer->planes[0], frames);
+    
+    pthread_mutex_lock(&renderer->lock);
+    while (renderer->pending > 0) {
+        pthread_cond_wait(&renderer->done, &renderer->lock);
+    }
+    pthread_mutex_unlock(&renderer->lock);
+}
+
+// Stop the helper threads (the chains are left to the caller)
+void channel_renderer_destroy(ChannelRenderer* renderer) {
+    if (!renderer) return;
+    
+    pthread_mutex_lock(&renderer->lock);
+    renderer->quit = 1;
+    pthread_cond_broadcast(&renderer->start);
+    pthread_mutex_unlock(&renderer->lock);
+    
+    for (size_t i = 0; i < renderer->num_threads; i++) {
+        pthread_join(renderer->threads[i].thread, NULL);
+    }
+    
+    pthread_mutex_destroy(&renderer->lock);
+    pthread_cond_destroy(&renderer->start);
+    pthread_cond_destroy(&renderer->done);
+    audio_free(renderer);
+}
+
+// Batch renderer functions
+
+// Take the next job, or NULL once the queue is closed and empty
+static BatchJob* batch_queue_pop(BatchRenderer* renderer) {
+    pthread_mutex_lock(&renderer->lock);
+    while (renderer->queue_count == 0 && !renderer->closed) {
+        pthread_cond_wait(&renderer->not_empty, &renderer->lock);
+    }
+    
+    BatchJob* job = NULL;
+    if (renderer->queue_count > 0) {
+        job = renderer->queue[renderer->queue_head];
+        renderer->queue_head = (renderer->queue_head + 1) % renderer->config.queue_depth;
+        renderer->queue_count--;
+        pthread_cond_signal(&renderer->not_full);
+    }
+    pthread_mutex_unlock(&renderer->lock);
+    
+    return job;
+}
+
+static void batch_worker_release_chains(BatchWorker* worker) {
+    channel_renderer_destroy(worker->channel_renderer);
+    worker->channel_renderer = NULL;
+    
+    for (size_t ch = 0; ch < worker->channels; ch++) {
+        effect_chain_destroy(worker->chains[ch]);
+        worker->chains[ch] = NULL;
+    }
+    audio_buffer_destroy(worker->block);
+    worker->block = NULL;
+    worker->channels = 0;
+}
+
+// Make sure the worker has chains for this stream shape
+static int batch_worker_prepare(BatchWorker* worker, size_t channels, size_t sample_rate) {
+    const BatchConfig* config = &worker->renderer->config;
+    
+    if (worker->channels == channels && worker->sample_rate == sample_rate) {
+        for (size_t ch = 0; ch < channels; ch++) {
+            effect_chain_reset(worker->chains[ch]);
+        }
+        return 1;
+    }
+    
+    batch_worker_release_chains(worker);
+    
+    // Channel threads work on planes; a single thread keeps the interleaved path
+    const int split = config->channel_threads && channels > 1;
+    if (split) {
+        worker->block = audio_buffer_create_planar(config->block_frames, channels, sample_rate);
+    } else {
+        worker->block = audio_buffer_create(config->block_frames, channels, sample_rate);
+    }
+    if (!worker->block) return 0;
+    
+    for (size_t ch = 0; ch < channels; ch++) {
+        worker->chains[ch] = config->factory(config->user, (float)sample_rate);
+        if (!worker->chains[ch]) {
+            worker->channels = ch;
+            batch_worker_release_chains(worker);
+            return 0;
+        }
+    }
+    worker->channels = channels;
+    worker->sample_rate = sample_rate;
+    
+    if (split) {
+        worker->channel_renderer = channel_renderer_create(worker->chains, channels);
+        if (!worker->channel_renderer) {
+            batch_worker_release_chains(worker);
+            return 0;
+        }
+    }
+    
+    return 1;
+}
+
+// Stream one file through the worker's chains
+static int batch_worker_render(BatchWorker* worker, BatchJob* job) {
+    WavReader* reader = wav_reader_open_mapped(job->input);
+    if (!reader) return 0;
+    
+    job->channels = reader->channels;
+    job->sample_rate = reader->sample_rate;
+    
+    if (reader->channels > MAX_CHANNELS) {
+        audio_log(AUDIO_LOG_ERROR, "%s has more than %d channels", job->input, MAX_CHANNELS);
+        wav_reader_close(reader);
+        return 0;
+    }
+    if (!batch_worker_prepare(worker, reader->channels, reader->sample_rate)) {
+        audio_log(AUDIO_LOG_ERROR, "Could not build effect chains for %s", job->input);
+        wav_reader_close(reader);
+        return 0;
+    }
+    
+    WavWriter* writer = wav_writer_open_format(job->output, reader->channels, reader->sample_rate,
+                                               reader->format.sample_format);
+    if (!writer) {
+        wav_reader_close(reader);
+        return 0;
+    }
+    
+    int ok = 1;
+    size_t frames;
+    while ((frames = wav_reader_read_buffer(reader, worker->block)) > 0) {
+        if (worker->channel_renderer) {
+            channel_renderer_process(worker->channel_renderer, worker->block, frames);
+        } else {
+            effect_chain_process_channels(worker->chains, worker->block);
+        }
+        if (wav_writer_write_buffer(writer, worker->block, frames) != frames) {
+            ok = 0;
+            break;
+        }
+        job->frames += frames;
+    }
+    
+    if (!wav_writer_close(writer)) ok = 0;
+    wav_reader_close(reader);
+    
+    return ok;
+}
+
+static void* batch_worker_main(void* arg) {
+    BatchWorker* worker = (BatchWorker*)arg;
+    BatchJob* job;
+    
+    while ((job = batch_queue_pop(worker->renderer)) != NULL) {
+        double start = batch_now();
+        
+        job->frames = 0;
+        job->worker = worker->index;
+        job->ok = batch_worker_render(worker, job);
+        job->seconds = batch_now() - start;
+    }
+    
+    batch_worker_release_chains(worker);
+    return NULL;
+}
+
+// Create a renderer and start its workers
+BatchRenderer* batch_renderer_create(const BatchConfig* config) {
+    if (!config || !config->factory) return NULL;
+    
+    BatchRenderer* renderer = audio_malloc(sizeof(BatchRenderer));
+    if (!renderer) return NULL;
+    
+    memset(renderer, 0, sizeof(BatchRenderer));
+    renderer->config = *config;
+    if (renderer->config.num_workers <= 0) renderer->config.num_workers = cpu_core_count();
+    if (renderer->config.num_workers > BATCH_MAX_WORKERS) renderer->config.num_workers = BATCH_MAX_WORKERS;
+    if (renderer->config.queue_depth == 0) renderer->config.queue_depth = BATCH_DEFAULT_QUEUE_DEPTH;
+    if (renderer->config.block_frames == 0) renderer->config.block_frames = BATCH_DEFAULT_BLOCK_FRAMES;
+    
+    renderer->queue = audio_calloc(renderer->config.queue_depth, sizeof(BatchJob*));
+    renderer->workers = audio_calloc((size_t)renderer->config.num_workers, sizeof(BatchWorker));
+    if (!renderer->queue || !renderer->workers) {
+        audio_free(renderer->queue);
+        audio_free(renderer->workers);
+        audio_free(renderer);
+        return NULL;
+    }
+    
+    pthread_mutex_init(&renderer->lock, NULL);
+    pthread_cond_init(&renderer->not_empty, NULL);
+    pthread_cond_init(&renderer->not_full, NULL);
+    
+    for (int i = 0; i < renderer->config.num_workers; i++) {
+        BatchWorker* worker = &renderer->workers[i];
+        worker->renderer = renderer;
+        worker->index = i;
+        
+        if (pthread_create(&worker->thread, NULL, batch_worker_main, worker) != 0) {
+            audio_log(AUDIO_LOG_ERROR, "Could not start batch worker %d", i);
+            break;
+        }
+        renderer->num_workers++;
+    }
+    
+    if (renderer->num_workers == 0) {
+        renderer->joined = 1;
+        batch_renderer_destroy(renderer);
+        return NULL;
+    }
+    
+    return renderer;
+}
+
+// Queue a job, waiting while the queue is full; returns 0 after finish
+int batch_renderer_submit(BatchRenderer* renderer, BatchJob* job) {
+    if (!renderer || !job) return 0;
+    
+    pthread_mutex_lock(&renderer->lock);
+    while (renderer->queue_count == renderer->config.queue_depth && !renderer->closed) {
+        pthread_cond_wait(&renderer->not_full, &renderer->lock);
+    }
+    
+    int accepted = !renderer->closed;
+    if (accepted) {
+        size_t tail = (renderer->queue_head + renderer->queue_count) % renderer->config.queue_depth;
+        renderer->queue[tail] = job;
+        renderer->queue_count++;
+        pthread_cond_signal(&renderer->not_empty);
+    }
+    pthread_mutex_unlock(&renderer->lock);
+    
+    return accepted;
+}
+
+// Close the queue, let the workers drain it and join them
+void batch_renderer_finish(BatchRenderer* renderer) {
+    if (!renderer || renderer->joined) return;
+    
+    pthread_mutex_lock(&renderer->lock);
+    renderer->closed = 1;
+    pthread_cond_broadcast(&renderer->not_empty);
+    pthread_cond_broadcast(&renderer->not_full);
+    pthread_mutex_unlock(&renderer->lock);
+    
+    for (int i = 0; i < renderer->num_workers; i++) {
+        pthread_join(renderer->workers[i].thread, NULL);
+    }
+    renderer->joined = 1;
+}
+
+// Destroy renderer
+void batch_renderer_destroy(BatchRenderer* renderer) {
+    if (!renderer) return;
+    
+    batch_renderer_finish(renderer);
+    
+    pthread_mutex_destroy(&renderer->lock);
+    pthread_cond_destroy(&renderer->not_empty);
+    pthread_cond_destroy(&renderer->not_full);
+    audio_free(renderer->queue);
+    audio_free(renderer->workers);
+    audio_free(renderer);
+}
+
+// Number of running workers
+int batch_renderer_workers(const BatchRenderer* renderer) {
+    return renderer ? renderer->num_workers : 0;
+}
+
+// Render a list of jobs; returns the number that succeeded
+size_t batch_render(const BatchConfig* config, BatchJob* jobs, size_t num_jobs) {
+    if (!jobs) return 0;
+    
+    BatchRenderer* renderer = batch_renderer_create(config);
+    if (!renderer) {
+        audio_log(AUDIO_LOG_ERROR, "Could not start batch renderer");
+        return 0;
+    }
+    
+    for (size_t i = 0; i < num_jobs; i++) {
+        jobs[i].ok = 0;
+        batch_renderer_submit(renderer, &jobs[i]);
+    }
+    batch_renderer_destroy(renderer);
+    
+    size_t succeeded = 0;
+    for (size_t i = 0; i < num_jobs; i++) {
+        if (jobs[i].ok) succeeded++;
+    }
+    
+    return succeeded;
+}
@@ -0,0 +1,399 @@
+#include "convolution.h"
+#include "wav_io.h"
+
+static int convolution_block_valid(size_t block) {
+    return block >= 2 && block <= CONVOLUTION_MAX_BLOCK && (block & (block - 1)) == 0;
+}
+
+// Free a segment's storage
+static void segment_free(ConvolutionSegment* segment) {
+    fft_plan_release(segment->plan);
+    audio_free(segment->ir_spectra);
+    audio_free(segment->fdl);
+    audio_free(segment->frame);
+    audio_free(segment->accum);
+    audio_free(segment->output);
+    memset(segment, 0, sizeof(*segment));
+}
+
+// Clear a segment's history
+static void segment_reset(ConvolutionSegment* segment) {
+    if (segment->partitions == 0) return;
+    
+    const size_t spectrum = 2 * segment->block;
+    memset(segment->fdl, 0, segment->partitions * spectrum * sizeof(float));
+    memset(segment->frame, 0, spectrum * sizeof(float));
+    memset(segment->accum, 0, spectrum * sizeof(float));
+    memset(segment->output, 0, spectrum * sizeof(float));
+    segment->fdl_pos = 0;
+    segment->fill = 0;
+    segment->next_partition = 1;
+}
+
+// Partition length samples of ir into blocks and transform them
+static int segment_init(ConvolutionSegment* segment, const float* ir, size_t length, size_t block) {
+    memset(segment, 0, sizeof(*segment));
+    if (length == 0) return 1;
+    
+    const size_t spectrum = 2 * block;
+    segment->block = block;
+    segment->partitions = (length + block - 1) / block;
+    segment->plan = fft_plan_acquire(spectrum);
+    segment->ir_spectra = audio_malloc(segment->partitions * spectrum * sizeof(float));
+    segment->fdl = audio_malloc(segment->partitions * spectrum * sizeof(float));
+    segment->frame = audio_malloc(spectrum * sizeof(float));
+    segment->accum = audio_malloc(spectrum * sizeof(float));
+    segment->output = audio_malloc(spectrum * sizeof(float));
+    if (!segment->plan || !segment->ir_spectra || !segment->fdl || !segment->frame || !segment->accum ||
+        !segment->output) {
+        segment_free(segment);
+        return 0;
+    }
+    
+    // Each partition is zero-padded to two blocks; the inverse transform's
+    // factor of 2 * block is folded into the spectra
+    const float scale = 1.0f / (float)spectrum;
+    for (size_t p = 0; p < segment->partitions; p++) {
+        const size_t start = p * block;
+        const size_t count = (length - start < block) ? length - start : block;
+        memset(segment->frame, 0, spectrum * sizeof(float));
+        for (size_t i = 0; i < count; i++) {
+            segment->frame[i] = ir[start + i] * scale;
+        }
+        fft_real_forward(segment->plan, segment->frame, segment->ir_spectra + p * spectrum);
+    }
+    
+    segment_reset(segment);
+    return 1;
+}
+
+// Sum partitions [first, last) of the IR against the delay line, where
+// partition p meets the input spectrum p blocks older than slot newest
+static void segment_accumulate(ConvolutionSegment* segment, size_t newest, size_t first, size_t last) {
+    const size_t spectrum = 2 * segment->block;
+    const size_t partitions = segment->partitions;
+    size_t slot = (newest + first) % partitions;
+    
+    for (size_t p = first; p < last; p++) {
+        fft_spectrum_mac(segment->plan, segment->fdl + slot * spectrum, segment->ir_spectra + p * spectrum,
+                         segment->accum);
+        if (++slot == partitions) slot = 0;
+    }
+}
+
+// Transform the frame into a new delay line slot, finish the sum and
+// transform it back; output[block..2 * block) is then the new output block
+static void segment_convolve(ConvolutionSegment* segment) {
+    const size_t block = segment->block;
+    const size_t spectrum = 2 * block;
+    
+    segment->fdl_pos = (segment->fdl_pos + segment->partitions - 1) % segment->partitions;
+    fft_real_forward(segment->plan, segment->frame, segment->fdl + segment->fdl_pos * spectrum);
+    
+    segment_accumulate(segment, segment->fdl_pos, 0, 1);
+    segment_accumulate(segment, segment->fdl_pos, segment->next_partition, segment->partitions);
+    fft_real_inverse(segment->plan, segment->accum, segment->output);
+    
+    memset(segment->accum, 0, spectrum * sizeof(float));
+    memcpy(segment->frame, segment->frame + block, block * sizeof(float));
+    segment->next_partition = 1;
+}
+
+// Head: one full block per call
+static const float* segment_process_head(ConvolutionSegment* segment, const float* in) {
+    memcpy(segment->frame + segment->block, in, segment->block * sizeof(float));
+    segment_convolve(segment);
+    return segment->output + segment->block;
+}
+
+// Tail: append one head block; on the tail block boundary convolve and
+// return nonzero, otherwise add the next slice of older partitions
+static int segment_process_tail(ConvolutionSegment* segment, const float* in, size_t count, size_t ticks) {
+    memcpy(segment->frame + segment->block + segment->fill, in, count * sizeof(float));
+    segment->fill += count;
+    
+    if (segment->fill == segment->block) {
+        segment->fill = 0;
+        segment_convolve(segment);
+        return 1;
+    }
+    
+    // Partitions p >= 1 of the next block use spectra that already exist:
+    // the next newest slot is one before the current one
+    const size_t slice = (segment->partitions - 1 + ticks - 2) / (ticks - 1);
+    size_t last = segment->next_partition + slice;
+    if (last > segment->partitions) last = segment->partitions;
+    if (segment->next_partition < last) {
+        const size_t newest = (segment->fdl_pos + segment->partitions - 1) % segment->partitions;
+        segment_accumulate(segment, newest, segment->next_partition, last);
+        segment->next_partition = last;
+    }
+    return 0;
+}
+
+// Create a convolution reverb for length samples of ir
+ConvolutionReverb* convolution_reverb_create(const float* ir, size_t length, size_t head_block, size_t tail_block,
+                                             float sample_rate) {
+    if (!ir || length == 0 || !convolution_block_valid(head_block)) return NULL;
+    if (tail_block && (!convolution_block_valid(tail_block) || tail_block <= head_block)) return NULL;
+    
+    ConvolutionReverb* reverb = audio_calloc(1, sizeof(ConvolutionReverb));
+    if (!reverb) return NULL;
+    
+    // The head covers the IR up to where the tail's own latency ends
+    size_t head_length = length;
+    if (tail_block && length > tail_block - head_block) {
+        head_length = tail_block - head_block;
+    }
+    
+    reverb->block = head_block;
+    reverb->ticks = tail_block ? tail_block / head_block : 1;
+    reverb->ir_length = length;
+    reverb->input = audio_calloc(head_block, sizeof(float));
+    reverb->output = audio_calloc(head_block, sizeof(float));
+    if (!reverb->input || !reverb->output || !segment_init(&reverb->head, ir, head_length, head_block) ||
+        !segment_init(&reverb->tail, ir + head_length, length - head_length, tail_block)) {
+        convolution_reverb_destroy(reverb);
+        return NULL;
+    }
+    
+    reverb->wet_level = 0.3f;
+    reverb->dry_level = 0.7f;
+    param_smoother_init(&reverb->wet_smoother, reverb->wet_level, PARAM_SMOOTH_DEFAULT_MS, sample_rate,
+                        PARAM_SMOOTH_LINEAR);
+    
+    return reverb;
+}
+
+// Load the IR from a WAV file, resampled linearly when its rate differs
+ConvolutionReverb* convolution_reverb_load(const char* filename, int channel, size_t head_block, size_t tail_block,
+                                           float sample_rate) {
+    if (!filename || sample_rate <= 0.0f) return NULL;
+    
+    WavReader* reader = wav_reader_open(filename);
+    if (!reader) return NULL;
+    
+    const size_t channels = reader->channels;
+    const size_t frames = reader->total_frames;
+    if (frames == 0 || channel >= (int)channels) {
+        if (frames) audio_log(AUDIO_LOG_ERROR, "%s has no channel %d", filename, channel);
+        wav_reader_close(reader);
+        return NULL;
+    }
+    
+    float* ir = audio_malloc(frames * sizeof(float));
+    if (!ir) {
+        wav_reader_close(reader);
+        return NULL;
+    }
+    
+    sample_t block[AUDIO_CHANNEL_CHUNK * MAX_CHANNELS];
+    const size_t chunk = AUDIO_CHANNEL_CHUNK * MAX_CHANNELS / channels;
+    size_t length = 0;
+    size_t got;
+    while (length < frames && (got = wav_reader_read(reader, block, chunk)) > 0) {
+        for (size_t i = 0; i < got; i++) {
+            if (channel >= 0) {
+                ir[length + i] = block[i * channels + channel];
+            } else {
+                float sum = 0.0f;
+                for (size_t ch = 0; ch < channels; ch++) {
+                    sum += block[i * channels + ch];
+                }
+                ir[length + i] = sum / channels;
+            }
+        }
+        length += got;
+    }
+    const float file_rate = (float)reader->sample_rate;
+    wav_reader_close(reader);
+    
+    ConvolutionReverb* reverb = NULL;
+    if (length > 0 && file_rate != sample_rate) {
+        const double step = (double)file_rate / sample_rate;
+        const size_t resampled_length = (size_t)((length - 1) / step) + 1;
+        float* resampled = audio_malloc(resampled_length * sizeof(float));
+        if (resampled) {
+            for (size_t i = 0; i < resampled_length; i++) {
+                double pos = i * step;
+                size_t index = (size_t)pos;
+                float frac = (float)(pos - index);
+                float next = index + 1 < length ? ir[index + 1] : 0.0f;
+                resampled[i] = ir[index] + frac * (next - ir[index]);
+            }
+            reverb = convolution_reverb_create(resampled, resampled_length, head_block, tail_block, sample_rate);
+            audio_free(resampled);
+        }
+    } else if (length > 0) {
+        reverb = convolution_reverb_create(ir, length, head_block, tail_block, sample_rate);
+    }
+    
+    audio_free(ir);
+    return reverb;
+}
+
+// Destroy convolution reverb
+void convolution_reverb_destroy(ConvolutionReverb* reverb) {
+    if (reverb) {
+        segment_free(&reverb->head);
+        segment_free(&reverb->tail);
+        audio_free(reverb->input);
+        audio_free(reverb->output);
+        audio_free(reverb);
+    }
+}
+
+// Set convolution reverb parameters
+void convolution_reverb_set_params(ConvolutionReverb* reverb, float wet_level) {
+    if (!reverb) return;
+    
+    reverb->wet_level = clamp(wet_level, 0.0f, 1.0f);
+    reverb->dry_level = 1.0f - reverb->wet_level;
+    param_smoother_set_target(&reverb->wet_smoother, reverb->wet_level);
+}
+
+// Delay of the output (dry and wet) in samples
+size_t convolution_reverb_latency(const ConvolutionReverb* reverb) {
+    return reverb ? reverb->block : 0;
+}
+
+// Convolve the collected head block and mix it with the dry block
+static void convolution_reverb_run_block(ConvolutionReverb* reverb) {
+    const size_t block = reverb->block;
+    const float* wet = segment_process_head(&reverb->head, reverb->input);
+    float* out = reverb->output;
+    
+    if (reverb->tail.partitions) {
+        if (segment_process_tail(&reverb->tail, reverb->input, block, reverb->ticks)) {
+            reverb->tick = 0;
+        } else {
+            reverb->tick++;
+        }
+        const float* tail = reverb->tail.output + reverb->tail.block + reverb->tick * block;
+        for (size_t i = 0; i < block; i++) {
+            out[i] = wet[i] + tail[i];
+        }
+        wet = out;
+    }
+    
+    if (param_smoother_active(&reverb->wet_smoother)) {
+        for (size_t i = 0; i < block; i++) {
+            const float level = param_smoother_next(&reverb->wet_smoother);
+            out[i] = reverb->input[i] * (1.0f - level) + wet[i] * level;
+        }
+    } else {
+        const float level = reverb->wet_smoother.current;
+        const float dry = 1.0f - level;
+        for (size_t i = 0; i < block; i++) {
+            out[i] = reverb->input[i] * dry + wet[i] * level;
+        }
+    }
+}
+
+// Process one sample through convolution reverb
+sample_t convolution_reverb_process(ConvolutionReverb* reverb, sample_t input) {
+    sample_t output = input;
+    convolution_reverb_process_block(reverb, &input, &output, 1);
+    return output;
+}
+
+// Process a block through convolution reverb (in and out may be the same
+// buffer). Input is collected into head blocks; each full block is
+// convolved and played out during the next one.
+void convolution_reverb_process_block(ConvolutionReverb* reverb, const sample_t* in, sample_t* out, size_t n) {
+    if (!reverb) {
+        audio_block_bypass(in, out, n);
+        return;
+    }
+    if (!in || !out) return;
+    
+    param_smoother_update(&reverb->wet_smoother);
+    
+    const size_t block = reverb->block;
+    size_t pos = 0;
+    while (pos < n) {
+        size_t count = block - reverb->fifo_pos;
+        if (count > n - pos) count = n - pos;
+        
+        memcpy(reverb->input + reverb->fifo_pos, in + pos, count * sizeof(sample_t));
+        memcpy(out + pos, reverb->output + reverb->fifo_pos, count * sizeof(sample_t));
+        reverb->fifo_pos += count;
+        pos += count;
+        
+        if (reverb->fifo_pos == block) {
+            convolution_reverb_run_block(reverb);
+            reverb->fifo_pos = 0;
+        }
+    }
+}
+
+// Process buffer through convolution reverb
+void convolution_reverb_process_buffer(ConvolutionReverb* reverb, AudioBuffer* buffer) {
+    if (!reverb || !buffer || !buffer->data) return;
+    
+    convolution_reverb_process_block(reverb, buffer->data, buffer->data, buffer->capacity);
+}
+
+// Block adapter used for per-channel processing
+static void convolution_reverb_channel_block(void* effect, const sample_t* in, sample_t* out, size_t n) {
+    convolution_reverb_process_block((ConvolutionReverb*)effect, in, out, n);
+}
+
+// Process each channel of an interleaved buffer with its own convolution reverb instance
+void convolution_reverb_process_channels(ConvolutionReverb** reverbs, AudioBuffer* buffer) {
+    if (!reverbs || !buffer || !buffer->data || buffer->channels > MAX_CHANNELS) return;
+    
+    void* instances[MAX_CHANNELS];
+    for (size_t ch = 0; ch < buffer->channels; ch++) {
+        instances[ch] = reverbs[ch];
+    }
+    audio_buffer_process_channels(buffer, convolution_reverb_channel_block, instances);
+}
+
+// Clear convolution reverb history (the IR and parameters are kept)
+void convolution_reverb_reset(ConvolutionReverb* reverb) {
+    if (!reverb) return;
+    
+    segment_reset(&reverb->head);
+    segment_reset(&reverb->tail);
+    memset(reverb->input, 0, reverb->block * sizeof(float));
+    memset(reverb->output, 0, reverb->block * sizeof(float));
+    reverb->fifo_pos = 0;
+    reverb->tick = 0;
+    param_smoother_snap(&reverb->wet_smoother);
+}
+
+// Effect interface adapters
+static void convolution_reverb_effect_reset(void* effect) {
+    convolution_reverb_reset((ConvolutionReverb*)effect);
+}
+
+static int convolution_reverb_effect_set_param(void* effect, int param, float value) {
+    if (param != 0) return 0;
+    
+    convolution_reverb_set_params((ConvolutionReverb*)effect, value);
+    return 1;
+}
+
+static size_t convolution_reverb_effect_latency(const void* effect) {
+    return convolution_reverb_latency((const ConvolutionReverb*)effect);
+}
+
+static void convolution_reverb_effect_destroy(void* effect) {
+    convolution_reverb_destroy((ConvolutionReverb*)effect);
+}
+
+static const EffectVTable convolution_reverb_vtable = {
+    .name = "convolution reverb",
+    .process_block = convolution_reverb_channel_block,
+    .reset = convolution_reverb_effect_reset,
+    .set_param = convolution_reverb_effect_set_param,
+    .latency = convolution_reverb_effect_latency,
+    .destroy = convolution_reverb_effect_destroy
+};
+
+// Wrap in the effect interface (params: wet_level)
+Effect convolution_reverb_effect(ConvolutionReverb* reverb) {
+    Effect effect = { &convolution_reverb_vtable, reverb };
+    return effect;
+}
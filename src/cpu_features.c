@@ -0,0 +1,77 @@
+#define _POSIX_C_SOURCE 200112L // sysconf
+#include "cpu_features.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <unistd.h>
+#endif
+
+static CpuFeatures features;
+static int features_detected = 0;
+static SimdLevel level_cap = SIMD_LEVEL_AVX2;
+
+// Probe the running CPU once
+static void cpu_detect(void) {
+    CpuFeatures f = {0, 0, 0, 0, 0, 0};
+    
+#if defined(AUDIO_X86_DISPATCH)
+    __builtin_cpu_init();
+    f.sse2 = __builtin_cpu_supports("sse2") != 0;
+    f.sse41 = __builtin_cpu_supports("sse4.1") != 0;
+    f.avx = __builtin_cpu_supports("avx") != 0;
+    f.avx2 = __builtin_cpu_supports("avx2") != 0;
+    f.fma = __builtin_cpu_supports("fma") != 0;
+#elif defined(__SSE2__) || defined(_M_X64)
+    f.sse2 = 1;
+#endif
+#if defined(__ARM_NEON)
+    f.neon = 1;
+#endif
+    
+    features = f;
+    features_detected = 1;
+}
+
+// Get the detected CPU features
+const CpuFeatures* cpu_get_features(void) {
+    if (!features_detected) {
+        cpu_detect();
+    }
+    return &features;
+}
+
+// Highest SIMD level usable on this CPU (respecting any cap)
+SimdLevel cpu_simd_level(void) {
+    const CpuFeatures* f = cpu_get_features();
+    SimdLevel level = SIMD_LEVEL_SCALAR;
+    
+    if (f->neon) level = SIMD_LEVEL_NEON;
+    if (f->sse2) level = SIMD_LEVEL_SSE2;
+    if (f->avx2 && f->fma) level = SIMD_LEVEL_AVX2;
+    
+    return (level > level_cap) ? level_cap : level;
+}
+
+// Limit the SIMD level used by kernels selected after this call
+void cpu_set_simd_level(SimdLevel level) {
+    level_cap = level;
+}
+
+// Human-readable level name
+const char* cpu_simd_level_name(SimdLevel level) {
+    switch (level) {
+        case SIMD_LEVEL_AVX2: return "AVX2";
+        case SIMD_LEVEL_NEON: return "NEON";
+        case SIMD_LEVEL_SSE2: return "SSE2";
+        case SIMD_LEVEL_SCALAR:
+        default: return "scalar";
+    }
+}
+
+// Number of online cores (1 when it cannot be determined)
+int cpu_core_count(void) {
+#if defined(_SC_NPROCESSORS_ONLN)
+    long count = sysconf(_SC_NPROCESSORS_ONLN);
+    if (count > 0) return (int)count;
+#endif
+    return 1;
+}
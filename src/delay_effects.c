@@ -1,14 +1,30 @@
+#define _POSIX_C_SOURCE 200112L // pthreads
 #include "delay_effects.h"
+#include "cpu_features.h"
+
+#include <pthread.h>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define DELAY_SSE 1
+#endif
 
 // Create a delay line
 DelayLine* delay_line_create(size_t max_delay_samples) {
-    DelayLine* delay = malloc(sizeof(DelayLine));
+    DelayLine* delay = audio_malloc(sizeof(DelayLine));
     if (!delay) return NULL;
     
     delay->size = max_delay_samples + 1; // +1 for interpolation safety
-    delay->buffer = calloc(delay->size, sizeof(sample_t));
+    
+    // Round the ring up to a power of two so positions wrap with a mask
+    size_t capacity = 1;
+    while (capacity < delay->size) {
+        capacity <<= 1;
+    }
+    delay->mask = capacity - 1;
+    delay->buffer = audio_calloc(capacity, sizeof(sample_t));
     if (!delay->buffer) {
-        free(delay);
+        audio_free(delay);
         return NULL;
     }
     
@@ -22,9 +38,9 @@ DelayLine* delay_line_create(size_t max_delay_samples) {
 void delay_line_destroy(DelayLine* delay) {
     if (delay) {
         if (delay->buffer) {
-            free(delay->buffer);
+            audio_free(delay->buffer);
         }
-        free(delay);
+        audio_free(delay);
     }
 }
 
@@ -32,45 +48,427 @@ void delay_line_destroy(DelayLine* delay) {
 void delay_line_write(DelayLine* delay, sample_t sample) {
     if (!delay || !delay->buffer) return;
     
-    delay->buffer[delay->write_pos] = sample;
-    delay->write_pos = (delay->write_pos + 1) % delay->size;
+    delay_line_push(delay, sample);
 }
 
 // Read sample from delay line
 sample_t delay_line_read(DelayLine* delay, size_t delay_samples) {
     if (!delay || !delay->buffer || delay_samples >= delay->size) return 0.0f;
     
-    size_t read_pos = (delay->write_pos - delay_samples + delay->size) % delay->size;
-    return delay->buffer[read_pos];
+    return delay_line_tap(delay, delay_samples);
 }
 
 // Read sample with linear interpolation for fractional delays
 sample_t delay_line_read_interpolated(DelayLine* delay, float delay_samples) {
     if (!delay || !delay->buffer) return 0.0f;
     
-    size_t delay_int = (size_t)delay_samples;
-    float delay_frac = delay_samples - delay_int;
-    
-    if (delay_int >= delay->size - 1) return 0.0f;
-    
-    size_t pos1 = (delay->write_pos - delay_int + delay->size) % delay->size;
-    size_t pos2 = (pos1 - 1 + delay->size) % delay->size;
-    
-    return lerp(delay->buffer[pos1], delay->buffer[pos2], delay_frac);
+    return delay_line_tap_interpolated(delay, delay_samples);
 }
 
 // Clear delay line
 void delay_line_clear(DelayLine* delay) {
     if (delay && delay->buffer) {
-        memset(delay->buffer, 0, delay->size * sizeof(sample_t));
+        memset(delay->buffer, 0, (delay->mask + 1) * sizeof(sample_t));
         delay->write_pos = 0;
         delay->read_pos = 0;
     }
 }
 
+// Write a block of samples, advancing the write position
+void delay_line_write_block(DelayLine* delay, const sample_t* in, size_t n) {
+    if (!delay || !delay->buffer || !in) return;
+    
+    const size_t capacity = delay->mask + 1;
+    
+    // Only the newest capacity samples survive a long write
+    if (n > capacity) {
+        delay->write_pos = (delay->write_pos + (n - capacity)) & delay->mask;
+        in += n - capacity;
+        n = capacity;
+    }
+    
+    size_t first = capacity - delay->write_pos;
+    if (first > n) first = n;
+    
+    memcpy(delay->buffer + delay->write_pos, in, first * sizeof(sample_t));
+    memcpy(delay->buffer, in + first, (n - first) * sizeof(sample_t));
+    delay->write_pos = (delay->write_pos + n) & delay->mask;
+}
+
+// Read a block of n consecutive samples starting delay_samples back
+void delay_line_read_block(const DelayLine* delay, size_t delay_samples, sample_t* out, size_t n) {
+    if (!delay || !delay->buffer || !out) return;
+    
+    const size_t capacity = delay->mask + 1;
+    if (n > capacity) n = capacity;
+    
+    size_t start = (delay->write_pos - delay_samples) & delay->mask;
+    size_t first = capacity - start;
+    if (first > n) first = n;
+    
+    memcpy(out, delay->buffer + start, first * sizeof(sample_t));
+    memcpy(out + first, delay->buffer, (n - first) * sizeof(sample_t));
+}
+
+// Fractional delay interpolation
+
+#define SINC_TAPS 8
+#define SINC_PHASES 128
+
+// Windowed-sinc coefficients for fractions 0..1 in SINC_PHASES steps, built
+// once by the first delay_interp_init that asks for the sinc; pthread_once
+// lets effects be created on several threads and publishes the finished table
+static float sinc_table[SINC_PHASES + 1][SINC_TAPS];
+static pthread_once_t sinc_table_once = PTHREAD_ONCE_INIT;
+
+static void sinc_table_build(void) {
+    for (int phase = 0; phase <= SINC_PHASES; phase++) {
+        double frac = (double)phase / SINC_PHASES;
+        double sum = 0.0;
+        double taps[SINC_TAPS];
+        
+        // Taps are stored oldest first; tap k sits 4 - k samples older
+        // than the integer delay
+        for (int k = 0; k < SINC_TAPS; k++) {
+            double t = (4 - k) - frac;
+            double x = PI * t;
+            double sinc = fabs(t) < 1e-9 ? 1.0 : sin(x) / x;
+            double window = 0.42 + 0.5 * cos(x / 4.0) + 0.08 * cos(x / 2.0);
+            taps[k] = fabs(t) < 4.0 ? sinc * window : 0.0;
+            sum += taps[k];
+        }
+        for (int k = 0; k < SINC_TAPS; k++) {
+            sinc_table[phase][k] = (float)(taps[k] / sum); // Unity gain at DC
+        }
+    }
+}
+
+// Set up an interpolator (not real-time safe the first time the sinc is used)
+void delay_interp_init(DelayInterpolator* interp, DelayInterpolation mode) {
+    if (!interp) return;
+    
+    interp->mode = mode;
+    interp->allpass_state = 0.0f;
+    if (mode == DELAY_INTERP_SINC) {
+        pthread_once(&sinc_table_once, sinc_table_build);
+    }
+}
+
+// Clear interpolator state
+void delay_interp_reset(DelayInterpolator* interp) {
+    if (interp) {
+        interp->allpass_state = 0.0f;
+    }
+}
+
+// Taps newer (lead) and older (tail) than the interpolated pair
+static void delay_interp_reach(DelayInterpolation mode, size_t* lead, size_t* tail) {
+    switch (mode) {
+        case DELAY_INTERP_LAGRANGE3:
+        case DELAY_INTERP_HERMITE4: *lead = 1; *tail = 1; break;
+        case DELAY_INTERP_ALLPASS: *lead = 1; *tail = 0; break;
+        case DELAY_INTERP_SINC: *lead = 3; *tail = 3; break;
+        case DELAY_INTERP_LINEAR:
+        default: *lead = 0; *tail = 0; break;
+    }
+}
+
+#define DELAY_READ_CHUNK 64
+
+// Clamp a chunk of delays and split them into the ring index of the
+// integer delay and the fraction; stops at the first unreadable sample.
+// offset is the number of pushes that precede the chunk. Indexes are
+// 32-bit, which bounds delay lines to 2^31 samples.
+static size_t delay_read_positions(const DelayLine* delay, const float* delays, size_t offset, size_t n,
+                                   size_t lead, size_t tail, uint32_t* base, float* frac) {
+    const float min_delay = (float)(lead + 1);
+    const float max_delay = (float)(delay->size - 2 - tail);
+    const uint32_t start = (uint32_t)(delay->write_pos + offset);
+    const uint32_t mask = (uint32_t)delay->mask;
+    size_t i = 0;
+    
+#if defined(DELAY_SSE)
+    if (cpu_simd_level() >= SIMD_LEVEL_SSE2) {
+        const __m128 low = _mm_set1_ps(min_delay);
+        const __m128 high = _mm_set1_ps(max_delay);
+        const __m128i lanes = _mm_setr_epi32(0, 1, 2, 3);
+        const __m128i reach = _mm_set1_epi32((int32_t)lead);
+        const __m128i wrap = _mm_set1_epi32((int32_t)mask);
+        
+        for (; i + 4 <= n; i += 4) {
+            __m128 d = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(delays + i), low), high);
+            __m128i whole = _mm_cvttps_epi32(d);
+            __m128i step = _mm_add_epi32(_mm_set1_epi32((int32_t)(offset + i)), lanes);
+            
+            // The newest tap of every lane must already be written
+            __m128i ready = _mm_cmpgt_epi32(_mm_sub_epi32(whole, reach), step);
+            if (_mm_movemask_ps(_mm_castsi128_ps(ready)) != 0xF) break;
+            
+            __m128i position = _mm_sub_epi32(_mm_add_epi32(_mm_set1_epi32((int32_t)(start + i)), lanes), whole);
+            _mm_storeu_si128((__m128i*)(base + i), _mm_and_si128(position, wrap));
+            _mm_storeu_ps(frac + i, _mm_sub_ps(d, _mm_cvtepi32_ps(whole)));
+        }
+    }
+#endif
+    for (; i < n; i++) {
+        float d = delays[i];
+        d = d < min_delay ? min_delay : (d > max_delay ? max_delay : d);
+        int32_t whole = (int32_t)d;
+        
+        // The newest tap must already be written
+        if ((size_t)whole - lead <= offset + i) return i;
+        
+        base[i] = (start + (uint32_t)i - (uint32_t)whole) & mask;
+        frac[i] = d - (float)whole;
+    }
+    return n;
+}
+
+// Interpolation kernels. x(k) is the sample k positions older than the
+// integer delay, so x(-1) is the newer neighbour.
+#define TAP(k) buffer[(base[i] - (uint32_t)(k)) & mask]
+
+static void delay_read_linear(const sample_t* buffer, uint32_t mask, const uint32_t* base, const float* frac,
+                              sample_t* out, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        float x0 = TAP(0);
+        out[i] = x0 + frac[i] * (TAP(1) - x0);
+    }
+}
+
+static void delay_read_lagrange3(const sample_t* buffer, uint32_t mask, const uint32_t* base, const float* frac,
+                                 sample_t* out, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        float f = frac[i];
+        float a = f * (f - 1.0f) * (1.0f / 6.0f);   // Shared factors of the four weights
+        float b = (f + 1.0f) * (f - 2.0f) * 0.5f;
+        out[i] = a * ((f + 1.0f) * TAP(2) - (f - 2.0f) * TAP(-1)) + b * ((f - 1.0f) * TAP(0) - f * TAP(1));
+    }
+}
+
+static void delay_read_hermite4(const sample_t* buffer, uint32_t mask, const uint32_t* base, const float* frac,
+                                sample_t* out, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        float xm1 = TAP(-1), x0 = TAP(0), x1 = TAP(1), x2 = TAP(2);
+        float c1 = 0.5f * (x1 - xm1);
+        float c2 = xm1 - 2.5f * x0 + 2.0f * x1 - 0.5f * x2;
+        float c3 = 0.5f * (x2 - xm1) + 1.5f * (x0 - x1);
+        out[i] = ((c3 * frac[i] + c2) * frac[i] + c1) * frac[i] + x0;
+    }
+}
+
+// The fraction is kept in [0.5, 1.5) so the pole stays clear of -1
+static void delay_read_allpass(const sample_t* buffer, uint32_t mask, const uint32_t* base, const float* frac,
+                               sample_t* out, size_t n, float* state) {
+    float y = *state;
+    
+    for (size_t i = 0; i < n; i++) {
+        float f = frac[i];
+        float xa = TAP(0), xb = TAP(1);
+        if (f < 0.5f) {
+            xb = xa;
+            xa = TAP(-1);
+            f += 1.0f;
+        }
+        float eta = (1.0f - f) / (1.0f + f);
+        y = eta * (xa - y) + xb;
+        out[i] = y;
+    }
+    *state = y;
+}
+
+static void delay_read_sinc(const sample_t* buffer, uint32_t mask, const uint32_t* base, const float* frac,
+                            sample_t* out, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        float position = frac[i] * SINC_PHASES;
+        int phase = (int)position;
+        float blend = position - (float)phase;
+        const float* h0 = sinc_table[phase];
+        const float* h1 = sinc_table[phase < SINC_PHASES ? phase + 1 : phase];
+        
+        float acc = 0.0f;
+        for (int k = 0; k < SINC_TAPS; k++) {
+            acc += (h0[k] + blend * (h1[k] - h0[k])) * TAP(4 - k);
+        }
+        out[i] = acc;
+    }
+}
+
+#if defined(DELAY_SSE)
+// SSE kernels work on four reads at a time and return how many they did;
+// the scalar kernels finish the rest. Taps are gathered lane by lane.
+static inline __m128 delay_gather(const sample_t* buffer, uint32_t mask, const uint32_t* base, int k) {
+    return _mm_setr_ps(buffer[(base[0] - (uint32_t)k) & mask], buffer[(base[1] - (uint32_t)k) & mask],
+                       buffer[(base[2] - (uint32_t)k) & mask], buffer[(base[3] - (uint32_t)k) & mask]);
+}
+
+static size_t delay_read_linear_sse(const sample_t* buffer, uint32_t mask, const uint32_t* base, const float* frac,
+                                    sample_t* out, size_t n) {
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128 x0 = delay_gather(buffer, mask, base + i, 0);
+        __m128 x1 = delay_gather(buffer, mask, base + i, 1);
+        _mm_storeu_ps(out + i, _mm_add_ps(x0, _mm_mul_ps(_mm_loadu_ps(frac + i), _mm_sub_ps(x1, x0))));
+    }
+    return i;
+}
+
+static size_t delay_read_lagrange3_sse(const sample_t* buffer, uint32_t mask, const uint32_t* base,
+                                       const float* frac, sample_t* out, size_t n) {
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 two = _mm_set1_ps(2.0f);
+    size_t i = 0;
+    
+    for (; i + 4 <= n; i += 4) {
+        __m128 f = _mm_loadu_ps(frac + i);
+        __m128 fp1 = _mm_add_ps(f, one);
+        __m128 fm1 = _mm_sub_ps(f, one);
+        __m128 fm2 = _mm_sub_ps(f, two);
+        __m128 a = _mm_mul_ps(_mm_mul_ps(f, fm1), _mm_set1_ps(1.0f / 6.0f));
+        __m128 b = _mm_mul_ps(_mm_mul_ps(fp1, fm2), _mm_set1_ps(0.5f));
+        
+        __m128 outer = _mm_sub_ps(_mm_mul_ps(fp1, delay_gather(buffer, mask, base + i, 2)),
+                                  _mm_mul_ps(fm2, delay_gather(buffer, mask, base + i, -1)));
+        __m128 inner = _mm_sub_ps(_mm_mul_ps(fm1, delay_gather(buffer, mask, base + i, 0)),
+                                  _mm_mul_ps(f, delay_gather(buffer, mask, base + i, 1)));
+        _mm_storeu_ps(out + i, _mm_add_ps(_mm_mul_ps(a, outer), _mm_mul_ps(b, inner)));
+    }
+    return i;
+}
+
+static size_t delay_read_hermite4_sse(const sample_t* buffer, uint32_t mask, const uint32_t* base,
+                                      const float* frac, sample_t* out, size_t n) {
+    const __m128 half = _mm_set1_ps(0.5f);
+    size_t i = 0;
+    
+    for (; i + 4 <= n; i += 4) {
+        __m128 xm1 = delay_gather(buffer, mask, base + i, -1);
+        __m128 x0 = delay_gather(buffer, mask, base + i, 0);
+        __m128 x1 = delay_gather(buffer, mask, base + i, 1);
+        __m128 x2 = delay_gather(buffer, mask, base + i, 2);
+        __m128 f = _mm_loadu_ps(frac + i);
+        
+        __m128 c1 = _mm_mul_ps(half, _mm_sub_ps(x1, xm1));
+        __m128 c2 = _mm_sub_ps(_mm_add_ps(xm1, _mm_add_ps(x1, x1)),
+                               _mm_add_ps(_mm_mul_ps(_mm_set1_ps(2.5f), x0), _mm_mul_ps(half, x2)));
+        __m128 c3 = _mm_add_ps(_mm_mul_ps(half, _mm_sub_ps(x2, xm1)),
+                               _mm_mul_ps(_mm_set1_ps(1.5f), _mm_sub_ps(x0, x1)));
+        __m128 y = _mm_add_ps(_mm_mul_ps(c3, f), c2);
+        y = _mm_add_ps(_mm_mul_ps(y, f), c1);
+        _mm_storeu_ps(out + i, _mm_add_ps(_mm_mul_ps(y, f), x0));
+    }
+    return i;
+}
+
+// One read per step, vectorised across the taps; reads whose taps wrap
+// around the end of the ring are left to the scalar kernel
+static size_t delay_read_sinc_sse(const sample_t* buffer, uint32_t mask, const uint32_t* base, const float* frac,
+                                  sample_t* out, size_t n) {
+    size_t i = 0;
+    for (; i < n; i++) {
+        uint32_t first = (base[i] - 4u) & mask;
+        if (first + SINC_TAPS > mask + 1u) break;
+        
+        float position = frac[i] * SINC_PHASES;
+        int phase = (int)position;
+        const __m128 blend = _mm_set1_ps(position - (float)phase);
+        const float* h0 = sinc_table[phase];
+        const float* h1 = sinc_table[phase < SINC_PHASES ? phase + 1 : phase];
+        
+        __m128 lo = _mm_loadu_ps(h0);
+        __m128 hi = _mm_loadu_ps(h0 + 4);
+        lo = _mm_add_ps(lo, _mm_mul_ps(blend, _mm_sub_ps(_mm_loadu_ps(h1), lo)));
+        hi = _mm_add_ps(hi, _mm_mul_ps(blend, _mm_sub_ps(_mm_loadu_ps(h1 + 4), hi)));
+        
+        __m128 acc = _mm_add_ps(_mm_mul_ps(lo, _mm_loadu_ps(buffer + first)),
+                                _mm_mul_ps(hi, _mm_loadu_ps(buffer + first + 4)));
+        acc = _mm_add_ps(acc, _mm_movehl_ps(acc, acc));
+        acc = _mm_add_ss(acc, _mm_shuffle_ps(acc, acc, 1));
+        out[i] = _mm_cvtss_f32(acc);
+    }
+    return i;
+}
+#endif
+
+#undef TAP
+
+// Read along a modulated delay trajectory (see delay_effects.h)
+size_t delay_line_read_modulated(const DelayLine* delay, DelayInterpolator* interp, const float* delays,
+                                 sample_t* out, size_t n) {
+    if (!delay || !delay->buffer || !interp || !delays || !out) return 0;
+    
+    size_t lead, tail;
+    delay_interp_reach(interp->mode, &lead, &tail);
+    if (delay->size < lead + tail + 3) {
+        memset(out, 0, n * sizeof(sample_t));
+        return n;
+    }
+    
+    uint32_t base[DELAY_READ_CHUNK];
+    const uint32_t mask = (uint32_t)delay->mask;
+    const sample_t* buffer = delay->buffer;
+#if defined(DELAY_SSE)
+    const int use_sse = cpu_simd_level() >= SIMD_LEVEL_SSE2;
+#endif
+    float frac[DELAY_READ_CHUNK];
+    size_t done = 0;
+    
+    while (done < n) {
+        size_t count = n - done < DELAY_READ_CHUNK ? n - done : DELAY_READ_CHUNK;
+        size_t ready = delay_read_positions(delay, delays + done, done, count, lead, tail, base, frac);
+        
+        sample_t* dest = out + done;
+        size_t vector = 0;
+        
+        switch (interp->mode) {
+            case DELAY_INTERP_LAGRANGE3:
+#if defined(DELAY_SSE)
+                if (use_sse) vector = delay_read_lagrange3_sse(buffer, mask, base, frac, dest, ready);
+#endif
+                delay_read_lagrange3(buffer, mask, base + vector, frac + vector, dest + vector, ready - vector);
+                break;
+            case DELAY_INTERP_HERMITE4:
+#if defined(DELAY_SSE)
+                if (use_sse) vector = delay_read_hermite4_sse(buffer, mask, base, frac, dest, ready);
+#endif
+                delay_read_hermite4(buffer, mask, base + vector, frac + vector, dest + vector, ready - vector);
+                break;
+            case DELAY_INTERP_ALLPASS:
+                delay_read_allpass(buffer, mask, base, frac, dest, ready, &interp->allpass_state);
+                break;
+            case DELAY_INTERP_SINC:
+                // Fall back per read only where the taps wrap
+                while (vector < ready) {
+#if defined(DELAY_SSE)
+                    if (use_sse) {
+                        vector += delay_read_sinc_sse(buffer, mask, base + vector, frac + vector, dest + vector,
+                                                      ready - vector);
+                        if (vector == ready) break;
+                    }
+#endif
+                    delay_read_sinc(buffer, mask, base + vector, frac + vector, dest + vector, 1);
+                    vector++;
+                }
+                break;
+            case DELAY_INTERP_LINEAR:
+            default:
+#if defined(DELAY_SSE)
+                if (use_sse) vector = delay_read_linear_sse(buffer, mask, base, frac, dest, ready);
+#endif
+                delay_read_linear(buffer, mask, base + vector, frac + vector, dest + vector, ready - vector);
+                break;
+        }
+        
+        done += ready;
+        if (ready < count) break;
+    }
+    
+    return done;
+}
+
 // Create echo effect
 Echo* echo_create(float max_delay_seconds, float sample_rate) {
-    Echo* echo = malloc(sizeof(Echo));
+    Echo* echo = audio_malloc(sizeof(Echo));
     if (!echo) return NULL;
     
     size_t max_delay_samples = (size_t)(max_delay_seconds * sample_rate);
@@ -78,19 +476,25 @@ Echo* echo_create(float max_delay_seconds, float sample_rate) {
     
     DelayLine* delay = delay_line_create(max_delay_samples);
     if (!delay) {
-        free(echo);
+        audio_free(echo);
         return NULL;
     }
     
     echo->delay = *delay;
-    free(delay); // We copied the contents, don't need the wrapper
+    audio_free(delay); // We copied the contents, don't need the wrapper
     
     echo->feedback = 0.3f;
     echo->wet_level = 0.3f;
     echo->dry_level = 0.7f;
+    echo->sample_rate = sample_rate;
     
     onepole_lowpass(&echo->feedback_filter, 8000.0f, sample_rate);
     
+    param_smoother_init(&echo->feedback_smoother, echo->feedback, PARAM_SMOOTH_DEFAULT_MS, sample_rate,
+                        PARAM_SMOOTH_LINEAR);
+    param_smoother_init(&echo->wet_smoother, echo->wet_level, PARAM_SMOOTH_DEFAULT_MS, sample_rate,
+                        PARAM_SMOOTH_LINEAR);
+    
     return echo;
 }
 
@@ -98,9 +502,9 @@ Echo* echo_create(float max_delay_seconds, float sample_rate) {
 void echo_destroy(Echo* echo) {
     if (echo) {
         if (echo->delay.buffer) {
-            free(echo->delay.buffer);
+            audio_free(echo->delay.buffer);
         }
-        free(echo);
+        audio_free(echo);
     }
 }
 
@@ -112,55 +516,167 @@ void echo_set_params(Echo* echo, float delay_seconds, float feedback, float wet_
     echo->wet_level = clamp(wet_level, 0.0f, 1.0f);
     echo->dry_level = 1.0f - echo->wet_level;
     
-    // Update feedback filter
-    onepole_lowpass(&echo->feedback_filter, 8000.0f, sample_rate);
+    param_smoother_set_target(&echo->feedback_smoother, echo->feedback);
+    param_smoother_set_target(&echo->wet_smoother, echo->wet_level);
+    
+    // The feedback filter keeps the rate it was created with: rebuilding it
+    // here would race with the audio thread
+    (void)sample_rate;
+}
+
+// Pick up new parameter targets; returns nonzero while a ramp runs
+static int echo_update_params(Echo* echo) {
+    param_smoother_update(&echo->feedback_smoother);
+    param_smoother_update(&echo->wet_smoother);
+    return param_smoother_active(&echo->feedback_smoother) || param_smoother_active(&echo->wet_smoother);
+}
+
+// Advance the ramps by one sample; returns nonzero while one is still active
+static int echo_step_params(Echo* echo) {
+    param_smoother_next(&echo->feedback_smoother);
+    param_smoother_next(&echo->wet_smoother);
+    return param_smoother_active(&echo->feedback_smoother) || param_smoother_active(&echo->wet_smoother);
 }
 
 // Process one sample through echo effect
 sample_t echo_process(Echo* echo, sample_t input) {
     if (!echo) return input;
     
-    // Calculate delay time in samples (you'd typically make this adjustable)
-    size_t delay_samples = echo->delay.size / 4; // Use 1/4 of max delay as default
+    sample_t output;
+    echo_process_block(echo, &input, &output, 1);
+    return output;
+}
+
+// Process a block through echo effect (in and out may be the same buffer)
+void echo_process_block(Echo* echo, const sample_t* in, sample_t* out, size_t n) {
+    if (!echo || !echo->delay.buffer) {
+        audio_block_bypass(in, out, n);
+        return;
+    }
+    if (!in || !out) return;
     
-    sample_t delayed = delay_line_read(&echo->delay, delay_samples);
-    sample_t filtered_delayed = onepole_process(&echo->feedback_filter, delayed, 0);
+    int ramping = echo_update_params(echo);
     
-    sample_t feedback_sample = input + filtered_delayed * echo->feedback;
-    delay_line_write(&echo->delay, feedback_sample);
+    DelayLine delay = echo->delay;
+    OnePoleFilter filter = echo->feedback_filter;
+    const size_t delay_samples = delay.size / 4;
+    float feedback = echo->feedback_smoother.current;
+    float wet = echo->wet_smoother.current;
+    float dry = 1.0f - wet;
     
-    return input * echo->dry_level + delayed * echo->wet_level;
+    for (size_t i = 0; i < n; i++) {
+        if (ramping) {
+            ramping = echo_step_params(echo);
+            feedback = echo->feedback_smoother.current;
+            wet = echo->wet_smoother.current;
+            dry = 1.0f - wet;
+        }
+        
+        sample_t input = in[i];
+        sample_t delayed = delay_line_tap(&delay, delay_samples);
+        sample_t filtered_delayed = onepole_tick_lowpass(&filter, delayed);
+        
+        delay_line_push(&delay, input + filtered_delayed * feedback);
+        out[i] = input * dry + delayed * wet;
+    }
+    
+    echo->delay.write_pos = delay.write_pos;
+    echo->feedback_filter = filter;
 }
 
 // Process buffer through echo effect
 void echo_process_buffer(Echo* echo, AudioBuffer* buffer) {
     if (!echo || !buffer || !buffer->data) return;
     
-    for (size_t i = 0; i < buffer->capacity; i++) {
-        buffer->data[i] = echo_process(echo, buffer->data[i]);
+    echo_process_block(echo, buffer->data, buffer->data, buffer->capacity);
+}
+
+// Block adapter used for per-channel processing
+static void echo_channel_block(void* effect, const sample_t* in, sample_t* out, size_t n) {
+    echo_process_block((Echo*)effect, in, out, n);
+}
+
+// Process each channel of an interleaved buffer with its own echo instance
+void echo_process_channels(Echo** echoes, AudioBuffer* buffer) {
+    if (!echoes || !buffer || !buffer->data || buffer->channels > MAX_CHANNELS) return;
+    
+    void* instances[MAX_CHANNELS];
+    for (size_t ch = 0; ch < buffer->channels; ch++) {
+        instances[ch] = echoes[ch];
     }
+    audio_buffer_process_channels(buffer, echo_channel_block, instances);
+}
+
+// Clear echo history (parameters are kept)
+void echo_reset(Echo* echo) {
+    if (!echo) return;
+    
+    delay_line_clear(&echo->delay);
+    onepole_reset(&echo->feedback_filter);
+    
+    param_smoother_snap(&echo->feedback_smoother);
+    param_smoother_snap(&echo->wet_smoother);
+}
+
+// Effect interface adapters
+static void echo_effect_reset(void* effect) {
+    echo_reset((Echo*)effect);
+}
+
+static int echo_effect_set_param(void* effect, int param, float value) {
+    Echo* echo = (Echo*)effect;
+    if (param < 0 || param >= 3) return 0;
+    
+    float p[3] = {0.0f, echo->feedback, echo->wet_level};
+    p[param] = value;
+    echo_set_params(echo, p[0], p[1], p[2], echo->sample_rate);
+    return 1;
+}
+
+static void echo_effect_destroy(void* effect) {
+    echo_destroy((Echo*)effect);
+}
+
+static const EffectVTable echo_vtable = {
+    .name = "echo",
+    .process_block = echo_channel_block,
+    .reset = echo_effect_reset,
+    .set_param = echo_effect_set_param,
+    .latency = NULL,
+    .destroy = echo_effect_destroy
+};
+
+// Wrap in the effect interface (params: delay_seconds, feedback, wet_level)
+Effect echo_effect(Echo* echo) {
+    Effect effect = { &echo_vtable, echo };
+    return effect;
 }
 
 // Create multi-tap delay
 MultiTapDelay* multitap_create(float max_delay_seconds, float sample_rate) {
-    MultiTapDelay* multitap = malloc(sizeof(MultiTapDelay));
+    MultiTapDelay* multitap = audio_malloc(sizeof(MultiTapDelay));
     if (!multitap) return NULL;
     
     size_t max_delay_samples = (size_t)(max_delay_seconds * sample_rate);
     DelayLine* delay = delay_line_create(max_delay_samples);
     if (!delay) {
-        free(multitap);
+        audio_free(multitap);
         return NULL;
     }
     
     multitap->delay = *delay;
-    free(delay);
+    audio_free(delay);
     
     multitap->num_taps = 0;
     multitap->feedback = 0.2f;
     multitap->wet_level = 0.3f;
     multitap->dry_level = 0.7f;
     
+    param_smoother_init(&multitap->feedback_smoother, multitap->feedback, PARAM_SMOOTH_DEFAULT_MS, sample_rate,
+                        PARAM_SMOOTH_LINEAR);
+    param_smoother_init(&multitap->wet_smoother, multitap->wet_level, PARAM_SMOOTH_DEFAULT_MS, sample_rate,
+                        PARAM_SMOOTH_LINEAR);
+    
     // Clear tap arrays
     memset(multitap->tap_gains, 0, sizeof(multitap->tap_gains));
     memset(multitap->tap_delays, 0, sizeof(multitap->tap_delays));
@@ -172,9 +688,9 @@ MultiTapDelay* multitap_create(float max_delay_seconds, float sample_rate) {
 void multitap_destroy(MultiTapDelay* multitap) {
     if (multitap) {
         if (multitap->delay.buffer) {
-            free(multitap->delay.buffer);
+            audio_free(multitap->delay.buffer);
         }
-        free(multitap);
+        audio_free(multitap);
     }
 }
 
@@ -197,40 +713,151 @@ void multitap_set_feedback(MultiTapDelay* multitap, float feedback, float wet_le
     multitap->feedback = clamp(feedback, 0.0f, 0.9f);
     multitap->wet_level = clamp(wet_level, 0.0f, 1.0f);
     multitap->dry_level = 1.0f - multitap->wet_level;
+    
+    param_smoother_set_target(&multitap->feedback_smoother, multitap->feedback);
+    param_smoother_set_target(&multitap->wet_smoother, multitap->wet_level);
+}
+
+// Pick up new parameter targets; returns nonzero while a ramp runs
+static int multitap_update_params(MultiTapDelay* multitap) {
+    param_smoother_update(&multitap->feedback_smoother);
+    param_smoother_update(&multitap->wet_smoother);
+    return param_smoother_active(&multitap->feedback_smoother) || param_smoother_active(&multitap->wet_smoother);
+}
+
+// Advance the ramps by one sample; returns nonzero while one is still active
+static int multitap_step_params(MultiTapDelay* multitap) {
+    param_smoother_next(&multitap->feedback_smoother);
+    param_smoother_next(&multitap->wet_smoother);
+    return param_smoother_active(&multitap->feedback_smoother) || param_smoother_active(&multitap->wet_smoother);
 }
 
 // Process one sample through multi-tap delay
 sample_t multitap_process(MultiTapDelay* multitap, sample_t input) {
     if (!multitap) return input;
     
-    sample_t output = input * multitap->dry_level;
-    sample_t tap_sum = 0.0f;
+    sample_t output;
+    multitap_process_block(multitap, &input, &output, 1);
+    return output;
+}
+
+// Process a block through multi-tap delay (in and out may be the same buffer)
+void multitap_process_block(MultiTapDelay* multitap, const sample_t* in, sample_t* out, size_t n) {
+    if (!multitap || !multitap->delay.buffer) {
+        audio_block_bypass(in, out, n);
+        return;
+    }
+    if (!in || !out) return;
+    
+    int ramping = multitap_update_params(multitap);
+    
+    DelayLine delay = multitap->delay;
+    const int num_taps = multitap->num_taps;
+    float feedback = multitap->feedback_smoother.current;
+    float wet = multitap->wet_smoother.current;
+    float dry = 1.0f - wet;
     
-    // Sum all taps
-    for (int i = 0; i < multitap->num_taps; i++) {
-        sample_t tap_output = delay_line_read(&multitap->delay, multitap->tap_delays[i]);
-        tap_sum += tap_output * multitap->tap_gains[i];
+    // Taps beyond the line read as silence, same as delay_line_read
+    size_t tap_delays[8];
+    float tap_gains[8];
+    for (int t = 0; t < num_taps; t++) {
+        int valid = multitap->tap_delays[t] < delay.size;
+        tap_delays[t] = valid ? multitap->tap_delays[t] : 0;
+        tap_gains[t] = valid ? multitap->tap_gains[t] : 0.0f;
     }
     
-    // Add feedback
-    sample_t feedback_sample = input + tap_sum * multitap->feedback;
-    delay_line_write(&multitap->delay, feedback_sample);
+    for (size_t i = 0; i < n; i++) {
+        if (ramping) {
+            ramping = multitap_step_params(multitap);
+            feedback = multitap->feedback_smoother.current;
+            wet = multitap->wet_smoother.current;
+            dry = 1.0f - wet;
+        }
+        
+        sample_t input = in[i];
+        sample_t tap_sum = 0.0f;
+        
+        for (int t = 0; t < num_taps; t++) {
+            tap_sum += delay_line_tap(&delay, tap_delays[t]) * tap_gains[t];
+        }
+        
+        delay_line_push(&delay, input + tap_sum * feedback);
+        out[i] = input * dry + tap_sum * wet;
+    }
     
-    return output + tap_sum * multitap->wet_level;
+    multitap->delay.write_pos = delay.write_pos;
 }
 
 // Process buffer through multi-tap delay
 void multitap_process_buffer(MultiTapDelay* multitap, AudioBuffer* buffer) {
     if (!multitap || !buffer || !buffer->data) return;
     
-    for (size_t i = 0; i < buffer->capacity; i++) {
-        buffer->data[i] = multitap_process(multitap, buffer->data[i]);
+    multitap_process_block(multitap, buffer->data, buffer->data, buffer->capacity);
+}
+
+// Block adapter used for per-channel processing
+static void multitap_channel_block(void* effect, const sample_t* in, sample_t* out, size_t n) {
+    multitap_process_block((MultiTapDelay*)effect, in, out, n);
+}
+
+// Process each channel of an interleaved buffer with its own multi-tap delay instance
+void multitap_process_channels(MultiTapDelay** multitaps, AudioBuffer* buffer) {
+    if (!multitaps || !buffer || !buffer->data || buffer->channels > MAX_CHANNELS) return;
+    
+    void* instances[MAX_CHANNELS];
+    for (size_t ch = 0; ch < buffer->channels; ch++) {
+        instances[ch] = multitaps[ch];
     }
+    audio_buffer_process_channels(buffer, multitap_channel_block, instances);
+}
+
+// Clear multi-tap delay history (parameters are kept)
+void multitap_reset(MultiTapDelay* multitap) {
+    if (!multitap) return;
+    
+    delay_line_clear(&multitap->delay);
+    
+    param_smoother_snap(&multitap->feedback_smoother);
+    param_smoother_snap(&multitap->wet_smoother);
+}
+
+// Effect interface adapters
+static void multitap_effect_reset(void* effect) {
+    multitap_reset((MultiTapDelay*)effect);
+}
+
+static int multitap_effect_set_param(void* effect, int param, float value) {
+    MultiTapDelay* multitap = (MultiTapDelay*)effect;
+    if (param < 0 || param >= 2) return 0;
+    
+    float p[2] = {multitap->feedback, multitap->wet_level};
+    p[param] = value;
+    multitap_set_feedback(multitap, p[0], p[1]);
+    return 1;
+}
+
+static void multitap_effect_destroy(void* effect) {
+    multitap_destroy((MultiTapDelay*)effect);
+}
+
+static const EffectVTable multitap_vtable = {
+    .name = "multi-tap delay",
+    .process_block = multitap_channel_block,
+    .reset = multitap_effect_reset,
+    .set_param = multitap_effect_set_param,
+    .latency = NULL,
+    .destroy = multitap_effect_destroy
+};
+
+// Wrap in the effect interface (params: feedback, wet_level)
+Effect multitap_effect(MultiTapDelay* multitap) {
+    Effect effect = { &multitap_vtable, multitap };
+    return effect;
 }
 
 // Create ping-pong delay
 PingPongDelay* pingpong_create(float max_delay_seconds, float sample_rate) {
-    PingPongDelay* pingpong = malloc(sizeof(PingPongDelay));
+    PingPongDelay* pingpong = audio_malloc(sizeof(PingPongDelay));
     if (!pingpong) return NULL;
     
     size_t max_delay_samples = (size_t)(max_delay_seconds * sample_rate);
@@ -241,14 +868,14 @@ PingPongDelay* pingpong_create(float max_delay_seconds, float sample_rate) {
     if (!left_delay || !right_delay) {
         if (left_delay) delay_line_destroy(left_delay);
         if (right_delay) delay_line_destroy(right_delay);
-        free(pingpong);
+        audio_free(pingpong);
         return NULL;
     }
     
     pingpong->left_delay = *left_delay;
     pingpong->right_delay = *right_delay;
-    free(left_delay);
-    free(right_delay);
+    audio_free(left_delay);
+    audio_free(right_delay);
     
     pingpong->feedback = 0.3f;
     pingpong->cross_feedback = 0.2f;
@@ -258,6 +885,13 @@ PingPongDelay* pingpong_create(float max_delay_seconds, float sample_rate) {
     onepole_lowpass(&pingpong->left_filter, 6000.0f, sample_rate);
     onepole_lowpass(&pingpong->right_filter, 6000.0f, sample_rate);
     
+    param_smoother_init(&pingpong->feedback_smoother, pingpong->feedback, PARAM_SMOOTH_DEFAULT_MS, sample_rate,
+                        PARAM_SMOOTH_LINEAR);
+    param_smoother_init(&pingpong->cross_feedback_smoother, pingpong->cross_feedback, PARAM_SMOOTH_DEFAULT_MS,
+                        sample_rate, PARAM_SMOOTH_LINEAR);
+    param_smoother_init(&pingpong->wet_smoother, pingpong->wet_level, PARAM_SMOOTH_DEFAULT_MS, sample_rate,
+                        PARAM_SMOOTH_LINEAR);
+    
     return pingpong;
 }
 
@@ -265,12 +899,12 @@ PingPongDelay* pingpong_create(float max_delay_seconds, float sample_rate) {
 void pingpong_destroy(PingPongDelay* pingpong) {
     if (pingpong) {
         if (pingpong->left_delay.buffer) {
-            free(pingpong->left_delay.buffer);
+            audio_free(pingpong->left_delay.buffer);
         }
         if (pingpong->right_delay.buffer) {
-            free(pingpong->right_delay.buffer);
+            audio_free(pingpong->right_delay.buffer);
         }
-        free(pingpong);
+        audio_free(pingpong);
     }
 }
 
@@ -284,8 +918,34 @@ void pingpong_set_params(PingPongDelay* pingpong, float delay_seconds, float fee
     pingpong->wet_level = clamp(wet_level, 0.0f, 1.0f);
     pingpong->dry_level = 1.0f - pingpong->wet_level;
     
-    onepole_lowpass(&pingpong->left_filter, 6000.0f, sample_rate);
-    onepole_lowpass(&pingpong->right_filter, 6000.0f, sample_rate);
+    param_smoother_set_target(&pingpong->feedback_smoother, pingpong->feedback);
+    param_smoother_set_target(&pingpong->cross_feedback_smoother, pingpong->cross_feedback);
+    param_smoother_set_target(&pingpong->wet_smoother, pingpong->wet_level);
+    
+    // As for echo, the filters stay at the creation rate
+    (void)sample_rate;
+}
+
+// Nonzero while a ping-pong parameter ramps
+static int pingpong_ramping(const PingPongDelay* pingpong) {
+    return param_smoother_active(&pingpong->feedback_smoother) ||
+           param_smoother_active(&pingpong->cross_feedback_smoother) || param_smoother_active(&pingpong->wet_smoother);
+}
+
+// Pick up new parameter targets; returns nonzero while a ramp runs
+static int pingpong_update_params(PingPongDelay* pingpong) {
+    param_smoother_update(&pingpong->feedback_smoother);
+    param_smoother_update(&pingpong->cross_feedback_smoother);
+    param_smoother_update(&pingpong->wet_smoother);
+    return pingpong_ramping(pingpong);
+}
+
+// Advance the ramps by one sample; returns nonzero while one is still active
+static int pingpong_step_params(PingPongDelay* pingpong) {
+    param_smoother_next(&pingpong->feedback_smoother);
+    param_smoother_next(&pingpong->cross_feedback_smoother);
+    param_smoother_next(&pingpong->wet_smoother);
+    return pingpong_ramping(pingpong);
 }
 
 // Process stereo samples through ping-pong delay
@@ -297,22 +957,72 @@ void pingpong_process_stereo(PingPongDelay* pingpong, sample_t* left_in, sample_
         return;
     }
     
-    size_t delay_samples = pingpong->left_delay.size / 4; // Default delay time
-    
-    sample_t left_delayed = delay_line_read(&pingpong->left_delay, delay_samples);
-    sample_t right_delayed = delay_line_read(&pingpong->right_delay, delay_samples);
+    pingpong_process_block(pingpong, left_in, right_in, left_out, right_out, 1);
+}
+
+// Process blocks of stereo samples through ping-pong delay
+void pingpong_process_block(PingPongDelay* pingpong, const sample_t* left_in, const sample_t* right_in,
+                            sample_t* left_out, sample_t* right_out, size_t n) {
+    if (!pingpong || !pingpong->left_delay.buffer || !pingpong->right_delay.buffer) {
+        audio_block_bypass(left_in, left_out, n);
+        audio_block_bypass(right_in, right_out, n);
+        return;
+    }
+    if (!left_in || !right_in || !left_out || !right_out) return;
     
-    // Apply filters to delayed signals
-    left_delayed = onepole_process(&pingpong->left_filter, left_delayed, 0);
-    right_delayed = onepole_process(&pingpong->right_filter, right_delayed, 0);
+    DelayLine left_delay = pingpong->left_delay;
+    DelayLine right_delay = pingpong->right_delay;
+    OnePoleFilter left_filter = pingpong->left_filter;
+    OnePoleFilter right_filter = pingpong->right_filter;
+    const size_t delay_samples = left_delay.size / 4;
+    int ramping = pingpong_update_params(pingpong);
+    float feedback = pingpong->feedback_smoother.current;
+    float cross_feedback = pingpong->cross_feedback_smoother.current;
+    float wet = pingpong->wet_smoother.current;
+    float dry = 1.0f - wet;
     
-    // Calculate feedback with cross-feedback (ping-pong effect)
-    sample_t left_feedback = *left_in + left_delayed * pingpong->feedback + right_delayed * pingpong->cross_feedback;
-    sample_t right_feedback = *right_in + right_delayed * pingpong->feedback + left_delayed * pingpong->cross_feedback;
+    for (size_t i = 0; i < n; i++) {
+        if (ramping) {
+            ramping = pingpong_step_params(pingpong);
+            feedback = pingpong->feedback_smoother.current;
+            cross_feedback = pingpong->cross_feedback_smoother.current;
+            wet = pingpong->wet_smoother.current;
+            dry = 1.0f - wet;
+        }
+        
+        sample_t left = left_in[i];
+        sample_t right = right_in[i];
+        
+        sample_t left_delayed = onepole_tick_lowpass(&left_filter, delay_line_tap(&left_delay, delay_samples));
+        sample_t right_delayed = onepole_tick_lowpass(&right_filter, delay_line_tap(&right_delay, delay_samples));
+        
+        delay_line_push(&left_delay, left + left_delayed * feedback + right_delayed * cross_feedback);
+        delay_line_push(&right_delay, right + right_delayed * feedback + left_delayed * cross_feedback);
+        
+        left_out[i] = left * dry + left_delayed * wet;
+        right_out[i] = right * dry + right_delayed * wet;
+    }
     
-    delay_line_write(&pingpong->left_delay, left_feedback);
-    delay_line_write(&pingpong->right_delay, right_feedback);
+    pingpong->left_delay.write_pos = left_delay.write_pos;
+    pingpong->right_delay.write_pos = right_delay.write_pos;
+    pingpong->left_filter = left_filter;
+    pingpong->right_filter = right_filter;
+}
+
+// Process an interleaved stereo buffer through ping-pong delay
+void pingpong_process_buffer(PingPongDelay* pingpong, AudioBuffer* buffer) {
+    if (!pingpong || !buffer || !buffer->data || buffer->channels != 2) return;
     
-    *left_out = *left_in * pingpong->dry_level + left_delayed * pingpong->wet_level;
-    *right_out = *right_in * pingpong->dry_level + right_delayed * pingpong->wet_level;
-}
\ No newline at end of file
+    sample_t left[AUDIO_CHANNEL_CHUNK];
+    sample_t right[AUDIO_CHANNEL_CHUNK];
+    for (size_t start = 0; start < buffer->length; start += AUDIO_CHANNEL_CHUNK) {
+        size_t frames = buffer->length - start;
+        if (frames > AUDIO_CHANNEL_CHUNK) frames = AUDIO_CHANNEL_CHUNK;
+        
+        audio_buffer_read_channel(buffer, 0, start, left, frames);
+        audio_buffer_read_channel(buffer, 1, start, right, frames);
+        pingpong_process_block(pingpong, left, right, left, right, frames);
+        audio_buffer_write_channel(buffer, 0, start, left, frames);
+        audio_buffer_write_channel(buffer, 1, start, right, frames);
+    }
+}
@@ -43,11 +43,64 @@ sample_t sigmoid_distortion(sample_t input, float drive) {
     return (2.0f / (1.0f + expf(-x))) - 1.0f;
 }
 
+// Oversampling helpers
+
+// Choose the factor; clears the oversampler and the dry delay
+static int oversampling_init(DistortionOversampling* os, int factor) {
+    if (!oversampler_init(&os->oversampler, factor)) return 0;
+    
+    memset(os->dry_delay, 0, sizeof(os->dry_delay));
+    os->dry_pos = 0;
+    return 1;
+}
+
+// Clear the oversampler and the dry delay (the factor is kept)
+static void oversampling_reset(DistortionOversampling* os) {
+    oversampler_reset(&os->oversampler);
+    memset(os->dry_delay, 0, sizeof(os->dry_delay));
+    os->dry_pos = 0;
+}
+
+// Delay a base-rate signal by latency samples through a ring of that length
+// (in and out may be the same buffer)
+static void latency_delay(float* line, size_t* pos, size_t latency, const float* in, float* out, size_t n) {
+    if (latency == 0) {
+        memmove(out, in, n * sizeof(float));
+        return;
+    }
+    
+    size_t p = *pos;
+    for (size_t i = 0; i < n; i++) {
+        float x = in[i];
+        out[i] = line[p];
+        line[p] = x;
+        p = p + 1 == latency ? 0 : p + 1;
+    }
+    *pos = p;
+}
+
+// Delay the dry input by the oversampler latency so the mix lines up
+static void oversampling_dry(DistortionOversampling* os, const sample_t* in, sample_t* dry, size_t n) {
+    latency_delay(os->dry_delay, &os->dry_pos, os->oversampler.latency, in, dry, n);
+}
+
+// Samples in the next oversampled pass
+static inline size_t oversampling_chunk(size_t remaining) {
+    return remaining < DISTORTION_BLOCK ? remaining : DISTORTION_BLOCK;
+}
+
+// Per-sample values of a parameter for one pass; returns nonzero if they ramp
+static int smoothed_values(ParamSmoother* smoother, float* values, size_t n) {
+    int ramping = param_smoother_active(smoother);
+    param_smoother_fill(smoother, values, n);
+    return ramping;
+}
+
 // Basic distortion functions
 
 // Create basic distortion effect
 Distortion* distortion_create(DistortionType type, float sample_rate) {
-    Distortion* dist = malloc(sizeof(Distortion));
+    Distortion* dist = audio_malloc(sizeof(Distortion));
     if (!dist) return NULL;
     
     dist->type = type;
@@ -55,18 +108,25 @@ Distortion* distortion_create(DistortionType type, float sample_rate) {
     dist->output_gain = 0.5f;
     dist->mix = 1.0f;
     dist->sample_rate = sample_rate;
+    oversampling_init(&dist->oversampling, DISTORTION_DEFAULT_OVERSAMPLING);
+    dist->accuracy = FAST_MATH_DEFAULT_TIER;
     
     // Setup pre and post filters
     biquad_highpass(&dist->pre_filter, 80.0f, 0.7f, sample_rate);
     biquad_lowpass(&dist->post_filter, 8000.0f, 0.7f, sample_rate);
     
+    param_smoother_init(&dist->drive_smoother, dist->drive, PARAM_SMOOTH_DEFAULT_MS, sample_rate, PARAM_SMOOTH_LINEAR);
+    param_smoother_init(&dist->output_gain_smoother, dist->output_gain, PARAM_SMOOTH_DEFAULT_MS, sample_rate,
+                        PARAM_SMOOTH_LINEAR);
+    param_smoother_init(&dist->mix_smoother, dist->mix, PARAM_SMOOTH_DEFAULT_MS, sample_rate, PARAM_SMOOTH_LINEAR);
+    
     return dist;
 }
 
 // Destroy basic distortion
 void distortion_destroy(Distortion* dist) {
     if (dist) {
-        free(dist);
+        audio_free(dist);
     }
 }
 
@@ -77,59 +137,194 @@ void distortion_set_params(Distortion* dist, float drive, float output_gain, flo
     dist->drive = clamp(drive, 1.0f, 20.0f);
     dist->output_gain = clamp(output_gain, 0.1f, 2.0f);
     dist->mix = clamp(mix, 0.0f, 1.0f);
+    
+    param_smoother_set_target(&dist->drive_smoother, dist->drive);
+    param_smoother_set_target(&dist->output_gain_smoother, dist->output_gain);
+    param_smoother_set_target(&dist->mix_smoother, dist->mix);
 }
 
 // Process one sample through basic distortion
 sample_t distortion_process(Distortion* dist, sample_t input) {
     if (!dist) return input;
     
-    // Pre-filtering
-    sample_t filtered = biquad_process(&dist->pre_filter, input);
-    
-    sample_t distorted;
-    
-    switch (dist->type) {
+    sample_t output;
+    distortion_process_block(dist, &input, &output, 1);
+    return output;
+}
+
+// Shape an oversampled block in place. The tanh-based curves use the
+// vectorized approximations; sigmoid_distortion is tanh(drive * x / 2).
+static void distortion_shape(DistortionType type, float drive, FastMathTier accuracy, sample_t* x, size_t n) {
+    switch (type) {
         case DISTORTION_HARD_CLIP:
-            distorted = hard_clip(filtered * dist->drive, 0.8f);
-            break;
-        case DISTORTION_SOFT_CLIP:
-            distorted = soft_clip(filtered, dist->drive);
+            for (size_t i = 0; i < n; i++) x[i] = hard_clip(x[i] * drive, 0.8f);
             break;
         case DISTORTION_TUBE:
-            distorted = tube_saturation(filtered, dist->drive, 0.1f);
+            fast_asym_shape_block(x, x, n, 0.1f, 2.0f * drive, 0.7f, 1.5f * drive, 0.8f, accuracy);
             break;
         case DISTORTION_FUZZ:
-            distorted = sigmoid_distortion(filtered, dist->drive);
+            fast_tanh_shape_block(x, x, n, 0.5f * drive, 1.0f, accuracy);
             break;
         case DISTORTION_OVERDRIVE:
-            distorted = cubic_distortion(filtered, dist->drive);
+            for (size_t i = 0; i < n; i++) x[i] = cubic_distortion(x[i], drive);
             break;
+        case DISTORTION_SOFT_CLIP:
         default:
-            distorted = soft_clip(filtered, dist->drive);
+            fast_tanh_shape_block(x, x, n, drive, 1.0f / drive, accuracy);
             break;
     }
+}
+
+// Process a block through basic distortion (in and out may be the same buffer).
+// Pre-filtering runs at the base rate, the shaper at the oversampled rate.
+void distortion_process_block(Distortion* dist, const sample_t* in, sample_t* out, size_t n) {
+    if (!dist) {
+        audio_block_bypass(in, out, n);
+        return;
+    }
+    if (!in || !out) return;
+    
+    BiquadFilter pre_filter = dist->pre_filter;
+    BiquadFilter post_filter = dist->post_filter;
+    Oversampler* oversampler = &dist->oversampling.oversampler;
+    const size_t factor = (size_t)oversampler->factor;
+    const DistortionType type = dist->type;
+    const FastMathTier accuracy = dist->accuracy;
+    float drive[DISTORTION_BLOCK];
+    float output_gain[DISTORTION_BLOCK];
+    float mix[DISTORTION_BLOCK];
+    sample_t dry[DISTORTION_BLOCK];
+    sample_t wet[DISTORTION_BLOCK];
+    sample_t upsampled[DISTORTION_BLOCK * OVERSAMPLE_MAX_FACTOR];
+    
+    param_smoother_update(&dist->drive_smoother);
+    param_smoother_update(&dist->output_gain_smoother);
+    param_smoother_update(&dist->mix_smoother);
+    
+    for (size_t start = 0; start < n; start += DISTORTION_BLOCK) {
+        const size_t count = oversampling_chunk(n - start);
+        const int drive_ramping = smoothed_values(&dist->drive_smoother, drive, count);
+        smoothed_values(&dist->output_gain_smoother, output_gain, count);
+        smoothed_values(&dist->mix_smoother, mix, count);
+        
+        oversampling_dry(&dist->oversampling, in + start, dry, count);
+        for (size_t i = 0; i < count; i++) {
+            wet[i] = biquad_tick(&pre_filter, in[start + i]);
+        }
+        
+        oversampler_up(oversampler, wet, upsampled, count);
+        const size_t groups = drive_ramping ? count : 1;
+        const size_t group_length = count * factor / groups;
+        for (size_t g = 0; g < groups; g++) {
+            distortion_shape(type, drive[g], accuracy, upsampled + g * group_length, group_length);
+        }
+        oversampler_down(oversampler, upsampled, wet, count);
+        
+        for (size_t i = 0; i < count; i++) {
+            sample_t distorted = biquad_tick(&post_filter, wet[i]) * output_gain[i];
+            out[start + i] = dry[i] + mix[i] * (distorted - dry[i]);
+        }
+    }
     
-    // Post-filtering and output gain
-    distorted = biquad_process(&dist->post_filter, distorted) * dist->output_gain;
-    
-    // Mix wet and dry
-    return lerp(input, distorted, dist->mix);
+    dist->pre_filter = pre_filter;
+    dist->post_filter = post_filter;
 }
 
 // Process buffer through basic distortion
 void distortion_process_buffer(Distortion* dist, AudioBuffer* buffer) {
     if (!dist || !buffer || !buffer->data) return;
     
-    for (size_t i = 0; i < buffer->capacity; i++) {
-        buffer->data[i] = distortion_process(dist, buffer->data[i]);
+    distortion_process_block(dist, buffer->data, buffer->data, buffer->capacity);
+}
+
+// Block adapter used for per-channel processing
+static void distortion_channel_block(void* effect, const sample_t* in, sample_t* out, size_t n) {
+    distortion_process_block((Distortion*)effect, in, out, n);
+}
+
+// Process each channel of an interleaved buffer with its own distortion instance
+void distortion_process_channels(Distortion** dists, AudioBuffer* buffer) {
+    if (!dists || !buffer || !buffer->data || buffer->channels > MAX_CHANNELS) return;
+    
+    void* instances[MAX_CHANNELS];
+    for (size_t ch = 0; ch < buffer->channels; ch++) {
+        instances[ch] = dists[ch];
     }
+    audio_buffer_process_channels(buffer, distortion_channel_block, instances);
+}
+
+// Clear distortion history (parameters are kept)
+void distortion_reset(Distortion* dist) {
+    if (!dist) return;
+    
+    biquad_reset(&dist->pre_filter);
+    biquad_reset(&dist->post_filter);
+    oversampling_reset(&dist->oversampling);
+    
+    param_smoother_snap(&dist->drive_smoother);
+    param_smoother_snap(&dist->output_gain_smoother);
+    param_smoother_snap(&dist->mix_smoother);
+}
+
+// Run the waveshaper at factor times the sample rate (1 turns oversampling off)
+int distortion_set_oversampling(Distortion* dist, int factor) {
+    if (!dist) return 0;
+    return oversampling_init(&dist->oversampling, factor);
+}
+
+// Choose the accuracy of the tanh approximation used by the waveshaper
+void distortion_set_accuracy(Distortion* dist, FastMathTier accuracy) {
+    if (dist) dist->accuracy = accuracy;
+}
+
+// Delay of the output behind the input, in samples
+size_t distortion_latency(const Distortion* dist) {
+    return dist ? dist->oversampling.oversampler.latency : 0;
+}
+
+// Effect interface adapters
+static void distortion_effect_reset(void* effect) {
+    distortion_reset((Distortion*)effect);
+}
+
+static int distortion_effect_set_param(void* effect, int param, float value) {
+    Distortion* dist = (Distortion*)effect;
+    if (param < 0 || param >= 3) return 0;
+    
+    float p[3] = {dist->drive, dist->output_gain, dist->mix};
+    p[param] = value;
+    distortion_set_params(dist, p[0], p[1], p[2]);
+    return 1;
+}
+
+static size_t distortion_effect_latency(const void* effect) {
+    return distortion_latency((const Distortion*)effect);
+}
+
+static void distortion_effect_destroy(void* effect) {
+    distortion_destroy((Distortion*)effect);
+}
+
+static const EffectVTable distortion_vtable = {
+    .name = "distortion",
+    .process_block = distortion_channel_block,
+    .reset = distortion_effect_reset,
+    .set_param = distortion_effect_set_param,
+    .latency = distortion_effect_latency,
+    .destroy = distortion_effect_destroy
+};
+
+// Wrap in the effect interface (params: drive, output_gain, mix)
+Effect distortion_effect(Distortion* dist) {
+    Effect effect = { &distortion_vtable, dist };
+    return effect;
 }
 
 // Tube distortion functions
 
 // Create tube distortion
 TubeDistortion* tube_distortion_create(float sample_rate) {
-    TubeDistortion* tube = malloc(sizeof(TubeDistortion));
+    TubeDistortion* tube = audio_malloc(sizeof(TubeDistortion));
     if (!tube) return NULL;
     
     tube->drive = 3.0f;
@@ -141,6 +336,14 @@ TubeDistortion* tube_distortion_create(float sample_rate) {
     biquad_highpass(&tube->input_filter, 100.0f, 0.7f, sample_rate);
     biquad_lowpass(&tube->output_filter, 5000.0f, 1.5f, sample_rate);
     onepole_highpass(&tube->dc_blocker, 20.0f, sample_rate);
+    oversampling_init(&tube->oversampling, DISTORTION_DEFAULT_OVERSAMPLING);
+    tube->accuracy = FAST_MATH_DEFAULT_TIER;
+    
+    param_smoother_init(&tube->drive_smoother, tube->drive, PARAM_SMOOTH_DEFAULT_MS, sample_rate, PARAM_SMOOTH_LINEAR);
+    param_smoother_init(&tube->bias_smoother, tube->bias, PARAM_SMOOTH_DEFAULT_MS, sample_rate, PARAM_SMOOTH_LINEAR);
+    param_smoother_init(&tube->output_gain_smoother, tube->output_gain, PARAM_SMOOTH_DEFAULT_MS, sample_rate,
+                        PARAM_SMOOTH_LINEAR);
+    param_smoother_init(&tube->mix_smoother, tube->mix, PARAM_SMOOTH_DEFAULT_MS, sample_rate, PARAM_SMOOTH_LINEAR);
     
     return tube;
 }
@@ -148,7 +351,7 @@ TubeDistortion* tube_distortion_create(float sample_rate) {
 // Destroy tube distortion
 void tube_distortion_destroy(TubeDistortion* tube) {
     if (tube) {
-        free(tube);
+        audio_free(tube);
     }
 }
 
@@ -160,43 +363,180 @@ void tube_distortion_set_params(TubeDistortion* tube, float drive, float bias, f
     tube->bias = clamp(bias, -0.5f, 0.5f);
     tube->output_gain = clamp(output_gain, 0.1f, 2.0f);
     tube->mix = clamp(mix, 0.0f, 1.0f);
+    
+    param_smoother_set_target(&tube->drive_smoother, tube->drive);
+    param_smoother_set_target(&tube->bias_smoother, tube->bias);
+    param_smoother_set_target(&tube->output_gain_smoother, tube->output_gain);
+    param_smoother_set_target(&tube->mix_smoother, tube->mix);
 }
 
 // Process one sample through tube distortion
 sample_t tube_distortion_process(TubeDistortion* tube, sample_t input) {
     if (!tube) return input;
     
-    // Input filtering
-    sample_t filtered = biquad_process(&tube->input_filter, input);
-    
-    // Tube saturation
-    sample_t distorted = tube_saturation(filtered, tube->drive, tube->bias);
-    
-    // DC blocking and output filtering
-    distorted = onepole_process(&tube->dc_blocker, distorted, 1);
-    distorted = biquad_process(&tube->output_filter, distorted);
-    
-    // Apply output gain
-    distorted *= tube->output_gain;
+    sample_t output;
+    tube_distortion_process_block(tube, &input, &output, 1);
+    return output;
+}
+
+// Process a block through tube distortion (in and out may be the same buffer).
+// Only the saturation runs at the oversampled rate.
+void tube_distortion_process_block(TubeDistortion* tube, const sample_t* in, sample_t* out, size_t n) {
+    if (!tube) {
+        audio_block_bypass(in, out, n);
+        return;
+    }
+    if (!in || !out) return;
+    
+    BiquadFilter input_filter = tube->input_filter;
+    BiquadFilter output_filter = tube->output_filter;
+    OnePoleFilter dc_blocker = tube->dc_blocker;
+    Oversampler* oversampler = &tube->oversampling.oversampler;
+    const size_t factor = (size_t)oversampler->factor;
+    const FastMathTier accuracy = tube->accuracy;
+    float drive[DISTORTION_BLOCK];
+    float bias[DISTORTION_BLOCK];
+    float output_gain[DISTORTION_BLOCK];
+    float mix[DISTORTION_BLOCK];
+    sample_t dry[DISTORTION_BLOCK];
+    sample_t wet[DISTORTION_BLOCK];
+    sample_t upsampled[DISTORTION_BLOCK * OVERSAMPLE_MAX_FACTOR];
+    
+    param_smoother_update(&tube->drive_smoother);
+    param_smoother_update(&tube->bias_smoother);
+    param_smoother_update(&tube->output_gain_smoother);
+    param_smoother_update(&tube->mix_smoother);
+    
+    for (size_t start = 0; start < n; start += DISTORTION_BLOCK) {
+        const size_t count = oversampling_chunk(n - start);
+        int shape_ramping = smoothed_values(&tube->drive_smoother, drive, count);
+        shape_ramping |= smoothed_values(&tube->bias_smoother, bias, count);
+        smoothed_values(&tube->output_gain_smoother, output_gain, count);
+        smoothed_values(&tube->mix_smoother, mix, count);
+        
+        oversampling_dry(&tube->oversampling, in + start, dry, count);
+        for (size_t i = 0; i < count; i++) {
+            wet[i] = biquad_tick(&input_filter, in[start + i]);
+        }
+        
+        oversampler_up(oversampler, wet, upsampled, count);
+        const size_t groups = shape_ramping ? count : 1;
+        const size_t group_length = count * factor / groups;
+        for (size_t g = 0; g < groups; g++) {
+            fast_asym_shape_block(upsampled + g * group_length, upsampled + g * group_length, group_length,
+                                  bias[g], 2.0f * drive[g], 0.7f, 1.5f * drive[g], 0.8f, accuracy);
+        }
+        oversampler_down(oversampler, upsampled, wet, count);
+        
+        for (size_t i = 0; i < count; i++) {
+            sample_t distorted = onepole_tick_highpass(&dc_blocker, wet[i]);
+            distorted = biquad_tick(&output_filter, distorted) * output_gain[i];
+            out[start + i] = dry[i] + mix[i] * (distorted - dry[i]);
+        }
+    }
     
-    // Mix
-    return lerp(input, distorted, tube->mix);
+    tube->input_filter = input_filter;
+    tube->output_filter = output_filter;
+    tube->dc_blocker = dc_blocker;
 }
 
 // Process buffer through tube distortion
 void tube_distortion_process_buffer(TubeDistortion* tube, AudioBuffer* buffer) {
     if (!tube || !buffer || !buffer->data) return;
     
-    for (size_t i = 0; i < buffer->capacity; i++) {
-        buffer->data[i] = tube_distortion_process(tube, buffer->data[i]);
+    tube_distortion_process_block(tube, buffer->data, buffer->data, buffer->capacity);
+}
+
+// Block adapter used for per-channel processing
+static void tube_distortion_channel_block(void* effect, const sample_t* in, sample_t* out, size_t n) {
+    tube_distortion_process_block((TubeDistortion*)effect, in, out, n);
+}
+
+// Process each channel of an interleaved buffer with its own tube distortion instance
+void tube_distortion_process_channels(TubeDistortion** tubes, AudioBuffer* buffer) {
+    if (!tubes || !buffer || !buffer->data || buffer->channels > MAX_CHANNELS) return;
+    
+    void* instances[MAX_CHANNELS];
+    for (size_t ch = 0; ch < buffer->channels; ch++) {
+        instances[ch] = tubes[ch];
     }
+    audio_buffer_process_channels(buffer, tube_distortion_channel_block, instances);
+}
+
+// Clear tube distortion history (parameters are kept)
+void tube_distortion_reset(TubeDistortion* tube) {
+    if (!tube) return;
+    
+    biquad_reset(&tube->input_filter);
+    biquad_reset(&tube->output_filter);
+    onepole_reset(&tube->dc_blocker);
+    oversampling_reset(&tube->oversampling);
+    
+    param_smoother_snap(&tube->drive_smoother);
+    param_smoother_snap(&tube->bias_smoother);
+    param_smoother_snap(&tube->output_gain_smoother);
+    param_smoother_snap(&tube->mix_smoother);
+}
+
+// Run the waveshaper at factor times the sample rate (1 turns oversampling off)
+int tube_distortion_set_oversampling(TubeDistortion* tube, int factor) {
+    if (!tube) return 0;
+    return oversampling_init(&tube->oversampling, factor);
+}
+
+// Choose the accuracy of the tanh approximation used by the waveshaper
+void tube_distortion_set_accuracy(TubeDistortion* tube, FastMathTier accuracy) {
+    if (tube) tube->accuracy = accuracy;
+}
+
+// Delay of the output behind the input, in samples
+size_t tube_distortion_latency(const TubeDistortion* tube) {
+    return tube ? tube->oversampling.oversampler.latency : 0;
+}
+
+// Effect interface adapters
+static void tube_distortion_effect_reset(void* effect) {
+    tube_distortion_reset((TubeDistortion*)effect);
+}
+
+static int tube_distortion_effect_set_param(void* effect, int param, float value) {
+    TubeDistortion* tube = (TubeDistortion*)effect;
+    if (param < 0 || param >= 4) return 0;
+    
+    float p[4] = {tube->drive, tube->bias, tube->output_gain, tube->mix};
+    p[param] = value;
+    tube_distortion_set_params(tube, p[0], p[1], p[2], p[3]);
+    return 1;
+}
+
+static size_t tube_distortion_effect_latency(const void* effect) {
+    return tube_distortion_latency((const TubeDistortion*)effect);
+}
+
+static void tube_distortion_effect_destroy(void* effect) {
+    tube_distortion_destroy((TubeDistortion*)effect);
+}
+
+static const EffectVTable tube_distortion_vtable = {
+    .name = "tube distortion",
+    .process_block = tube_distortion_channel_block,
+    .reset = tube_distortion_effect_reset,
+    .set_param = tube_distortion_effect_set_param,
+    .latency = tube_distortion_effect_latency,
+    .destroy = tube_distortion_effect_destroy
+};
+
+// Wrap in the effect interface (params: drive, bias, output_gain, mix)
+Effect tube_distortion_effect(TubeDistortion* tube) {
+    Effect effect = { &tube_distortion_vtable, tube };
+    return effect;
 }
 
 // Fuzz distortion functions
 
 // Create fuzz distortion
 FuzzDistortion* fuzz_distortion_create(float sample_rate) {
-    FuzzDistortion* fuzz = malloc(sizeof(FuzzDistortion));
+    FuzzDistortion* fuzz = audio_malloc(sizeof(FuzzDistortion));
     if (!fuzz) return NULL;
     
     fuzz->fuzz_amount = 8.0f;
@@ -208,6 +548,15 @@ FuzzDistortion* fuzz_distortion_create(float sample_rate) {
     biquad_highpass(&fuzz->pre_emphasis, 1000.0f, 2.0f, sample_rate);
     biquad_lowpass(&fuzz->de_emphasis, 4000.0f, 0.7f, sample_rate);
     onepole_lowpass(&fuzz->gate_filter, 10.0f, sample_rate);
+    fuzz_distortion_set_oversampling(fuzz, DISTORTION_DEFAULT_OVERSAMPLING);
+    
+    param_smoother_init(&fuzz->fuzz_amount_smoother, fuzz->fuzz_amount, PARAM_SMOOTH_DEFAULT_MS, sample_rate,
+                        PARAM_SMOOTH_LINEAR);
+    param_smoother_init(&fuzz->gate_threshold_smoother, fuzz->gate_threshold, PARAM_SMOOTH_DEFAULT_MS, sample_rate,
+                        PARAM_SMOOTH_LINEAR);
+    param_smoother_init(&fuzz->output_gain_smoother, fuzz->output_gain, PARAM_SMOOTH_DEFAULT_MS, sample_rate,
+                        PARAM_SMOOTH_LINEAR);
+    param_smoother_init(&fuzz->mix_smoother, fuzz->mix, PARAM_SMOOTH_DEFAULT_MS, sample_rate, PARAM_SMOOTH_LINEAR);
     
     return fuzz;
 }
@@ -215,7 +564,7 @@ FuzzDistortion* fuzz_distortion_create(float sample_rate) {
 // Destroy fuzz distortion
 void fuzz_distortion_destroy(FuzzDistortion* fuzz) {
     if (fuzz) {
-        free(fuzz);
+        audio_free(fuzz);
     }
 }
 
@@ -227,51 +576,186 @@ void fuzz_distortion_set_params(FuzzDistortion* fuzz, float fuzz_amount, float g
     fuzz->gate_threshold = clamp(gate_threshold, 0.001f, 0.1f);
     fuzz->output_gain = clamp(output_gain, 0.1f, 1.0f);
     fuzz->mix = clamp(mix, 0.0f, 1.0f);
+    
+    param_smoother_set_target(&fuzz->fuzz_amount_smoother, fuzz->fuzz_amount);
+    param_smoother_set_target(&fuzz->gate_threshold_smoother, fuzz->gate_threshold);
+    param_smoother_set_target(&fuzz->output_gain_smoother, fuzz->output_gain);
+    param_smoother_set_target(&fuzz->mix_smoother, fuzz->mix);
 }
 
 // Process one sample through fuzz distortion
 sample_t fuzz_distortion_process(FuzzDistortion* fuzz, sample_t input) {
     if (!fuzz) return input;
     
-    // Pre-emphasis
-    sample_t emphasized = biquad_process(&fuzz->pre_emphasis, input);
-    
-    // Gate (noise gate for fuzz character)
-    float gate_signal = onepole_process(&fuzz->gate_filter, fabsf(emphasized), 0);
-    float gate_amount = (gate_signal > fuzz->gate_threshold) ? 1.0f : 0.0f;
-    
-    // Extreme clipping for fuzz
-    sample_t fuzzed = emphasized * fuzz->fuzz_amount;
-    fuzzed = hard_clip(fuzzed, 1.0f);
-    
-    // Add some chaos (bit crushing effect)
-    fuzzed = floorf(fuzzed * 32.0f) / 32.0f;
-    
-    // Apply gate
-    fuzzed *= gate_amount;
-    
-    // De-emphasis and output gain
-    fuzzed = biquad_process(&fuzz->de_emphasis, fuzzed);
-    fuzzed *= fuzz->output_gain;
+    sample_t output;
+    fuzz_distortion_process_block(fuzz, &input, &output, 1);
+    return output;
+}
+
+// Process a block through fuzz distortion (in and out may be the same buffer).
+// Clipping and bit crushing run at the oversampled rate. The gate follows
+// the base-rate signal and is delayed by the latency to meet it again after
+// downsampling.
+void fuzz_distortion_process_block(FuzzDistortion* fuzz, const sample_t* in, sample_t* out, size_t n) {
+    if (!fuzz) {
+        audio_block_bypass(in, out, n);
+        return;
+    }
+    if (!in || !out) return;
+    
+    BiquadFilter pre_emphasis = fuzz->pre_emphasis;
+    BiquadFilter de_emphasis = fuzz->de_emphasis;
+    OnePoleFilter gate_filter = fuzz->gate_filter;
+    Oversampler* oversampler = &fuzz->oversampling.oversampler;
+    const size_t factor = (size_t)oversampler->factor;
+    float fuzz_amount[DISTORTION_BLOCK];
+    float gate_threshold[DISTORTION_BLOCK];
+    float output_gain[DISTORTION_BLOCK];
+    float mix[DISTORTION_BLOCK];
+    sample_t dry[DISTORTION_BLOCK];
+    sample_t wet[DISTORTION_BLOCK];
+    float gate[DISTORTION_BLOCK];
+    sample_t upsampled[DISTORTION_BLOCK * OVERSAMPLE_MAX_FACTOR];
+    
+    param_smoother_update(&fuzz->fuzz_amount_smoother);
+    param_smoother_update(&fuzz->gate_threshold_smoother);
+    param_smoother_update(&fuzz->output_gain_smoother);
+    param_smoother_update(&fuzz->mix_smoother);
+    
+    for (size_t start = 0; start < n; start += DISTORTION_BLOCK) {
+        const size_t count = oversampling_chunk(n - start);
+        smoothed_values(&fuzz->fuzz_amount_smoother, fuzz_amount, count);
+        smoothed_values(&fuzz->gate_threshold_smoother, gate_threshold, count);
+        smoothed_values(&fuzz->output_gain_smoother, output_gain, count);
+        smoothed_values(&fuzz->mix_smoother, mix, count);
+        
+        oversampling_dry(&fuzz->oversampling, in + start, dry, count);
+        for (size_t i = 0; i < count; i++) {
+            sample_t emphasized = biquad_tick(&pre_emphasis, in[start + i]);
+            float gate_signal = onepole_tick_lowpass(&gate_filter, fabsf(emphasized));
+            gate[i] = (gate_signal > gate_threshold[i]) ? 1.0f : 0.0f;
+            wet[i] = emphasized;
+        }
+        
+        oversampler_up(oversampler, wet, upsampled, count);
+        for (size_t i = 0; i < count; i++) {
+            sample_t* group = upsampled + i * factor;
+            for (size_t k = 0; k < factor; k++) {
+                sample_t fuzzed = hard_clip(group[k] * fuzz_amount[i], 1.0f);
+                group[k] = floorf(fuzzed * 32.0f) / 32.0f;
+            }
+        }
+        oversampler_down(oversampler, upsampled, wet, count);
+        latency_delay(fuzz->gate_delay, &fuzz->gate_pos, oversampler->latency, gate, gate, count);
+        
+        for (size_t i = 0; i < count; i++) {
+            sample_t fuzzed = biquad_tick(&de_emphasis, wet[i] * gate[i]) * output_gain[i];
+            out[start + i] = dry[i] + mix[i] * (fuzzed - dry[i]);
+        }
+    }
     
-    // Mix
-    return lerp(input, fuzzed, fuzz->mix);
+    fuzz->pre_emphasis = pre_emphasis;
+    fuzz->de_emphasis = de_emphasis;
+    fuzz->gate_filter = gate_filter;
 }
 
 // Process buffer through fuzz distortion
 void fuzz_distortion_process_buffer(FuzzDistortion* fuzz, AudioBuffer* buffer) {
     if (!fuzz || !buffer || !buffer->data) return;
     
-    for (size_t i = 0; i < buffer->capacity; i++) {
-        buffer->data[i] = fuzz_distortion_process(fuzz, buffer->data[i]);
+    fuzz_distortion_process_block(fuzz, buffer->data, buffer->data, buffer->capacity);
+}
+
+// Block adapter used for per-channel processing
+static void fuzz_distortion_channel_block(void* effect, const sample_t* in, sample_t* out, size_t n) {
+    fuzz_distortion_process_block((FuzzDistortion*)effect, in, out, n);
+}
+
+// Process each channel of an interleaved buffer with its own fuzz distortion instance
+void fuzz_distortion_process_channels(FuzzDistortion** fuzzes, AudioBuffer* buffer) {
+    if (!fuzzes || !buffer || !buffer->data || buffer->channels > MAX_CHANNELS) return;
+    
+    void* instances[MAX_CHANNELS];
+    for (size_t ch = 0; ch < buffer->channels; ch++) {
+        instances[ch] = fuzzes[ch];
     }
+    audio_buffer_process_channels(buffer, fuzz_distortion_channel_block, instances);
+}
+
+// Clear fuzz history (parameters are kept)
+void fuzz_distortion_reset(FuzzDistortion* fuzz) {
+    if (!fuzz) return;
+    
+    biquad_reset(&fuzz->pre_emphasis);
+    biquad_reset(&fuzz->de_emphasis);
+    onepole_reset(&fuzz->gate_filter);
+    oversampling_reset(&fuzz->oversampling);
+    memset(fuzz->gate_delay, 0, sizeof(fuzz->gate_delay));
+    fuzz->gate_pos = 0;
+    
+    param_smoother_snap(&fuzz->fuzz_amount_smoother);
+    param_smoother_snap(&fuzz->gate_threshold_smoother);
+    param_smoother_snap(&fuzz->output_gain_smoother);
+    param_smoother_snap(&fuzz->mix_smoother);
+}
+
+// Run the waveshaper at factor times the sample rate (1 turns oversampling off)
+int fuzz_distortion_set_oversampling(FuzzDistortion* fuzz, int factor) {
+    if (!fuzz || !oversampling_init(&fuzz->oversampling, factor)) return 0;
+    
+    memset(fuzz->gate_delay, 0, sizeof(fuzz->gate_delay));
+    fuzz->gate_pos = 0;
+    return 1;
+}
+
+// Delay of the output behind the input, in samples
+size_t fuzz_distortion_latency(const FuzzDistortion* fuzz) {
+    return fuzz ? fuzz->oversampling.oversampler.latency : 0;
+}
+
+// Effect interface adapters
+static void fuzz_distortion_effect_reset(void* effect) {
+    fuzz_distortion_reset((FuzzDistortion*)effect);
+}
+
+static int fuzz_distortion_effect_set_param(void* effect, int param, float value) {
+    FuzzDistortion* fuzz = (FuzzDistortion*)effect;
+    if (param < 0 || param >= 4) return 0;
+    
+    float p[4] = {fuzz->fuzz_amount, fuzz->gate_threshold, fuzz->output_gain, fuzz->mix};
+    p[param] = value;
+    fuzz_distortion_set_params(fuzz, p[0], p[1], p[2], p[3]);
+    return 1;
+}
+
+static size_t fuzz_distortion_effect_latency(const void* effect) {
+    return fuzz_distortion_latency((const FuzzDistortion*)effect);
+}
+
+static void fuzz_distortion_effect_destroy(void* effect) {
+    fuzz_distortion_destroy((FuzzDistortion*)effect);
+}
+
+static const EffectVTable fuzz_distortion_vtable = {
+    .name = "fuzz",
+    .process_block = fuzz_distortion_channel_block,
+    .reset = fuzz_distortion_effect_reset,
+    .set_param = fuzz_distortion_effect_set_param,
+    .latency = fuzz_distortion_effect_latency,
+    .destroy = fuzz_distortion_effect_destroy
+};
+
+// Wrap in the effect interface (params: fuzz_amount, gate_threshold, output_gain, mix)
+Effect fuzz_distortion_effect(FuzzDistortion* fuzz) {
+    Effect effect = { &fuzz_distortion_vtable, fuzz };
+    return effect;
 }
 
 // Overdrive functions
 
 // Create overdrive effect
 Overdrive* overdrive_create(float sample_rate) {
-    Overdrive* overdrive = malloc(sizeof(Overdrive));
+    Overdrive* overdrive = audio_malloc(sizeof(Overdrive));
     if (!overdrive) return NULL;
     
     overdrive->drive = 4.0f;
@@ -288,6 +772,17 @@ Overdrive* overdrive_create(float sample_rate) {
     overdrive->stage_gains[0] = 2.0f;
     overdrive->stage_gains[1] = 1.5f;
     overdrive->stage_gains[2] = 1.2f;
+    oversampling_init(&overdrive->oversampling, DISTORTION_DEFAULT_OVERSAMPLING);
+    overdrive->accuracy = FAST_MATH_DEFAULT_TIER;
+    
+    param_smoother_init(&overdrive->drive_smoother, overdrive->drive, PARAM_SMOOTH_DEFAULT_MS, sample_rate,
+                        PARAM_SMOOTH_LINEAR);
+    param_smoother_init(&overdrive->tone_smoother, overdrive->tone, PARAM_SMOOTH_DEFAULT_MS, sample_rate,
+                        PARAM_SMOOTH_LINEAR);
+    param_smoother_init(&overdrive->output_gain_smoother, overdrive->output_gain, PARAM_SMOOTH_DEFAULT_MS, sample_rate,
+                        PARAM_SMOOTH_LINEAR);
+    param_smoother_init(&overdrive->mix_smoother, overdrive->mix, PARAM_SMOOTH_DEFAULT_MS, sample_rate,
+                        PARAM_SMOOTH_LINEAR);
     
     return overdrive;
 }
@@ -295,7 +790,7 @@ Overdrive* overdrive_create(float sample_rate) {
 // Destroy overdrive
 void overdrive_destroy(Overdrive* overdrive) {
     if (overdrive) {
-        free(overdrive);
+        audio_free(overdrive);
     }
 }
 
@@ -307,38 +802,179 @@ void overdrive_set_params(Overdrive* overdrive, float drive, float tone, float o
     overdrive->tone = clamp(tone, 0.0f, 1.0f);
     overdrive->output_gain = clamp(output_gain, 0.1f, 2.0f);
     overdrive->mix = clamp(mix, 0.0f, 1.0f);
+    
+    param_smoother_set_target(&overdrive->drive_smoother, overdrive->drive);
+    param_smoother_set_target(&overdrive->tone_smoother, overdrive->tone);
+    param_smoother_set_target(&overdrive->output_gain_smoother, overdrive->output_gain);
+    param_smoother_set_target(&overdrive->mix_smoother, overdrive->mix);
 }
 
 // Process one sample through overdrive
 sample_t overdrive_process(Overdrive* overdrive, sample_t input) {
     if (!overdrive) return input;
     
-    // Input filtering
-    sample_t signal = biquad_process(&overdrive->input_filter, input);
-    
-    // Multi-stage clipping
-    for (int stage = 0; stage < 3; stage++) {
-        signal = soft_clip(signal, overdrive->drive * overdrive->stage_gains[stage]);
-        signal *= 0.7f; // Reduce level between stages
+    sample_t output;
+    overdrive_process_block(overdrive, &input, &output, 1);
+    return output;
+}
+
+// Process a block through overdrive (in and out may be the same buffer).
+// The three clipping stages run at the oversampled rate, the tone and
+// output filters at the base rate.
+void overdrive_process_block(Overdrive* overdrive, const sample_t* in, sample_t* out, size_t n) {
+    if (!overdrive) {
+        audio_block_bypass(in, out, n);
+        return;
+    }
+    if (!in || !out) return;
+    
+    BiquadFilter input_filter = overdrive->input_filter;
+    BiquadFilter tone_filter = overdrive->tone_filter;
+    BiquadFilter output_filter = overdrive->output_filter;
+    Oversampler* oversampler = &overdrive->oversampling.oversampler;
+    const size_t factor = (size_t)oversampler->factor;
+    const float* stage_gains = overdrive->stage_gains;
+    const FastMathTier accuracy = overdrive->accuracy;
+    float drive[DISTORTION_BLOCK];
+    float tone[DISTORTION_BLOCK];
+    float output_gain[DISTORTION_BLOCK];
+    float mix[DISTORTION_BLOCK];
+    sample_t dry[DISTORTION_BLOCK];
+    sample_t wet[DISTORTION_BLOCK];
+    sample_t upsampled[DISTORTION_BLOCK * OVERSAMPLE_MAX_FACTOR];
+    
+    param_smoother_update(&overdrive->drive_smoother);
+    param_smoother_update(&overdrive->tone_smoother);
+    param_smoother_update(&overdrive->output_gain_smoother);
+    param_smoother_update(&overdrive->mix_smoother);
+    
+    for (size_t start = 0; start < n; start += DISTORTION_BLOCK) {
+        const size_t count = oversampling_chunk(n - start);
+        const int drive_ramping = smoothed_values(&overdrive->drive_smoother, drive, count);
+        smoothed_values(&overdrive->tone_smoother, tone, count);
+        smoothed_values(&overdrive->output_gain_smoother, output_gain, count);
+        smoothed_values(&overdrive->mix_smoother, mix, count);
+        
+        oversampling_dry(&overdrive->oversampling, in + start, dry, count);
+        for (size_t i = 0; i < count; i++) {
+            wet[i] = biquad_tick(&input_filter, in[start + i]);
+        }
+        
+        oversampler_up(oversampler, wet, upsampled, count);
+        const size_t groups = drive_ramping ? count : 1;
+        const size_t group_length = count * factor / groups;
+        for (size_t g = 0; g < groups; g++) {
+            sample_t* group = upsampled + g * group_length;
+            for (int stage = 0; stage < 3; stage++) {
+                const float stage_drive = drive[g] * stage_gains[stage];
+                fast_tanh_shape_block(group, group, group_length, stage_drive, 0.7f / stage_drive, accuracy);
+            }
+        }
+        oversampler_down(oversampler, upsampled, wet, count);
+        
+        for (size_t i = 0; i < count; i++) {
+            sample_t signal = wet[i];
+            sample_t toned = biquad_tick(&tone_filter, signal);
+            signal = signal + tone[i] * (toned - signal);
+            
+            signal = biquad_tick(&output_filter, signal) * output_gain[i];
+            out[start + i] = dry[i] + mix[i] * (signal - dry[i]);
+        }
     }
     
-    // Tone control (mix between full signal and mid-boosted signal)
-    sample_t toned = biquad_process(&overdrive->tone_filter, signal);
-    signal = lerp(signal, toned, overdrive->tone);
-    
-    // Output filtering and gain
-    signal = biquad_process(&overdrive->output_filter, signal);
-    signal *= overdrive->output_gain;
-    
-    // Mix
-    return lerp(input, signal, overdrive->mix);
+    overdrive->input_filter = input_filter;
+    overdrive->tone_filter = tone_filter;
+    overdrive->output_filter = output_filter;
 }
 
 // Process buffer through overdrive
 void overdrive_process_buffer(Overdrive* overdrive, AudioBuffer* buffer) {
     if (!overdrive || !buffer || !buffer->data) return;
     
-    for (size_t i = 0; i < buffer->capacity; i++) {
-        buffer->data[i] = overdrive_process(overdrive, buffer->data[i]);
+    overdrive_process_block(overdrive, buffer->data, buffer->data, buffer->capacity);
+}
+
+// Block adapter used for per-channel processing
+static void overdrive_channel_block(void* effect, const sample_t* in, sample_t* out, size_t n) {
+    overdrive_process_block((Overdrive*)effect, in, out, n);
+}
+
+// Process each channel of an interleaved buffer with its own overdrive instance
+void overdrive_process_channels(Overdrive** overdrives, AudioBuffer* buffer) {
+    if (!overdrives || !buffer || !buffer->data || buffer->channels > MAX_CHANNELS) return;
+    
+    void* instances[MAX_CHANNELS];
+    for (size_t ch = 0; ch < buffer->channels; ch++) {
+        instances[ch] = overdrives[ch];
     }
-}
\ No newline at end of file
+    audio_buffer_process_channels(buffer, overdrive_channel_block, instances);
+}
+
+// Clear overdrive history (parameters are kept)
+void overdrive_reset(Overdrive* overdrive) {
+    if (!overdrive) return;
+    
+    biquad_reset(&overdrive->input_filter);
+    biquad_reset(&overdrive->tone_filter);
+    biquad_reset(&overdrive->output_filter);
+    oversampling_reset(&overdrive->oversampling);
+    
+    param_smoother_snap(&overdrive->drive_smoother);
+    param_smoother_snap(&overdrive->tone_smoother);
+    param_smoother_snap(&overdrive->output_gain_smoother);
+    param_smoother_snap(&overdrive->mix_smoother);
+}
+
+// Run the waveshaper at factor times the sample rate (1 turns oversampling off)
+int overdrive_set_oversampling(Overdrive* overdrive, int factor) {
+    if (!overdrive) return 0;
+    return oversampling_init(&overdrive->oversampling, factor);
+}
+
+// Choose the accuracy of the tanh approximation used by the waveshaper
+void overdrive_set_accuracy(Overdrive* overdrive, FastMathTier accuracy) {
+    if (overdrive) overdrive->accuracy = accuracy;
+}
+
+// Delay of the output behind the input, in samples
+size_t overdrive_latency(const Overdrive* overdrive) {
+    return overdrive ? overdrive->oversampling.oversampler.latency : 0;
+}
+
+// Effect interface adapters
+static void overdrive_effect_reset(void* effect) {
+    overdrive_reset((Overdrive*)effect);
+}
+
+static int overdrive_effect_set_param(void* effect, int param, float value) {
+    Overdrive* overdrive = (Overdrive*)effect;
+    if (param < 0 || param >= 4) return 0;
+    
+    float p[4] = {overdrive->drive, overdrive->tone, overdrive->output_gain, overdrive->mix};
+    p[param] = value;
+    overdrive_set_params(overdrive, p[0], p[1], p[2], p[3]);
+    return 1;
+}
+
+static size_t overdrive_effect_latency(const void* effect) {
+    return overdrive_latency((const Overdrive*)effect);
+}
+
+static void overdrive_effect_destroy(void* effect) {
+    overdrive_destroy((Overdrive*)effect);
+}
+
+static const EffectVTable overdrive_vtable = {
+    .name = "overdrive",
+    .process_block = overdrive_channel_block,
+    .reset = overdrive_effect_reset,
+    .set_param = overdrive_effect_set_param,
+    .latency = overdrive_effect_latency,
+    .destroy = overdrive_effect_destroy
+};
+
+// Wrap in the effect interface (params: drive, tone, output_gain, mix)
+Effect overdrive_effect(Overdrive* overdrive) {
+    Effect effect = { &overdrive_vtable, overdrive };
+    return effect;
+}
@@ -0,0 +1,367 @@
+#include "effect_chain.h"
+
+// Latency reported by an effect (0 when it has no latency callback)
+static size_t effect_latency(Effect effect) {
+    if (!effect.vtable || !effect.vtable->latency) return 0;
+    return effect.vtable->latency(effect.state);
+}
+
+static void effect_release(Effect effect) {
+    if (effect.vtable && effect.vtable->destroy) {
+        effect.vtable->destroy(effect.state);
+    }
+}
+
+// Claim the next node slot
+static ChainNode* chain_node_alloc(EffectChain* chain) {
+    if (chain->num_nodes >= EFFECT_CHAIN_MAX_NODES) {
+        audio_log(AUDIO_LOG_ERROR, "Effect chain is full (%d nodes)", EFFECT_CHAIN_MAX_NODES);
+        return NULL;
+    }
+    
+    ChainNode* node = &chain->nodes[chain->num_nodes];
+    memset(node, 0, sizeof(ChainNode));
+    node->level = 1.0f;
+    return node;
+}
+
+// Create an empty chain
+EffectChain* effect_chain_create(float sample_rate) {
+    EffectChain* chain = audio_malloc(sizeof(EffectChain));
+    if (!chain) return NULL;
+    
+    memset(chain, 0, sizeof(EffectChain));
+    chain->sample_rate = sample_rate;
+    
+    return chain;
+}
+
+// Destroy chain and every effect it owns
+void effect_chain_destroy(EffectChain* chain) {
+    if (!chain) return;
+    
+    for (int i = 0; i < chain->num_nodes; i++) {
+        ChainNode* node = &chain->nodes[i];
+        effect_release(node->effect);
+        
+        for (int b = 0; b < node->num_branches; b++) {
+            effect_release(node->branches[b]);
+            delay_line_destroy(node->branch_delays[b]);
+        }
+    }
+    
+    audio_free(chain);
+}
+
+// Append an effect that processes the signal in place
+int effect_chain_add(EffectChain* chain, Effect effect) {
+    if (!chain || !effect.vtable || !effect.vtable->process_block) return -1;
+    
+    ChainNode* node = chain_node_alloc(chain);
+    if (!node) return -1;
+    
+    node->type = CHAIN_NODE_EFFECT;
+    node->effect = effect;
+    
+    return chain->num_nodes++;
+}
+
+// Append parallel branches summed into one signal
+int effect_chain_add_parallel(EffectChain* chain, const Effect* branches, const float* gains, int num_branches) {
+    if (!chain || !branches || num_branches < 1 || num_branches > EFFECT_CHAIN_MAX_BRANCHES) return -1;
+    
+    ChainNode* node = chain_node_alloc(chain);
+    if (!node) return -1;
+    
+    size_t max_latency = 0;
+    for (int b = 0; b < num_branches; b++) {
+        size_t latency = effect_latency(branches[b]);
+        if (latency > max_latency) max_latency = latency;
+    }
+    
+    // Delay the faster branches so all of them line up with the slowest
+    for (int b = 0; b < num_branches; b++) {
+        size_t offset = max_latency - effect_latency(branches[b]);
+        if (offset == 0) continue;
+        
+        node->branch_delays[b] = delay_line_create(offset + EFFECT_CHAIN_BLOCK);
+        if (!node->branch_delays[b]) {
+            for (int j = 0; j < b; j++) {
+                delay_line_destroy(node->branch_delays[j]);
+            }
+            audio_log(AUDIO_LOG_ERROR, "Could not allocate branch compensation delay");
+            return -1;
+        }
+        node->branch_offsets[b] = offset;
+    }
+    
+    node->type = CHAIN_NODE_PARALLEL;
+    node->num_branches = num_branches;
+    for (int b = 0; b < num_branches; b++) {
+        node->branches[b] = branches[b];
+        node->branch_gains[b] = gains ? gains[b] : 1.0f;
+    }
+    
+    return chain->num_nodes++;
+}
+
+// Append a send into a bus
+int effect_chain_add_send(EffectChain* chain, int bus, float level) {
+    if (!chain || bus < 0 || bus >= EFFECT_CHAIN_MAX_BUSES) return -1;
+    
+    ChainNode* node = chain_node_alloc(chain);
+    if (!node) return -1;
+    
+    node->type = CHAIN_NODE_SEND;
+    node->bus = bus;
+    node->level = level;
+    
+    return chain->num_nodes++;
+}
+
+// Append a bus return processed by effect
+int effect_chain_add_return(EffectChain* chain, int bus, Effect effect, float level) {
+    if (!chain || bus < 0 || bus >= EFFECT_CHAIN_MAX_BUSES) return -1;
+    
+    ChainNode* node = chain_node_alloc(chain);
+    if (!node) return -1;
+    
+    node->type = CHAIN_NODE_RETURN;
+    node->bus = bus;
+    node->effect = effect;
+    node->level = level;
+    
+    return chain->num_nodes++;
+}
+
+// Set an effect parameter; returns 0 if the node or parameter is unknown
+int effect_chain_set_param(EffectChain* chain, int node, int param, float value) {
+    if (!chain || node < 0 || node >= chain->num_nodes) return 0;
+    
+    Effect effect = chain->nodes[node].effect;
+    if (!effect.vtable || !effect.vtable->set_param) return 0;
+    
+    return effect.vtable->set_param(effect.state, param, value);
+}
+
+// Set a send or return level
+void effect_chain_set_level(EffectChain* chain, int node, float level) {
+    if (!chain || node < 0 || node >= chain->num_nodes) return;
+    
+    chain->nodes[node].level = level;
+}
+
+// Bypass a node (its effects keep their state but are not run)
+void effect_chain_set_bypass(EffectChain* chain, int node, int bypass) {
+    if (!chain || node < 0 || node >= chain->num_nodes) return;
+    
+    chain->nodes[node].bypass = bypass;
+}
+
+// Clear the history of every effect, bus and compensation delay
+void effect_chain_reset(EffectChain* chain) {
+    if (!chain) return;
+    
+    for (int i = 0; i < chain->num_nodes; i++) {
+        ChainNode* node = &chain->nodes[i];
+        
+        if (node->effect.vtable && node->effect.vtable->reset) {
+            node->effect.vtable->reset(node->effect.state);
+        }
+        for (int b = 0; b < node->num_branches; b++) {
+            Effect branch = node->branches[b];
+            if (branch.vtable && branch.vtable->reset) {
+                branch.vtable->reset(branch.state);
+            }
+            delay_line_clear(node->branch_delays[b]);
+        }
+    }
+    
+    memset(chain->buses, 0, sizeof(chain->buses));
+}
+
+// Latency of the signal path in samples (bypassed nodes count as zero)
+size_t effect_chain_latency(const EffectChain* chain) {
+    if (!chain) return 0;
+    
+    size_t total = 0;
+    for (int i = 0; i < chain->num_nodes; i++) {
+        const ChainNode* node = &chain->nodes[i];
+        if (node->bypass) continue;
+        
+        if (node->type == CHAIN_NODE_EFFECT) {
+            total += effect_latency(node->effect);
+        } else if (node->type == CHAIN_NODE_PARALLEL) {
+            total += node->branch_offsets[0] + effect_latency(node->branches[0]);
+        }
+    }
+    
+    return total;
+}
+
+// Run the parallel branches of node over block (n <= EFFECT_CHAIN_BLOCK)
+static void chain_run_parallel(EffectChain* chain, ChainNode* node, sample_t* block, size_t n) {
+    memcpy(chain->branch_in, block, n * sizeof(sample_t));
+    memset(block, 0, n * sizeof(sample_t));
+    
+    for (int b = 0; b < node->num_branches; b++) {
+        Effect branch = node->branches[b];
+        const float gain = node->branch_gains[b];
+        
+        if (branch.vtable) {
+            branch.vtable->process_block(branch.state, chain->branch_in, chain->branch_out, n);
+        } else {
+            memcpy(chain->branch_out, chain->branch_in, n * sizeof(sample_t));
+        }
+        
+        DelayLine* delay = node->branch_delays[b];
+        if (delay) {
+            delay_line_write_block(delay, chain->branch_out, n);
+            delay_line_read_block(delay, node->branch_offsets[b] + n, chain->branch_out, n);
+        }
+        
+        for (size_t i = 0; i < n; i++) {
+            block[i] += chain->branch_out[i] * gain;
+        }
+    }
+}
+
+// Run every node over one block in place (n <= EFFECT_CHAIN_BLOCK)
+static void chain_run_block(EffectChain* chain, sample_t* block, size_t n) {
+    for (int i = 0; i < chain->num_nodes; i++) {
+        ChainNode* node = &chain->nodes[i];
+        if (node->bypass) continue;
+        
+        switch (node->type) {
+            case CHAIN_NODE_EFFECT:
+                node->effect.vtable->process_block(node->effect.state, block, block, n);
+                break;
+            
+            case CHAIN_NODE_PARALLEL:
+                chain_run_parallel(chain, node, block, n);
+                break;
+            
+            case CHAIN_NODE_SEND: {
+                sample_t* bus = chain->buses[node->bus];
+                const float level = node->level;
+                for (size_t j = 0; j < n; j++) {
+                    bus[j] += block[j] * level;
+                }
+                break;
+            }
+            
+            case CHAIN_NODE_RETURN: {
+                sample_t* bus = chain->buses[node->bus];
+                const float level = node->level;
+                if (node->effect.vtable) {
+                    node->effect.vtable->process_block(node->effect.state, bus, bus, n);
+                }
+                for (size_t j = 0; j < n; j++) {
+                    block[j] += bus[j] * level;
+                }
+                memset(bus, 0, n * sizeof(sample_t));
+                break;
+            }
+        }
+    }
+}
+
+// Process a block through the chain (in and out may be the same buffer).
+// The signal is carried in out, one EFFECT_CHAIN_BLOCK chunk at a time.
+void effect_chain_process_block(EffectChain* chain, const sample_t* in, sample_t* out, size_t n) {
+    if (!chain) {
+        audio_block_bypass(in, out, n);
+        return;
+    }
+    if (!in || !out) return;
+    
+    for (size_t pos = 0; pos < n; pos += EFFECT_CHAIN_BLOCK) {
+        size_t count = n - pos < EFFECT_CHAIN_BLOCK ? n - pos : EFFECT_CHAIN_BLOCK;
+        
+        if (in != out) {
+            memcpy(out + pos, in + pos, count * sizeof(sample_t));
+        }
+        chain_run_block(chain, out + pos, count);
+    }
+}
+
+// Process a block, applying automation events at their frames
+size_t effect_chain_process_automated(EffectChain* chain, const sample_t* in, sample_t* out, size_t n,
+                                      const AutomationEvent* events, size_t num_events) {
+    if (!chain || !events) {
+        effect_chain_process_block(chain, in, out, n);
+        return 0;
+    }
+    if (!in || !out) return 0;
+    
+    size_t applied = 0;
+    size_t event = 0;
+    size_t pos = 0;
+    
+    while (pos < n) {
+        for (; event < num_events && events[event].frame <= pos; event++) {
+            applied += effect_chain_set_param(chain, events[event].node, events[event].param, events[event].value) != 0;
+        }
+        
+        size_t end = (event < num_events && events[event].frame < n) ? events[event].frame : n;
+        effect_chain_process_block(chain, in + pos, out + pos, end - pos);
+        pos = end;
+    }
+    
+    for (; event < num_events; event++) {
+        applied += effect_chain_set_param(chain, events[event].node, events[event].param, events[event].value) != 0;
+    }
+    
+    return applied;
+}
+
+// Process buffer through the chain
+void effect_chain_process_buffer(EffectChain* chain, AudioBuffer* buffer) {
+    if (!chain || !buffer || !buffer->data) return;
+    
+    effect_chain_process_block(chain, buffer->data, buffer->data, buffer->capacity);
+}
+
+// Block adapter used for per-channel processing
+static void effect_chain_channel_block(void* effect, const sample_t* in, sample_t* out, size_t n) {
+    effect_chain_process_block((EffectChain*)effect, in, out, n);
+}
+
+// Process each channel of an interleaved buffer with its own chain
+void effect_chain_process_channels(EffectChain** chains, AudioBuffer* buffer) {
+    if (!chains || !buffer || !buffer->data || buffer->channels > MAX_CHANNELS) return;
+    
+    void* instances[MAX_CHANNELS];
+    for (size_t ch = 0; ch < buffer->channels; ch++) {
+        instances[ch] = chains[ch];
+    }
+    audio_buffer_process_channels(buffer, effect_chain_channel_block, instances);
+}
+
+// Effect interface adapters
+static void effect_chain_effect_reset(void* effect) {
+    effect_chain_reset((EffectChain*)effect);
+}
+
+static size_t effect_chain_effect_latency(const void* effect) {
+    return effect_chain_latency((const EffectChain*)effect);
+}
+
+static void effect_chain_effect_destroy(void* effect) {
+    effect_chain_destroy((EffectChain*)effect);
+}
+
+static const EffectVTable effect_chain_vtable = {
+    .name = "chain",
+    .process_block = effect_chain_channel_block,
+    .reset = effect_chain_effect_reset,
+    .set_param = NULL,
+    .latency = effect_chain_effect_latency,
+    .destroy = effect_chain_effect_destroy
+};
+
+// Wrap a chain in the effect interface (no params; address nodes directly)
+Effect effect_chain_effect(EffectChain* chain) {
+    Effect effect = { &effect_chain_vtable, chain };
+    return effect;
+}
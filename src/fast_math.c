@@ -0,0 +1,379 @@
+#include "fast_math.h"
+#include "cpu_features.h"
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define FAST_MATH_SSE 1
+#endif
+
+// Tanh approximations are odd rationals x * P(x^2) / Q(x^2) evaluated on
+// a clamped input; beyond the clamp each one has reached its final value.
+// LOW is the [5/4] Pade approximant (exact slope at 0, monotonic); MEDIUM
+// and HIGH are minimax fits, the latter with the rounding of float itself.
+#define TANH_LOW_CLAMP 3.5f
+#define TANH_MEDIUM_CLAMP 7.0f
+#define TANH_HIGH_CLAMP 7.90531110763549805f
+
+static const float tanh_medium_p[4] = {9.9999569147e-01f, 1.2302182471e-01f, 2.2769864827e-03f, 3.9299875597e-06f};
+static const float tanh_medium_q[4] = {1.0f, 4.5634031825e-01f, 2.1072173723e-02f, 1.4235043111e-04f};
+static const float tanh_high_p[7] = {
+    4.89352455891786e-03f, 6.37261928875436e-04f, 1.48572235717979e-05f, 5.12229709037114e-08f,
+    -8.60467152213735e-11f, 2.00018790482477e-13f, -2.76076847742355e-16f
+};
+static const float tanh_high_q[4] = {4.89352518554385e-03f, 2.26843463243900e-03f, 1.18534705686654e-04f, 1.19825839466702e-06f};
+
+// exp(x) = 2^n * 2^f with n = round(x / ln 2) and |f| <= 1/2; 2^f is a
+// minimax polynomial (relative error) and 2^n goes into the exponent bits.
+// The remainder x - n ln 2 is taken with ln 2 split in two so it stays
+// exact for large x. The input clamp keeps n inside the normal float range.
+#define EXP_MIN -87.3f
+#define EXP_MAX 88.0f
+#define LOG2_E 1.44269504088896341f
+#define LN2_HI 0.693359375f
+#define LN2_LO -2.12194440e-4f
+
+static const float exp_low_c[4] = {9.9992806588e-01f, 6.9326099784e-01f, 2.4261125287e-01f, 5.5171664366e-02f};
+static const float exp_medium_c[5] = {9.9999926135e-01f, 6.9312181258e-01f, 2.4024744998e-01f, 5.5917878140e-02f, 9.5701013927e-03f};
+static const float exp_high_c[7] = {
+    1.0000000006e+00f, 6.9314720574e-01f, 2.4022646890e-01f, 5.5503287721e-02f,
+    9.6184889809e-03f, 1.3399933189e-03f, 1.5345810244e-04f
+};
+
+// Scalar kernels (reference and fallback)
+
+static inline float clampf(float x, float limit) {
+    return x < -limit ? -limit : (x > limit ? limit : x);
+}
+
+static inline float tanh_scalar(float x, FastMathTier tier) {
+    float x2, p, q;
+    
+    switch (tier) {
+        case FAST_MATH_LOW:
+            x = clampf(x, TANH_LOW_CLAMP);
+            x2 = x * x;
+            p = 945.0f + x2 * (105.0f + x2);
+            q = 945.0f + x2 * (420.0f + x2 * 15.0f);
+            break;
+        case FAST_MATH_HIGH:
+            x = clampf(x, TANH_HIGH_CLAMP);
+            x2 = x * x;
+            p = tanh_high_p[6];
+            for (int k = 5; k >= 0; k--) p = p * x2 + tanh_high_p[k];
+            q = tanh_high_q[3];
+            for (int k = 2; k >= 0; k--) q = q * x2 + tanh_high_q[k];
+            break;
+        case FAST_MATH_MEDIUM:
+        default:
+            x = clampf(x, TANH_MEDIUM_CLAMP);
+            x2 = x * x;
+            p = tanh_medium_p[3];
+            for (int k = 2; k >= 0; k--) p = p * x2 + tanh_medium_p[k];
+            q = tanh_medium_q[3];
+            for (int k = 2; k >= 0; k--) q = q * x2 + tanh_medium_q[k];
+            break;
+    }
+    
+    return x * p / q;
+}
+
+static inline float exp_scalar(float x, FastMathTier tier) {
+    x = x < EXP_MIN ? EXP_MIN : (x > EXP_MAX ? EXP_MAX : x);
+    
+    float t = x * LOG2_E;
+    float n = (float)(int32_t)(t + 0.5f);
+    n -= n > t + 0.5f ? 1.0f : 0.0f;         // Floor for negative t
+    float f = ((x - n * LN2_HI) - n * LN2_LO) * LOG2_E;
+    
+    const float* c;
+    int degree;
+    switch (tier) {
+        case FAST_MATH_LOW: c = exp_low_c; degree = 3; break;
+        case FAST_MATH_HIGH: c = exp_high_c; degree = 6; break;
+        case FAST_MATH_MEDIUM:
+        default: c = exp_medium_c; degree = 4; break;
+    }
+    
+    float p = c[degree];
+    for (int k = degree - 1; k >= 0; k--) p = p * f + c[k];
+    
+    uint32_t bits;
+    memcpy(&bits, &p, sizeof(bits));
+    bits += (uint32_t)(int32_t)n << 23;
+    memcpy(&p, &bits, sizeof(p));
+    return p;
+}
+
+// Shared tanh shaper: out = offset + scale * tanh(gain * (in + bias)), with
+// gain and scale picked by the sign of in + bias
+typedef struct {
+    float bias;
+    float offset;
+    float pos_gain;
+    float pos_scale;
+    float neg_gain;
+    float neg_scale;
+} TanhShape;
+
+static inline float shape_scalar(float x, const TanhShape* shape, FastMathTier tier) {
+    float v = x + shape->bias;
+    int positive = v > 0.0f;
+    float gain = positive ? shape->pos_gain : shape->neg_gain;
+    float scale = positive ? shape->pos_scale : shape->neg_scale;
+    return shape->offset + scale * tanh_scalar(gain * v, tier);
+}
+
+#if defined(FAST_MATH_SSE)
+// SSE kernels: the scalar operations, four samples at a time
+
+static inline __m128 clamp_sse(__m128 x, float limit) {
+    return _mm_min_ps(_mm_max_ps(x, _mm_set1_ps(-limit)), _mm_set1_ps(limit));
+}
+
+static inline __m128 horner_sse(__m128 x, const float* c, int degree) {
+    __m128 p = _mm_set1_ps(c[degree]);
+    for (int k = degree - 1; k >= 0; k--) p = _mm_add_ps(_mm_mul_ps(p, x), _mm_set1_ps(c[k]));
+    return p;
+}
+
+static inline __m128 tanh_sse(__m128 x, FastMathTier tier) {
+    __m128 x2, p, q;
+    
+    switch (tier) {
+        case FAST_MATH_LOW:
+            x = clamp_sse(x, TANH_LOW_CLAMP);
+            x2 = _mm_mul_ps(x, x);
+            p = _mm_add_ps(_mm_set1_ps(945.0f), _mm_mul_ps(x2, _mm_add_ps(_mm_set1_ps(105.0f), x2)));
+            q = _mm_add_ps(_mm_set1_ps(945.0f),
+                           _mm_mul_ps(x2, _mm_add_ps(_mm_set1_ps(420.0f), _mm_mul_ps(x2, _mm_set1_ps(15.0f)))));
+            break;
+        case FAST_MATH_HIGH:
+            x = clamp_sse(x, TANH_HIGH_CLAMP);
+            x2 = _mm_mul_ps(x, x);
+            p = horner_sse(x2, tanh_high_p, 6);
+            q = horner_sse(x2, tanh_high_q, 3);
+            break;
+        case FAST_MATH_MEDIUM:
+        default:
+            x = clamp_sse(x, TANH_MEDIUM_CLAMP);
+            x2 = _mm_mul_ps(x, x);
+            p = horner_sse(x2, tanh_medium_p, 3);
+            q = horner_sse(x2, tanh_medium_q, 3);
+            break;
+    }
+    
+    return _mm_div_ps(_mm_mul_ps(x, p), q);
+}
+
+static inline __m128 exp_sse(__m128 x, FastMathTier tier) {
+    x = _mm_min_ps(_mm_max_ps(x, _mm_set1_ps(EXP_MIN)), _mm_set1_ps(EXP_MAX));
+    
+    __m128 t = _mm_mul_ps(x, _mm_set1_ps(LOG2_E));
+    __m128 half_up = _mm_add_ps(t, _mm_set1_ps(0.5f));
+    __m128 n = _mm_cvtepi32_ps(_mm_cvttps_epi32(half_up));
+    n = _mm_sub_ps(n, _mm_and_ps(_mm_cmpgt_ps(n, half_up), _mm_set1_ps(1.0f)));
+    __m128 r = _mm_sub_ps(_mm_sub_ps(x, _mm_mul_ps(n, _mm_set1_ps(LN2_HI))), _mm_mul_ps(n, _mm_set1_ps(LN2_LO)));
+    __m128 f = _mm_mul_ps(r, _mm_set1_ps(LOG2_E));
+    
+    __m128 p;
+    switch (tier) {
+        case FAST_MATH_LOW: p = horner_sse(f, exp_low_c, 3); break;
+        case FAST_MATH_HIGH: p = horner_sse(f, exp_high_c, 6); break;
+        case FAST_MATH_MEDIUM:
+        default: p = horner_sse(f, exp_medium_c, 4); break;
+    }
+    
+    __m128i scale = _mm_slli_epi32(_mm_cvttps_epi32(n), 23);
+    return _mm_castsi128_ps(_mm_add_epi32(_mm_castps_si128(p), scale));
+}
+
+static inline __m128 shape_sse(__m128 x, const TanhShape* shape, FastMathTier tier) {
+    __m128 v = _mm_add_ps(x, _mm_set1_ps(shape->bias));
+    __m128 positive = _mm_cmpgt_ps(v, _mm_setzero_ps());
+    __m128 gain = _mm_or_ps(_mm_and_ps(positive, _mm_set1_ps(shape->pos_gain)),
+                            _mm_andnot_ps(positive, _mm_set1_ps(shape->neg_gain)));
+    __m128 scale = _mm_or_ps(_mm_and_ps(positive, _mm_set1_ps(shape->pos_scale)),
+                             _mm_andnot_ps(positive, _mm_set1_ps(shape->neg_scale)));
+    __m128 shaped = _mm_mul_ps(scale, tanh_sse(_mm_mul_ps(gain, v), tier));
+    return _mm_add_ps(_mm_set1_ps(shape->offset), shaped);
+}
+#endif // FAST_MATH_SSE
+
+// Block drivers: SSE for whole registers, scalar for the tail. Each
+// dispatcher passes the tier as a constant so the loops are specialized.
+
+static inline void shape_loop(const float* in, float* out, size_t n, const TanhShape* shape, FastMathTier tier) {
+    size_t i = 0;
+#if defined(FAST_MATH_SSE)
+    if (cpu_simd_level() >= SIMD_LEVEL_SSE2) {
+        for (; i + 4 <= n; i += 4) {
+            _mm_storeu_ps(out + i, shape_sse(_mm_loadu_ps(in + i), shape, tier));
+        }
+    }
+#endif
+    for (; i < n; i++) {
+        out[i] = shape_scalar(in[i], shape, tier);
+    }
+}
+
+static void shape_block(const float* in, float* out, size_t n, const TanhShape* shape, FastMathTier tier) {
+    if (!in || !out) return;
+    
+    switch (tier) {
+        case FAST_MATH_LOW: shape_loop(in, out, n, shape, FAST_MATH_LOW); break;
+        case FAST_MATH_HIGH: shape_loop(in, out, n, shape, FAST_MATH_HIGH); break;
+        case FAST_MATH_MEDIUM:
+        default: shape_loop(in, out, n, shape, FAST_MATH_MEDIUM); break;
+    }
+}
+
+// exp, or the logistic 1 / (1 + e^-x) when sigmoid is set
+static inline void exp_loop(const float* in, float* out, size_t n, FastMathTier tier, int sigmoid) {
+    size_t i = 0;
+#if defined(FAST_MATH_SSE)
+    if (cpu_simd_level() >= SIMD_LEVEL_SSE2) {
+        const __m128 one = _mm_set1_ps(1.0f);
+        for (; i + 4 <= n; i += 4) {
+            __m128 x = _mm_loadu_ps(in + i);
+            __m128 y = sigmoid ? _mm_div_ps(one, _mm_add_ps(one, exp_sse(_mm_sub_ps(_mm_setzero_ps(), x), tier)))
+                               : exp_sse(x, tier);
+            _mm_storeu_ps(out + i, y);
+        }
+    }
+#endif
+    for (; i < n; i++) {
+        out[i] = sigmoid ? 1.0f / (1.0f + exp_scalar(-in[i], tier)) : exp_scalar(in[i], tier);
+    }
+}
+
+static void exp_block(const float* in, float* out, size_t n, FastMathTier tier, int sigmoid) {
+    if (!in || !out) return;
+    
+    switch (tier) {
+        case FAST_MATH_LOW: exp_loop(in, out, n, FAST_MATH_LOW, sigmoid); break;
+        case FAST_MATH_HIGH: exp_loop(in, out, n, FAST_MATH_HIGH, sigmoid); break;
+        case FAST_MATH_MEDIUM:
+        default: exp_loop(in, out, n, FAST_MATH_MEDIUM, sigmoid); break;
+    }
+}
+
+// Single values
+
+float fast_tanh(float x, FastMathTier tier) {
+    return tanh_scalar(x, tier);
+}
+
+float fast_exp(float x, FastMathTier tier) {
+    return exp_scalar(x, tier);
+}
+
+float fast_sigmoid(float x, FastMathTier tier) {
+    return 1.0f / (1.0f + exp_scalar(-x, tier));
+}
+
+// Blocks
+
+void fast_tanh_block(const float* in, float* out, size_t n, FastMathTier tier) {
+    const TanhShape shape = {0.0f, 0.0f, 1.0f, 1.0f, 1.0f, 1.0f};
+    shape_block(in, out, n, &shape, tier);
+}
+
+void fast_exp_block(const float* in, float* out, size_t n, FastMathTier tier) {
+    exp_block(in, out, n, tier, 0);
+}
+
+void fast_sigmoid_block(const float* in, float* out, size_t n, FastMathTier tier) {
+    exp_block(in, out, n, tier, 1);
+}
+
+// Symmetric tanh waveshaper: scale * tanh(gain * in)
+void fast_tanh_shape_block(const float* in, float* out, size_t n, float gain, float scale, FastMathTier tier) {
+    const TanhShape shape = {0.0f, 0.0f, gain, scale, gain, scale};
+    shape_block(in, out, n, &shape, tier);
+}
+
+// Asymmetric tanh waveshaper with a DC bias (tube-style)
+void fast_asym_shape_block(const float* in, float* out, size_t n, float bias,
+                           float pos_gain, float pos_scale, float neg_gain, float neg_scale,
+                           FastMathTier tier) {
+    const TanhShape shape = {bias, 0.0f, pos_gain, pos_scale, neg_gain, neg_scale};
+    shape_block(in, out, n, &shape, tier);
+}
+
+// Accuracy report
+
+#define MEASURE_CHUNK 256
+
+// Compare the block kernel with libm (in double) at evenly spaced inputs
+FastMathError fast_math_measure(FastMathFunction function, FastMathTier tier, float lo, float hi, size_t points) {
+    FastMathError error = {0.0, 0.0, lo};
+    if (points < 2) points = 2;
+    
+    float x[MEASURE_CHUNK];
+    float y[MEASURE_CHUNK];
+    const double step = ((double)hi - (double)lo) / (double)(points - 1);
+    
+    for (size_t start = 0; start < points; start += MEASURE_CHUNK) {
+        size_t count = points - start < MEASURE_CHUNK ? points - start : MEASURE_CHUNK;
+        for (size_t i = 0; i < count; i++) {
+            x[i] = (float)(lo + step * (double)(start + i));
+        }
+        
+        switch (function) {
+            case FAST_MATH_EXP: fast_exp_block(x, y, count, tier); break;
+            case FAST_MATH_SIGMOID: fast_sigmoid_block(x, y, count, tier); break;
+            case FAST_MATH_TANH:
+            default: fast_tanh_block(x, y, count, tier); break;
+        }
+        
+        for (size_t i = 0; i < count; i++) {
+            double reference;
+            switch (function) {
+                case FAST_MATH_EXP: reference = exp((double)x[i]); break;
+                case FAST_MATH_SIGMOID: reference = 1.0 / (1.0 + exp(-(double)x[i])); break;
+                case FAST_MATH_TANH:
+                default: reference = tanh((double)x[i]); break;
+            }
+            
+            double abs_error = fabs((double)y[i] - reference);
+            if (abs_error > error.max_abs_error) {
+                error.max_abs_error = abs_error;
+                error.worst_input = x[i];
+            }
+            if (reference != 0.0 && abs_error / fabs(reference) > error.max_rel_error) {
+                error.max_rel_error = abs_error / fabs(reference);
+            }
+        }
+    }
+    
+    return error;
+}
+
+// Documented error bound of each approximation (relative for exp)
+double fast_math_error_bound(FastMathFunction function, FastMathTier tier) {
+    static const double bounds[3][3] = {
+        {1.1e-3, 1.5e-6, 5e-7},   // tanh
+        {8e-5, 3e-6, 2e-7},       // exp
+        {2e-5, 1e-6, 2e-7}        // sigmoid
+    };
+    if ((int)function < 0 || function > FAST_MATH_SIGMOID || (int)tier < 0 || tier > FAST_MATH_HIGH) return 0.0;
+    return bounds[function][tier];
+}
+
+const char* fast_math_tier_name(FastMathTier tier) {
+    switch (tier) {
+        case FAST_MATH_LOW: return "low";
+        case FAST_MATH_MEDIUM: return "medium";
+        case FAST_MATH_HIGH: return "high";
+        default: return "unknown";
+    }
+}
+
+const char* fast_math_function_name(FastMathFunction function) {
+    switch (function) {
+        case FAST_MATH_TANH: return "tanh";
+        case FAST_MATH_EXP: return "exp";
+        case FAST_MATH_SIGMOID: return "sigmoid";
+        default: return "unknown";
+    }
+}
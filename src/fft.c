@@ -0,0 +1,629 @@
+#define _POSIX_C_SOURCE 200112L // pthreads
+#include "fft.h"
+#include "cpu_features.h"
+#include <pthread.h>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define FFT_SSE 1
+#endif
+#if defined(AUDIO_X86_DISPATCH)
+#include <immintrin.h>
+#endif
+
+// Shared plans, indexed by log2 of the real size
+static FftPlan* fft_plan_cache[21];
+static pthread_mutex_t fft_plan_cache_lock = PTHREAD_MUTEX_INITIALIZER;
+
+// Create a plan for a real transform of size points
+FftPlan* fft_plan_create(size_t size) {
+    if (size < FFT_MIN_SIZE || size > FFT_MAX_SIZE || (size & (size - 1))) return NULL;
+    
+    FftPlan* plan = audio_calloc(1, sizeof(FftPlan));
+    if (!plan) return NULL;
+    
+    const size_t half = size / 2;
+    int bits = 0;
+    while (((size_t)1 << bits) < half) bits++;
+    
+    plan->size = size;
+    plan->half = half;
+    plan->bits = bits;
+    plan->bitrev = audio_malloc(half * sizeof(uint32_t));
+    plan->twiddles = audio_malloc(2 * half * sizeof(float));
+    plan->real_cos = audio_malloc((half / 2 + 1) * sizeof(float));
+    plan->real_sin = audio_malloc((half / 2 + 1) * sizeof(float));
+    if (!plan->bitrev || !plan->twiddles || !plan->real_cos || !plan->real_sin) {
+        fft_plan_destroy(plan);
+        return NULL;
+    }
+    
+    for (size_t i = 0; i < half; i++) {
+        uint32_t r = 0;
+        for (int b = 0; b < bits; b++) {
+            r |= (uint32_t)((i >> b) & 1) << (bits - 1 - b);
+        }
+        plan->bitrev[i] = r;
+    }
+    
+    // Each radix-4 pass over groups of 4h needs W^j, W^2j and W^3j of
+    // W = e^(-2 pi i / 4h) for j < h, stored as six arrays of h
+    float* w = plan->twiddles;
+    for (size_t h = (bits & 1) ? 2 : 1; h < half; h *= 4) {
+        for (size_t j = 0; j < h; j++) {
+            for (int m = 1; m <= 3; m++) {
+                double angle = -TWO_PI * (double)(m * j) / (double)(4 * h);
+                w[(2 * m - 2) * h + j] = (float)cos(angle);
+                w[(2 * m - 1) * h + j] = (float)sin(angle);
+            }
+        }
+        w += 6 * h;
+    }
+    
+    for (size_t k = 0; k <= half / 2; k++) {
+        plan->real_cos[k] = (float)cos(TWO_PI * (double)k / (double)size);
+        plan->real_sin[k] = (float)sin(TWO_PI * (double)k / (double)size);
+    }
+    
+    return plan;
+}
+
+// Destroy plan
+void fft_plan_destroy(FftPlan* plan) {
+    if (plan) {
+        audio_free(plan->bitrev);
+        audio_free(plan->twiddles);
+        audio_free(plan->real_cos);
+        audio_free(plan->real_sin);
+        audio_free(plan);
+    }
+}
+
+// Get the shared plan for size, creating it on first use
+FftPlan* fft_plan_acquire(size_t size) {
+    if (size < FFT_MIN_SIZE || size > FFT_MAX_SIZE || (size & (size - 1))) return NULL;
+    
+    int index = 0;
+    while (((size_t)1 << index) < size) index++;
+    
+    pthread_mutex_lock(&fft_plan_cache_lock);
+    FftPlan* plan = fft_plan_cache[index];
+    if (!plan) {
+        plan = fft_plan_create(size);
+        fft_plan_cache[index] = plan;
+    }
+    if (plan) {
+        plan->users++;
+    }
+    pthread_mutex_unlock(&fft_plan_cache_lock);
+    
+    return plan;
+}
+
+// Drop a reference to a shared plan, freeing it with the last one
+void fft_plan_release(FftPlan* plan) {
+    if (!plan) return;
+    
+    pthread_mutex_lock(&fft_plan_cache_lock);
+    if (plan->users > 0 && --plan->users == 0) {
+        fft_plan_cache[plan->bits + 1] = NULL;
+        fft_plan_destroy(plan);
+    }
+    pthread_mutex_unlock(&fft_plan_cache_lock);
+}
+
+// Radix-4 butterfly on already twiddled inputs, for any vector width
+#define FFT_BUTTERFLY4(T, ADD, SUB, x0r, x0i, t1r, t1i, t2r, t2i, t3r, t3i, \
+                       y0r, y0i, y1r, y1i, y2r, y2i, y3r, y3i) \
+    do { \
+        T a0r_ = ADD(x0r, t1r), a0i_ = ADD(x0i, t1i); \
+        T a1r_ = SUB(x0r, t1r), a1i_ = SUB(x0i, t1i); \
+        T c2r_ = ADD(t2r, t3r), c2i_ = ADD(t2i, t3i); \
+        T c3r_ = SUB(t2r, t3r), c3i_ = SUB(t2i, t3i); \
+        y0r = ADD(a0r_, c2r_); \
+        y0i = ADD(a0i_, c2i_); \
+        y1r = ADD(a1r_, c3i_); \
+        y1i = SUB(a1i_, c3r_); \
+        y2r = SUB(a0r_, c2r_); \
+        y2i = SUB(a0i_, c2i_); \
+        y3r = SUB(a1r_, c3i_); \
+        y3i = ADD(a1i_, c3r_); \
+    } while (0)
+
+#define FFT_ADD(a, b) ((a) + (b))
+#define FFT_SUB(a, b) ((a) - (b))
+
+// Radix-2 first pass, used when log2(N/2) is odd
+static void radix2_pass_scalar(float* re, float* im, size_t n) {
+    for (size_t j = 0; j < n; j += 2) {
+        float ar = re[j], ai = im[j];
+        float br = re[j + 1], bi = im[j + 1];
+        re[j] = ar + br;
+        im[j] = ai + bi;
+        re[j + 1] = ar - br;
+        im[j + 1] = ai - bi;
+    }
+}
+
+// Radix-4 pass over groups of 4h; w points at the pass's six twiddle arrays
+static void radix4_pass_scalar(float* re, float* im, size_t n, size_t h, const float* w) {
+    const float* w1r = w;
+    const float* w1i = w + h;
+    const float* w2r = w + 2 * h;
+    const float* w2i = w + 3 * h;
+    const float* w3r = w + 4 * h;
+    const float* w3i = w + 5 * h;
+    
+    for (size_t g = 0; g < n; g += 4 * h) {
+        float* r0 = re + g;
+        float* i0 = im + g;
+        for (size_t j = 0; j < h; j++) {
+            float x1r = r0[j + h], x1i = i0[j + h];
+            float x2r = r0[j + 2 * h], x2i = i0[j + 2 * h];
+            float x3r = r0[j + 3 * h], x3i = i0[j + 3 * h];
+            
+            float t1r = w2r[j] * x1r - w2i[j] * x1i;
+            float t1i = w2r[j] * x1i + w2i[j] * x1r;
+            float t2r = w1r[j] * x2r - w1i[j] * x2i;
+            float t2i = w1r[j] * x2i + w1i[j] * x2r;
+            float t3r = w3r[j] * x3r - w3i[j] * x3i;
+            float t3i = w3r[j] * x3i + w3i[j] * x3r;
+            
+            float y0r, y0i, y1r, y1i, y2r, y2i, y3r, y3i;
+            FFT_BUTTERFLY4(float, FFT_ADD, FFT_SUB, r0[j], i0[j], t1r, t1i, t2r, t2i, t3r, t3i,
+                           y0r, y0i, y1r, y1i, y2r, y2i, y3r, y3i);
+            r0[j] = y0r;
+            i0[j] = y0i;
+            r0[j + h] = y1r;
+            i0[j + h] = y1i;
+            r0[j + 2 * h] = y2r;
+            i0[j + 2 * h] = y2i;
+            r0[j + 3 * h] = y3r;
+            i0[j + 3 * h] = y3i;
+        }
+    }
+}
+
+#if defined(FFT_SSE)
+#define FFT_REVERSE(v) _mm_shuffle_ps((v), (v), _MM_SHUFFLE(0, 1, 2, 3))
+
+static inline void cmul_sse(__m128 xr, __m128 xi, __m128 wr, __m128 wi, __m128* yr, __m128* yi) {
+    *yr = _mm_sub_ps(_mm_mul_ps(wr, xr), _mm_mul_ps(wi, xi));
+    *yi = _mm_add_ps(_mm_mul_ps(wr, xi), _mm_mul_ps(wi, xr));
+}
+
+// Radix-2 first pass: pairs are neighbours, so split even and odd lanes
+// (n >= 8)
+static void radix2_pass_sse(float* re, float* im, size_t n) {
+    float* parts[2] = {re, im};
+    for (int p = 0; p < 2; p++) {
+        float* x = parts[p];
+        for (size_t j = 0; j < n; j += 8) {
+            __m128 a = _mm_loadu_ps(x + j);
+            __m128 b = _mm_loadu_ps(x + j + 4);
+            __m128 even = _mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0));
+            __m128 odd = _mm_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1));
+            __m128 sum = _mm_add_ps(even, odd);
+            __m128 diff = _mm_sub_ps(even, odd);
+            _mm_storeu_ps(x + j, _mm_unpacklo_ps(sum, diff));
+            _mm_storeu_ps(x + j + 4, _mm_unpackhi_ps(sum, diff));
+        }
+    }
+}
+
+// First radix-4 pass (h = 1, no twiddles): four groups of four are
+// transposed so each register holds one butterfly input of every group
+static void radix4_first_sse(float* re, float* im, size_t n) {
+    for (size_t g = 0; g < n; g += 16) {
+        __m128 r0 = _mm_loadu_ps(re + g), r1 = _mm_loadu_ps(re + g + 4);
+        __m128 r2 = _mm_loadu_ps(re + g + 8), r3 = _mm_loadu_ps(re + g + 12);
+        __m128 i0 = _mm_loadu_ps(im + g), i1 = _mm_loadu_ps(im + g + 4);
+        __m128 i2 = _mm_loadu_ps(im + g + 8), i3 = _mm_loadu_ps(im + g + 12);
+        _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+        _MM_TRANSPOSE4_PS(i0, i1, i2, i3);
+        FFT_BUTTERFLY4(__m128, _mm_add_ps, _mm_sub_ps, r0, i0, r1, i1, r2, i2, r3, i3,
+                       r0, i0, r1, i1, r2, i2, r3, i3);
+        _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+        _MM_TRANSPOSE4_PS(i0, i1, i2, i3);
+        _mm_storeu_ps(re + g, r0);
+        _mm_storeu_ps(re + g + 4, r1);
+        _mm_storeu_ps(re + g + 8, r2);
+        _mm_storeu_ps(re + g + 12, r3);
+        _mm_storeu_ps(im + g, i0);
+        _mm_storeu_ps(im + g + 4, i1);
+        _mm_storeu_ps(im + g + 8, i2);
+        _mm_storeu_ps(im + g + 12, i3);
+    }
+}
+
+// Radix-4 pass with h = 2: the quarters of two groups of eight are paired
+// so each register holds the same butterfly input of both groups
+static void radix4_h2_sse(float* re, float* im, size_t n, const float* w) {
+    const __m128 w1r = _mm_setr_ps(w[0], w[1], w[0], w[1]);
+    const __m128 w1i = _mm_setr_ps(w[2], w[3], w[2], w[3]);
+    const __m128 w2r = _mm_setr_ps(w[4], w[5], w[4], w[5]);
+    const __m128 w2i = _mm_setr_ps(w[6], w[7], w[6], w[7]);
+    const __m128 w3r = _mm_setr_ps(w[8], w[9], w[8], w[9]);
+    const __m128 w3i = _mm_setr_ps(w[10], w[11], w[10], w[11]);
+    float* parts[2] = {re, im};
+    
+    for (size_t g = 0; g < n; g += 16) {
+        __m128 x[2][4];
+        for (int p = 0; p < 2; p++) {
+            const float* src = parts[p] + g;
+            __m128 a1 = _mm_loadu_ps(src), b1 = _mm_loadu_ps(src + 4);
+            __m128 a2 = _mm_loadu_ps(src + 8), b2 = _mm_loadu_ps(src + 12);
+            x[p][0] = _mm_movelh_ps(a1, a2);
+            x[p][1] = _mm_movehl_ps(a2, a1);
+            x[p][2] = _mm_movelh_ps(b1, b2);
+            x[p][3] = _mm_movehl_ps(b2, b1);
+        }
+        
+        __m128 t1r, t1i, t2r, t2i, t3r, t3i;
+        cmul_sse(x[0][1], x[1][1], w2r, w2i, &t1r, &t1i);
+        cmul_sse(x[0][2], x[1][2], w1r, w1i, &t2r, &t2i);
+        cmul_sse(x[0][3], x[1][3], w3r, w3i, &t3r, &t3i);
+        
+        __m128 y[2][4];
+        FFT_BUTTERFLY4(__m128, _mm_add_ps, _mm_sub_ps, x[0][0], x[1][0], t1r, t1i, t2r, t2i, t3r, t3i,
+                       y[0][0], y[1][0], y[0][1], y[1][1], y[0][2], y[1][2], y[0][3], y[1][3]);
+        
+        for (int p = 0; p < 2; p++) {
+            float* dst = parts[p] + g;
+            _mm_storeu_ps(dst, _mm_movelh_ps(y[p][0], y[p][1]));
+            _mm_storeu_ps(dst + 4, _mm_movelh_ps(y[p][2], y[p][3]));
+            _mm_storeu_ps(dst + 8, _mm_movehl_ps(y[p][1], y[p][0]));
+            _mm_storeu_ps(dst + 12, _mm_movehl_ps(y[p][3], y[p][2]));
+        }
+    }
+}
+
+// Radix-4 pass with h a multiple of 4: four butterflies per register
+static void radix4_pass_sse(float* re, float* im, size_t n, size_t h, const float* w) {
+    for (size_t g = 0; g < n; g += 4 * h) {
+        float* r0 = re + g;
+        float* i0 = im + g;
+        for (size_t j = 0; j < h; j += 4) {
+            __m128 t1r, t1i, t2r, t2i, t3r, t3i;
+            cmul_sse(_mm_loadu_ps(r0 + j + h), _mm_loadu_ps(i0 + j + h),
+                     _mm_loadu_ps(w + 2 * h + j), _mm_loadu_ps(w + 3 * h + j), &t1r, &t1i);
+            cmul_sse(_mm_loadu_ps(r0 + j + 2 * h), _mm_loadu_ps(i0 + j + 2 * h),
+                     _mm_loadu_ps(w + j), _mm_loadu_ps(w + h + j), &t2r, &t2i);
+            cmul_sse(_mm_loadu_ps(r0 + j + 3 * h), _mm_loadu_ps(i0 + j + 3 * h),
+                     _mm_loadu_ps(w + 4 * h + j), _mm_loadu_ps(w + 5 * h + j), &t3r, &t3i);
+            
+            __m128 y0r, y0i, y1r, y1i, y2r, y2i, y3r, y3i;
+            FFT_BUTTERFLY4(__m128, _mm_add_ps, _mm_sub_ps, _mm_loadu_ps(r0 + j), _mm_loadu_ps(i0 + j),
+                           t1r, t1i, t2r, t2i, t3r, t3i, y0r, y0i, y1r, y1i, y2r, y2i, y3r, y3i);
+            _mm_storeu_ps(r0 + j, y0r);
+            _mm_storeu_ps(i0 + j, y0i);
+            _mm_storeu_ps(r0 + j + h, y1r);
+            _mm_storeu_ps(i0 + j + h, y1i);
+            _mm_storeu_ps(r0 + j + 2 * h, y2r);
+            _mm_storeu_ps(i0 + j + 2 * h, y2i);
+            _mm_storeu_ps(r0 + j + 3 * h, y3r);
+            _mm_storeu_ps(i0 + j + 3 * h, y3i);
+        }
+    }
+}
+#endif // FFT_SSE
+
+#if defined(AUDIO_X86_DISPATCH)
+// Radix-4 pass with h a multiple of 8: eight butterflies per register
+AUDIO_TARGET_AVX2
+static void radix4_pass_avx2(float* re, float* im, size_t n, size_t h, const float* w) {
+    for (size_t g = 0; g < n; g += 4 * h) {
+        float* r0 = re + g;
+        float* i0 = im + g;
+        for (size_t j = 0; j < h; j += 8) {
+            __m256 x1r = _mm256_loadu_ps(r0 + j + h), x1i = _mm256_loadu_ps(i0 + j + h);
+            __m256 x2r = _mm256_loadu_ps(r0 + j + 2 * h), x2i = _mm256_loadu_ps(i0 + j + 2 * h);
+            __m256 x3r = _mm256_loadu_ps(r0 + j + 3 * h), x3i = _mm256_loadu_ps(i0 + j + 3 * h);
+            __m256 w1r = _mm256_loadu_ps(w + j), w1i = _mm256_loadu_ps(w + h + j);
+            __m256 w2r = _mm256_loadu_ps(w + 2 * h + j), w2i = _mm256_loadu_ps(w + 3 * h + j);
+            __m256 w3r = _mm256_loadu_ps(w + 4 * h + j), w3i = _mm256_loadu_ps(w + 5 * h + j);
+            
+            __m256 t1r = _mm256_fmsub_ps(w2r, x1r, _mm256_mul_ps(w2i, x1i));
+            __m256 t1i = _mm256_fmadd_ps(w2r, x1i, _mm256_mul_ps(w2i, x1r));
+            __m256 t2r = _mm256_fmsub_ps(w1r, x2r, _mm256_mul_ps(w1i, x2i));
+            __m256 t2i = _mm256_fmadd_ps(w1r, x2i, _mm256_mul_ps(w1i, x2r));
+            __m256 t3r = _mm256_fmsub_ps(w3r, x3r, _mm256_mul_ps(w3i, x3i));
+            __m256 t3i = _mm256_fmadd_ps(w3r, x3i, _mm256_mul_ps(w3i, x3r));
+            
+            __m256 y0r, y0i, y1r, y1i, y2r, y2i, y3r, y3i;
+            FFT_BUTTERFLY4(__m256, _mm256_add_ps, _mm256_sub_ps, _mm256_loadu_ps(r0 + j), _mm256_loadu_ps(i0 + j),
+                           t1r, t1i, t2r, t2i, t3r, t3i, y0r, y0i, y1r, y1i, y2r, y2i, y3r, y3i);
+            _mm256_storeu_ps(r0 + j, y0r);
+            _mm256_storeu_ps(i0 + j, y0i);
+            _mm256_storeu_ps(r0 + j + h, y1r);
+            _mm256_storeu_ps(i0 + j + h, y1i);
+            _mm256_storeu_ps(r0 + j + 2 * h, y2r);
+            _mm256_storeu_ps(i0 + j + 2 * h, y2i);
+            _mm256_storeu_ps(r0 + j + 3 * h, y3r);
+            _mm256_storeu_ps(i0 + j + 3 * h, y3i);
+        }
+    }
+}
+
+// acc += a * b over k in [start, end), end - start a multiple of 8
+AUDIO_TARGET_AVX2
+static void spectrum_mac_avx2(const float* ar, const float* ai, const float* br, const float* bi,
+                              float* cr, float* ci, size_t end) {
+    for (size_t k = 0; k < end; k += 8) {
+        __m256 xr = _mm256_loadu_ps(ar + k);
+        __m256 xi = _mm256_loadu_ps(ai + k);
+        __m256 yr = _mm256_loadu_ps(br + k);
+        __m256 yi = _mm256_loadu_ps(bi + k);
+        __m256 re = _mm256_fnmadd_ps(xi, yi, _mm256_fmadd_ps(xr, yr, _mm256_loadu_ps(cr + k)));
+        __m256 im = _mm256_fmadd_ps(xi, yr, _mm256_fmadd_ps(xr, yi, _mm256_loadu_ps(ci + k)));
+        _mm256_storeu_ps(cr + k, re);
+        _mm256_storeu_ps(ci + k, im);
+    }
+}
+#endif // AUDIO_X86_DISPATCH
+
+// Forward complex FFT of bit-reversed input, in place, natural-order
+// output. Each pass runs the widest kernel its butterfly spacing allows.
+static void fft_complex(const FftPlan* plan, float* re, float* im) {
+    const size_t n = plan->half;
+    const SimdLevel level = cpu_simd_level();
+    const float* w = plan->twiddles;
+    size_t h = 1;
+    (void)level;
+    
+    if (plan->bits & 1) {
+#if defined(FFT_SSE)
+        if (level >= SIMD_LEVEL_SSE2 && n >= 8) {
+            radix2_pass_sse(re, im, n);
+        } else
+#endif
+        radix2_pass_scalar(re, im, n);
+        h = 2;
+    }
+    
+    for (; h < n; w += 6 * h, h *= 4) {
+#if defined(AUDIO_X86_DISPATCH)
+        if (level >= SIMD_LEVEL_AVX2 && h >= 8) {
+            radix4_pass_avx2(re, im, n, h, w);
+            continue;
+        }
+#endif
+#if defined(FFT_SSE)
+        if (level >= SIMD_LEVEL_SSE2 && h >= 4) {
+            radix4_pass_sse(re, im, n, h, w);
+            continue;
+        }
+        if (level >= SIMD_LEVEL_SSE2 && n >= 16) {
+            if (h == 1) {
+                radix4_first_sse(re, im, n);
+            } else {
+                radix4_h2_sse(re, im, n, w);
+            }
+            continue;
+        }
+#endif
+        radix4_pass_scalar(re, im, n, h, w);
+    }
+}
+
+// In-place bit-reversal permutation of plan->half points
+static void fft_bit_reverse(const FftPlan* plan, float* re, float* im) {
+    for (size_t i = 0; i < plan->half; i++) {
+        const size_t j = plan->bitrev[i];
+        if (i < j) {
+            float t = re[i];
+            re[i] = re[j];
+            re[j] = t;
+            t = im[i];
+            im[i] = im[j];
+            im[j] = t;
+        }
+    }
+}
+
+// Complex forward transform in natural order
+void fft_complex_forward(const FftPlan* plan, float* re, float* im) {
+    if (!plan || !re || !im) return;
+    
+    fft_bit_reverse(plan, re, im);
+    fft_complex(plan, re, im);
+}
+
+// Complex inverse transform: the forward transform with the real and
+// imaginary arrays swapped
+void fft_complex_inverse(const FftPlan* plan, float* re, float* im) {
+    if (!plan || !re || !im) return;
+    
+    fft_bit_reverse(plan, re, im);
+    fft_complex(plan, im, re);
+}
+
+// Real forward transform: pack even/odd samples as one complex signal,
+// transform, then split the result into the spectrum of the real input
+void fft_real_forward(const FftPlan* plan, const float* in, float* spectrum) {
+    if (!plan || !in || !spectrum) return;
+    
+    const size_t half = plan->half;
+    float* re = spectrum;
+    float* im = spectrum + half;
+    
+    for (size_t i = 0; i < half; i++) {
+        re[plan->bitrev[i]] = in[2 * i];
+        im[plan->bitrev[i]] = in[2 * i + 1];
+    }
+    fft_complex(plan, re, im);
+    
+    const float dc = re[0] + im[0];
+    const float nyquist = re[0] - im[0];
+    re[0] = dc;
+    im[0] = nyquist;
+    
+    size_t k = 1;
+#if defined(FFT_SSE)
+    // Four bins k at a time with their mirrors m = half - k loaded reversed
+    if (cpu_simd_level() >= SIMD_LEVEL_SSE2) {
+        const __m128 halfv = _mm_set1_ps(0.5f);
+        for (; k + 3 < half / 2; k += 4) {
+            const size_t m = half - k - 3;
+            __m128 rk = _mm_loadu_ps(re + k), ik = _mm_loadu_ps(im + k);
+            __m128 rm = FFT_REVERSE(_mm_loadu_ps(re + m)), imm = FFT_REVERSE(_mm_loadu_ps(im + m));
+            __m128 even_r = _mm_mul_ps(halfv, _mm_add_ps(rk, rm));
+            __m128 even_i = _mm_mul_ps(halfv, _mm_sub_ps(ik, imm));
+            __m128 odd_r = _mm_mul_ps(halfv, _mm_add_ps(ik, imm));
+            __m128 odd_i = _mm_mul_ps(halfv, _mm_sub_ps(rm, rk));
+            __m128 c = _mm_loadu_ps(plan->real_cos + k), sn = _mm_loadu_ps(plan->real_sin + k);
+            __m128 wr = _mm_add_ps(_mm_mul_ps(c, odd_r), _mm_mul_ps(sn, odd_i));
+            __m128 wi = _mm_sub_ps(_mm_mul_ps(c, odd_i), _mm_mul_ps(sn, odd_r));
+            
+            _mm_storeu_ps(re + k, _mm_add_ps(even_r, wr));
+            _mm_storeu_ps(im + k, _mm_add_ps(even_i, wi));
+            _mm_storeu_ps(re + m, FFT_REVERSE(_mm_sub_ps(even_r, wr)));
+            _mm_storeu_ps(im + m, FFT_REVERSE(_mm_sub_ps(wi, even_i)));
+        }
+    }
+#endif
+    for (; k <= half / 2; k++) {
+        const size_t m = half - k;
+        const float even_r = 0.5f * (re[k] + re[m]);
+        const float even_i = 0.5f * (im[k] - im[m]);
+        const float odd_r = 0.5f * (im[k] + im[m]);
+        const float odd_i = -0.5f * (re[k] - re[m]);
+        const float c = plan->real_cos[k];
+        const float s = plan->real_sin[k];
+        const float wr = c * odd_r + s * odd_i;
+        const float wi = c * odd_i - s * odd_r;
+        
+        re[k] = even_r + wr;
+        im[k] = even_i + wi;
+        re[m] = even_r - wr;
+        im[m] = wi - even_i;
+    }
+}
+
+// Real inverse transform: rebuild the packed complex spectrum, transform
+// it back with the real and imaginary arrays swapped (which conjugates),
+// then interleave the even and odd samples
+void fft_real_inverse(const FftPlan* plan, float* spectrum, float* out) {
+    if (!plan || !spectrum || !out) return;
+    
+    const size_t half = plan->half;
+    float* re = spectrum;
+    float* im = spectrum + half;
+    
+    const float dc = re[0];
+    const float nyquist = im[0];
+    re[0] = dc + nyquist;
+    im[0] = dc - nyquist;
+    
+    size_t k = 1;
+#if defined(FFT_SSE)
+    if (cpu_simd_level() >= SIMD_LEVEL_SSE2) {
+        for (; k + 3 < half / 2; k += 4) {
+            const size_t m = half - k - 3;
+            __m128 rk = _mm_loadu_ps(re + k), ik = _mm_loadu_ps(im + k);
+            __m128 rm = FFT_REVERSE(_mm_loadu_ps(re + m)), imm = FFT_REVERSE(_mm_loadu_ps(im + m));
+            __m128 even_r = _mm_add_ps(rk, rm);
+            __m128 even_i = _mm_sub_ps(ik, imm);
+            __m128 diff_r = _mm_sub_ps(rk, rm);
+            __m128 diff_i = _mm_add_ps(ik, imm);
+            __m128 c = _mm_loadu_ps(plan->real_cos + k), sn = _mm_loadu_ps(plan->real_sin + k);
+            __m128 odd_r = _mm_sub_ps(_mm_mul_ps(diff_r, c), _mm_mul_ps(diff_i, sn));
+            __m128 odd_i = _mm_add_ps(_mm_mul_ps(diff_i, c), _mm_mul_ps(diff_r, sn));
+            
+            _mm_storeu_ps(re + k, _mm_sub_ps(even_r, odd_i));
+            _mm_storeu_ps(im + k, _mm_add_ps(even_i, odd_r));
+            _mm_storeu_ps(re + m, FFT_REVERSE(_mm_add_ps(even_r, odd_i)));
+            _mm_storeu_ps(im + m, FFT_REVERSE(_mm_sub_ps(odd_r, even_i)));
+        }
+    }
+#endif
+    for (; k <= half / 2; k++) {
+        const size_t m = half - k;
+        const float even_r = re[k] + re[m];
+        const float even_i = im[k] - im[m];
+        const float diff_r = re[k] - re[m];
+        const float diff_i = im[k] + im[m];
+        const float c = plan->real_cos[k];
+        const float s = plan->real_sin[k];
+        const float odd_r = diff_r * c - diff_i * s;
+        const float odd_i = diff_i * c + diff_r * s;
+        
+        re[k] = even_r - odd_i;
+        im[k] = even_i + odd_r;
+        re[m] = even_r + odd_i;
+        im[m] = odd_r - even_i;
+    }
+    
+    fft_bit_reverse(plan, re, im);
+    fft_complex(plan, im, re);
+    
+    for (size_t i = 0; i < half; i++) {
+        out[2 * i] = re[i];
+        out[2 * i + 1] = im[i];
+    }
+}
+
+// Complex multiply-accumulate of two split spectra. Bin 0 holds two real
+// values (DC and Nyquist), which are multiplied separately.
+void fft_spectrum_mac(const FftPlan* plan, const float* a, const float* b, float* acc) {
+    if (!plan || !a || !b || !acc) return;
+    
+    const size_t half = plan->half;
+    const float* ar = a;
+    const float* ai = a + half;
+    const float* br = b;
+    const float* bi = b + half;
+    float* cr = acc;
+    float* ci = acc + half;
+    const SimdLevel level = cpu_simd_level();
+    (void)level;
+    
+    const float dc = cr[0] + ar[0] * br[0];
+    const float nyquist = ci[0] + ai[0] * bi[0];
+    
+    size_t start = 0;
+#if defined(AUDIO_X86_DISPATCH)
+    if (level >= SIMD_LEVEL_AVX2) {
+        start = half & ~(size_t)7;
+        spectrum_mac_avx2(ar, ai, br, bi, cr, ci, start);
+    }
+#endif
+#if defined(FFT_SSE)
+    if (level >= SIMD_LEVEL_SSE2) {
+        const size_t end = half & ~(size_t)3;
+        for (size_t k = start; k < end; k += 4) {
+            __m128 xr = _mm_loadu_ps(ar + k);
+            __m128 xi = _mm_loadu_ps(ai + k);
+            __m128 yr = _mm_loadu_ps(br + k);
+            __m128 yi = _mm_loadu_ps(bi + k);
+            __m128 re = _mm_sub_ps(_mm_mul_ps(xr, yr), _mm_mul_ps(xi, yi));
+            __m128 im = _mm_add_ps(_mm_mul_ps(xr, yi), _mm_mul_ps(xi, yr));
+            _mm_storeu_ps(cr + k, _mm_add_ps(_mm_loadu_ps(cr + k), re));
+            _mm_storeu_ps(ci + k, _mm_add_ps(_mm_loadu_ps(ci + k), im));
+        }
+        start = end;
+    }
+#endif
+    for (size_t k = start; k < half; k++) {
+        cr[k] += ar[k] * br[k] - ai[k] * bi[k];
+        ci[k] += ar[k] * bi[k] + ai[k] * br[k];
+    }
+    
+    cr[0] = dc;
+    ci[0] = nyquist;
+}
+
+// Magnitude spectrum from split order: DC and Nyquist are real
+void fft_spectrum_magnitude(const FftPlan* plan, const float* spectrum, float* magnitude) {
+    if (!plan || !spectrum || !magnitude) return;
+    
+    const size_t half = plan->half;
+    const float* re = spectrum;
+    const float* im = spectrum + half;
+    
+    magnitude[0] = fabsf(re[0]);
+    magnitude[half] = fabsf(im[0]);
+    for (size_t k = 1; k < half; k++) {
+        magnitude[k] = sqrtf(re[k] * re[k] + im[k] * im[k]);
+    }
+}
@@ -1,14 +1,70 @@
 #include "modulation_effects.h"
+#include "cpu_features.h"
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define MODULATION_SSE 1
+#endif
 
 // LFO functions
 
+#define LFO_PHASE_SCALE 4294967296.0   // 2^32, one cycle
+
+// Phase increment for a frequency
+static uint32_t lfo_increment(float frequency, float sample_rate) {
+    double cycles = sample_rate > 0.0f ? (double)frequency / sample_rate : 0.0;
+    return (uint32_t)(int64_t)(cycles * LFO_PHASE_SCALE + 0.5);
+}
+
+// Phase as a signed fraction of a cycle in [-0.5, 0.5)
+static inline float lfo_signed_phase(uint32_t phase) {
+    return (float)(int32_t)phase * (float)(1.0 / LFO_PHASE_SCALE);
+}
+
+// sin(2*pi*x) for x in [-0.5, 0.5): fold into [-0.25, 0.25], then an odd
+// Taylor polynomial to the 11th power
+static inline float lfo_sine(float x) {
+    x = x < 0.5f - x ? x : 0.5f - x;
+    x = x > -0.5f - x ? x : -0.5f - x;
+    
+    float z = (float)TWO_PI * x;
+    float z2 = z * z;
+    float p = -2.5052108e-8f;
+    p = p * z2 + 2.7557319e-6f;
+    p = p * z2 - 1.9841270e-4f;
+    p = p * z2 + 8.3333333e-3f;
+    p = p * z2 - 1.6666667e-1f;
+    return z + z * z2 * p;
+}
+
+// Waveform value at a phase, in [-1, 1]
+static inline float lfo_shape(uint32_t phase, LfoWaveform waveform) {
+    float x = lfo_signed_phase(phase);
+    
+    switch (waveform) {
+        case LFO_TRIANGLE: return 4.0f * fabsf(x) - 1.0f;
+        case LFO_SAWTOOTH: return (x < 0.0f ? 2.0f * x + 1.0f : 2.0f * x - 1.0f);
+        case LFO_SQUARE: return (x < 0.0f ? -1.0f : 1.0f);
+        case LFO_SINE:
+        default: return lfo_sine(x);
+    }
+}
+
+// Output for a waveform, then advance one sample
+static inline float lfo_step(LFO* lfo, LfoWaveform waveform) {
+    float output = lfo->amplitude * lfo_shape(lfo->phase, waveform) + lfo->offset;
+    lfo->phase += lfo->increment;
+    return output;
+}
+
 // Initialize LFO
 void lfo_init(LFO* lfo, float frequency, float sample_rate) {
     if (!lfo) return;
     
     lfo->frequency = frequency;
     lfo->sample_rate = sample_rate;
-    lfo->phase = 0.0f;
+    lfo->phase = 0;
+    lfo->increment = lfo_increment(frequency, sample_rate);
     lfo->amplitude = 1.0f;
     lfo->offset = 0.0f;
 }
@@ -17,98 +73,194 @@ void lfo_init(LFO* lfo, float frequency, float sample_rate) {
 void lfo_set_params(LFO* lfo, float frequency, float amplitude, float offset) {
     if (!lfo) return;
     
-    lfo->frequency = clamp(frequency, 0.01f, 20.0f);
+    lfo_set_frequency(lfo, frequency);
     lfo->amplitude = clamp(amplitude, 0.0f, 2.0f);
     lfo->offset = clamp(offset, -1.0f, 1.0f);
 }
 
+// Set LFO frequency (cheap enough to call every sample)
+void lfo_set_frequency(LFO* lfo, float frequency) {
+    if (!lfo) return;
+    
+    lfo->frequency = clamp(frequency, 0.01f, 20.0f);
+    lfo->increment = lfo_increment(lfo->frequency, lfo->sample_rate);
+}
+
+// Jump to a position within the cycle (0 to 1)
+void lfo_set_phase(LFO* lfo, float cycles) {
+    if (!lfo) return;
+    
+    double fraction = cycles - floor(cycles);
+    lfo->phase = (uint32_t)(int64_t)(fraction * LFO_PHASE_SCALE);
+}
+
 // Process LFO (sine wave)
 float lfo_process(LFO* lfo) {
     if (!lfo) return 0.0f;
     
-    float output = lfo->amplitude * sinf(lfo->phase) + lfo->offset;
-    
-    lfo->phase += TWO_PI * lfo->frequency / lfo->sample_rate;
-    if (lfo->phase >= TWO_PI) {
-        lfo->phase -= TWO_PI;
-    }
+    return lfo_step(lfo, LFO_SINE);
+}
+
+// LFO value at the current phase, then skip ahead by samples (for
+// control-rate modulation)
+static float lfo_control(LFO* lfo, size_t samples) {
+    float value = lfo->amplitude * lfo_shape(lfo->phase, LFO_SINE) + lfo->offset;
     
-    return output;
+    lfo->phase += (uint32_t)samples * lfo->increment;
+    return value;
 }
 
 // Triangle wave LFO
 float lfo_triangle(LFO* lfo) {
     if (!lfo) return 0.0f;
     
-    float phase_norm = lfo->phase / TWO_PI;
-    float triangle;
-    
-    if (phase_norm < 0.5f) {
-        triangle = 4.0f * phase_norm - 1.0f;
-    } else {
-        triangle = 3.0f - 4.0f * phase_norm;
-    }
-    
-    float output = lfo->amplitude * triangle + lfo->offset;
-    
-    lfo->phase += TWO_PI * lfo->frequency / lfo->sample_rate;
-    if (lfo->phase >= TWO_PI) {
-        lfo->phase -= TWO_PI;
-    }
-    
-    return output;
+    return lfo_step(lfo, LFO_TRIANGLE);
 }
 
 // Sawtooth wave LFO
 float lfo_sawtooth(LFO* lfo) {
     if (!lfo) return 0.0f;
     
-    float phase_norm = lfo->phase / TWO_PI;
-    float sawtooth = 2.0f * phase_norm - 1.0f;
-    float output = lfo->amplitude * sawtooth + lfo->offset;
-    
-    lfo->phase += TWO_PI * lfo->frequency / lfo->sample_rate;
-    if (lfo->phase >= TWO_PI) {
-        lfo->phase -= TWO_PI;
-    }
-    
-    return output;
+    return lfo_step(lfo, LFO_SAWTOOTH);
 }
 
 // Square wave LFO
 float lfo_square(LFO* lfo) {
     if (!lfo) return 0.0f;
     
-    float phase_norm = lfo->phase / TWO_PI;
-    float square = (phase_norm < 0.5f) ? 1.0f : -1.0f;
-    float output = lfo->amplitude * square + lfo->offset;
+    return lfo_step(lfo, LFO_SQUARE);
+}
+
+#if defined(MODULATION_SSE)
+// Four sine values per step; the phase lanes wrap in integer arithmetic
+static size_t lfo_render_sine_sse(LFO* lfo, float* out, size_t n) {
+    const uint32_t inc = lfo->increment;
+    const __m128 scale = _mm_set1_ps((float)(1.0 / LFO_PHASE_SCALE));
+    const __m128 half = _mm_set1_ps(0.5f);
+    const __m128 two_pi = _mm_set1_ps((float)TWO_PI);
+    const __m128 amplitude = _mm_set1_ps(lfo->amplitude);
+    const __m128 offset = _mm_set1_ps(lfo->offset);
+    const __m128i step = _mm_set1_epi32((int32_t)(4u * inc));
+    __m128i phase = _mm_setr_epi32((int32_t)lfo->phase, (int32_t)(lfo->phase + inc),
+                                   (int32_t)(lfo->phase + 2u * inc), (int32_t)(lfo->phase + 3u * inc));
+    
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128 x = _mm_mul_ps(_mm_cvtepi32_ps(phase), scale);
+        x = _mm_min_ps(x, _mm_sub_ps(half, x));
+        x = _mm_max_ps(x, _mm_sub_ps(_mm_sub_ps(_mm_setzero_ps(), half), x));
+        
+        __m128 z = _mm_mul_ps(two_pi, x);
+        __m128 z2 = _mm_mul_ps(z, z);
+        __m128 p = _mm_set1_ps(-2.5052108e-8f);
+        p = _mm_add_ps(_mm_mul_ps(p, z2), _mm_set1_ps(2.7557319e-6f));
+        p = _mm_add_ps(_mm_mul_ps(p, z2), _mm_set1_ps(-1.9841270e-4f));
+        p = _mm_add_ps(_mm_mul_ps(p, z2), _mm_set1_ps(8.3333333e-3f));
+        p = _mm_add_ps(_mm_mul_ps(p, z2), _mm_set1_ps(-1.6666667e-1f));
+        __m128 sine = _mm_add_ps(z, _mm_mul_ps(_mm_mul_ps(z, z2), p));
+        
+        _mm_storeu_ps(out + i, _mm_add_ps(_mm_mul_ps(amplitude, sine), offset));
+        phase = _mm_add_epi32(phase, step);
+    }
     
-    lfo->phase += TWO_PI * lfo->frequency / lfo->sample_rate;
-    if (lfo->phase >= TWO_PI) {
-        lfo->phase -= TWO_PI;
+    lfo->phase += (uint32_t)i * inc;
+    return i;
+}
+#endif
+
+// Fill out with the next n LFO values
+void lfo_render(LFO* lfo, LfoWaveform waveform, float* out, size_t n) {
+    if (!lfo || !out) return;
+    
+    size_t i = 0;
+#if defined(MODULATION_SSE)
+    if (waveform == LFO_SINE && cpu_simd_level() >= SIMD_LEVEL_SSE2) {
+        i = lfo_render_sine_sse(lfo, out, n);
     }
+#endif
+    for (; i < n; i++) {
+        out[i] = lfo_step(lfo, waveform);
+    }
+}
+
+// Fill out with the next n LFO values while parameters ramp: the rate
+// follows its smoother and amplitude and offset their per-sample values
+static void lfo_render_ramp(LFO* lfo, LfoWaveform waveform, ParamSmoother* rate, const float* amplitude,
+                            const float* offset, float* out, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        if (param_smoother_active(rate)) lfo_set_frequency(lfo, param_smoother_next(rate));
+        lfo->amplitude = amplitude[i];
+        lfo->offset = offset[i];
+        out[i] = lfo_step(lfo, waveform);
+    }
+}
+
+// LFO bank functions
+
+// Initialize a bank with num_voices voices, all in phase
+void lfo_bank_init(LfoBank* bank, int num_voices, float frequency, float sample_rate) {
+    if (!bank) return;
     
-    return output;
+    lfo_init(&bank->clock, frequency, sample_rate);
+    memset(bank->offsets, 0, sizeof(bank->offsets));
+    bank->num_voices = num_voices < 1 ? 1 : (num_voices > LFO_BANK_MAX_VOICES ? LFO_BANK_MAX_VOICES : num_voices);
+}
+
+// Phase of a voice relative to the clock, in cycles
+void lfo_bank_set_offset(LfoBank* bank, int voice, float cycles) {
+    if (!bank || voice < 0 || voice >= bank->num_voices) return;
+    
+    double fraction = cycles - floor(cycles);
+    bank->offsets[voice] = (uint32_t)(int64_t)(fraction * LFO_PHASE_SCALE);
+}
+
+// One LFO cycle every beats_per_cycle beats at bpm
+void lfo_bank_set_tempo(LfoBank* bank, float bpm, float beats_per_cycle) {
+    if (!bank || beats_per_cycle <= 0.0f) return;
+    
+    lfo_set_frequency(&bank->clock, bpm / (60.0f * beats_per_cycle));
+}
+
+// Align the clock with a transport position given in beats
+void lfo_bank_sync(LfoBank* bank, double beats, float beats_per_cycle) {
+    if (!bank || beats_per_cycle <= 0.0f) return;
+    
+    double cycles = beats / beats_per_cycle;
+    lfo_set_phase(&bank->clock, (float)(cycles - floor(cycles)));
+}
+
+// Fill outputs[voice] with the next n values of every voice
+void lfo_bank_render(LfoBank* bank, LfoWaveform waveform, float* const* outputs, size_t n) {
+    if (!bank || !outputs) return;
+    
+    for (int v = 0; v < bank->num_voices; v++) {
+        LFO voice = bank->clock;
+        voice.phase += bank->offsets[v];
+        lfo_render(&voice, waveform, outputs[v], n);
+    }
+    bank->clock.phase += (uint32_t)n * bank->clock.increment;
 }
 
 // Chorus functions
 
 // Create chorus effect
 Chorus* chorus_create(float max_delay_ms, float sample_rate) {
-    Chorus* chorus = malloc(sizeof(Chorus));
+    Chorus* chorus = audio_malloc(sizeof(Chorus));
     if (!chorus) return NULL;
     
     size_t max_delay_samples = (size_t)((max_delay_ms / 1000.0f) * sample_rate);
     DelayLine* delay = delay_line_create(max_delay_samples);
     if (!delay) {
-        free(chorus);
+        audio_free(chorus);
         return NULL;
     }
     
     chorus->delay = *delay;
-    free(delay);
+    audio_free(delay);
+    delay_interp_init(&chorus->interpolator, MODULATION_DEFAULT_INTERPOLATION);
     
     lfo_init(&chorus->lfo, 1.0f, sample_rate);
+    chorus->lfo.offset = 0.5f;
     chorus->depth = 0.5f;
     chorus->rate = 1.0f;
     chorus->feedback = 0.1f;
@@ -117,6 +269,15 @@ Chorus* chorus_create(float max_delay_ms, float sample_rate) {
     
     onepole_lowpass(&chorus->feedback_filter, 5000.0f, sample_rate);
     
+    param_smoother_init(&chorus->rate_smoother, chorus->rate, PARAM_SMOOTH_DEFAULT_MS, sample_rate,
+                        PARAM_SMOOTH_ONE_POLE);
+    param_smoother_init(&chorus->depth_smoother, chorus->depth, PARAM_SMOOTH_DEFAULT_MS, sample_rate,
+                        PARAM_SMOOTH_LINEAR);
+    param_smoother_init(&chorus->feedback_smoother, chorus->feedback, PARAM_SMOOTH_DEFAULT_MS, sample_rate,
+                        PARAM_SMOOTH_LINEAR);
+    param_smoother_init(&chorus->wet_smoother, chorus->wet_level, PARAM_SMOOTH_DEFAULT_MS, sample_rate,
+                        PARAM_SMOOTH_LINEAR);
+    
     return chorus;
 }
 
@@ -124,9 +285,9 @@ Chorus* chorus_create(float max_delay_ms, float sample_rate) {
 void chorus_destroy(Chorus* chorus) {
     if (chorus) {
         if (chorus->delay.buffer) {
-            free(chorus->delay.buffer);
+            audio_free(chorus->delay.buffer);
         }
-        free(chorus);
+        audio_free(chorus);
     }
 }
 
@@ -140,56 +301,236 @@ void chorus_set_params(Chorus* chorus, float rate, float depth, float feedback,
     chorus->wet_level = clamp(wet_level, 0.0f, 1.0f);
     chorus->dry_level = 1.0f - chorus->wet_level;
     
-    lfo_set_params(&chorus->lfo, chorus->rate, chorus->depth, 0.5f);
+    param_smoother_set_target(&chorus->rate_smoother, chorus->rate);
+    param_smoother_set_target(&chorus->depth_smoother, chorus->depth);
+    param_smoother_set_target(&chorus->feedback_smoother, chorus->feedback);
+    param_smoother_set_target(&chorus->wet_smoother, chorus->wet_level);
+}
+
+// Pick up new parameter targets; returns nonzero while a ramp is active
+static int chorus_update_params(Chorus* chorus) {
+    int changed = param_smoother_update(&chorus->rate_smoother);
+    changed |= param_smoother_update(&chorus->depth_smoother);
+    changed |= param_smoother_update(&chorus->feedback_smoother);
+    changed |= param_smoother_update(&chorus->wet_smoother);
+    
+    if (changed) {
+        lfo_set_frequency(&chorus->lfo, chorus->rate_smoother.current);
+        chorus->lfo.amplitude = chorus->depth_smoother.current;
+    }
+    
+    return param_smoother_active(&chorus->rate_smoother) || param_smoother_active(&chorus->depth_smoother) ||
+           param_smoother_active(&chorus->feedback_smoother) || param_smoother_active(&chorus->wet_smoother);
+}
+
+// Advance every ramp by one sample; returns nonzero while one is still active
+static int chorus_step_params(Chorus* chorus, LFO* lfo) {
+    lfo_set_frequency(lfo, param_smoother_next(&chorus->rate_smoother));
+    lfo->amplitude = param_smoother_next(&chorus->depth_smoother);
+    param_smoother_next(&chorus->feedback_smoother);
+    param_smoother_next(&chorus->wet_smoother);
+    
+    return param_smoother_active(&chorus->rate_smoother) || param_smoother_active(&chorus->depth_smoother) ||
+           param_smoother_active(&chorus->feedback_smoother) || param_smoother_active(&chorus->wet_smoother);
+}
+
+// Choose the fractional delay interpolator (not real-time safe)
+void chorus_set_interpolation(Chorus* chorus, DelayInterpolation mode) {
+    if (!chorus) return;
+    
+    delay_interp_init(&chorus->interpolator, mode);
+}
+
+// LFO values to delays in samples
+static void chorus_scale_delays(float* delays, size_t n, float delay_range) {
+    for (size_t i = 0; i < n; i++) {
+        delays[i] *= delay_range;
+    }
 }
 
 // Process one sample through chorus
 sample_t chorus_process(Chorus* chorus, sample_t input) {
     if (!chorus) return input;
     
+    if (chorus_update_params(chorus)) {
+        chorus_step_params(chorus, &chorus->lfo);
+    }
+    const float wet = chorus->wet_smoother.current;
+    
     // Get LFO value to modulate delay time
     float lfo_value = lfo_process(&chorus->lfo);
     float delay_samples = lfo_value * (chorus->delay.size / 4.0f); // Use portion of max delay
     
     // Read delayed signal with interpolation
-    sample_t delayed = delay_line_read_interpolated(&chorus->delay, delay_samples);
+    sample_t delayed;
+    delay_line_read_modulated(&chorus->delay, &chorus->interpolator, &delay_samples, &delayed, 1);
     
     // Apply feedback filtering
     sample_t filtered_delayed = onepole_process(&chorus->feedback_filter, delayed, 0);
     
     // Write to delay line with feedback
-    sample_t feedback_sample = input + filtered_delayed * chorus->feedback;
+    sample_t feedback_sample = input + filtered_delayed * chorus->feedback_smoother.current;
     delay_line_write(&chorus->delay, feedback_sample);
     
     // Mix dry and wet signals
-    return input * chorus->dry_level + delayed * chorus->wet_level;
+    return input * (1.0f - wet) + delayed * wet;
+}
+
+// Process a block through chorus (in and out may be the same buffer)
+void chorus_process_block(Chorus* chorus, const sample_t* in, sample_t* out, size_t n) {
+    if (!chorus || !chorus->delay.buffer) {
+        audio_block_bypass(in, out, n);
+        return;
+    }
+    if (!in || !out) return;
+    
+    int ramping = chorus_update_params(chorus);
+    
+    DelayLine delay = chorus->delay;
+    DelayInterpolator interpolator = chorus->interpolator;
+    LFO lfo = chorus->lfo;
+    OnePoleFilter filter = chorus->feedback_filter;
+    const float delay_range = delay.size / 4.0f;
+    float feedback = chorus->feedback_smoother.current;
+    float wet = chorus->wet_smoother.current;
+    float dry = 1.0f - wet;
+    float delays[LFO_BLOCK];
+    sample_t delayed[LFO_BLOCK];
+    
+    // Parameters only change per sample while a ramp runs; otherwise the
+    // LFO and the delayed signal are computed a control buffer at a time
+    for (size_t start = 0; start < n; start += LFO_BLOCK) {
+        size_t count = n - start < LFO_BLOCK ? n - start : LFO_BLOCK;
+        if (!ramping) {
+            lfo_render(&lfo, LFO_SINE, delays, count);
+            chorus_scale_delays(delays, count, delay_range);
+        }
+        
+        size_t done = 0;
+        while (done < count) {
+            size_t ready;
+            if (ramping) {
+                ramping = chorus_step_params(chorus, &lfo);
+                feedback = chorus->feedback_smoother.current;
+                wet = chorus->wet_smoother.current;
+                dry = 1.0f - wet;
+                delays[done] = lfo_process(&lfo) * delay_range;
+                if (!ramping) {
+                    lfo_render(&lfo, LFO_SINE, delays + done + 1, count - done - 1);
+                    chorus_scale_delays(delays + done + 1, count - done - 1, delay_range);
+                }
+                ready = delay_line_read_modulated(&delay, &interpolator, delays + done, delayed, 1);
+            } else {
+                // Reads as far ahead as the feedback writes allow
+                ready = delay_line_read_modulated(&delay, &interpolator, delays + done, delayed, count - done);
+            }
+            
+            for (size_t i = 0; i < ready; i++) {
+                sample_t input = in[start + done + i];
+                sample_t filtered_delayed = onepole_tick_lowpass(&filter, delayed[i]);
+                
+                delay_line_push(&delay, input + filtered_delayed * feedback);
+                out[start + done + i] = input * dry + delayed[i] * wet;
+            }
+            done += ready;
+        }
+    }
+    
+    chorus->delay.write_pos = delay.write_pos;
+    chorus->interpolator = interpolator;
+    chorus->lfo = lfo;
+    chorus->feedback_filter = filter;
 }
 
 // Process buffer through chorus
 void chorus_process_buffer(Chorus* chorus, AudioBuffer* buffer) {
     if (!chorus || !buffer || !buffer->data) return;
     
-    for (size_t i = 0; i < buffer->capacity; i++) {
-        buffer->data[i] = chorus_process(chorus, buffer->data[i]);
+    chorus_process_block(chorus, buffer->data, buffer->data, buffer->capacity);
+}
+
+// Block adapter used for per-channel processing
+static void chorus_channel_block(void* effect, const sample_t* in, sample_t* out, size_t n) {
+    chorus_process_block((Chorus*)effect, in, out, n);
+}
+
+// Process each channel of an interleaved buffer with its own chorus instance
+void chorus_process_channels(Chorus** choruses, AudioBuffer* buffer) {
+    if (!choruses || !buffer || !buffer->data || buffer->channels > MAX_CHANNELS) return;
+    
+    void* instances[MAX_CHANNELS];
+    for (size_t ch = 0; ch < buffer->channels; ch++) {
+        instances[ch] = choruses[ch];
     }
+    audio_buffer_process_channels(buffer, chorus_channel_block, instances);
+}
+
+// Clear chorus history (parameters are kept)
+void chorus_reset(Chorus* chorus) {
+    if (!chorus) return;
+    
+    delay_line_clear(&chorus->delay);
+    delay_interp_reset(&chorus->interpolator);
+    onepole_reset(&chorus->feedback_filter);
+    chorus->lfo.phase = 0;
+    
+    param_smoother_snap(&chorus->rate_smoother);
+    param_smoother_snap(&chorus->depth_smoother);
+    param_smoother_snap(&chorus->feedback_smoother);
+    param_smoother_snap(&chorus->wet_smoother);
+}
+
+// Effect interface adapters
+static void chorus_effect_reset(void* effect) {
+    chorus_reset((Chorus*)effect);
+}
+
+static int chorus_effect_set_param(void* effect, int param, float value) {
+    Chorus* chorus = (Chorus*)effect;
+    if (param < 0 || param >= 4) return 0;
+    
+    float p[4] = {chorus->rate, chorus->depth, chorus->feedback, chorus->wet_level};
+    p[param] = value;
+    chorus_set_params(chorus, p[0], p[1], p[2], p[3]);
+    return 1;
+}
+
+static void chorus_effect_destroy(void* effect) {
+    chorus_destroy((Chorus*)effect);
+}
+
+static const EffectVTable chorus_vtable = {
+    .name = "chorus",
+    .process_block = chorus_channel_block,
+    .reset = chorus_effect_reset,
+    .set_param = chorus_effect_set_param,
+    .latency = NULL,
+    .destroy = chorus_effect_destroy
+};
+
+// Wrap in the effect interface (params: rate, depth, feedback, wet_level)
+Effect chorus_effect(Chorus* chorus) {
+    Effect effect = { &chorus_vtable, chorus };
+    return effect;
 }
 
 // Flanger functions
 
 // Create flanger effect
 Flanger* flanger_create(float max_delay_ms, float sample_rate) {
-    Flanger* flanger = malloc(sizeof(Flanger));
+    Flanger* flanger = audio_malloc(sizeof(Flanger));
     if (!flanger) return NULL;
     
     size_t max_delay_samples = (size_t)((max_delay_ms / 1000.0f) * sample_rate);
     DelayLine* delay = delay_line_create(max_delay_samples);
     if (!delay) {
-        free(flanger);
+        audio_free(flanger);
         return NULL;
     }
     
     flanger->delay = *delay;
-    free(delay);
+    audio_free(delay);
+    delay_interp_init(&flanger->interpolator, MODULATION_DEFAULT_INTERPOLATION);
     
     lfo_init(&flanger->lfo, 0.5f, sample_rate);
     flanger->depth = 0.8f;
@@ -201,6 +542,17 @@ Flanger* flanger_create(float max_delay_ms, float sample_rate) {
     
     onepole_lowpass(&flanger->feedback_filter, 8000.0f, sample_rate);
     
+    param_smoother_init(&flanger->rate_smoother, flanger->rate, PARAM_SMOOTH_DEFAULT_MS, sample_rate,
+                        PARAM_SMOOTH_ONE_POLE);
+    param_smoother_init(&flanger->depth_smoother, flanger->depth, PARAM_SMOOTH_DEFAULT_MS, sample_rate,
+                        PARAM_SMOOTH_LINEAR);
+    param_smoother_init(&flanger->feedback_smoother, flanger->feedback, PARAM_SMOOTH_DEFAULT_MS, sample_rate,
+                        PARAM_SMOOTH_LINEAR);
+    param_smoother_init(&flanger->manual_smoother, flanger->manual, PARAM_SMOOTH_DEFAULT_MS, sample_rate,
+                        PARAM_SMOOTH_LINEAR);
+    param_smoother_init(&flanger->wet_smoother, flanger->wet_level, PARAM_SMOOTH_DEFAULT_MS, sample_rate,
+                        PARAM_SMOOTH_LINEAR);
+    
     return flanger;
 }
 
@@ -208,9 +560,9 @@ Flanger* flanger_create(float max_delay_ms, float sample_rate) {
 void flanger_destroy(Flanger* flanger) {
     if (flanger) {
         if (flanger->delay.buffer) {
-            free(flanger->delay.buffer);
+            audio_free(flanger->delay.buffer);
         }
-        free(flanger);
+        audio_free(flanger);
     }
 }
 
@@ -225,57 +577,197 @@ void flanger_set_params(Flanger* flanger, float rate, float depth, float feedbac
     flanger->wet_level = clamp(wet_level, 0.0f, 1.0f);
     flanger->dry_level = 1.0f - flanger->wet_level;
     
-    lfo_set_params(&flanger->lfo, flanger->rate, flanger->depth, flanger->manual);
+    param_smoother_set_target(&flanger->rate_smoother, flanger->rate);
+    param_smoother_set_target(&flanger->depth_smoother, flanger->depth);
+    param_smoother_set_target(&flanger->feedback_smoother, flanger->feedback);
+    param_smoother_set_target(&flanger->manual_smoother, flanger->manual);
+    param_smoother_set_target(&flanger->wet_smoother, flanger->wet_level);
+}
+
+// Nonzero while a flanger parameter ramps
+static int flanger_ramping(const Flanger* flanger) {
+    return param_smoother_active(&flanger->rate_smoother) || param_smoother_active(&flanger->depth_smoother) ||
+           param_smoother_active(&flanger->feedback_smoother) || param_smoother_active(&flanger->manual_smoother) ||
+           param_smoother_active(&flanger->wet_smoother);
+}
+
+// Pick up new parameter targets; returns nonzero while a ramp is active
+static int flanger_update_params(Flanger* flanger) {
+    int changed = param_smoother_update(&flanger->rate_smoother);
+    changed |= param_smoother_update(&flanger->depth_smoother);
+    changed |= param_smoother_update(&flanger->feedback_smoother);
+    changed |= param_smoother_update(&flanger->manual_smoother);
+    changed |= param_smoother_update(&flanger->wet_smoother);
+    
+    if (changed) {
+        lfo_set_params(&flanger->lfo, flanger->rate_smoother.current, flanger->depth_smoother.current,
+                       flanger->manual_smoother.current);
+    }
+    
+    return flanger_ramping(flanger);
+}
+
+// Choose the fractional delay interpolator (not real-time safe)
+void flanger_set_interpolation(Flanger* flanger, DelayInterpolation mode) {
+    if (!flanger) return;
+    
+    delay_interp_init(&flanger->interpolator, mode);
 }
 
 // Process one sample through flanger
 sample_t flanger_process(Flanger* flanger, sample_t input) {
     if (!flanger) return input;
     
-    // Get LFO value for delay modulation
-    float lfo_value = lfo_triangle(&flanger->lfo); // Triangle wave for flanger
-    float delay_samples = lfo_value * (flanger->delay.size / 8.0f); // Shorter delay than chorus
-    
-    // Ensure minimum delay to avoid zero-delay issues
-    delay_samples = clamp(delay_samples, 1.0f, (float)(flanger->delay.size - 1));
-    
-    // Read delayed signal
-    sample_t delayed = delay_line_read_interpolated(&flanger->delay, delay_samples);
-    
-    // Apply feedback filtering
-    sample_t filtered_delayed = onepole_process(&flanger->feedback_filter, delayed, 0);
-    
-    // Write to delay line with feedback
-    sample_t feedback_sample = input + filtered_delayed * flanger->feedback;
-    delay_line_write(&flanger->delay, feedback_sample);
+    sample_t output;
+    flanger_process_block(flanger, &input, &output, 1);
+    return output;
+}
+
+// Process a block through flanger (in and out may be the same buffer)
+void flanger_process_block(Flanger* flanger, const sample_t* in, sample_t* out, size_t n) {
+    if (!flanger || !flanger->delay.buffer) {
+        audio_block_bypass(in, out, n);
+        return;
+    }
+    if (!in || !out) return;
+    
+    int ramping = flanger_update_params(flanger);
+    
+    DelayLine delay = flanger->delay;
+    DelayInterpolator interpolator = flanger->interpolator;
+    LFO lfo = flanger->lfo;
+    OnePoleFilter filter = flanger->feedback_filter;
+    const float delay_range = delay.size / 8.0f;
+    float delays[LFO_BLOCK];
+    float feedback[LFO_BLOCK];
+    float wet[LFO_BLOCK];
+    sample_t delayed[LFO_BLOCK];
+    
+    for (size_t start = 0; start < n; start += LFO_BLOCK) {
+        size_t count = n - start < LFO_BLOCK ? n - start : LFO_BLOCK;
+        
+        // While a ramp runs the LFO follows the parameters sample by sample
+        if (ramping) {
+            float depth[LFO_BLOCK];
+            float manual[LFO_BLOCK];
+            param_smoother_fill(&flanger->depth_smoother, depth, count);
+            param_smoother_fill(&flanger->manual_smoother, manual, count);
+            lfo_render_ramp(&lfo, LFO_TRIANGLE, &flanger->rate_smoother, depth, manual, delays, count);
+        } else {
+            lfo_render(&lfo, LFO_TRIANGLE, delays, count);
+        }
+        param_smoother_fill(&flanger->feedback_smoother, feedback, count);
+        param_smoother_fill(&flanger->wet_smoother, wet, count);
+        ramping = flanger_ramping(flanger);
+        for (size_t i = 0; i < count; i++) {
+            delays[i] *= delay_range;
+        }
+        
+        // Short delays leave fewer samples readable ahead of the feedback writes
+        size_t done = 0;
+        while (done < count) {
+            size_t ready = delay_line_read_modulated(&delay, &interpolator, delays + done, delayed, count - done);
+            
+            for (size_t i = 0; i < ready; i++) {
+                sample_t input = in[start + done + i];
+                sample_t filtered_delayed = onepole_tick_lowpass(&filter, delayed[i]);
+                const float w = wet[done + i];
+                
+                delay_line_push(&delay, input + filtered_delayed * feedback[done + i]);
+                out[start + done + i] = input * (1.0f - w) - delayed[i] * w;
+            }
+            done += ready;
+        }
+    }
     
-    // Mix with inverted phase for flanger effect
-    return input * flanger->dry_level - delayed * flanger->wet_level;
+    flanger->delay.write_pos = delay.write_pos;
+    flanger->interpolator = interpolator;
+    flanger->lfo = lfo;
+    flanger->feedback_filter = filter;
 }
 
 // Process buffer through flanger
 void flanger_process_buffer(Flanger* flanger, AudioBuffer* buffer) {
     if (!flanger || !buffer || !buffer->data) return;
     
-    for (size_t i = 0; i < buffer->capacity; i++) {
-        buffer->data[i] = flanger_process(flanger, buffer->data[i]);
+    flanger_process_block(flanger, buffer->data, buffer->data, buffer->capacity);
+}
+
+// Block adapter used for per-channel processing
+static void flanger_channel_block(void* effect, const sample_t* in, sample_t* out, size_t n) {
+    flanger_process_block((Flanger*)effect, in, out, n);
+}
+
+// Process each channel of an interleaved buffer with its own flanger instance
+void flanger_process_channels(Flanger** flangers, AudioBuffer* buffer) {
+    if (!flangers || !buffer || !buffer->data || buffer->channels > MAX_CHANNELS) return;
+    
+    void* instances[MAX_CHANNELS];
+    for (size_t ch = 0; ch < buffer->channels; ch++) {
+        instances[ch] = flangers[ch];
     }
+    audio_buffer_process_channels(buffer, flanger_channel_block, instances);
+}
+
+// Clear flanger history (parameters are kept)
+void flanger_reset(Flanger* flanger) {
+    if (!flanger) return;
+    
+    delay_line_clear(&flanger->delay);
+    delay_interp_reset(&flanger->interpolator);
+    onepole_reset(&flanger->feedback_filter);
+    flanger->lfo.phase = 0;
+    
+    param_smoother_snap(&flanger->rate_smoother);
+    param_smoother_snap(&flanger->depth_smoother);
+    param_smoother_snap(&flanger->feedback_smoother);
+    param_smoother_snap(&flanger->manual_smoother);
+    param_smoother_snap(&flanger->wet_smoother);
+}
+
+// Effect interface adapters
+static void flanger_effect_reset(void* effect) {
+    flanger_reset((Flanger*)effect);
+}
+
+static int flanger_effect_set_param(void* effect, int param, float value) {
+    Flanger* flanger = (Flanger*)effect;
+    if (param < 0 || param >= 5) return 0;
+    
+    float p[5] = {flanger->rate, flanger->depth, flanger->feedback, flanger->manual, flanger->wet_level};
+    p[param] = value;
+    flanger_set_params(flanger, p[0], p[1], p[2], p[3], p[4]);
+    return 1;
+}
+
+static void flanger_effect_destroy(void* effect) {
+    flanger_destroy((Flanger*)effect);
+}
+
+static const EffectVTable flanger_vtable = {
+    .name = "flanger",
+    .process_block = flanger_channel_block,
+    .reset = flanger_effect_reset,
+    .set_param = flanger_effect_set_param,
+    .latency = NULL,
+    .destroy = flanger_effect_destroy
+};
+
+// Wrap in the effect interface (params: rate, depth, feedback, manual, wet_level)
+Effect flanger_effect(Flanger* flanger) {
+    Effect effect = { &flanger_vtable, flanger };
+    return effect;
 }
 
 // Phaser functions
 
-// Create phaser effect
+// Create phaser effect (2 to PHASER_MAX_STAGES stages)
 Phaser* phaser_create(int num_stages, float sample_rate) {
-    Phaser* phaser = malloc(sizeof(Phaser));
+    Phaser* phaser = audio_calloc(1, sizeof(Phaser));
     if (!phaser) return NULL;
     
-    phaser->num_stages = clamp(num_stages, 2, 6);
-    
-    // Initialize allpass filters
-    for (int i = 0; i < phaser->num_stages; i++) {
-        float freq = 1000.0f + i * 500.0f; // Spread frequencies
-        biquad_bandpass(&phaser->allpass_stages[i], freq, 2.0f, sample_rate);
-    }
+    phaser->num_stages = num_stages < 2 ? 2 : (num_stages > PHASER_MAX_STAGES ? PHASER_MAX_STAGES : num_stages);
+    phaser->sample_rate = sample_rate;
     
     lfo_init(&phaser->lfo, 0.5f, sample_rate);
     phaser->depth = 0.7f;
@@ -284,13 +776,23 @@ Phaser* phaser_create(int num_stages, float sample_rate) {
     phaser->wet_level = 0.5f;
     phaser->dry_level = 0.5f;
     
+    param_smoother_init(&phaser->rate_smoother, phaser->rate, PARAM_SMOOTH_DEFAULT_MS, sample_rate,
+                        PARAM_SMOOTH_ONE_POLE);
+    param_smoother_init(&phaser->depth_smoother, phaser->depth, PARAM_SMOOTH_DEFAULT_MS, sample_rate,
+                        PARAM_SMOOTH_LINEAR);
+    param_smoother_init(&phaser->feedback_smoother, phaser->feedback, PARAM_SMOOTH_DEFAULT_MS, sample_rate,
+                        PARAM_SMOOTH_LINEAR);
+    param_smoother_init(&phaser->wet_smoother, phaser->wet_level, PARAM_SMOOTH_DEFAULT_MS, sample_rate,
+                        PARAM_SMOOTH_LINEAR);
+    
+    phaser_reset(phaser);
     return phaser;
 }
 
 // Destroy phaser
 void phaser_destroy(Phaser* phaser) {
     if (phaser) {
-        free(phaser);
+        audio_free(phaser);
     }
 }
 
@@ -304,46 +806,368 @@ void phaser_set_params(Phaser* phaser, float rate, float depth, float feedback,
     phaser->wet_level = clamp(wet_level, 0.0f, 1.0f);
     phaser->dry_level = 1.0f - phaser->wet_level;
     
-    lfo_set_params(&phaser->lfo, phaser->rate, phaser->depth, 0.0f);
+    param_smoother_set_target(&phaser->rate_smoother, phaser->rate);
+    param_smoother_set_target(&phaser->depth_smoother, phaser->depth);
+    param_smoother_set_target(&phaser->feedback_smoother, phaser->feedback);
+    param_smoother_set_target(&phaser->wet_smoother, phaser->wet_level);
+}
+
+// Pick up new parameter targets (once per block)
+static void phaser_update_params(Phaser* phaser, LFO* lfo) {
+    param_smoother_update(&phaser->depth_smoother);
+    param_smoother_update(&phaser->feedback_smoother);
+    param_smoother_update(&phaser->wet_smoother);
+    if (param_smoother_update(&phaser->rate_smoother)) {
+        lfo_set_frequency(lfo, phaser->rate_smoother.current);
+    }
+}
+
+// Nonzero while feedback is on or ramping towards a nonzero value
+static int phaser_wants_serial(const Phaser* phaser) {
+    return phaser->feedback_smoother.current > 0.0f || phaser->feedback_smoother.target > 0.0f;
 }
 
+// First-order allpass coefficient for a break frequency
+static float phaser_coefficient(const Phaser* phaser, float freq) {
+    float t = tanf((float)PI * clamp(freq, 20.0f, 0.45f * phaser->sample_rate) / phaser->sample_rate);
+    return (t - 1.0f) / (t + 1.0f);
+}
+
+// Break frequency at the current LFO position, then advance the LFO
+static float phaser_sweep(Phaser* phaser, LFO* lfo) {
+    float position = lfo_control(lfo, MOD_FILTER_CONTROL_RATE);
+    return PHASER_CENTER_HZ * exp2f(phaser->depth_smoother.current * PHASER_SWEEP_OCTAVES * position);
+}
+
+// Pipeline kernels. Each step feeds a new input to stage 0 while every
+// stage k passes its result to stage k + 1, so the stages of one step are
+// independent and n steps produce the outputs of samples t - (stages - 1).
+// Stages are updated from the last down so every stage reads its input
+// before the previous stage overwrites it.
+static void phaser_pipeline_scalar(Phaser* phaser, const sample_t* in, sample_t* wet, size_t n,
+                                   float a, float da) {
+    float* pipe = phaser->pipe;
+    float* state = phaser->state;
+    const int last = phaser->num_stages;
+    
+    for (size_t i = 0; i < n; i++) {
+        a += da;
+        pipe[0] = in[i];
+        for (int k = last - 1; k >= 0; k--) {
+            float x = pipe[k];
+            float y = a * x + state[k];
+            state[k] = x - a * y;
+            pipe[k + 1] = y;
+        }
+        wet[i] = pipe[last];
+    }
+}
+
+// Pipeline steps while it refills after serial processing. Stage k holds
+// the serial state, so it first runs k steps later; until the last stage
+// runs, the outputs come from the samples the serial cascade held back.
+static void phaser_pipeline_fill(Phaser* phaser, const sample_t* in, sample_t* wet, size_t n,
+                                 float a, float da) {
+    float* pipe = phaser->pipe;
+    float* state = phaser->state;
+    const size_t delay = (size_t)phaser->num_stages - 1;
+    
+    for (size_t i = 0; i < n; i++) {
+        const int ready = phaser->num_stages - (int)phaser->fill_remaining;
+        a += da;
+        pipe[0] = in[i];
+        for (int k = ready - 1; k >= 0; k--) {
+            float x = pipe[k];
+            float y = a * x + state[k];
+            state[k] = x - a * y;
+            pipe[k + 1] = y;
+        }
+        wet[i] = phaser->wet_delay[(phaser->dry_pos + i) % delay];
+        phaser->fill_remaining--;
+    }
+}
+
+// Finish the samples in flight in the pipeline so every stage reaches the
+// newest sample, as the serial cascade expects; their outputs are held back
+// in wet_delay in the order the pipeline would have produced them
+static void phaser_pipeline_drain(Phaser* phaser, float a) {
+    float* pipe = phaser->pipe;
+    float* state = phaser->state;
+    const int last = phaser->num_stages;
+    const size_t delay = (size_t)last - 1;
+    
+    for (int j = 1; j < last; j++) {
+        for (int k = last - 1; k >= j; k--) {
+            float x = pipe[k];
+            float y = a * x + state[k];
+            state[k] = x - a * y;
+            pipe[k + 1] = y;
+        }
+        phaser->wet_delay[(phaser->dry_pos + (size_t)j - 1) % delay] = pipe[last];
+    }
+}
+
+// Serial cascade for feedback: every stage works on the same sample, so
+// the newest output (kept in pipe[last]) returns to the input one sample
+// later
+static void phaser_serial(Phaser* phaser, const sample_t* in, const float* feedback, sample_t* wet, size_t n,
+                          float a, float da) {
+    float* state = phaser->state;
+    const int last = phaser->num_stages;
+    float output = phaser->pipe[last];
+    
+    for (size_t i = 0; i < n; i++) {
+        a += da;
+        float x = in[i] + feedback[i] * output;
+        for (int k = 0; k < last; k++) {
+            float y = a * x + state[k];
+            state[k] = x - a * y;
+            x = y;
+        }
+        output = x;
+        wet[i] = output;
+    }
+    phaser->pipe[last] = output;
+}
+
+#if defined(MODULATION_SSE)
+// Four stages per register with the pipeline held in registers: after each
+// step the outputs move up one lane, carrying lane 3 into the next
+// register. Padding lanes past the last stage never reach an output.
+static void phaser_pipeline_sse(Phaser* phaser, const sample_t* in, sample_t* wet, size_t n,
+                                float a, float da) {
+    const int last = phaser->num_stages;
+    const int regs = (last + 3) / 4;
+    const int out_lane = (last - 1) & 3;
+    float output = phaser->pipe[last];
+    __m128 pipe[PHASER_MAX_STAGES / 4];
+    __m128 state[PHASER_MAX_STAGES / 4];
+    __m128 y[PHASER_MAX_STAGES / 4];
+    float lanes[4];
+    
+    for (int r = 0; r < regs; r++) {
+        pipe[r] = _mm_loadu_ps(phaser->pipe + 4 * r);
+        state[r] = _mm_loadu_ps(phaser->state + 4 * r);
+    }
+    
+    for (size_t i = 0; i < n; i++) {
+        a += da;
+        const __m128 av = _mm_set1_ps(a);
+        pipe[0] = _mm_move_ss(pipe[0], _mm_set_ss(in[i]));
+        
+        for (int r = 0; r < regs; r++) {
+            y[r] = _mm_add_ps(_mm_mul_ps(av, pipe[r]), state[r]);
+            state[r] = _mm_sub_ps(pipe[r], _mm_mul_ps(av, y[r]));
+        }
+        for (int r = regs - 1; r > 0; r--) {
+            __m128 shifted = _mm_castsi128_ps(_mm_slli_si128(_mm_castps_si128(y[r]), 4));
+            pipe[r] = _mm_move_ss(shifted, _mm_shuffle_ps(y[r - 1], y[r - 1], _MM_SHUFFLE(3, 3, 3, 3)));
+        }
+        pipe[0] = _mm_castsi128_ps(_mm_slli_si128(_mm_castps_si128(y[0]), 4));
+        
+        _mm_storeu_ps(lanes, y[regs - 1]);
+        output = lanes[out_lane];
+        wet[i] = output;
+    }
+    
+    for (int r = 0; r < regs; r++) {
+        _mm_storeu_ps(phaser->pipe + 4 * r, pipe[r]);
+        _mm_storeu_ps(phaser->state + 4 * r, state[r]);
+    }
+    phaser->pipe[last] = output;
+}
+#endif
+
 // Process one sample through phaser
 sample_t phaser_process(Phaser* phaser, sample_t input) {
     if (!phaser) return input;
     
-    float lfo_value = lfo_process(&phaser->lfo);
-    
-    sample_t processed = input;
-    
-    // Process through allpass stages with LFO modulation
-    for (int i = 0; i < phaser->num_stages; i++) {
-        // Modulate the filter coefficients based on LFO
-        // This is a simplified approach - real phasers modulate the allpass frequency
-        processed = biquad_process(&phaser->allpass_stages[i], processed);
-        processed *= (1.0f + lfo_value * phaser->depth * 0.1f);
+    sample_t output;
+    phaser_process_block(phaser, &input, &output, 1);
+    return output;
+}
+
+// Process a block through phaser (in and out may be the same buffer).
+// Work is split at control-period boundaries; within a period the
+// coefficient ramps linearly to the value for the new LFO position, from
+// the rate and depth at the period start. A mode change waits until a
+// refilling pipeline is complete.
+void phaser_process_block(Phaser* phaser, const sample_t* in, sample_t* out, size_t n) {
+    if (!phaser) {
+        audio_block_bypass(in, out, n);
+        return;
+    }
+    if (!in || !out) return;
+    
+#if defined(MODULATION_SSE)
+    const int use_sse = cpu_simd_level() >= SIMD_LEVEL_SSE2;
+#endif
+    const size_t delay = (size_t)phaser->num_stages - 1;
+    sample_t wet[MOD_FILTER_CONTROL_RATE];
+    float wet_level[MOD_FILTER_CONTROL_RATE];
+    float feedback[MOD_FILTER_CONTROL_RATE];
+    LFO lfo = phaser->lfo;
+    
+    phaser_update_params(phaser, &lfo);
+    
+    size_t pos = 0;
+    while (pos < n) {
+        if (phaser->control_remaining == 0) {
+            if (param_smoother_active(&phaser->rate_smoother)) {
+                lfo_set_frequency(&lfo, phaser->rate_smoother.current);
+            }
+            float target = phaser_coefficient(phaser, phaser_sweep(phaser, &lfo));
+            phaser->coefficient_step = (target - phaser->coefficient) / MOD_FILTER_CONTROL_RATE;
+            phaser->control_remaining = MOD_FILTER_CONTROL_RATE;
+        }
+        
+        const int serial = phaser_wants_serial(phaser);
+        if (serial != phaser->serial && phaser->fill_remaining == 0) {
+            if (serial) {
+                phaser_pipeline_drain(phaser, phaser->coefficient);
+            } else {
+                phaser->fill_remaining = delay;
+            }
+            phaser->serial = serial;
+        }
+        
+        size_t count = n - pos < phaser->control_remaining ? n - pos : phaser->control_remaining;
+        if (phaser->fill_remaining && count > phaser->fill_remaining) count = phaser->fill_remaining;
+        const float a = phaser->coefficient;
+        const float da = phaser->coefficient_step;
+        param_smoother_fill(&phaser->feedback_smoother, feedback, count);
+        param_smoother_fill(&phaser->wet_smoother, wet_level, count);
+        param_smoother_skip(&phaser->rate_smoother, count);
+        param_smoother_skip(&phaser->depth_smoother, count);
+        
+        if (phaser->serial) {
+            phaser_serial(phaser, in + pos, feedback, wet, count, a, da);
+        } else if (phaser->fill_remaining) {
+            phaser_pipeline_fill(phaser, in + pos, wet, count, a, da);
+        } else
+#if defined(MODULATION_SSE)
+        if (use_sse) {
+            phaser_pipeline_sse(phaser, in + pos, wet, count, a, da);
+        } else
+#endif
+        {
+            phaser_pipeline_scalar(phaser, in + pos, wet, count, a, da);
+        }
+        
+        phaser->coefficient = a + da * (float)count;
+        phaser->control_remaining -= count;
+        
+        // Delay the dry signal, and serial outputs, by the pipeline latency
+        for (size_t i = 0; i < count; i++) {
+            sample_t dry = phaser->dry_delay[phaser->dry_pos];
+            phaser->dry_delay[phaser->dry_pos] = in[pos + i];
+            if (phaser->serial) {
+                sample_t held = phaser->wet_delay[phaser->dry_pos];
+                phaser->wet_delay[phaser->dry_pos] = wet[i];
+                wet[i] = held;
+            }
+            if (++phaser->dry_pos == delay) phaser->dry_pos = 0;
+            out[pos + i] = dry * (1.0f - wet_level[i]) + wet[i] * wet_level[i];
+        }
+        pos += count;
     }
     
-    // Add feedback
-    processed += processed * phaser->feedback * 0.5f;
-    
-    // Mix with original
-    return input * phaser->dry_level + processed * phaser->wet_level;
+    phaser->lfo = lfo;
 }
 
 // Process buffer through phaser
 void phaser_process_buffer(Phaser* phaser, AudioBuffer* buffer) {
     if (!phaser || !buffer || !buffer->data) return;
     
-    for (size_t i = 0; i < buffer->capacity; i++) {
-        buffer->data[i] = phaser_process(phaser, buffer->data[i]);
+    phaser_process_block(phaser, buffer->data, buffer->data, buffer->capacity);
+}
+
+// Block adapter used for per-channel processing
+static void phaser_channel_block(void* effect, const sample_t* in, sample_t* out, size_t n) {
+    phaser_process_block((Phaser*)effect, in, out, n);
+}
+
+// Process each channel of an interleaved buffer with its own phaser instance
+void phaser_process_channels(Phaser** phasers, AudioBuffer* buffer) {
+    if (!phasers || !buffer || !buffer->data || buffer->channels > MAX_CHANNELS) return;
+    
+    void* instances[MAX_CHANNELS];
+    for (size_t ch = 0; ch < buffer->channels; ch++) {
+        instances[ch] = phasers[ch];
     }
+    audio_buffer_process_channels(buffer, phaser_channel_block, instances);
+}
+
+// Clear phaser history (parameters are kept)
+void phaser_reset(Phaser* phaser) {
+    if (!phaser) return;
+    
+    memset(phaser->pipe, 0, sizeof(phaser->pipe));
+    memset(phaser->state, 0, sizeof(phaser->state));
+    memset(phaser->dry_delay, 0, sizeof(phaser->dry_delay));
+    memset(phaser->wet_delay, 0, sizeof(phaser->wet_delay));
+    phaser->dry_pos = 0;
+    phaser->fill_remaining = 0;
+    phaser->lfo.phase = 0;
+    phaser->coefficient = phaser_coefficient(phaser, PHASER_CENTER_HZ);
+    phaser->coefficient_step = 0.0f;
+    phaser->control_remaining = 0;
+    
+    param_smoother_snap(&phaser->rate_smoother);
+    param_smoother_snap(&phaser->depth_smoother);
+    param_smoother_snap(&phaser->feedback_smoother);
+    param_smoother_snap(&phaser->wet_smoother);
+    phaser->serial = phaser_wants_serial(phaser);
+}
+
+// Samples by which the output trails the input
+size_t phaser_latency(const Phaser* phaser) {
+    return phaser ? (size_t)phaser->num_stages - 1 : 0;
+}
+
+// Effect interface adapters
+static void phaser_effect_reset(void* effect) {
+    phaser_reset((Phaser*)effect);
+}
+
+static int phaser_effect_set_param(void* effect, int param, float value) {
+    Phaser* phaser = (Phaser*)effect;
+    if (param < 0 || param >= 4) return 0;
+    
+    float p[4] = {phaser->rate, phaser->depth, phaser->feedback, phaser->wet_level};
+    p[param] = value;
+    phaser_set_params(phaser, p[0], p[1], p[2], p[3]);
+    return 1;
+}
+
+static size_t phaser_effect_latency(const void* effect) {
+    return phaser_latency((const Phaser*)effect);
+}
+
+static void phaser_effect_destroy(void* effect) {
+    phaser_destroy((Phaser*)effect);
+}
+
+static const EffectVTable phaser_vtable = {
+    .name = "phaser",
+    .process_block = phaser_channel_block,
+    .reset = phaser_effect_reset,
+    .set_param = phaser_effect_set_param,
+    .latency = phaser_effect_latency,
+    .destroy = phaser_effect_destroy
+};
+
+// Wrap in the effect interface (params: rate, depth, feedback, wet_level)
+Effect phaser_effect(Phaser* phaser) {
+    Effect effect = { &phaser_vtable, phaser };
+    return effect;
 }
 
 // Tremolo functions
 
 // Create tremolo effect
 Tremolo* tremolo_create(float sample_rate) {
-    Tremolo* tremolo = malloc(sizeof(Tremolo));
+    Tremolo* tremolo = audio_malloc(sizeof(Tremolo));
     if (!tremolo) return NULL;
     
     lfo_init(&tremolo->lfo, 4.0f, sample_rate);
@@ -351,13 +1175,18 @@ Tremolo* tremolo_create(float sample_rate) {
     tremolo->rate = 4.0f;
     tremolo->stereo_phase = 0;
     
+    param_smoother_init(&tremolo->rate_smoother, tremolo->rate, PARAM_SMOOTH_DEFAULT_MS, sample_rate,
+                        PARAM_SMOOTH_ONE_POLE);
+    param_smoother_init(&tremolo->depth_smoother, tremolo->depth, PARAM_SMOOTH_DEFAULT_MS, sample_rate,
+                        PARAM_SMOOTH_LINEAR);
+    
     return tremolo;
 }
 
 // Destroy tremolo
 void tremolo_destroy(Tremolo* tremolo) {
     if (tremolo) {
-        free(tremolo);
+        audio_free(tremolo);
     }
 }
 
@@ -367,29 +1196,150 @@ void tremolo_set_params(Tremolo* tremolo, float rate, float depth, int stereo_ph
     
     tremolo->rate = clamp(rate, 0.1f, 20.0f);
     tremolo->depth = clamp(depth, 0.0f, 1.0f);
-    tremolo->stereo_phase = stereo_phase;
+    __atomic_store_n(&tremolo->stereo_phase, stereo_phase, __ATOMIC_RELAXED);
     
-    lfo_set_params(&tremolo->lfo, tremolo->rate, tremolo->depth, 1.0f - tremolo->depth);
+    param_smoother_set_target(&tremolo->rate_smoother, tremolo->rate);
+    param_smoother_set_target(&tremolo->depth_smoother, tremolo->depth);
+}
+
+// Pick up new parameter targets; returns nonzero while a ramp is active.
+// The gain swings between 1 - 2 * depth and 1.
+static int tremolo_update_params(Tremolo* tremolo) {
+    int changed = param_smoother_update(&tremolo->rate_smoother);
+    changed |= param_smoother_update(&tremolo->depth_smoother);
+    
+    if (changed) {
+        const float depth = tremolo->depth_smoother.current;
+        lfo_set_params(&tremolo->lfo, tremolo->rate_smoother.current, depth, 1.0f - depth);
+    }
+    
+    return param_smoother_active(&tremolo->rate_smoother) || param_smoother_active(&tremolo->depth_smoother);
+}
+
+// Next count gains; ramping comes from tremolo_update_params and the
+// return value says whether a ramp is still active
+static int tremolo_render(Tremolo* tremolo, int ramping, float* gain, size_t count) {
+    if (!ramping) {
+        lfo_render(&tremolo->lfo, LFO_SINE, gain, count);
+        return 0;
+    }
+    
+    float depth[LFO_BLOCK];
+    float offset[LFO_BLOCK];
+    param_smoother_fill(&tremolo->depth_smoother, depth, count);
+    for (size_t i = 0; i < count; i++) {
+        offset[i] = 1.0f - depth[i];
+    }
+    lfo_render_ramp(&tremolo->lfo, LFO_SINE, &tremolo->rate_smoother, depth, offset, gain, count);
+    return param_smoother_active(&tremolo->rate_smoother) || param_smoother_active(&tremolo->depth_smoother);
 }
 
 // Process one sample through tremolo
 sample_t tremolo_process(Tremolo* tremolo, sample_t input) {
     if (!tremolo) return input;
     
-    float lfo_value = lfo_process(&tremolo->lfo);
-    return input * lfo_value;
+    sample_t output;
+    tremolo_process_block(tremolo, &input, &output, 1);
+    return output;
+}
+
+// Process a block through tremolo (in and out may be the same buffer)
+void tremolo_process_block(Tremolo* tremolo, const sample_t* in, sample_t* out, size_t n) {
+    if (!tremolo) {
+        audio_block_bypass(in, out, n);
+        return;
+    }
+    if (!in || !out) return;
+    
+    int ramping = tremolo_update_params(tremolo);
+    float gain[LFO_BLOCK];
+    for (size_t start = 0; start < n; start += LFO_BLOCK) {
+        size_t count = n - start < LFO_BLOCK ? n - start : LFO_BLOCK;
+        ramping = tremolo_render(tremolo, ramping, gain, count);
+        for (size_t i = 0; i < count; i++) {
+            out[start + i] = in[start + i] * gain[i];
+        }
+    }
+}
+
+// Process buffer through tremolo
+void tremolo_process_buffer(Tremolo* tremolo, AudioBuffer* buffer) {
+    if (!tremolo || !buffer || !buffer->data) return;
+    
+    tremolo_process_block(tremolo, buffer->data, buffer->data, buffer->capacity);
+}
+
+// Block adapter used for per-channel processing
+static void tremolo_channel_block(void* effect, const sample_t* in, sample_t* out, size_t n) {
+    tremolo_process_block((Tremolo*)effect, in, out, n);
+}
+
+// Process each channel of an interleaved buffer with its own tremolo instance
+void tremolo_process_channels(Tremolo** tremolos, AudioBuffer* buffer) {
+    if (!tremolos || !buffer || !buffer->data || buffer->channels > MAX_CHANNELS) return;
+    
+    void* instances[MAX_CHANNELS];
+    for (size_t ch = 0; ch < buffer->channels; ch++) {
+        instances[ch] = tremolos[ch];
+    }
+    audio_buffer_process_channels(buffer, tremolo_channel_block, instances);
+}
+
+// Clear tremolo history (parameters are kept)
+void tremolo_reset(Tremolo* tremolo) {
+    if (!tremolo) return;
+    
+    tremolo->lfo.phase = 0;
+    
+    param_smoother_snap(&tremolo->rate_smoother);
+    param_smoother_snap(&tremolo->depth_smoother);
+}
+
+// Effect interface adapters
+static void tremolo_effect_reset(void* effect) {
+    tremolo_reset((Tremolo*)effect);
+}
+
+static int tremolo_effect_set_param(void* effect, int param, float value) {
+    Tremolo* tremolo = (Tremolo*)effect;
+    if (param < 0 || param >= 3) return 0;
+    
+    float p[3] = {tremolo->rate, tremolo->depth, (float)tremolo->stereo_phase};
+    p[param] = value;
+    tremolo_set_params(tremolo, p[0], p[1], (int)p[2]);
+    return 1;
+}
+
+static void tremolo_effect_destroy(void* effect) {
+    tremolo_destroy((Tremolo*)effect);
+}
+
+static const EffectVTable tremolo_vtable = {
+    .name = "tremolo",
+    .process_block = tremolo_channel_block,
+    .reset = tremolo_effect_reset,
+    .set_param = tremolo_effect_set_param,
+    .latency = NULL,
+    .destroy = tremolo_effect_destroy
+};
+
+// Wrap in the effect interface (params: rate, depth, stereo_phase)
+Effect tremolo_effect(Tremolo* tremolo) {
+    Effect effect = { &tremolo_vtable, tremolo };
+    return effect;
 }
 
 // Process stereo samples through tremolo
 void tremolo_process_stereo(Tremolo* tremolo, sample_t* left, sample_t* right) {
     if (!tremolo) return;
     
-    float lfo_left = lfo_process(&tremolo->lfo);
+    float lfo_left;
+    tremolo_render(tremolo, tremolo_update_params(tremolo), &lfo_left, 1);
     
     float lfo_right;
-    if (tremolo->stereo_phase) {
+    if (__atomic_load_n(&tremolo->stereo_phase, __ATOMIC_RELAXED)) {
         // For stereo tremolo, right channel is 180 degrees out of phase
-        lfo_right = 2.0f * (1.0f - tremolo->depth) - lfo_left;
+        lfo_right = 2.0f * tremolo->lfo.offset - lfo_left;
     } else {
         lfo_right = lfo_left;
     }
@@ -402,24 +1352,32 @@ void tremolo_process_stereo(Tremolo* tremolo, sample_t* left, sample_t* right) {
 
 // Create vibrato effect
 Vibrato* vibrato_create(float max_delay_ms, float sample_rate) {
-    Vibrato* vibrato = malloc(sizeof(Vibrato));
+    Vibrato* vibrato = audio_malloc(sizeof(Vibrato));
     if (!vibrato) return NULL;
     
     size_t max_delay_samples = (size_t)((max_delay_ms / 1000.0f) * sample_rate);
     DelayLine* delay = delay_line_create(max_delay_samples);
     if (!delay) {
-        free(vibrato);
+        audio_free(vibrato);
         return NULL;
     }
     
     vibrato->delay = *delay;
-    free(delay);
+    audio_free(delay);
+    delay_interp_init(&vibrato->interpolator, MODULATION_DEFAULT_INTERPOLATION);
     
     lfo_init(&vibrato->lfo, 5.0f, sample_rate);
     vibrato->depth = 0.3f;
     vibrato->rate = 5.0f;
     vibrato->wet_level = 1.0f;
     
+    param_smoother_init(&vibrato->rate_smoother, vibrato->rate, PARAM_SMOOTH_DEFAULT_MS, sample_rate,
+                        PARAM_SMOOTH_ONE_POLE);
+    param_smoother_init(&vibrato->depth_smoother, vibrato->depth, PARAM_SMOOTH_DEFAULT_MS, sample_rate,
+                        PARAM_SMOOTH_LINEAR);
+    param_smoother_init(&vibrato->wet_smoother, vibrato->wet_level, PARAM_SMOOTH_DEFAULT_MS, sample_rate,
+                        PARAM_SMOOTH_LINEAR);
+    
     return vibrato;
 }
 
@@ -427,9 +1385,9 @@ Vibrato* vibrato_create(float max_delay_ms, float sample_rate) {
 void vibrato_destroy(Vibrato* vibrato) {
     if (vibrato) {
         if (vibrato->delay.buffer) {
-            free(vibrato->delay.buffer);
+            audio_free(vibrato->delay.buffer);
         }
-        free(vibrato);
+        audio_free(vibrato);
     }
 }
 
@@ -441,43 +1399,177 @@ void vibrato_set_params(Vibrato* vibrato, float rate, float depth, float wet_lev
     vibrato->depth = clamp(depth, 0.0f, 1.0f);
     vibrato->wet_level = clamp(wet_level, 0.0f, 1.0f);
     
-    lfo_set_params(&vibrato->lfo, vibrato->rate, vibrato->depth, 0.5f);
+    param_smoother_set_target(&vibrato->rate_smoother, vibrato->rate);
+    param_smoother_set_target(&vibrato->depth_smoother, vibrato->depth);
+    param_smoother_set_target(&vibrato->wet_smoother, vibrato->wet_level);
+}
+
+// Nonzero while a vibrato parameter ramps
+static int vibrato_ramping(const Vibrato* vibrato) {
+    return param_smoother_active(&vibrato->rate_smoother) || param_smoother_active(&vibrato->depth_smoother) ||
+           param_smoother_active(&vibrato->wet_smoother);
+}
+
+// Pick up new parameter targets; returns nonzero while a ramp is active
+static int vibrato_update_params(Vibrato* vibrato) {
+    int changed = param_smoother_update(&vibrato->rate_smoother);
+    changed |= param_smoother_update(&vibrato->depth_smoother);
+    changed |= param_smoother_update(&vibrato->wet_smoother);
+    
+    if (changed) {
+        lfo_set_params(&vibrato->lfo, vibrato->rate_smoother.current, vibrato->depth_smoother.current, 0.5f);
+    }
+    
+    return vibrato_ramping(vibrato);
+}
+
+// Choose the fractional delay interpolator (not real-time safe)
+void vibrato_set_interpolation(Vibrato* vibrato, DelayInterpolation mode) {
+    if (!vibrato) return;
+    
+    delay_interp_init(&vibrato->interpolator, mode);
 }
 
 // Process one sample through vibrato
 sample_t vibrato_process(Vibrato* vibrato, sample_t input) {
     if (!vibrato) return input;
     
-    // Write input to delay line
-    delay_line_write(&vibrato->delay, input);
-    
-    // Get LFO value to modulate delay time
-    float lfo_value = lfo_process(&vibrato->lfo);
-    float delay_samples = lfo_value * (vibrato->delay.size / 6.0f);
-    
-    // Ensure minimum delay
-    delay_samples = clamp(delay_samples, 1.0f, (float)(vibrato->delay.size - 1));
-    
-    // Read modulated signal
-    sample_t delayed = delay_line_read_interpolated(&vibrato->delay, delay_samples);
+    sample_t output;
+    vibrato_process_block(vibrato, &input, &output, 1);
+    return output;
+}
+
+// Process a block through vibrato (in and out may be the same buffer)
+void vibrato_process_block(Vibrato* vibrato, const sample_t* in, sample_t* out, size_t n) {
+    if (!vibrato || !vibrato->delay.buffer) {
+        audio_block_bypass(in, out, n);
+        return;
+    }
+    if (!in || !out) return;
+    
+    int ramping = vibrato_update_params(vibrato);
+    
+    DelayLine delay = vibrato->delay;
+    DelayInterpolator interpolator = vibrato->interpolator;
+    LFO lfo = vibrato->lfo;
+    const float delay_range = delay.size / 6.0f;
+    float delays[LFO_BLOCK];
+    float wet[LFO_BLOCK];
+    sample_t delayed[LFO_BLOCK];
+    
+    for (size_t start = 0; start < n; start += LFO_BLOCK) {
+        size_t count = n - start < LFO_BLOCK ? n - start : LFO_BLOCK;
+        
+        if (ramping) {
+            float depth[LFO_BLOCK];
+            float offset[LFO_BLOCK];
+            param_smoother_fill(&vibrato->depth_smoother, depth, count);
+            for (size_t i = 0; i < count; i++) {
+                offset[i] = 0.5f;
+            }
+            lfo_render_ramp(&lfo, LFO_SINE, &vibrato->rate_smoother, depth, offset, delays, count);
+        } else {
+            lfo_render(&lfo, LFO_SINE, delays, count);
+        }
+        param_smoother_fill(&vibrato->wet_smoother, wet, count);
+        ramping = vibrato_ramping(vibrato);
+        for (size_t i = 0; i < count; i++) {
+            delays[i] = delays[i] * delay_range - 1.0f; // Counted from the previous input
+        }
+        
+        size_t done = 0;
+        while (done < count) {
+            size_t ready = delay_line_read_modulated(&delay, &interpolator, delays + done, delayed, count - done);
+            
+            for (size_t i = 0; i < ready; i++) {
+                sample_t input = in[start + done + i];
+                delay_line_push(&delay, input);
+                out[start + done + i] = delayed[i] * wet[done + i] + input * (1.0f - wet[done + i]);
+            }
+            done += ready;
+        }
+    }
     
-    return delayed * vibrato->wet_level + input * (1.0f - vibrato->wet_level);
+    vibrato->delay.write_pos = delay.write_pos;
+    vibrato->interpolator = interpolator;
+    vibrato->lfo = lfo;
 }
 
 // Process buffer through vibrato
 void vibrato_process_buffer(Vibrato* vibrato, AudioBuffer* buffer) {
     if (!vibrato || !buffer || !buffer->data) return;
     
-    for (size_t i = 0; i < buffer->capacity; i++) {
-        buffer->data[i] = vibrato_process(vibrato, buffer->data[i]);
+    vibrato_process_block(vibrato, buffer->data, buffer->data, buffer->capacity);
+}
+
+// Block adapter used for per-channel processing
+static void vibrato_channel_block(void* effect, const sample_t* in, sample_t* out, size_t n) {
+    vibrato_process_block((Vibrato*)effect, in, out, n);
+}
+
+// Process each channel of an interleaved buffer with its own vibrato instance
+void vibrato_process_channels(Vibrato** vibratos, AudioBuffer* buffer) {
+    if (!vibratos || !buffer || !buffer->data || buffer->channels > MAX_CHANNELS) return;
+    
+    void* instances[MAX_CHANNELS];
+    for (size_t ch = 0; ch < buffer->channels; ch++) {
+        instances[ch] = vibratos[ch];
     }
+    audio_buffer_process_channels(buffer, vibrato_channel_block, instances);
+}
+
+// Clear vibrato history (parameters are kept)
+void vibrato_reset(Vibrato* vibrato) {
+    if (!vibrato) return;
+    
+    delay_line_clear(&vibrato->delay);
+    delay_interp_reset(&vibrato->interpolator);
+    vibrato->lfo.phase = 0;
+    
+    param_smoother_snap(&vibrato->rate_smoother);
+    param_smoother_snap(&vibrato->depth_smoother);
+    param_smoother_snap(&vibrato->wet_smoother);
+}
+
+// Effect interface adapters
+static void vibrato_effect_reset(void* effect) {
+    vibrato_reset((Vibrato*)effect);
+}
+
+static int vibrato_effect_set_param(void* effect, int param, float value) {
+    Vibrato* vibrato = (Vibrato*)effect;
+    if (param < 0 || param >= 3) return 0;
+    
+    float p[3] = {vibrato->rate, vibrato->depth, vibrato->wet_level};
+    p[param] = value;
+    vibrato_set_params(vibrato, p[0], p[1], p[2]);
+    return 1;
+}
+
+static void vibrato_effect_destroy(void* effect) {
+    vibrato_destroy((Vibrato*)effect);
+}
+
+static const EffectVTable vibrato_vtable = {
+    .name = "vibrato",
+    .process_block = vibrato_channel_block,
+    .reset = vibrato_effect_reset,
+    .set_param = vibrato_effect_set_param,
+    .latency = NULL,
+    .destroy = vibrato_effect_destroy
+};
+
+// Wrap in the effect interface (params: rate, depth, wet_level)
+Effect vibrato_effect(Vibrato* vibrato) {
+    Effect effect = { &vibrato_vtable, vibrato };
+    return effect;
 }
 
 // Auto-wah functions
 
 // Create auto-wah effect
 AutoWah* autowah_create(float sample_rate) {
-    AutoWah* autowah = malloc(sizeof(AutoWah));
+    AutoWah* autowah = audio_malloc(sizeof(AutoWah));
     if (!autowah) return NULL;
     
     autowah->sensitivity = 0.5f;
@@ -487,17 +1579,28 @@ AutoWah* autowah_create(float sample_rate) {
     autowah->rate = 0.0f; // Manual control initially
     autowah->sample_rate = sample_rate;
     
-    biquad_bandpass(&autowah->filter, 1000.0f, 2.0f, sample_rate);
+    modfilter_init(&autowah->filter, FILTER_BANDPASS, 1000.0f, autowah->resonance, sample_rate);
     lfo_init(&autowah->lfo, 0.5f, sample_rate);
     onepole_lowpass(&autowah->envelope_follower, 10.0f, sample_rate);
     
+    param_smoother_init(&autowah->sensitivity_smoother, autowah->sensitivity, PARAM_SMOOTH_DEFAULT_MS, sample_rate,
+                        PARAM_SMOOTH_LINEAR);
+    param_smoother_init(&autowah->frequency_min_smoother, autowah->frequency_min, PARAM_SMOOTH_DEFAULT_MS,
+                        sample_rate, PARAM_SMOOTH_LINEAR);
+    param_smoother_init(&autowah->frequency_max_smoother, autowah->frequency_max, PARAM_SMOOTH_DEFAULT_MS,
+                        sample_rate, PARAM_SMOOTH_LINEAR);
+    param_smoother_init(&autowah->resonance_smoother, autowah->resonance, PARAM_SMOOTH_DEFAULT_MS, sample_rate,
+                        PARAM_SMOOTH_ONE_POLE);
+    param_smoother_init(&autowah->rate_smoother, autowah->rate, PARAM_SMOOTH_DEFAULT_MS, sample_rate,
+                        PARAM_SMOOTH_ONE_POLE);
+    
     return autowah;
 }
 
 // Destroy auto-wah
 void autowah_destroy(AutoWah* autowah) {
     if (autowah) {
-        free(autowah);
+        audio_free(autowah);
     }
 }
 
@@ -511,39 +1614,171 @@ void autowah_set_params(AutoWah* autowah, float sensitivity, float freq_min, flo
     autowah->resonance = clamp(resonance, 0.5f, 10.0f);
     autowah->rate = clamp(rate, 0.0f, 5.0f);
     
-    lfo_set_params(&autowah->lfo, autowah->rate, 1.0f, 0.0f);
+    param_smoother_set_target(&autowah->sensitivity_smoother, autowah->sensitivity);
+    param_smoother_set_target(&autowah->frequency_min_smoother, autowah->frequency_min);
+    param_smoother_set_target(&autowah->frequency_max_smoother, autowah->frequency_max);
+    param_smoother_set_target(&autowah->resonance_smoother, autowah->resonance);
+    param_smoother_set_target(&autowah->rate_smoother, autowah->rate);
+}
+
+// Nonzero while an auto-wah parameter ramps
+static int autowah_ramping(const AutoWah* autowah) {
+    return param_smoother_active(&autowah->sensitivity_smoother) ||
+           param_smoother_active(&autowah->frequency_min_smoother) ||
+           param_smoother_active(&autowah->frequency_max_smoother) ||
+           param_smoother_active(&autowah->resonance_smoother) || param_smoother_active(&autowah->rate_smoother);
+}
+
+// Pick up new parameter targets; returns nonzero when a value changed or ramps
+static int autowah_update_params(AutoWah* autowah) {
+    int changed = param_smoother_update(&autowah->sensitivity_smoother);
+    changed |= param_smoother_update(&autowah->frequency_min_smoother);
+    changed |= param_smoother_update(&autowah->frequency_max_smoother);
+    changed |= param_smoother_update(&autowah->resonance_smoother);
+    changed |= param_smoother_update(&autowah->rate_smoother);
+    return changed;
+}
+
+// Advance every ramp by one sample; returns nonzero while one is still active
+static int autowah_step_params(AutoWah* autowah) {
+    param_smoother_next(&autowah->sensitivity_smoother);
+    param_smoother_next(&autowah->frequency_min_smoother);
+    param_smoother_next(&autowah->frequency_max_smoother);
+    param_smoother_next(&autowah->resonance_smoother);
+    param_smoother_next(&autowah->rate_smoother);
+    return autowah_ramping(autowah);
 }
 
 // Process one sample through auto-wah
 sample_t autowah_process(AutoWah* autowah, sample_t input) {
     if (!autowah) return input;
     
-    // Envelope following
-    float envelope = onepole_process(&autowah->envelope_follower, fabsf(input), 0);
-    
-    // Calculate filter frequency
-    float freq;
-    if (autowah->rate > 0.0f) {
-        // LFO mode
-        float lfo_value = (lfo_process(&autowah->lfo) + 1.0f) * 0.5f; // Normalize to 0-1
-        freq = autowah->frequency_min + lfo_value * (autowah->frequency_max - autowah->frequency_min);
-    } else {
-        // Envelope-following mode
-        freq = autowah->frequency_min + envelope * autowah->sensitivity * (autowah->frequency_max - autowah->frequency_min);
+    sample_t output;
+    autowah_process_block(autowah, &input, &output, 1);
+    return output;
+}
+
+// Process a block through auto-wah (in and out may be the same buffer)
+void autowah_process_block(AutoWah* autowah, const sample_t* in, sample_t* out, size_t n) {
+    if (!autowah) {
+        audio_block_bypass(in, out, n);
+        return;
+    }
+    if (!in || !out) return;
+    
+    ModulatedFilter filter = autowah->filter;
+    OnePoleFilter envelope_follower = autowah->envelope_follower;
+    LFO lfo = autowah->lfo;
+    int changed = autowah_update_params(autowah);
+    int ramping = autowah_ramping(autowah);
+    
+    // The envelope runs every sample; the cutoff follows it (or the LFO)
+    // once per control period, from the parameters at that sample
+    for (size_t i = 0; i < n; i++) {
+        sample_t input = in[i];
+        float envelope = onepole_tick_lowpass(&envelope_follower, fabsf(input));
+        
+        if (modfilter_control_due(&filter)) {
+            const float rate = autowah->rate_smoother.current;
+            const int lfo_mode = rate > 0.0f;
+            const float freq_min = autowah->frequency_min_smoother.current;
+            const float freq_range = autowah->frequency_max_smoother.current - freq_min;
+            
+            if (changed) {
+                if (lfo_mode) lfo_set_frequency(&lfo, rate);
+                modfilter_set_q(&filter, autowah->resonance_smoother.current);
+                changed = ramping;
+            }
+            
+            float freq;
+            if (lfo_mode) {
+                freq = freq_min + (lfo_control(&lfo, MOD_FILTER_CONTROL_RATE) + 1.0f) * 0.5f * freq_range;
+            } else {
+                freq = freq_min + envelope * autowah->sensitivity_smoother.current * freq_range;
+            }
+            modfilter_target(&filter, freq);
+        }
+        
+        out[i] = modfilter_tick(&filter, input);
+        if (ramping) {
+            ramping = autowah_step_params(autowah);
+            changed = 1;
+        }
     }
     
-    // Update filter frequency
-    biquad_bandpass(&autowah->filter, freq, autowah->resonance, autowah->sample_rate);
-    
-    // Process through filter
-    return biquad_process(&autowah->filter, input);
+    autowah->filter = filter;
+    autowah->envelope_follower = envelope_follower;
+    autowah->lfo = lfo;
 }
 
 // Process buffer through auto-wah
 void autowah_process_buffer(AutoWah* autowah, AudioBuffer* buffer) {
     if (!autowah || !buffer || !buffer->data) return;
     
-    for (size_t i = 0; i < buffer->capacity; i++) {
-        buffer->data[i] = autowah_process(autowah, buffer->data[i]);
+    autowah_process_block(autowah, buffer->data, buffer->data, buffer->capacity);
+}
+
+// Block adapter used for per-channel processing
+static void autowah_channel_block(void* effect, const sample_t* in, sample_t* out, size_t n) {
+    autowah_process_block((AutoWah*)effect, in, out, n);
+}
+
+// Process each channel of an interleaved buffer with its own auto-wah instance
+void autowah_process_channels(AutoWah** autowahs, AudioBuffer* buffer) {
+    if (!autowahs || !buffer || !buffer->data || buffer->channels > MAX_CHANNELS) return;
+    
+    void* instances[MAX_CHANNELS];
+    for (size_t ch = 0; ch < buffer->channels; ch++) {
+        instances[ch] = autowahs[ch];
     }
-}
\ No newline at end of file
+    audio_buffer_process_channels(buffer, autowah_channel_block, instances);
+}
+
+// Clear auto-wah history (parameters are kept)
+void autowah_reset(AutoWah* autowah) {
+    if (!autowah) return;
+    
+    modfilter_reset(&autowah->filter);
+    onepole_reset(&autowah->envelope_follower);
+    autowah->lfo.phase = 0;
+    
+    param_smoother_snap(&autowah->sensitivity_smoother);
+    param_smoother_snap(&autowah->frequency_min_smoother);
+    param_smoother_snap(&autowah->frequency_max_smoother);
+    param_smoother_snap(&autowah->resonance_smoother);
+    param_smoother_snap(&autowah->rate_smoother);
+}
+
+// Effect interface adapters
+static void autowah_effect_reset(void* effect) {
+    autowah_reset((AutoWah*)effect);
+}
+
+static int autowah_effect_set_param(void* effect, int param, float value) {
+    AutoWah* autowah = (AutoWah*)effect;
+    if (param < 0 || param >= 5) return 0;
+    
+    float p[5] = {autowah->sensitivity, autowah->frequency_min, autowah->frequency_max, autowah->resonance, autowah->rate};
+    p[param] = value;
+    autowah_set_params(autowah, p[0], p[1], p[2], p[3], p[4]);
+    return 1;
+}
+
+static void autowah_effect_destroy(void* effect) {
+    autowah_destroy((AutoWah*)effect);
+}
+
+static const EffectVTable autowah_vtable = {
+    .name = "auto-wah",
+    .process_block = autowah_channel_block,
+    .reset = autowah_effect_reset,
+    .set_param = autowah_effect_set_param,
+    .latency = NULL,
+    .destroy = autowah_effect_destroy
+};
+
+// Wrap in the effect interface (params: sensitivity, freq_min, freq_max, resonance, rate)
+Effect autowah_effect(AutoWah* autowah) {
+    Effect effect = { &autowah_vtable, autowah };
+    return effect;
+}
@@ -1,4 +1,49 @@
 #include "reverb.h"
+#include "cpu_features.h"
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define REVERB_SSE 1
+#endif
+#if defined(AUDIO_X86_DISPATCH)
+#include <immintrin.h>
+#endif
+
+// Largest chunk for which every delay line can be read as a block before
+// it is written (the chunk may not exceed the shortest delay)
+static size_t reverb_chunk_size(const DelayLine* lines, int count, size_t limit) {
+    for (int i = 0; i < count; i++) {
+        size_t delay_samples = lines[i].size - 1;
+        if (delay_samples < limit) limit = delay_samples;
+    }
+    return limit > 0 ? limit : 1;
+}
+
+// Allocate one delay line in place
+static int reverb_line_init(DelayLine* line, size_t delay_samples) {
+    DelayLine* delay = delay_line_create(delay_samples);
+    if (!delay) return 0;
+    
+    *line = *delay;
+    audio_free(delay);
+    return 1;
+}
+
+// Per-sample gain scale and wet level for one chunk while either ramps;
+// returns nonzero while a ramp is still active afterwards
+static int reverb_fill_ramps(ParamSmoother* scale, ParamSmoother* wet, float* scales, float* wets, size_t count) {
+    param_smoother_fill(scale, scales, count);
+    param_smoother_fill(wet, wets, count);
+    return param_smoother_active(scale) || param_smoother_active(wet);
+}
+
+// Dry/wet mix with a ramping wet level
+static void reverb_mix_ramp(const sample_t* in, const sample_t* wet_sum, const float* wets, sample_t* out,
+                            size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        out[i] = in[i] * (1.0f - wets[i]) + wet_sum[i] * wets[i];
+    }
+}
 
 // Schroeder reverb delay times (in samples at 44.1kHz)
 static const int schroeder_comb_delays[] = {1116, 1188, 1277, 1356};
@@ -8,7 +53,7 @@ static const float schroeder_allpass_gains[] = {0.7f, 0.7f};
 
 // Create Schroeder reverb
 SchroederReverb* schroeder_reverb_create(float sample_rate) {
-    SchroederReverb* reverb = malloc(sizeof(SchroederReverb));
+    SchroederReverb* reverb = audio_malloc(sizeof(SchroederReverb));
     if (!reverb) return NULL;
     
     // Scale delay times to sample rate
@@ -23,11 +68,11 @@ SchroederReverb* schroeder_reverb_create(float sample_rate) {
             for (int j = 0; j < i; j++) {
                 delay_line_destroy(&reverb->comb_delays[j]);
             }
-            free(reverb);
+            audio_free(reverb);
             return NULL;
         }
         reverb->comb_delays[i] = *delay;
-        free(delay);
+        audio_free(delay);
         
         reverb->comb_gains[i] = schroeder_comb_gains[i];
         onepole_lowpass(&reverb->damping_filters[i], 5000.0f, sample_rate);
@@ -45,11 +90,11 @@ SchroederReverb* schroeder_reverb_create(float sample_rate) {
             for (int j = 0; j < i; j++) {
                 delay_line_destroy(&reverb->allpass_delays[j]);
             }
-            free(reverb);
+            audio_free(reverb);
             return NULL;
         }
         reverb->allpass_delays[i] = *delay;
-        free(delay);
+        audio_free(delay);
         
         reverb->allpass_gains[i] = schroeder_allpass_gains[i];
     }
@@ -59,6 +104,10 @@ SchroederReverb* schroeder_reverb_create(float sample_rate) {
     reverb->wet_level = 0.3f;
     reverb->dry_level = 0.7f;
     
+    param_smoother_init(&reverb->room_smoother, 1.0f, PARAM_SMOOTH_DEFAULT_MS, sample_rate, PARAM_SMOOTH_LINEAR);
+    param_smoother_init(&reverb->wet_smoother, reverb->wet_level, PARAM_SMOOTH_DEFAULT_MS, sample_rate,
+                        PARAM_SMOOTH_LINEAR);
+    
     return reverb;
 }
 
@@ -67,15 +116,15 @@ void schroeder_reverb_destroy(SchroederReverb* reverb) {
     if (reverb) {
         for (int i = 0; i < 4; i++) {
             if (reverb->comb_delays[i].buffer) {
-                free(reverb->comb_delays[i].buffer);
+                audio_free(reverb->comb_delays[i].buffer);
             }
         }
         for (int i = 0; i < 2; i++) {
             if (reverb->allpass_delays[i].buffer) {
-                free(reverb->allpass_delays[i].buffer);
+                audio_free(reverb->allpass_delays[i].buffer);
             }
         }
-        free(reverb);
+        audio_free(reverb);
     }
 }
 
@@ -88,16 +137,39 @@ void schroeder_reverb_set_params(SchroederReverb* reverb, float room_size, float
     reverb->wet_level = clamp(wet_level, 0.0f, 1.0f);
     reverb->dry_level = 1.0f - reverb->wet_level;
     
-    // Update comb gains based on room size
+    // Comb gains follow the room size
+    param_smoother_set_target(&reverb->room_smoother, reverb->room_size);
+    param_smoother_set_target(&reverb->wet_smoother, reverb->wet_level);
+}
+
+// Recompute the comb gains from the current room size
+static void schroeder_reverb_update_gains(SchroederReverb* reverb) {
     for (int i = 0; i < 4; i++) {
-        reverb->comb_gains[i] = schroeder_comb_gains[i] * reverb->room_size;
+        reverb->comb_gains[i] = schroeder_comb_gains[i] * reverb->room_smoother.current;
     }
 }
 
+// Pick up new parameter targets; returns nonzero while a ramp is active
+static int schroeder_reverb_update_params(SchroederReverb* reverb) {
+    if (param_smoother_update(&reverb->room_smoother)) {
+        schroeder_reverb_update_gains(reverb);
+    }
+    param_smoother_update(&reverb->wet_smoother);
+    
+    return param_smoother_active(&reverb->room_smoother) || param_smoother_active(&reverb->wet_smoother);
+}
+
 // Process one sample through Schroeder reverb
 sample_t schroeder_reverb_process(SchroederReverb* reverb, sample_t input) {
     if (!reverb) return input;
     
+    if (schroeder_reverb_update_params(reverb)) {
+        param_smoother_next(&reverb->room_smoother);
+        param_smoother_next(&reverb->wet_smoother);
+        schroeder_reverb_update_gains(reverb);
+    }
+    const float wet = reverb->wet_smoother.current;
+    
     sample_t comb_sum = 0.0f;
     
     // Process through comb filters
@@ -128,55 +200,301 @@ sample_t schroeder_reverb_process(SchroederReverb* reverb, sample_t input) {
         allpass_output = delayed - allpass_output * reverb->allpass_gains[i];
     }
     
-    return input * reverb->dry_level + allpass_output * reverb->wet_level;
+    return input * (1.0f - wet) + allpass_output * wet;
+}
+
+// Process a block through Schroeder reverb (in and out may be the same buffer).
+// Works in chunks no longer than the shortest delay so each comb and
+// allpass is read and written as contiguous spans.
+void schroeder_reverb_process_block(SchroederReverb* reverb, const sample_t* in, sample_t* out, size_t n) {
+    if (!reverb) {
+        audio_block_bypass(in, out, n);
+        return;
+    }
+    if (!in || !out) return;
+    
+    int ramping = schroeder_reverb_update_params(reverb);
+    
+    DelayLine combs[4];
+    DelayLine allpasses[2];
+    OnePoleFilter filters[4];
+    float allpass_gains[2];
+    memcpy(combs, reverb->comb_delays, sizeof(combs));
+    memcpy(allpasses, reverb->allpass_delays, sizeof(allpasses));
+    memcpy(filters, reverb->damping_filters, sizeof(filters));
+    memcpy(allpass_gains, reverb->allpass_gains, sizeof(allpass_gains));
+    
+    size_t chunk = reverb_chunk_size(combs, 4, AUDIO_CHANNEL_CHUNK);
+    chunk = reverb_chunk_size(allpasses, 2, chunk);
+    sample_t delayed[AUDIO_CHANNEL_CHUNK];
+    sample_t wet_sum[AUDIO_CHANNEL_CHUNK];
+    float scales[AUDIO_CHANNEL_CHUNK];
+    float wets[AUDIO_CHANNEL_CHUNK];
+    
+    for (size_t pos = 0; pos < n; pos += chunk) {
+        const size_t count = (n - pos < chunk) ? n - pos : chunk;
+        const sample_t* input = in + pos;
+        const int ramp_chunk = ramping;
+        if (ramp_chunk) {
+            ramping = reverb_fill_ramps(&reverb->room_smoother, &reverb->wet_smoother, scales, wets, count);
+        }
+        
+        memset(wet_sum, 0, count * sizeof(sample_t));
+        for (int c = 0; c < 4; c++) {
+            delay_line_read_block(&combs[c], combs[c].size - 1, delayed, count);
+            if (ramp_chunk) {
+                const float base = schroeder_comb_gains[c];
+                for (size_t i = 0; i < count; i++) {
+                    sample_t d = onepole_tick_lowpass(&filters[c], delayed[i]);
+                    wet_sum[i] += d;
+                    delayed[i] = input[i] + d * (base * scales[i]);
+                }
+            } else {
+                const float gain = reverb->comb_gains[c];
+                for (size_t i = 0; i < count; i++) {
+                    sample_t d = onepole_tick_lowpass(&filters[c], delayed[i]);
+                    wet_sum[i] += d;
+                    delayed[i] = input[i] + d * gain;
+                }
+            }
+            delay_line_write_block(&combs[c], delayed, count);
+        }
+        
+        for (size_t i = 0; i < count; i++) {
+            wet_sum[i] *= 0.25f;
+        }
+        for (int a = 0; a < 2; a++) {
+            const float g = allpass_gains[a];
+            delay_line_read_block(&allpasses[a], allpasses[a].size - 1, delayed, count);
+            for (size_t i = 0; i < count; i++) {
+                sample_t d = delayed[i];
+                delayed[i] = wet_sum[i] + d * g;
+                wet_sum[i] = d - wet_sum[i] * g;
+            }
+            delay_line_write_block(&allpasses[a], delayed, count);
+        }
+        
+        if (ramp_chunk) {
+            reverb_mix_ramp(input, wet_sum, wets, out + pos, count);
+            schroeder_reverb_update_gains(reverb);
+        } else {
+            const float wet = reverb->wet_smoother.current;
+            const float dry = 1.0f - wet;
+            for (size_t i = 0; i < count; i++) {
+                out[pos + i] = input[i] * dry + wet_sum[i] * wet;
+            }
+        }
+    }
+    
+    for (int c = 0; c < 4; c++) {
+        reverb->comb_delays[c].write_pos = combs[c].write_pos;
+        reverb->damping_filters[c] = filters[c];
+    }
+    for (int a = 0; a < 2; a++) {
+        reverb->allpass_delays[a].write_pos = allpasses[a].write_pos;
+    }
 }
 
 // Process buffer through Schroeder reverb
 void schroeder_reverb_process_buffer(SchroederReverb* reverb, AudioBuffer* buffer) {
     if (!reverb || !buffer || !buffer->data) return;
     
-    for (size_t i = 0; i < buffer->capacity; i++) {
-        buffer->data[i] = schroeder_reverb_process(reverb, buffer->data[i]);
+    schroeder_reverb_process_block(reverb, buffer->data, buffer->data, buffer->capacity);
+}
+
+// Block adapter used for per-channel processing
+static void schroeder_reverb_channel_block(void* effect, const sample_t* in, sample_t* out, size_t n) {
+    schroeder_reverb_process_block((SchroederReverb*)effect, in, out, n);
+}
+
+// Process each channel of an interleaved buffer with its own Schroeder reverb instance
+void schroeder_reverb_process_channels(SchroederReverb** reverbs, AudioBuffer* buffer) {
+    if (!reverbs || !buffer || !buffer->data || buffer->channels > MAX_CHANNELS) return;
+    
+    void* instances[MAX_CHANNELS];
+    for (size_t ch = 0; ch < buffer->channels; ch++) {
+        instances[ch] = reverbs[ch];
+    }
+    audio_buffer_process_channels(buffer, schroeder_reverb_channel_block, instances);
+}
+
+// Clear Schroeder reverb history (parameters are kept)
+void schroeder_reverb_reset(SchroederReverb* reverb) {
+    if (!reverb) return;
+    
+    for (int i = 0; i < 4; i++) {
+        delay_line_clear(&reverb->comb_delays[i]);
+        onepole_reset(&reverb->damping_filters[i]);
+    }
+    for (int i = 0; i < 2; i++) {
+        delay_line_clear(&reverb->allpass_delays[i]);
     }
+    
+    param_smoother_snap(&reverb->room_smoother);
+    param_smoother_snap(&reverb->wet_smoother);
+    schroeder_reverb_update_gains(reverb);
 }
 
-// Plate reverb delay times and gains
-static const int plate_delays[] = {142, 107, 379, 277, 1011, 1687, 1229, 1597};
-static const float plate_gains[] = {0.841f, 0.504f, 0.491f, 0.379f, 0.380f, 0.346f, 0.289f, 0.272f};
+// Effect interface adapters
+static void schroeder_reverb_effect_reset(void* effect) {
+    schroeder_reverb_reset((SchroederReverb*)effect);
+}
+
+static int schroeder_reverb_effect_set_param(void* effect, int param, float value) {
+    SchroederReverb* reverb = (SchroederReverb*)effect;
+    if (param < 0 || param >= 3) return 0;
+    
+    float p[3] = {reverb->room_size, reverb->damping, reverb->wet_level};
+    p[param] = value;
+    schroeder_reverb_set_params(reverb, p[0], p[1], p[2]);
+    return 1;
+}
+
+static void schroeder_reverb_effect_destroy(void* effect) {
+    schroeder_reverb_destroy((SchroederReverb*)effect);
+}
+
+static const EffectVTable schroeder_reverb_vtable = {
+    .name = "Schroeder reverb",
+    .process_block = schroeder_reverb_channel_block,
+    .reset = schroeder_reverb_effect_reset,
+    .set_param = schroeder_reverb_effect_set_param,
+    .latency = NULL,
+    .destroy = schroeder_reverb_effect_destroy
+};
+
+// Wrap in the effect interface (params: room_size, damping, wet_level)
+Effect schroeder_reverb_effect(SchroederReverb* reverb) {
+    Effect effect = { &schroeder_reverb_vtable, reverb };
+    return effect;
+}
+
+// Dattorro's plate, lengths in samples at his 29761 Hz
+#define PLATE_REFERENCE_RATE 29761.0f
+#define PLATE_EXCURSION 16.0f          // Modulation depth at the reference rate
+#define PLATE_LFO_RATE 1.0f            // Hz
+#define PLATE_DECAY_DIFFUSION1 0.7f
+#define PLATE_DECAY_DIFFUSION2 0.5f
+#define PLATE_OUTPUT_GAIN 0.6f
+
+enum { PLATE_MOD_ALLPASS, PLATE_DELAY1, PLATE_ALLPASS, PLATE_DELAY2 };
+
+static const int plate_diffuser_delays[PLATE_DIFFUSERS] = {142, 107, 379, 277};
+static const float plate_diffuser_gains[PLATE_DIFFUSERS] = {0.75f, 0.75f, 0.625f, 0.625f};
+static const int plate_tank_delays[2][4] = {{672, 4453, 1800, 3720}, {908, 4217, 2656, 3163}};
+
+// Output taps: tank half, line, delay and sign
+typedef struct {
+    int half;
+    int stage;
+    int delay;
+    float sign;
+} PlateTap;
+
+static const PlateTap plate_taps[2][PLATE_TAPS] = {
+    {{1, PLATE_DELAY1, 266, 1.0f}, {1, PLATE_DELAY1, 2974, 1.0f}, {1, PLATE_ALLPASS, 1913, -1.0f},
+     {1, PLATE_DELAY2, 1996, 1.0f}, {0, PLATE_DELAY1, 1990, -1.0f}, {0, PLATE_ALLPASS, 187, -1.0f},
+     {0, PLATE_DELAY2, 1066, -1.0f}},
+    {{0, PLATE_DELAY1, 353, 1.0f}, {0, PLATE_DELAY1, 3627, 1.0f}, {0, PLATE_ALLPASS, 1228, -1.0f},
+     {0, PLATE_DELAY2, 2673, 1.0f}, {1, PLATE_DELAY1, 2111, -1.0f}, {1, PLATE_ALLPASS, 335, -1.0f},
+     {1, PLATE_DELAY2, 121, -1.0f}}
+};
+
+// Tank gain for a decay time. A trip around the figure eight takes the
+// sum of the tank delays and passes four gain stages, so each stage takes
+// a quarter of the loop's share of the 60 dB decay.
+static float plate_decay_gain(float decay_time) {
+    int loop = 0;
+    for (int h = 0; h < 2; h++) {
+        for (int s = 0; s < 4; s++) {
+            loop += plate_tank_delays[h][s];
+        }
+    }
+    return powf(0.001f, (float)loop / (PLATE_REFERENCE_RATE * 4.0f * decay_time));
+}
+
+// Step the LFO bank to the next control point
+static void plate_lfo_advance(PlateReverb* reverb) {
+    float* const outputs[2] = {&reverb->lfo_end[0], &reverb->lfo_end[1]};
+    
+    reverb->lfo_start[0] = reverb->lfo_end[0];
+    reverb->lfo_start[1] = reverb->lfo_end[1];
+    lfo_bank_render(&reverb->lfo, LFO_SINE, outputs, 1);
+    reverb->lfo_pos = 0;
+}
+
+// Restart the LFO at phase zero; the next sample opens a control interval
+static void plate_lfo_reset(PlateReverb* reverb) {
+    lfo_set_phase(&reverb->lfo.clock, 0.0f);
+    plate_lfo_advance(reverb);
+    reverb->lfo_pos = LFO_BLOCK;
+}
 
 // Create plate reverb
 PlateReverb* plate_reverb_create(float sample_rate) {
-    PlateReverb* reverb = malloc(sizeof(PlateReverb));
+    PlateReverb* reverb = audio_calloc(1, sizeof(PlateReverb));
     if (!reverb) return NULL;
     
-    float scale = sample_rate / 44100.0f;
+    const float scale = sample_rate / PLATE_REFERENCE_RATE;
+    reverb->excursion = PLATE_EXCURSION * scale;
+    const size_t excursion = (size_t)ceilf(reverb->excursion);
     
-    // Initialize delays
-    for (int i = 0; i < 8; i++) {
-        size_t delay_samples = (size_t)(plate_delays[i] * scale);
-        DelayLine* delay = delay_line_create(delay_samples);
-        if (!delay) {
-            // Cleanup on failure
-            for (int j = 0; j < i; j++) {
-                delay_line_destroy(&reverb->delays[j]);
-            }
-            free(reverb);
-            return NULL;
+    // The pre-delay line is written before it is read, so it holds a chunk
+    // on top of the longest pre-delay
+    int ok = reverb_line_init(&reverb->pre_delay_line,
+                              (size_t)(PLATE_MAX_PRE_DELAY * sample_rate) + AUDIO_CHANNEL_CHUNK);
+    for (int d = 0; d < PLATE_DIFFUSERS && ok; d++) {
+        reverb->diffuser_delays[d] = (size_t)(plate_diffuser_delays[d] * scale);
+        ok = reverb_line_init(&reverb->diffusers[d], reverb->diffuser_delays[d]);
+    }
+    for (int h = 0; h < 2 && ok; h++) {
+        for (int s = 0; s < 4 && ok; s++) {
+            reverb->tank_delays[h][s] = (size_t)(plate_tank_delays[h][s] * scale);
+            // Room for the excursion and the interpolation
+            size_t length = reverb->tank_delays[h][s] + (s == PLATE_MOD_ALLPASS ? excursion + 2 : 0);
+            ok = reverb_line_init(&reverb->tank[h][s], length);
         }
-        reverb->delays[i] = *delay;
-        free(delay);
-        
-        reverb->gains[i] = plate_gains[i];
     }
+    if (!ok) {
+        plate_reverb_destroy(reverb);
+        return NULL;
+    }
+    
+    // Taps are read before their line is written, so like every delay
+    // they must be at least one chunk long
+    size_t chunk = reverb_chunk_size(reverb->diffusers, PLATE_DIFFUSERS, AUDIO_CHANNEL_CHUNK);
+    for (int h = 0; h < 2; h++) {
+        chunk = reverb_chunk_size(&reverb->tank[h][PLATE_DELAY1], 3, chunk);
+        const size_t shortest = reverb->tank_delays[h][PLATE_MOD_ALLPASS] - excursion - 2;
+        if (shortest < chunk) chunk = shortest;
+    }
+    for (int ch = 0; ch < 2; ch++) {
+        for (int t = 0; t < PLATE_TAPS; t++) {
+            reverb->taps[ch][t] = (size_t)(plate_taps[ch][t].delay * scale);
+            if (reverb->taps[ch][t] < chunk) chunk = reverb->taps[ch][t];
+        }
+    }
+    reverb->chunk = chunk > 0 ? chunk : 1;
     
-    // Initialize filters
-    biquad_highpass(&reverb->input_filter, 80.0f, 0.7f, sample_rate);
-    biquad_lowpass(&reverb->output_filter, 8000.0f, 0.7f, sample_rate);
+    onepole_lowpass(&reverb->bandwidth_filter, 12000.0f, sample_rate);
+    for (int h = 0; h < 2; h++) {
+        onepole_lowpass(&reverb->damping_filters[h], 8000.0f, sample_rate);
+    }
+    lfo_bank_init(&reverb->lfo, 2, PLATE_LFO_RATE, sample_rate / (float)LFO_BLOCK);
+    lfo_bank_set_offset(&reverb->lfo, 1, 0.25f);
+    plate_lfo_reset(reverb);
     
     reverb->decay_time = 2.0f;
     reverb->wet_level = 0.3f;
     reverb->dry_level = 0.7f;
     reverb->pre_delay = 0.02f; // 20ms pre-delay
+    reverb->pre_delay_samples = (size_t)(reverb->pre_delay * sample_rate);
+    reverb->sample_rate = sample_rate;
+    
+    param_smoother_init(&reverb->decay_smoother, plate_decay_gain(reverb->decay_time), PARAM_SMOOTH_DEFAULT_MS,
+                        sample_rate, PARAM_SMOOTH_LINEAR);
+    param_smoother_init(&reverb->wet_smoother, reverb->wet_level, PARAM_SMOOTH_DEFAULT_MS, sample_rate,
+                        PARAM_SMOOTH_LINEAR);
     
     return reverb;
 }
@@ -184,140 +502,527 @@ PlateReverb* plate_reverb_create(float sample_rate) {
 // Destroy plate reverb
 void plate_reverb_destroy(PlateReverb* reverb) {
     if (reverb) {
-        for (int i = 0; i < 8; i++) {
-            if (reverb->delays[i].buffer) {
-                free(reverb->delays[i].buffer);
+        audio_free(reverb->pre_delay_line.buffer);
+        for (int d = 0; d < PLATE_DIFFUSERS; d++) {
+            audio_free(reverb->diffusers[d].buffer);
+        }
+        for (int h = 0; h < 2; h++) {
+            for (int s = 0; s < 4; s++) {
+                audio_free(reverb->tank[h][s].buffer);
             }
         }
-        free(reverb);
+        audio_free(reverb);
     }
 }
 
-// Set plate reverb parameters
+// Set plate reverb parameters. The pre-delay changes at the next block
+// without a ramp.
 void plate_reverb_set_params(PlateReverb* reverb, float decay_time, float wet_level, float pre_delay, float sample_rate) {
     if (!reverb) return;
     
     reverb->decay_time = clamp(decay_time, 0.1f, 10.0f);
     reverb->wet_level = clamp(wet_level, 0.0f, 1.0f);
     reverb->dry_level = 1.0f - reverb->wet_level;
-    reverb->pre_delay = clamp(pre_delay, 0.0f, 0.1f);
+    reverb->pre_delay = clamp(pre_delay, 0.0f, PLATE_MAX_PRE_DELAY);
+    
+    // The line was sized at the create rate
+    const size_t longest = reverb->pre_delay_line.size - 1 - AUDIO_CHANNEL_CHUNK;
+    const size_t pre_delay_samples = (size_t)(reverb->pre_delay * sample_rate);
+    reverb->pre_delay_samples = pre_delay_samples < longest ? pre_delay_samples : longest;
+    
+    param_smoother_set_target(&reverb->decay_smoother, plate_decay_gain(reverb->decay_time));
+    param_smoother_set_target(&reverb->wet_smoother, reverb->wet_level);
+}
+
+// Pick up new parameter targets; returns nonzero while a ramp is active
+static int plate_reverb_update_params(PlateReverb* reverb) {
+    param_smoother_update(&reverb->decay_smoother);
+    param_smoother_update(&reverb->wet_smoother);
+    
+    return param_smoother_active(&reverb->decay_smoother) || param_smoother_active(&reverb->wet_smoother);
+}
+
+// Allpass over a chunk given the delayed samples: v = x - g * d goes into
+// the line and d + g * v comes out (io holds x, then the output)
+static void plate_allpass_mix(DelayLine* line, const sample_t* delayed, float gain, sample_t* io, size_t count,
+                              int simd) {
+    sample_t state[AUDIO_CHANNEL_CHUNK];
+    size_t start = 0;
+#if defined(REVERB_SSE)
+    if (simd) {
+        const __m128 g = _mm_set1_ps(gain);
+        start = count & ~(size_t)3;
+        for (size_t i = 0; i < start; i += 4) {
+            const __m128 d = _mm_loadu_ps(delayed + i);
+            const __m128 v = _mm_sub_ps(_mm_loadu_ps(io + i), _mm_mul_ps(g, d));
+            _mm_storeu_ps(state + i, v);
+            _mm_storeu_ps(io + i, _mm_add_ps(d, _mm_mul_ps(g, v)));
+        }
+    }
+#endif
+    (void)simd;
+    for (size_t i = start; i < count; i++) {
+        const sample_t v = io[i] - gain * delayed[i];
+        state[i] = v;
+        io[i] = delayed[i] + gain * v;
+    }
+    delay_line_write_block(line, state, count);
+}
+
+// Fixed allpass over a chunk no longer than its delay
+static void plate_allpass_block(DelayLine* line, size_t delay_samples, float gain, sample_t* io, size_t count,
+                                int simd) {
+    sample_t delayed[AUDIO_CHANNEL_CHUNK];
+    delay_line_read_block(line, delay_samples, delayed, count);
+    plate_allpass_mix(line, delayed, gain, io, count, simd);
+}
+
+// acc += gain * x
+static void plate_accumulate(sample_t* acc, const sample_t* x, float gain, size_t count, int simd) {
+    size_t start = 0;
+#if defined(REVERB_SSE)
+    if (simd) {
+        const __m128 g = _mm_set1_ps(gain);
+        start = count & ~(size_t)3;
+        for (size_t i = 0; i < start; i += 4) {
+            _mm_storeu_ps(acc + i, _mm_add_ps(_mm_loadu_ps(acc + i), _mm_mul_ps(g, _mm_loadu_ps(x + i))));
+        }
+    }
+#endif
+    (void)simd;
+    for (size_t i = start; i < count; i++) {
+        acc[i] += gain * x[i];
+    }
+}
+
+// out[i] = a[i] + (origin - delays[i]) * (a[i + 1] - a[i]) over [from, to)
+static void plate_sweep_run(const sample_t* a, float origin, const float* delays, sample_t* out, size_t from,
+                            size_t to, int simd) {
+    size_t i = from;
+#if defined(REVERB_SSE)
+    if (simd) {
+        const __m128 o = _mm_set1_ps(origin);
+        for (; i + 4 <= to; i += 4) {
+            const __m128 older = _mm_loadu_ps(a + i);
+            const __m128 f = _mm_sub_ps(o, _mm_loadu_ps(delays + i));
+            _mm_storeu_ps(out + i, _mm_add_ps(older, _mm_mul_ps(f, _mm_sub_ps(_mm_loadu_ps(a + i + 1), older))));
+        }
+    }
+#endif
+    (void)simd;
+    for (; i < to; i++) {
+        out[i] = a[i] + (origin - delays[i]) * (a[i + 1] - a[i]);
+    }
+}
+
+// Linearly interpolated read at per-sample delays (measured as for
+// delay_line_read_modulated) that stay within a sample of delays[0], so
+// the samples read fit in one span of count + 2. Sample i then sits at
+// span[i + c] plus a fraction, with c one of -1, 0 and 1, and each run of
+// equal c is interpolated contiguously. The fractions are differences of
+// nearby floats and so exact: a sample's value depends only on its delay,
+// not on where the block around it starts.
+static void plate_read_sweep(const DelayLine* line, const float* delays, sample_t* out, size_t count, int simd) {
+    sample_t span[AUDIO_CHANNEL_CHUNK + 3];
+    const size_t back = (size_t)ceilf(delays[0]);
+    const float top = (float)back;
+    delay_line_read_block(line, back, span + 1, count + 2);
+    
+    size_t i = 0;
+    while (i < count) {
+        const float frac = top - delays[i];
+        const int offset = frac < 0.0f ? -1 : (frac >= 1.0f ? 1 : 0);
+        const float low = (float)offset;
+        
+        size_t end = i + 1;
+        while (end < count && top - delays[end] >= low && top - delays[end] < low + 1.0f) {
+            end++;
+        }
+        plate_sweep_run(span + 1 + offset, top - low, delays, out, i, end, simd);
+        i = end;
+    }
+}
+
+// Fill both halves' modulated delays for a chunk, measured as for
+// plate_read_sweep. The LFO is interpolated linearly between control
+// points LFO_BLOCK samples apart on a grid that ignores chunk boundaries.
+static void plate_modulation_fill(PlateReverb* reverb, float (*delays)[AUDIO_CHANNEL_CHUNK], size_t count) {
+    size_t i = 0;
+    while (i < count) {
+        if (reverb->lfo_pos == LFO_BLOCK) plate_lfo_advance(reverb);
+        
+        const size_t pos = reverb->lfo_pos;
+        const size_t run = count - i < LFO_BLOCK - pos ? count - i : LFO_BLOCK - pos;
+        for (int h = 0; h < 2; h++) {
+            const float base = (float)reverb->tank_delays[h][PLATE_MOD_ALLPASS] + reverb->excursion *
+                               reverb->lfo_start[h];
+            const float slope = reverb->excursion * (reverb->lfo_end[h] - reverb->lfo_start[h]) / (float)LFO_BLOCK;
+            for (size_t j = 0; j < run; j++) {
+                delays[h][i + j] = base + slope * (float)(pos + j);
+            }
+        }
+        reverb->lfo_pos += run;
+        i += run;
+    }
+}
+
+// Add the output taps on one tank line, accumulating straight from the
+// ring; called before the line is written
+static void plate_add_taps(const PlateReverb* reverb, int half, int stage, sample_t* left, sample_t* right,
+                           size_t count, int simd) {
+    const DelayLine* line = &reverb->tank[half][stage];
+    const size_t capacity = line->mask + 1;
     
-    // Update gains based on decay time
-    float decay_factor = powf(0.001f, 1.0f / (reverb->decay_time * sample_rate));
-    for (int i = 0; i < 8; i++) {
-        reverb->gains[i] = plate_gains[i] * decay_factor;
+    for (int ch = 0; ch < 2; ch++) {
+        sample_t* out = ch ? right : left;
+        if (!out) continue;
+        
+        for (int t = 0; t < PLATE_TAPS; t++) {
+            const PlateTap* source = &plate_taps[ch][t];
+            if (source->half != half || source->stage != stage) continue;
+            
+            const float gain = source->sign * PLATE_OUTPUT_GAIN;
+            const size_t start = (line->write_pos - reverb->taps[ch][t]) & line->mask;
+            const size_t first = capacity - start < count ? capacity - start : count;
+            plate_accumulate(out, line->buffer + start, gain, first, simd);
+            plate_accumulate(out + first, line->buffer, gain, count - first, simd);
+        }
+    }
+}
+
+// Run one chunk (at most reverb->chunk samples) of mono input through the
+// plate. decays is NULL unless the tank gain ramps; right may be NULL.
+// Within a chunk no line is read after it is written, so the halves (which
+// only meet through their second delays) advance stage by stage, and the
+// tank's first delays can be read and damped up front, in the same loop
+// as the input's bandwidth filter.
+static void plate_reverb_run(PlateReverb* reverb, const sample_t* in, const float* decays, sample_t* left,
+                             sample_t* right, size_t count) {
+    sample_t diffused[AUDIO_CHANNEL_CHUNK];
+    sample_t x[2][AUDIO_CHANNEL_CHUNK];
+    sample_t damped[2][AUDIO_CHANNEL_CHUNK];
+    sample_t delayed[AUDIO_CHANNEL_CHUNK];
+    float delays[2][AUDIO_CHANNEL_CHUNK];
+    const int simd = cpu_simd_level() >= SIMD_LEVEL_SSE2;
+    const float decay = reverb->decay_smoother.current;
+    
+    // Written first, so a pre-delay of zero reads the chunk itself
+    delay_line_write_block(&reverb->pre_delay_line, in, count);
+    delay_line_read_block(&reverb->pre_delay_line, reverb->pre_delay_samples + count, diffused, count);
+    for (int h = 0; h < 2; h++) {
+        delay_line_read_block(&reverb->tank[h][PLATE_DELAY1], reverb->tank_delays[h][PLATE_DELAY1], damped[h],
+                              count);
+    }
+    
+    // Bandwidth lowpass, then damping and the first decay gain of each half
+    OnePoleFilter bandwidth = reverb->bandwidth_filter;
+    OnePoleFilter damping0 = reverb->damping_filters[0];
+    OnePoleFilter damping1 = reverb->damping_filters[1];
+    for (size_t i = 0; i < count; i++) {
+        const float gain = decays ? decays[i] : decay;
+        diffused[i] = onepole_tick_lowpass(&bandwidth, diffused[i]);
+        damped[0][i] = onepole_tick_lowpass(&damping0, damped[0][i]) * gain;
+        damped[1][i] = onepole_tick_lowpass(&damping1, damped[1][i]) * gain;
+    }
+    reverb->bandwidth_filter = bandwidth;
+    reverb->damping_filters[0] = damping0;
+    reverb->damping_filters[1] = damping1;
+    
+    for (int d = 0; d < PLATE_DIFFUSERS; d++) {
+        plate_allpass_block(&reverb->diffusers[d], reverb->diffuser_delays[d], plate_diffuser_gains[d], diffused,
+                            count, simd);
+    }
+    
+    // Each half starts with the diffused input plus the end of the other
+    for (int h = 0; h < 2; h++) {
+        delay_line_read_block(&reverb->tank[1 - h][PLATE_DELAY2], reverb->tank_delays[1 - h][PLATE_DELAY2],
+                              delayed, count);
+        if (decays) {
+            for (size_t i = 0; i < count; i++) {
+                x[h][i] = diffused[i] + decays[i] * delayed[i];
+            }
+        } else {
+            memcpy(x[h], diffused, count * sizeof(sample_t));
+            plate_accumulate(x[h], delayed, decay, count, simd);
+        }
+    }
+    
+    // Modulated allpasses, their LFOs in quadrature. The delay moves at
+    // most 2 pi * 1 Hz * 16 samples at 29761 Hz, under a sample per chunk
+    // at any rate, as plate_read_sweep needs.
+    plate_modulation_fill(reverb, delays, count);
+    for (int h = 0; h < 2; h++) {
+        DelayLine* line = &reverb->tank[h][PLATE_MOD_ALLPASS];
+        plate_read_sweep(line, delays[h], delayed, count, simd);
+        plate_allpass_mix(line, delayed, -PLATE_DECAY_DIFFUSION1, x[h], count, simd);
+    }
+    
+    memset(left, 0, count * sizeof(sample_t));
+    if (right) memset(right, 0, count * sizeof(sample_t));
+    
+    for (int h = 0; h < 2; h++) {
+        plate_add_taps(reverb, h, PLATE_DELAY1, left, right, count, simd);
+        delay_line_write_block(&reverb->tank[h][PLATE_DELAY1], x[h], count);
+        
+        plate_add_taps(reverb, h, PLATE_ALLPASS, left, right, count, simd);
+        plate_allpass_block(&reverb->tank[h][PLATE_ALLPASS], reverb->tank_delays[h][PLATE_ALLPASS],
+                            PLATE_DECAY_DIFFUSION2, damped[h], count, simd);
+        
+        plate_add_taps(reverb, h, PLATE_DELAY2, left, right, count, simd);
+        delay_line_write_block(&reverb->tank[h][PLATE_DELAY2], damped[h], count);
     }
 }
 
 // Process one sample through plate reverb
 sample_t plate_reverb_process(PlateReverb* reverb, sample_t input) {
-    if (!reverb) return input;
+    sample_t output;
+    plate_reverb_process_block(reverb, &input, &output, 1);
+    return output;
+}
+
+// Process a mono block through plate reverb (in and out may be the same
+// buffer); the wet signal is the left output
+void plate_reverb_process_block(PlateReverb* reverb, const sample_t* in, sample_t* out, size_t n) {
+    if (!reverb) {
+        audio_block_bypass(in, out, n);
+        return;
+    }
+    if (!in || !out) return;
     
-    // Apply input filtering
-    sample_t filtered_input = biquad_process(&reverb->input_filter, input);
+    int ramping = plate_reverb_update_params(reverb);
     
-    sample_t reverb_sum = 0.0f;
+    const size_t chunk = reverb->chunk;
+    sample_t wet_sum[AUDIO_CHANNEL_CHUNK];
+    float decays[AUDIO_CHANNEL_CHUNK];
+    float wets[AUDIO_CHANNEL_CHUNK];
     
-    // Process through delay network
-    for (int i = 0; i < 8; i++) {
-        size_t delay_samples = reverb->delays[i].size - 1;
-        sample_t delayed = delay_line_read(&reverb->delays[i], delay_samples);
+    for (size_t pos = 0; pos < n; pos += chunk) {
+        const size_t count = (n - pos < chunk) ? n - pos : chunk;
+        const int ramp_chunk = ramping;
+        if (ramp_chunk) {
+            ramping = reverb_fill_ramps(&reverb->decay_smoother, &reverb->wet_smoother, decays, wets, count);
+        }
         
-        sample_t feedback = filtered_input + delayed * reverb->gains[i];
-        delay_line_write(&reverb->delays[i], feedback);
+        plate_reverb_run(reverb, in + pos, ramp_chunk ? decays : NULL, wet_sum, NULL, count);
         
-        reverb_sum += delayed;
+        if (ramp_chunk) {
+            reverb_mix_ramp(in + pos, wet_sum, wets, out + pos, count);
+        } else {
+            const float wet = reverb->wet_smoother.current;
+            const float dry = 1.0f - wet;
+            for (size_t i = 0; i < count; i++) {
+                out[pos + i] = in[pos + i] * dry + wet_sum[i] * wet;
+            }
+        }
     }
+}
+
+// Process a stereo block (outputs may alias the inputs). The tank takes the
+// mono sum of the input and each channel gets its own set of taps.
+void plate_reverb_process_stereo_block(PlateReverb* reverb, const sample_t* left_in, const sample_t* right_in,
+                                       sample_t* left_out, sample_t* right_out, size_t n) {
+    if (!reverb) {
+        audio_block_bypass(left_in, left_out, n);
+        audio_block_bypass(right_in, right_out, n);
+        return;
+    }
+    if (!left_in || !right_in || !left_out || !right_out) return;
     
-    reverb_sum *= 0.125f; // Average the outputs
+    int ramping = plate_reverb_update_params(reverb);
     
-    // Apply output filtering
-    sample_t filtered_output = biquad_process(&reverb->output_filter, reverb_sum);
+    const size_t chunk = reverb->chunk;
+    sample_t mono[AUDIO_CHANNEL_CHUNK];
+    sample_t wet_left[AUDIO_CHANNEL_CHUNK];
+    sample_t wet_right[AUDIO_CHANNEL_CHUNK];
+    float decays[AUDIO_CHANNEL_CHUNK];
+    float wets[AUDIO_CHANNEL_CHUNK];
     
-    return input * reverb->dry_level + filtered_output * reverb->wet_level;
+    for (size_t pos = 0; pos < n; pos += chunk) {
+        const size_t count = (n - pos < chunk) ? n - pos : chunk;
+        const int ramp_chunk = ramping;
+        if (ramp_chunk) {
+            ramping = reverb_fill_ramps(&reverb->decay_smoother, &reverb->wet_smoother, decays, wets, count);
+        }
+        
+        for (size_t i = 0; i < count; i++) {
+            mono[i] = 0.5f * (left_in[pos + i] + right_in[pos + i]);
+        }
+        plate_reverb_run(reverb, mono, ramp_chunk ? decays : NULL, wet_left, wet_right, count);
+        
+        if (ramp_chunk) {
+            reverb_mix_ramp(left_in + pos, wet_left, wets, left_out + pos, count);
+            reverb_mix_ramp(right_in + pos, wet_right, wets, right_out + pos, count);
+        } else {
+            const float wet = reverb->wet_smoother.current;
+            const float dry = 1.0f - wet;
+            for (size_t i = 0; i < count; i++) {
+                left_out[pos + i] = left_in[pos + i] * dry + wet_left[i] * wet;
+                right_out[pos + i] = right_in[pos + i] * dry + wet_right[i] * wet;
+            }
+        }
+    }
 }
 
-// Process buffer through plate reverb
+// Process buffer through plate reverb: stereo buffers get the stereo taps,
+// anything else is processed as one mono stream
 void plate_reverb_process_buffer(PlateReverb* reverb, AudioBuffer* buffer) {
     if (!reverb || !buffer || !buffer->data) return;
     
-    for (size_t i = 0; i < buffer->capacity; i++) {
-        buffer->data[i] = plate_reverb_process(reverb, buffer->data[i]);
+    if (buffer->channels != 2) {
+        plate_reverb_process_block(reverb, buffer->data, buffer->data, buffer->capacity);
+        return;
+    }
+    if (buffer->layout == AUDIO_LAYOUT_PLANAR) {
+        plate_reverb_process_stereo_block(reverb, buffer->planes[0], buffer->planes[1], buffer->planes[0],
+                                          buffer->planes[1], buffer->length);
+        return;
+    }
+    
+    sample_t left[AUDIO_CHANNEL_CHUNK];
+    sample_t right[AUDIO_CHANNEL_CHUNK];
+    for (size_t start = 0; start < buffer->length; start += AUDIO_CHANNEL_CHUNK) {
+        size_t frames = buffer->length - start;
+        if (frames > AUDIO_CHANNEL_CHUNK) frames = AUDIO_CHANNEL_CHUNK;
+        
+        audio_buffer_read_channel(buffer, 0, start, left, frames);
+        audio_buffer_read_channel(buffer, 1, start, right, frames);
+        plate_reverb_process_stereo_block(reverb, left, right, left, right, frames);
+        audio_buffer_write_channel(buffer, 0, start, left, frames);
+        audio_buffer_write_channel(buffer, 1, start, right, frames);
     }
 }
 
-// Freeverb delay times
+// Block adapter used for per-channel processing
+static void plate_reverb_channel_block(void* effect, const sample_t* in, sample_t* out, size_t n) {
+    plate_reverb_process_block((PlateReverb*)effect, in, out, n);
+}
+
+// Process each channel of an interleaved buffer with its own plate reverb instance
+void plate_reverb_process_channels(PlateReverb** reverbs, AudioBuffer* buffer) {
+    if (!reverbs || !buffer || !buffer->data || buffer->channels > MAX_CHANNELS) return;
+    
+    void* instances[MAX_CHANNELS];
+    for (size_t ch = 0; ch < buffer->channels; ch++) {
+        instances[ch] = reverbs[ch];
+    }
+    audio_buffer_process_channels(buffer, plate_reverb_channel_block, instances);
+}
+
+// Clear plate reverb history (parameters are kept)
+void plate_reverb_reset(PlateReverb* reverb) {
+    if (!reverb) return;
+    
+    delay_line_clear(&reverb->pre_delay_line);
+    for (int d = 0; d < PLATE_DIFFUSERS; d++) {
+        delay_line_clear(&reverb->diffusers[d]);
+    }
+    for (int h = 0; h < 2; h++) {
+        for (int s = 0; s < 4; s++) {
+            delay_line_clear(&reverb->tank[h][s]);
+        }
+        onepole_reset(&reverb->damping_filters[h]);
+    }
+    onepole_reset(&reverb->bandwidth_filter);
+    plate_lfo_reset(reverb);
+    
+    param_smoother_snap(&reverb->decay_smoother);
+    param_smoother_snap(&reverb->wet_smoother);
+}
+
+// Effect interface adapters
+static void plate_reverb_effect_reset(void* effect) {
+    plate_reverb_reset((PlateReverb*)effect);
+}
+
+static int plate_reverb_effect_set_param(void* effect, int param, float value) {
+    PlateReverb* reverb = (PlateReverb*)effect;
+    if (param < 0 || param >= 3) return 0;
+    
+    float p[3] = {reverb->decay_time, reverb->wet_level, reverb->pre_delay};
+    p[param] = value;
+    plate_reverb_set_params(reverb, p[0], p[1], p[2], reverb->sample_rate);
+    return 1;
+}
+
+static void plate_reverb_effect_destroy(void* effect) {
+    plate_reverb_destroy((PlateReverb*)effect);
+}
+
+static const EffectVTable plate_reverb_vtable = {
+    .name = "plate reverb",
+    .process_block = plate_reverb_channel_block,
+    .reset = plate_reverb_effect_reset,
+    .set_param = plate_reverb_effect_set_param,
+    .latency = NULL,
+    .destroy = plate_reverb_effect_destroy
+};
+
+// Wrap in the effect interface (params: decay_time, wet_level, pre_delay)
+Effect plate_reverb_effect(PlateReverb* reverb) {
+    Effect effect = { &plate_reverb_vtable, reverb };
+    return effect;
+}
+
+// Freeverb delay times (left set; the right set adds FREEVERB_STEREO_SPREAD)
 static const int freeverb_comb_delays[] = {1116, 1188, 1277, 1356, 1422, 1491, 1557, 1617};
 static const int freeverb_allpass_delays[] = {556, 441, 341, 225};
 
 // Create Freeverb
 Freeverb* freeverb_create(float sample_rate) {
-    Freeverb* reverb = malloc(sizeof(Freeverb));
+    Freeverb* reverb = audio_calloc(1, sizeof(Freeverb));
     if (!reverb) return NULL;
     
     float scale = sample_rate / 44100.0f;
     
-    // Initialize comb delays
-    for (int i = 0; i < 8; i++) {
-        size_t delay_samples = (size_t)(freeverb_comb_delays[i] * scale);
-        DelayLine* delay = delay_line_create(delay_samples);
-        if (!delay) {
-            // Cleanup on failure
-            for (int j = 0; j < i; j++) {
-                delay_line_destroy(&reverb->comb_delays[j]);
+    for (int ch = 0; ch < 2; ch++) {
+        const int spread = ch * FREEVERB_STEREO_SPREAD;
+        for (int i = 0; i < FREEVERB_COMBS; i++) {
+            if (!reverb_line_init(&reverb->comb_delays[ch][i], (size_t)((freeverb_comb_delays[i] + spread) * scale))) {
+                freeverb_destroy(reverb);
+                return NULL;
             }
-            free(reverb);
-            return NULL;
         }
-        reverb->comb_delays[i] = *delay;
-        free(delay);
-        
-        reverb->comb_feedbacks[i] = 0.84f;
-        onepole_lowpass(&reverb->comb_filters[i], 5000.0f, sample_rate);
-    }
-    
-    // Initialize allpass delays
-    for (int i = 0; i < 4; i++) {
-        size_t delay_samples = (size_t)(freeverb_allpass_delays[i] * scale);
-        DelayLine* delay = delay_line_create(delay_samples);
-        if (!delay) {
-            // Cleanup on failure
-            for (int j = 0; j < 8; j++) {
-                delay_line_destroy(&reverb->comb_delays[j]);
+        for (int i = 0; i < FREEVERB_ALLPASSES; i++) {
+            if (!reverb_line_init(&reverb->allpass_delays[ch][i],
+                                  (size_t)((freeverb_allpass_delays[i] + spread) * scale))) {
+                freeverb_destroy(reverb);
+                return NULL;
             }
-            for (int j = 0; j < i; j++) {
-                delay_line_destroy(&reverb->allpass_delays[j]);
-            }
-            free(reverb);
-            return NULL;
         }
-        reverb->allpass_delays[i] = *delay;
-        free(delay);
     }
     
+    OnePoleFilter damping;
+    onepole_lowpass(&damping, 5000.0f, sample_rate);
+    reverb->comb_alpha = damping.alpha;
+    
     reverb->room_size = 0.5f;
     reverb->damping = 0.5f;
     reverb->wet_level = 0.3f;
     reverb->dry_level = 0.7f;
     reverb->width = 1.0f;
     
+    param_smoother_init(&reverb->feedback_smoother, 0.84f, PARAM_SMOOTH_DEFAULT_MS, sample_rate,
+                        PARAM_SMOOTH_LINEAR);
+    param_smoother_init(&reverb->wet_smoother, reverb->wet_level, PARAM_SMOOTH_DEFAULT_MS, sample_rate,
+                        PARAM_SMOOTH_LINEAR);
+    param_smoother_init(&reverb->width_smoother, reverb->width, PARAM_SMOOTH_DEFAULT_MS, sample_rate,
+                        PARAM_SMOOTH_LINEAR);
+    
     return reverb;
 }
 
 // Destroy Freeverb
 void freeverb_destroy(Freeverb* reverb) {
     if (reverb) {
-        for (int i = 0; i < 8; i++) {
-            if (reverb->comb_delays[i].buffer) {
-                free(reverb->comb_delays[i].buffer);
+        for (int ch = 0; ch < 2; ch++) {
+            for (int i = 0; i < FREEVERB_COMBS; i++) {
+                audio_free(reverb->comb_delays[ch][i].buffer);
             }
-        }
-        for (int i = 0; i < 4; i++) {
-            if (reverb->allpass_delays[i].buffer) {
-                free(reverb->allpass_delays[i].buffer);
+            for (int i = 0; i < FREEVERB_ALLPASSES; i++) {
+                audio_free(reverb->allpass_delays[ch][i].buffer);
             }
         }
-        free(reverb);
+        audio_free(reverb);
     }
 }
 
@@ -331,52 +1036,877 @@ void freeverb_set_params(Freeverb* reverb, float room_size, float damping, float
     reverb->dry_level = 1.0f - reverb->wet_level;
     reverb->width = clamp(width, 0.0f, 1.0f);
     
-    // Update comb feedbacks based on room size
-    for (int i = 0; i < 8; i++) {
-        reverb->comb_feedbacks[i] = 0.28f + 0.7f * reverb->room_size;
+    // Comb feedback follows the room size
+    param_smoother_set_target(&reverb->feedback_smoother, 0.28f + 0.7f * reverb->room_size);
+    param_smoother_set_target(&reverb->wet_smoother, reverb->wet_level);
+    param_smoother_set_target(&reverb->width_smoother, reverb->width);
+}
+
+// Pick up new parameter targets; returns nonzero while a ramp is active
+static int freeverb_update_params(Freeverb* reverb) {
+    param_smoother_update(&reverb->feedback_smoother);
+    param_smoother_update(&reverb->wet_smoother);
+    param_smoother_update(&reverb->width_smoother);
+    
+    return param_smoother_active(&reverb->feedback_smoother) || param_smoother_active(&reverb->wet_smoother) ||
+           param_smoother_active(&reverb->width_smoother);
+}
+
+typedef sample_t FreeverbBlock[AUDIO_CHANNEL_CHUNK];
+
+// One set of combs over a chunk. On entry lines holds what each comb read
+// back; on exit it holds what each comb writes, and wet_sum the sum of
+// the damped comb outputs. feedbacks is per sample while the room size
+// ramps, NULL otherwise. The SIMD paths put one comb in each lane and
+// transpose tiles of the chunk so a register holds one sample of every
+// comb; the sum keeps the scalar order, so the paths agree to rounding.
+#if defined(REVERB_SSE)
+// Four combs over four samples starting at i
+static inline void freeverb_combs_sse_tile(FreeverbBlock* lines, __m128* state, __m128 alpha, const sample_t* in,
+                                           const float* feedbacks, float feedback, sample_t* wet_sum, size_t i) {
+    __m128 r[4];
+    for (int c = 0; c < 4; c++) {
+        r[c] = _mm_loadu_ps(lines[c] + i);
+    }
+    _MM_TRANSPOSE4_PS(r[0], r[1], r[2], r[3]);
+    __m128 y[4];
+    for (int t = 0; t < 4; t++) {
+        const float fb = feedbacks ? feedbacks[i + t] : feedback;
+        *state = _mm_add_ps(*state, _mm_mul_ps(alpha, _mm_sub_ps(r[t], *state)));
+        y[t] = *state;
+        r[t] = _mm_add_ps(_mm_set1_ps(in[i + t]), _mm_mul_ps(*state, _mm_set1_ps(fb)));
+    }
+    _MM_TRANSPOSE4_PS(r[0], r[1], r[2], r[3]);
+    _MM_TRANSPOSE4_PS(y[0], y[1], y[2], y[3]);
+    __m128 sum = _mm_loadu_ps(wet_sum + i);
+    for (int c = 0; c < 4; c++) {
+        _mm_storeu_ps(lines[c] + i, r[c]);
+        sum = _mm_add_ps(sum, y[c]);
+    }
+    _mm_storeu_ps(wet_sum + i, sum);
+}
+#endif
+
+#if defined(AUDIO_X86_DISPATCH)
+// Transpose an 8x8 tile held in eight registers
+AUDIO_TARGET_AVX2
+static inline void freeverb_transpose8(__m256* r) {
+    __m256 t[8];
+    for (int k = 0; k < 8; k += 2) {
+        t[k] = _mm256_unpacklo_ps(r[k], r[k + 1]);
+        t[k + 1] = _mm256_unpackhi_ps(r[k], r[k + 1]);
+    }
+    __m256 s[8];
+    for (int k = 0; k < 8; k += 4) {
+        s[k] = _mm256_shuffle_ps(t[k], t[k + 2], _MM_SHUFFLE(1, 0, 1, 0));
+        s[k + 1] = _mm256_shuffle_ps(t[k], t[k + 2], _MM_SHUFFLE(3, 2, 3, 2));
+        s[k + 2] = _mm256_shuffle_ps(t[k + 1], t[k + 3], _MM_SHUFFLE(1, 0, 1, 0));
+        s[k + 3] = _mm256_shuffle_ps(t[k + 1], t[k + 3], _MM_SHUFFLE(3, 2, 3, 2));
+    }
+    for (int k = 0; k < 4; k++) {
+        r[k] = _mm256_permute2f128_ps(s[k], s[k + 4], 0x20);
+        r[k + 4] = _mm256_permute2f128_ps(s[k], s[k + 4], 0x31);
+    }
+}
+
+// All eight combs in one register, eight samples per tile
+AUDIO_TARGET_AVX2
+static size_t freeverb_combs_avx2(FreeverbBlock* lines, float* state, float alpha, const sample_t* in,
+                                  const float* feedbacks, float feedback, sample_t* wet_sum, size_t count) {
+    const size_t end = count & ~(size_t)7;
+    const __m256 alphav = _mm256_set1_ps(alpha);
+    __m256 s = _mm256_loadu_ps(state);
+    
+    for (size_t i = 0; i < end; i += 8) {
+        __m256 r[8];
+        __m256 y[8];
+        for (int c = 0; c < 8; c++) {
+            r[c] = _mm256_loadu_ps(lines[c] + i);
+        }
+        freeverb_transpose8(r);
+        for (int t = 0; t < 8; t++) {
+            const float fb = feedbacks ? feedbacks[i + t] : feedback;
+            s = _mm256_add_ps(s, _mm256_mul_ps(alphav, _mm256_sub_ps(r[t], s)));
+            y[t] = s;
+            r[t] = _mm256_add_ps(_mm256_set1_ps(in[i + t]), _mm256_mul_ps(s, _mm256_set1_ps(fb)));
+        }
+        freeverb_transpose8(r);
+        freeverb_transpose8(y);
+        __m256 sum = _mm256_loadu_ps(wet_sum + i);
+        for (int c = 0; c < 8; c++) {
+            _mm256_storeu_ps(lines[c] + i, r[c]);
+            sum = _mm256_add_ps(sum, y[c]);
+        }
+        _mm256_storeu_ps(wet_sum + i, sum);
+    }
+    
+    _mm256_storeu_ps(state, s);
+    return end;
+}
+#endif
+
+static void freeverb_combs(FreeverbBlock* lines, float* state, float alpha, const sample_t* in,
+                           const float* feedbacks, float feedback, sample_t* wet_sum, size_t count, SimdLevel level) {
+    size_t start = 0;
+    (void)level;
+#if defined(AUDIO_X86_DISPATCH)
+    if (level >= SIMD_LEVEL_AVX2) {
+        start = freeverb_combs_avx2(lines, state, alpha, in, feedbacks, feedback, wet_sum, count);
+    } else
+#endif
+#if defined(REVERB_SSE)
+    if (level >= SIMD_LEVEL_SSE2) {
+        // The sum is kept in order by finishing a tile of the first four
+        // combs before the second four add to it
+        start = count & ~(size_t)3;
+        const __m128 alphav = _mm_set1_ps(alpha);
+        __m128 low = _mm_loadu_ps(state);
+        __m128 high = _mm_loadu_ps(state + 4);
+        for (size_t i = 0; i < start; i += 4) {
+            freeverb_combs_sse_tile(lines, &low, alphav, in, feedbacks, feedback, wet_sum, i);
+            freeverb_combs_sse_tile(lines + 4, &high, alphav, in, feedbacks, feedback, wet_sum, i);
+        }
+        _mm_storeu_ps(state, low);
+        _mm_storeu_ps(state + 4, high);
+    }
+#endif
+    
+    for (int c = 0; c < FREEVERB_COMBS; c++) {
+        float s = state[c];
+        sample_t* x = lines[c];
+        for (size_t i = start; i < count; i++) {
+            s += alpha * (x[i] - s);
+            wet_sum[i] += s;
+            x[i] = in[i] + s * (feedbacks ? feedbacks[i] : feedback);
+        }
+        state[c] = s;
     }
 }
 
+// Run one channel's comb and allpass sets over a chunk into wet_sum
+static void freeverb_run_set(Freeverb* reverb, DelayLine* combs, DelayLine* allpasses, float* state,
+                             const sample_t* in, const float* feedbacks, sample_t* wet_sum, size_t count,
+                             SimdLevel level) {
+    FreeverbBlock lines[FREEVERB_COMBS];
+    
+    memset(wet_sum, 0, count * sizeof(sample_t));
+    for (int c = 0; c < FREEVERB_COMBS; c++) {
+        delay_line_read_block(&combs[c], combs[c].size - 1, lines[c], count);
+    }
+    freeverb_combs(lines, state, reverb->comb_alpha, in, feedbacks, reverb->feedback_smoother.current, wet_sum,
+                   count, level);
+    for (int c = 0; c < FREEVERB_COMBS; c++) {
+        delay_line_write_block(&combs[c], lines[c], count);
+    }
+    
+    sample_t* delayed = lines[0];
+    for (int a = 0; a < FREEVERB_ALLPASSES; a++) {
+        delay_line_read_block(&allpasses[a], allpasses[a].size - 1, delayed, count);
+        for (size_t i = 0; i < count; i++) {
+            sample_t d = delayed[i];
+            delayed[i] = wet_sum[i] + d * 0.5f;
+            wet_sum[i] = d - wet_sum[i] * 0.5f;
+        }
+        delay_line_write_block(&allpasses[a], delayed, count);
+    }
+}
+
+// Largest chunk every line of both sets can be read for before it is written
+static size_t freeverb_chunk_size(const Freeverb* reverb) {
+    size_t chunk = reverb_chunk_size(reverb->comb_delays[0], FREEVERB_COMBS, AUDIO_CHANNEL_CHUNK);
+    return reverb_chunk_size(reverb->allpass_delays[0], FREEVERB_ALLPASSES, chunk);
+}
+
 // Process one sample through Freeverb
 sample_t freeverb_process(Freeverb* reverb, sample_t input) {
-    if (!reverb) return input;
+    sample_t output;
+    freeverb_process_block(reverb, &input, &output, 1);
+    return output;
+}
+
+// Process a mono block through the left set (in and out may be the same
+// buffer). Works in chunks no longer than the shortest delay so each comb
+// and allpass is read and written as contiguous spans.
+void freeverb_process_block(Freeverb* reverb, const sample_t* in, sample_t* out, size_t n) {
+    if (!reverb) {
+        audio_block_bypass(in, out, n);
+        return;
+    }
+    if (!in || !out) return;
     
-    sample_t comb_sum = 0.0f;
+    int ramping = freeverb_update_params(reverb);
+    const SimdLevel level = cpu_simd_level();
     
-    // Process through comb filters
-    for (int i = 0; i < 8; i++) {
-        size_t delay_samples = reverb->comb_delays[i].size - 1;
-        sample_t delayed = delay_line_read(&reverb->comb_delays[i], delay_samples);
-        
-        // Apply damping filter
-        delayed = onepole_process(&reverb->comb_filters[i], delayed, 0);
+    DelayLine combs[FREEVERB_COMBS];
+    DelayLine allpasses[FREEVERB_ALLPASSES];
+    memcpy(combs, reverb->comb_delays[0], sizeof(combs));
+    memcpy(allpasses, reverb->allpass_delays[0], sizeof(allpasses));
+    
+    const size_t chunk = freeverb_chunk_size(reverb);
+    sample_t wet_sum[AUDIO_CHANNEL_CHUNK];
+    float feedbacks[AUDIO_CHANNEL_CHUNK];
+    float wets[AUDIO_CHANNEL_CHUNK];
+    float widths[AUDIO_CHANNEL_CHUNK];
+    
+    for (size_t pos = 0; pos < n; pos += chunk) {
+        const size_t count = (n - pos < chunk) ? n - pos : chunk;
+        const sample_t* input = in + pos;
+        const int ramp_chunk = ramping;
+        if (ramp_chunk) {
+            ramping = reverb_fill_ramps(&reverb->feedback_smoother, &reverb->wet_smoother, feedbacks, wets, count);
+            param_smoother_fill(&reverb->width_smoother, widths, count); // Unused in mono, but kept moving
+            ramping = ramping || param_smoother_active(&reverb->width_smoother);
+        }
         
-        sample_t feedback = input + delayed * reverb->comb_feedbacks[i];
-        delay_line_write(&reverb->comb_delays[i], feedback);
+        freeverb_run_set(reverb, combs, allpasses, reverb->comb_state[0], input, ramp_chunk ? feedbacks : NULL,
+                         wet_sum, count, level);
         
-        comb_sum += delayed;
+        if (ramp_chunk) {
+            reverb_mix_ramp(input, wet_sum, wets, out + pos, count);
+        } else {
+            const float wet = reverb->wet_smoother.current;
+            const float dry = 1.0f - wet;
+            for (size_t i = 0; i < count; i++) {
+                out[pos + i] = input[i] * dry + wet_sum[i] * wet;
+            }
+        }
     }
     
-    // Process through allpass filters
-    sample_t allpass_output = comb_sum;
-    for (int i = 0; i < 4; i++) {
-        size_t delay_samples = reverb->allpass_delays[i].size - 1;
-        sample_t delayed = delay_line_read(&reverb->allpass_delays[i], delay_samples);
+    for (int c = 0; c < FREEVERB_COMBS; c++) {
+        reverb->comb_delays[0][c].write_pos = combs[c].write_pos;
+    }
+    for (int a = 0; a < FREEVERB_ALLPASSES; a++) {
+        reverb->allpass_delays[0][a].write_pos = allpasses[a].write_pos;
+    }
+}
+
+// Process a stereo block (outputs may alias the inputs). Both sets take the
+// mono sum of the input; each channel gets its own set's output weighted by
+// (1 + width) / 2 plus the other set's by (1 - width) / 2.
+void freeverb_process_stereo_block(Freeverb* reverb, const sample_t* left_in, const sample_t* right_in,
+                                   sample_t* left_out, sample_t* right_out, size_t n) {
+    if (!reverb) {
+        audio_block_bypass(left_in, left_out, n);
+        audio_block_bypass(right_in, right_out, n);
+        return;
+    }
+    if (!left_in || !right_in || !left_out || !right_out) return;
+    
+    int ramping = freeverb_update_params(reverb);
+    const SimdLevel level = cpu_simd_level();
+    
+    DelayLine combs[2][FREEVERB_COMBS];
+    DelayLine allpasses[2][FREEVERB_ALLPASSES];
+    memcpy(combs, reverb->comb_delays, sizeof(combs));
+    memcpy(allpasses, reverb->allpass_delays, sizeof(allpasses));
+    
+    const size_t chunk = freeverb_chunk_size(reverb);
+    sample_t mono[AUDIO_CHANNEL_CHUNK];
+    sample_t wet_left[AUDIO_CHANNEL_CHUNK];
+    sample_t wet_right[AUDIO_CHANNEL_CHUNK];
+    float feedbacks[AUDIO_CHANNEL_CHUNK];
+    float wets[AUDIO_CHANNEL_CHUNK];
+    float widths[AUDIO_CHANNEL_CHUNK];
+    
+    for (size_t pos = 0; pos < n; pos += chunk) {
+        const size_t count = (n - pos < chunk) ? n - pos : chunk;
+        const int ramp_chunk = ramping;
+        if (ramp_chunk) {
+            ramping = reverb_fill_ramps(&reverb->feedback_smoother, &reverb->wet_smoother, feedbacks, wets, count);
+            param_smoother_fill(&reverb->width_smoother, widths, count);
+            ramping = ramping || param_smoother_active(&reverb->width_smoother);
+        }
         
-        sample_t feedback = allpass_output + delayed * 0.5f;
-        delay_line_write(&reverb->allpass_delays[i], feedback);
+        for (size_t i = 0; i < count; i++) {
+            mono[i] = 0.5f * (left_in[pos + i] + right_in[pos + i]);
+        }
+        const float* ramp = ramp_chunk ? feedbacks : NULL;
+        freeverb_run_set(reverb, combs[0], allpasses[0], reverb->comb_state[0], mono, ramp, wet_left, count, level);
+        freeverb_run_set(reverb, combs[1], allpasses[1], reverb->comb_state[1], mono, ramp, wet_right, count, level);
         
-        allpass_output = delayed - allpass_output * 0.5f;
+        if (ramp_chunk) {
+            for (size_t i = 0; i < count; i++) {
+                const float wet1 = wets[i] * (0.5f + 0.5f * widths[i]);
+                const float wet2 = wets[i] * (0.5f - 0.5f * widths[i]);
+                const float dry = 1.0f - wets[i];
+                const sample_t wl = wet_left[i];
+                const sample_t wr = wet_right[i];
+                left_out[pos + i] = left_in[pos + i] * dry + wl * wet1 + wr * wet2;
+                right_out[pos + i] = right_in[pos + i] * dry + wr * wet1 + wl * wet2;
+            }
+        } else {
+            const float wet = reverb->wet_smoother.current;
+            const float width = reverb->width_smoother.current;
+            const float wet1 = wet * (0.5f + 0.5f * width);
+            const float wet2 = wet * (0.5f - 0.5f * width);
+            const float dry = 1.0f - wet;
+            for (size_t i = 0; i < count; i++) {
+                const sample_t wl = wet_left[i];
+                const sample_t wr = wet_right[i];
+                left_out[pos + i] = left_in[pos + i] * dry + wl * wet1 + wr * wet2;
+                right_out[pos + i] = right_in[pos + i] * dry + wr * wet1 + wl * wet2;
+            }
+        }
     }
     
-    return input * reverb->dry_level + allpass_output * reverb->wet_level;
+    for (int ch = 0; ch < 2; ch++) {
+        for (int c = 0; c < FREEVERB_COMBS; c++) {
+            reverb->comb_delays[ch][c].write_pos = combs[ch][c].write_pos;
+        }
+        for (int a = 0; a < FREEVERB_ALLPASSES; a++) {
+            reverb->allpass_delays[ch][a].write_pos = allpasses[ch][a].write_pos;
+        }
+    }
 }
 
-// Process buffer through Freeverb
+// Process buffer through Freeverb: stereo buffers get the true stereo
+// path, anything else is processed as one mono stream
 void freeverb_process_buffer(Freeverb* reverb, AudioBuffer* buffer) {
     if (!reverb || !buffer || !buffer->data) return;
     
-    for (size_t i = 0; i < buffer->capacity; i++) {
-        buffer->data[i] = freeverb_process(reverb, buffer->data[i]);
+    if (buffer->channels != 2) {
+        freeverb_process_block(reverb, buffer->data, buffer->data, buffer->capacity);
+        return;
+    }
+    if (buffer->layout == AUDIO_LAYOUT_PLANAR) {
+        freeverb_process_stereo_block(reverb, buffer->planes[0], buffer->planes[1], buffer->planes[0],
+                                      buffer->planes[1], buffer->length);
+        return;
+    }
+    
+    sample_t left[AUDIO_CHANNEL_CHUNK];
+    sample_t right[AUDIO_CHANNEL_CHUNK];
+    for (size_t start = 0; start < buffer->length; start += AUDIO_CHANNEL_CHUNK) {
+        size_t frames = buffer->length - start;
+        if (frames > AUDIO_CHANNEL_CHUNK) frames = AUDIO_CHANNEL_CHUNK;
+        
+        audio_buffer_read_channel(buffer, 0, start, left, frames);
+        audio_buffer_read_channel(buffer, 1, start, right, frames);
+        freeverb_process_stereo_block(reverb, left, right, left, right, frames);
+        audio_buffer_write_channel(buffer, 0, start, left, frames);
+        audio_buffer_write_channel(buffer, 1, start, right, frames);
+    }
+}
+
+// Block adapter used for per-channel processing
+static void freeverb_channel_block(void* effect, const sample_t* in, sample_t* out, size_t n) {
+    freeverb_process_block((Freeverb*)effect, in, out, n);
+}
+
+// Process each channel of an interleaved buffer with its own Freeverb instance
+void freeverb_process_channels(Freeverb** reverbs, AudioBuffer* buffer) {
+    if (!reverbs || !buffer || !buffer->data || buffer->channels > MAX_CHANNELS) return;
+    
+    void* instances[MAX_CHANNELS];
+    for (size_t ch = 0; ch < buffer->channels; ch++) {
+        instances[ch] = reverbs[ch];
+    }
+    audio_buffer_process_channels(buffer, freeverb_channel_block, instances);
+}
+
+// Clear freeverb history (parameters are kept)
+void freeverb_reset(Freeverb* reverb) {
+    if (!reverb) return;
+    
+    for (int ch = 0; ch < 2; ch++) {
+        for (int i = 0; i < FREEVERB_COMBS; i++) {
+            delay_line_clear(&reverb->comb_delays[ch][i]);
+            reverb->comb_state[ch][i] = 0.0f;
+        }
+        for (int i = 0; i < FREEVERB_ALLPASSES; i++) {
+            delay_line_clear(&reverb->allpass_delays[ch][i]);
+        }
+    }
+    
+    param_smoother_snap(&reverb->feedback_smoother);
+    param_smoother_snap(&reverb->wet_smoother);
+    param_smoother_snap(&reverb->width_smoother);
+}
+
+// Effect interface adapters
+static void freeverb_effect_reset(void* effect) {
+    freeverb_reset((Freeverb*)effect);
+}
+
+static int freeverb_effect_set_param(void* effect, int param, float value) {
+    Freeverb* reverb = (Freeverb*)effect;
+    if (param < 0 || param >= 4) return 0;
+    
+    float p[4] = {reverb->room_size, reverb->damping, reverb->wet_level, reverb->width};
+    p[param] = value;
+    freeverb_set_params(reverb, p[0], p[1], p[2], p[3]);
+    return 1;
+}
+
+static void freeverb_effect_destroy(void* effect) {
+    freeverb_destroy((Freeverb*)effect);
+}
+
+static const EffectVTable freeverb_vtable = {
+    .name = "freeverb",
+    .process_block = freeverb_channel_block,
+    .reset = freeverb_effect_reset,
+    .set_param = freeverb_effect_set_param,
+    .latency = NULL,
+    .destroy = freeverb_effect_destroy
+};
+
+// Wrap in the effect interface (params: room_size, damping, wet_level, width)
+Effect freeverb_effect(Freeverb* reverb) {
+    Effect effect = { &freeverb_vtable, reverb };
+    return effect;
+}
+
+
+// FDN line lengths in samples at 44.1kHz: primes spread geometrically over
+// 21-70 ms. Eight-line networks take every other one.
+static const int fdn_line_lengths[FDN_MAX_LINES] = {
+    929, 1009, 1087, 1181, 1277, 1399, 1499, 1627, 1777, 1907, 2069, 2239, 2437, 2633, 2851, 3089
+};
+
+// Sign patterns spreading the input over the lines and picking the output
+// from them, chosen so neither is an eigenvector of either matrix
+static const float fdn_input_signs[FDN_MAX_LINES] = {
+    1, -1, 1, 1, -1, 1, -1, -1, 1, 1, -1, 1, 1, -1, -1, -1
+};
+static const float fdn_output_signs[FDN_MAX_LINES] = {
+    1, 1, -1, 1, 1, -1, -1, 1, -1, 1, 1, -1, 1, -1, -1, -1
+};
+
+// Recompute the absorption filters from the current RT60s and crossover.
+// Each is a first-order shelf with gain g_low at DC and g_high at Nyquist,
+// where g = 0.001^(length / (rt60 * fs)) is the gain per pass through the
+// line that gives the decay time. The matrix normalization is folded in,
+// and taken back out of the output taps.
+static void fdn_reverb_update_filters(FdnReverb* reverb) {
+    const float fs = reverb->sample_rate;
+    const float low_samples = reverb->rt60_low_smoother.current * fs;
+    const float high_samples = reverb->rt60_high_smoother.current * fs;
+    const float k = tanf((float)PI * reverb->crossover_smoother.current / fs);
+    const float norm = reverb->matrix == FDN_MATRIX_HADAMARD ? 1.0f / sqrtf((float)reverb->num_lines) : 1.0f;
+    
+    for (int i = 0; i < reverb->num_lines; i++) {
+        const float length = (float)(reverb->lines[i].size - 1);
+        const float g_low = powf(0.001f, length / low_samples) * norm;
+        const float g_high = powf(0.001f, length / high_samples) * norm;
+        reverb->b0[i] = (g_low * k + g_high) / (k + 1.0f);
+        reverb->b1[i] = (g_low * k - g_high) / (k + 1.0f);
+        reverb->a1[i] = (k - 1.0f) / (k + 1.0f);
+        reverb->output_gains[i] = fdn_output_signs[i] / (sqrtf((float)reverb->num_lines) * norm);
     }
-}
\ No newline at end of file
+}
+
+// Create an FDN reverb with 8 or 16 lines
+FdnReverb* fdn_reverb_create(int num_lines, float sample_rate) {
+    if (num_lines != 8 && num_lines != FDN_MAX_LINES) return NULL;
+    
+    FdnReverb* reverb = audio_malloc(sizeof(FdnReverb));
+    if (!reverb) return NULL;
+    
+    float scale = sample_rate / 44100.0f;
+    const int stride = FDN_MAX_LINES / num_lines;
+    
+    for (int i = 0; i < num_lines; i++) {
+        size_t delay_samples = (size_t)(fdn_line_lengths[i * stride] * scale);
+        DelayLine* delay = delay_line_create(delay_samples);
+        if (!delay) {
+            // Cleanup on failure
+            for (int j = 0; j < i; j++) {
+                audio_free(reverb->lines[j].buffer);
+            }
+            audio_free(reverb);
+            return NULL;
+        }
+        reverb->lines[i] = *delay;
+        audio_free(delay);
+        
+        reverb->state[i] = 0.0f;
+        reverb->input_gains[i] = fdn_input_signs[i];
+    }
+    
+    reverb->num_lines = num_lines;
+    reverb->matrix = FDN_MATRIX_HADAMARD;
+    reverb->rt60_low = 2.0f;
+    reverb->rt60_high = 1.0f;
+    reverb->crossover = 3000.0f;
+    reverb->wet_level = 0.3f;
+    reverb->dry_level = 0.7f;
+    reverb->sample_rate = sample_rate;
+    
+    param_smoother_init(&reverb->rt60_low_smoother, reverb->rt60_low, PARAM_SMOOTH_DEFAULT_MS, sample_rate,
+                        PARAM_SMOOTH_LINEAR);
+    param_smoother_init(&reverb->rt60_high_smoother, reverb->rt60_high, PARAM_SMOOTH_DEFAULT_MS, sample_rate,
+                        PARAM_SMOOTH_LINEAR);
+    param_smoother_init(&reverb->crossover_smoother, reverb->crossover, PARAM_SMOOTH_DEFAULT_MS, sample_rate,
+                        PARAM_SMOOTH_LINEAR);
+    param_smoother_init(&reverb->wet_smoother, reverb->wet_level, PARAM_SMOOTH_DEFAULT_MS, sample_rate,
+                        PARAM_SMOOTH_LINEAR);
+    fdn_reverb_update_filters(reverb);
+    
+    return reverb;
+}
+
+// Destroy FDN reverb
+void fdn_reverb_destroy(FdnReverb* reverb) {
+    if (reverb) {
+        for (int i = 0; i < reverb->num_lines; i++) {
+            if (reverb->lines[i].buffer) {
+                audio_free(reverb->lines[i].buffer);
+            }
+        }
+        audio_free(reverb);
+    }
+}
+
+// Set FDN reverb parameters (decay times in seconds, crossover in Hz)
+void fdn_reverb_set_params(FdnReverb* reverb, float rt60_low, float rt60_high, float crossover, float wet_level) {
+    if (!reverb) return;
+    
+    reverb->rt60_low = clamp(rt60_low, 0.1f, 20.0f);
+    reverb->rt60_high = clamp(rt60_high, 0.1f, 20.0f);
+    reverb->crossover = clamp(crossover, 100.0f, fminf(10000.0f, 0.45f * reverb->sample_rate));
+    reverb->wet_level = clamp(wet_level, 0.0f, 1.0f);
+    reverb->dry_level = 1.0f - reverb->wet_level;
+    
+    param_smoother_set_target(&reverb->rt60_low_smoother, reverb->rt60_low);
+    param_smoother_set_target(&reverb->rt60_high_smoother, reverb->rt60_high);
+    param_smoother_set_target(&reverb->crossover_smoother, reverb->crossover);
+    param_smoother_set_target(&reverb->wet_smoother, reverb->wet_level);
+}
+
+// Choose the feedback matrix
+void fdn_reverb_set_matrix(FdnReverb* reverb, FdnMatrix matrix) {
+    if (!reverb || (matrix != FDN_MATRIX_HADAMARD && matrix != FDN_MATRIX_HOUSEHOLDER)) return;
+    
+    reverb->matrix = matrix;
+    fdn_reverb_update_filters(reverb);
+}
+
+// Pick up new parameter targets; returns nonzero while a ramp is active
+static int fdn_reverb_update_params(FdnReverb* reverb) {
+    int changed = param_smoother_update(&reverb->rt60_low_smoother);
+    changed |= param_smoother_update(&reverb->rt60_high_smoother);
+    changed |= param_smoother_update(&reverb->crossover_smoother);
+    if (changed) {
+        fdn_reverb_update_filters(reverb);
+    }
+    param_smoother_update(&reverb->wet_smoother);
+    
+    return param_smoother_active(&reverb->rt60_low_smoother) || param_smoother_active(&reverb->rt60_high_smoother) ||
+           param_smoother_active(&reverb->crossover_smoother) || param_smoother_active(&reverb->wet_smoother);
+}
+
+// Advance every ramp by one chunk (the wet level per sample, the filter
+// parameters once per chunk); returns nonzero while a ramp is still active
+static int fdn_reverb_fill_ramps(FdnReverb* reverb, float* wets, float* scratch, size_t count) {
+    param_smoother_fill(&reverb->rt60_low_smoother, scratch, count);
+    param_smoother_fill(&reverb->rt60_high_smoother, scratch, count);
+    param_smoother_fill(&reverb->crossover_smoother, scratch, count);
+    param_smoother_fill(&reverb->wet_smoother, wets, count);
+    
+    return param_smoother_active(&reverb->rt60_low_smoother) || param_smoother_active(&reverb->rt60_high_smoother) ||
+           param_smoother_active(&reverb->crossover_smoother) || param_smoother_active(&reverb->wet_smoother);
+}
+
+typedef sample_t FdnBlock[AUDIO_CHANNEL_CHUNK];
+
+// Absorption filters over the chunk of every line. The SSE path runs four
+// lines side by side, transposing 4x4 tiles so one register holds the same
+// sample of four lines and their recursions share one dependency chain.
+static void fdn_absorb(FdnReverb* reverb, FdnBlock* lines, size_t count, int simd) {
+    size_t start = 0;
+#if defined(REVERB_SSE)
+    if (simd) {
+        start = count & ~(size_t)3;
+        for (int g = 0; g < reverb->num_lines; g += 4) {
+            const __m128 b0 = _mm_loadu_ps(reverb->b0 + g);
+            const __m128 b1 = _mm_loadu_ps(reverb->b1 + g);
+            const __m128 a1 = _mm_loadu_ps(reverb->a1 + g);
+            __m128 state = _mm_loadu_ps(reverb->state + g);
+            
+            for (size_t i = 0; i < start; i += 4) {
+                __m128 r[4];
+                for (int l = 0; l < 4; l++) {
+                    r[l] = _mm_loadu_ps(lines[g + l] + i);
+                }
+                _MM_TRANSPOSE4_PS(r[0], r[1], r[2], r[3]);
+                for (int t = 0; t < 4; t++) {
+                    __m128 y = _mm_add_ps(_mm_mul_ps(b0, r[t]), state);
+                    state = _mm_sub_ps(_mm_mul_ps(b1, r[t]), _mm_mul_ps(a1, y));
+                    r[t] = y;
+                }
+                _MM_TRANSPOSE4_PS(r[0], r[1], r[2], r[3]);
+                for (int l = 0; l < 4; l++) {
+                    _mm_storeu_ps(lines[g + l] + i, r[l]);
+                }
+            }
+            _mm_storeu_ps(reverb->state + g, state);
+        }
+    }
+#endif
+    (void)simd;
+    for (int l = 0; l < reverb->num_lines; l++) {
+        const float b0 = reverb->b0[l];
+        const float b1 = reverb->b1[l];
+        const float a1 = reverb->a1[l];
+        float state = reverb->state[l];
+        sample_t* x = lines[l];
+        for (size_t i = start; i < count; i++) {
+            float y = b0 * x[i] + state;
+            state = b1 * x[i] - a1 * y;
+            x[i] = y;
+        }
+        reverb->state[l] = state;
+    }
+}
+
+// wet = sum of gains[l] * lines[l]
+static void fdn_tap(const FdnBlock* lines, const float* gains, int num_lines, sample_t* wet, size_t count, int simd) {
+    size_t start = 0;
+#if defined(REVERB_SSE)
+    if (simd) {
+        start = count & ~(size_t)3;
+        for (size_t i = 0; i < start; i += 4) {
+            __m128 acc = _mm_mul_ps(_mm_set1_ps(gains[0]), _mm_loadu_ps(lines[0] + i));
+            for (int l = 1; l < num_lines; l++) {
+                acc = _mm_add_ps(acc, _mm_mul_ps(_mm_set1_ps(gains[l]), _mm_loadu_ps(lines[l] + i)));
+            }
+            _mm_storeu_ps(wet + i, acc);
+        }
+    }
+#endif
+    (void)simd;
+    for (size_t i = start; i < count; i++) {
+        float acc = gains[0] * lines[0][i];
+        for (int l = 1; l < num_lines; l++) {
+            acc += gains[l] * lines[l][i];
+        }
+        wet[i] = acc;
+    }
+}
+
+// Unnormalized Walsh-Hadamard transform across the lines: log2(N) passes of
+// sum/difference butterflies, each vectorized over the samples
+static void fdn_hadamard(FdnBlock* lines, int num_lines, size_t count, int simd) {
+    for (int h = 1; h < num_lines; h <<= 1) {
+        for (int j = 0; j < num_lines; j += 2 * h) {
+            for (int l = j; l < j + h; l++) {
+                sample_t* x = lines[l];
+                sample_t* y = lines[l + h];
+                size_t start = 0;
+#if defined(REVERB_SSE)
+                if (simd) {
+                    start = count & ~(size_t)3;
+                    for (size_t i = 0; i < start; i += 4) {
+                        __m128 a = _mm_loadu_ps(x + i);
+                        __m128 b = _mm_loadu_ps(y + i);
+                        _mm_storeu_ps(x + i, _mm_add_ps(a, b));
+                        _mm_storeu_ps(y + i, _mm_sub_ps(a, b));
+                    }
+                }
+#endif
+                for (size_t i = start; i < count; i++) {
+                    sample_t a = x[i];
+                    sample_t b = y[i];
+                    x[i] = a + b;
+                    y[i] = a - b;
+                }
+            }
+        }
+    }
+    (void)simd;
+}
+
+// Householder reflection I - 2/N * ones: subtract 2/N of the line sum
+// (scratch receives it) from every line
+static void fdn_householder(FdnBlock* lines, int num_lines, sample_t* scratch, size_t count, int simd) {
+    float ones[FDN_MAX_LINES];
+    for (int l = 0; l < num_lines; l++) {
+        ones[l] = 2.0f / num_lines;
+    }
+    fdn_tap((const FdnBlock*)lines, ones, num_lines, scratch, count, simd);
+    
+    for (int l = 0; l < num_lines; l++) {
+        sample_t* x = lines[l];
+        size_t start = 0;
+#if defined(REVERB_SSE)
+        if (simd) {
+            start = count & ~(size_t)3;
+            for (size_t i = 0; i < start; i += 4) {
+                _mm_storeu_ps(x + i, _mm_sub_ps(_mm_loadu_ps(x + i), _mm_loadu_ps(scratch + i)));
+            }
+        }
+#endif
+        for (size_t i = start; i < count; i++) {
+            x[i] -= scratch[i];
+        }
+    }
+}
+
+// lines[l] += gains[l] * in
+static void fdn_inject(FdnBlock* lines, const float* gains, int num_lines, const sample_t* in, size_t count,
+                       int simd) {
+    for (int l = 0; l < num_lines; l++) {
+        sample_t* x = lines[l];
+        const float g = gains[l];
+        size_t start = 0;
+#if defined(REVERB_SSE)
+        if (simd) {
+            const __m128 gv = _mm_set1_ps(g);
+            start = count & ~(size_t)3;
+            for (size_t i = 0; i < start; i += 4) {
+                __m128 v = _mm_add_ps(_mm_loadu_ps(x + i), _mm_mul_ps(gv, _mm_loadu_ps(in + i)));
+                _mm_storeu_ps(x + i, v);
+            }
+        }
+#endif
+        for (size_t i = start; i < count; i++) {
+            x[i] += g * in[i];
+        }
+    }
+    (void)simd;
+}
+
+// Process one sample through FDN reverb
+sample_t fdn_reverb_process(FdnReverb* reverb, sample_t input) {
+    sample_t output = input;
+    fdn_reverb_process_block(reverb, &input, &output, 1);
+    return output;
+}
+
+// Process a block through FDN reverb (in and out may be the same buffer).
+// Each chunk, no longer than the shortest line, reads every line as a span,
+// filters it, taps the output, mixes the lines through the matrix, adds the
+// input and writes the lines back.
+void fdn_reverb_process_block(FdnReverb* reverb, const sample_t* in, sample_t* out, size_t n) {
+    if (!reverb) {
+        audio_block_bypass(in, out, n);
+        return;
+    }
+    if (!in || !out) return;
+    
+    int ramping = fdn_reverb_update_params(reverb);
+    
+    const int num_lines = reverb->num_lines;
+    const int simd = cpu_simd_level() >= SIMD_LEVEL_SSE2;
+    DelayLine delays[FDN_MAX_LINES];
+    memcpy(delays, reverb->lines, num_lines * sizeof(DelayLine));
+    
+    const size_t chunk = reverb_chunk_size(delays, num_lines, AUDIO_CHANNEL_CHUNK);
+    FdnBlock lines[FDN_MAX_LINES];
+    sample_t wet_sum[AUDIO_CHANNEL_CHUNK];
+    sample_t scratch[AUDIO_CHANNEL_CHUNK];
+    float wets[AUDIO_CHANNEL_CHUNK];
+    
+    for (size_t pos = 0; pos < n; pos += chunk) {
+        const size_t count = (n - pos < chunk) ? n - pos : chunk;
+        const int ramp_chunk = ramping;
+        if (ramp_chunk) {
+            ramping = fdn_reverb_fill_ramps(reverb, wets, scratch, count);
+        }
+        
+        for (int l = 0; l < num_lines; l++) {
+            delay_line_read_block(&delays[l], delays[l].size - 1, lines[l], count);
+        }
+        fdn_absorb(reverb, lines, count, simd);
+        fdn_tap((const FdnBlock*)lines, reverb->output_gains, num_lines, wet_sum, count, simd);
+        
+        if (reverb->matrix == FDN_MATRIX_HADAMARD) {
+            fdn_hadamard(lines, num_lines, count, simd);
+        } else {
+            fdn_householder(lines, num_lines, scratch, count, simd);
+        }
+        fdn_inject(lines, reverb->input_gains, num_lines, in + pos, count, simd);
+        for (int l = 0; l < num_lines; l++) {
+            delay_line_write_block(&delays[l], lines[l], count);
+        }
+        
+        if (ramp_chunk) {
+            reverb_mix_ramp(in + pos, wet_sum, wets, out + pos, count);
+            fdn_reverb_update_filters(reverb);
+        } else {
+            const float wet = reverb->wet_smoother.current;
+            const float dry = 1.0f - wet;
+            for (size_t i = 0; i < count; i++) {
+                out[pos + i] = in[pos + i] * dry + wet_sum[i] * wet;
+            }
+        }
+    }
+    
+    for (int l = 0; l < num_lines; l++) {
+        reverb->lines[l].write_pos = delays[l].write_pos;
+    }
+}
+
+// Process buffer through FDN reverb
+void fdn_reverb_process_buffer(FdnReverb* reverb, AudioBuffer* buffer) {
+    if (!reverb || !buffer || !buffer->data) return;
+    
+    fdn_reverb_process_block(reverb, buffer->data, buffer->data, buffer->capacity);
+}
+
+// Block adapter used for per-channel processing
+static void fdn_reverb_channel_block(void* effect, const sample_t* in, sample_t* out, size_t n) {
+    fdn_reverb_process_block((FdnReverb*)effect, in, out, n);
+}
+
+// Process each channel of an interleaved buffer with its own FDN reverb instance
+void fdn_reverb_process_channels(FdnReverb** reverbs, AudioBuffer* buffer) {
+    if (!reverbs || !buffer || !buffer->data || buffer->channels > MAX_CHANNELS) return;
+    
+    void* instances[MAX_CHANNELS];
+    for (size_t ch = 0; ch < buffer->channels; ch++) {
+        instances[ch] = reverbs[ch];
+    }
+    audio_buffer_process_channels(buffer, fdn_reverb_channel_block, instances);
+}
+
+// Clear FDN reverb history (parameters are kept)
+void fdn_reverb_reset(FdnReverb* reverb) {
+    if (!reverb) return;
+    
+    for (int i = 0; i < reverb->num_lines; i++) {
+        delay_line_clear(&reverb->lines[i]);
+        reverb->state[i] = 0.0f;
+    }
+    
+    param_smoother_snap(&reverb->rt60_low_smoother);
+    param_smoother_snap(&reverb->rt60_high_smoother);
+    param_smoother_snap(&reverb->crossover_smoother);
+    param_smoother_snap(&reverb->wet_smoother);
+    fdn_reverb_update_filters(reverb);
+}
+
+// Effect interface adapters
+static void fdn_reverb_effect_reset(void* effect) {
+    fdn_reverb_reset((FdnReverb*)effect);
+}
+
+static int fdn_reverb_effect_set_param(void* effect, int param, float value) {
+    FdnReverb* reverb = (FdnReverb*)effect;
+    if (param < 0 || param >= 4) return 0;
+    
+    float p[4] = {reverb->rt60_low, reverb->rt60_high, reverb->crossover, reverb->wet_level};
+    p[param] = value;
+    fdn_reverb_set_params(reverb, p[0], p[1], p[2], p[3]);
+    return 1;
+}
+
+static void fdn_reverb_effect_destroy(void* effect) {
+    fdn_reverb_destroy((FdnReverb*)effect);
+}
+
+static const EffectVTable fdn_reverb_vtable = {
+    .name = "FDN reverb",
+    .process_block = fdn_reverb_channel_block,
+    .reset = fdn_reverb_effect_reset,
+    .set_param = fdn_reverb_effect_set_param,
+    .latency = NULL,
+    .destroy = fdn_reverb_effect_destroy
+};
+
+// Wrap in the effect interface (params: rt60_low, rt60_high, crossover, wet_level)
+Effect fdn_reverb_effect(FdnReverb* reverb) {
+    Effect effect = { &fdn_reverb_vtable, reverb };
+    return effect;
+}
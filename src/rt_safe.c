@@ -0,0 +1,174 @@
+#include "rt_safe.h"
+
+#define ARENA_ALIGNMENT 16
+
+// Arena allocator
+
+// Use memory as an empty arena
+void audio_arena_init(AudioArena* arena, void* memory, size_t size) {
+    if (!arena) return;
+    
+    arena->base = (unsigned char*)memory;
+    arena->size = memory ? size : 0;
+    arena->used = 0;
+    arena->failed = 0;
+}
+
+// Bump-allocate size bytes (AudioAllocFn signature)
+void* audio_arena_alloc(void* user, size_t size) {
+    AudioArena* arena = (AudioArena*)user;
+    if (!arena || !arena->base) return NULL;
+    
+    uintptr_t start = (uintptr_t)(arena->base + arena->used);
+    size_t pad = (size_t)((ARENA_ALIGNMENT - (start & (ARENA_ALIGNMENT - 1))) & (ARENA_ALIGNMENT - 1));
+    
+    if (size > arena->size - arena->used || pad > arena->size - arena->used - size) {
+        arena->failed++;
+        return NULL;
+    }
+    
+    void* ptr = arena->base + arena->used + pad;
+    arena->used += pad + size;
+    return ptr;
+}
+
+// Individual frees are ignored (AudioFreeFn signature)
+void audio_arena_free(void* user, void* ptr) {
+    (void)user;
+    (void)ptr;
+}
+
+// Send library allocations to the arena
+void audio_arena_install(AudioArena* arena) {
+    if (arena) {
+        audio_set_allocator(audio_arena_alloc, audio_arena_free, arena);
+    } else {
+        audio_set_allocator(NULL, NULL, NULL);
+    }
+}
+
+// Forget every allocation (objects in the arena become invalid)
+void audio_arena_reset(AudioArena* arena) {
+    if (!arena) return;
+    
+    arena->used = 0;
+    arena->failed = 0;
+}
+
+// SPSC queue
+
+// Create a queue holding at least capacity items
+SpscQueue* spsc_queue_create(size_t capacity, size_t item_size) {
+    if (capacity == 0 || item_size == 0) return NULL;
+    
+    size_t slots = 1;
+    while (slots < capacity) slots <<= 1;
+    
+    SpscQueue* queue = audio_malloc(sizeof(SpscQueue));
+    if (!queue) return NULL;
+    
+    queue->items = audio_calloc(slots, item_size);
+    if (!queue->items) {
+        audio_free(queue);
+        return NULL;
+    }
+    
+    queue->item_size = item_size;
+    queue->mask = slots - 1;
+    queue->head = 0;
+    queue->tail = 0;
+    queue->dropped = 0;
+    
+    return queue;
+}
+
+// Destroy queue
+void spsc_queue_destroy(SpscQueue* queue) {
+    if (queue) {
+        audio_free(queue->items);
+        audio_free(queue);
+    }
+}
+
+// Producer side: copy item in, or count a drop when the ring is full
+int spsc_queue_push(SpscQueue* queue, const void* item) {
+    if (!queue || !item) return 0;
+    
+    size_t tail = queue->tail;
+    size_t head = __atomic_load_n(&queue->head, __ATOMIC_ACQUIRE);
+    
+    if (tail - head > queue->mask) {
+        __atomic_store_n(&queue->dropped, queue->dropped + 1, __ATOMIC_RELAXED);
+        return 0;
+    }
+    
+    memcpy(queue->items + (tail & queue->mask) * queue->item_size, item, queue->item_size);
+    __atomic_store_n(&queue->tail, tail + 1, __ATOMIC_RELEASE);
+    return 1;
+}
+
+// Consumer side: copy the oldest item out
+int spsc_queue_pop(SpscQueue* queue, void* item) {
+    if (!queue || !item) return 0;
+    
+    size_t head = queue->head;
+    size_t tail = __atomic_load_n(&queue->tail, __ATOMIC_ACQUIRE);
+    
+    if (head == tail) return 0;
+    
+    memcpy(item, queue->items + (head & queue->mask) * queue->item_size, queue->item_size);
+    __atomic_store_n(&queue->head, head + 1, __ATOMIC_RELEASE);
+    return 1;
+}
+
+// Pushes refused so far (readable from either side)
+size_t spsc_queue_dropped(const SpscQueue* queue) {
+    return queue ? __atomic_load_n(&queue->dropped, __ATOMIC_RELAXED) : 0;
+}
+
+// Typed queues
+
+SpscQueue* param_queue_create(size_t capacity) {
+    return spsc_queue_create(capacity, sizeof(ParamChange));
+}
+
+SpscQueue* rt_error_queue_create(size_t capacity) {
+    return spsc_queue_create(capacity, sizeof(RtError));
+}
+
+int param_queue_push(SpscQueue* queue, int node, int param, float value) {
+    ParamChange change = {node, param, value};
+    return spsc_queue_push(queue, &change);
+}
+
+int rt_error_push(SpscQueue* errors, RtErrorCode code, int node, int param, float value) {
+    RtError error = {code, node, param, value};
+    return spsc_queue_push(errors, &error);
+}
+
+const char* rt_error_name(RtErrorCode code) {
+    switch (code) {
+        case RT_ERROR_PARAM_REJECTED: return "parameter rejected";
+        case RT_ERROR_OVERLOAD: return "overload";
+        case RT_ERROR_USER:
+        default: return "user error";
+    }
+}
+
+// Apply every queued parameter change to the chain
+size_t rt_apply_params(EffectChain* chain, SpscQueue* params, SpscQueue* errors) {
+    if (!chain || !params) return 0;
+    
+    size_t applied = 0;
+    ParamChange change;
+    
+    while (spsc_queue_pop(params, &change)) {
+        if (effect_chain_set_param(chain, change.node, change.param, change.value)) {
+            applied++;
+        } else if (errors) {
+            rt_error_push(errors, RT_ERROR_PARAM_REJECTED, change.node, change.param, change.value);
+        }
+    }
+    
+    return applied;
+}
@@ -0,0 +1,377 @@
+#include "sample_convert.h"
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define CONVERT_SSE2 1
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#define CONVERT_NEON 1
+#endif
+
+// Full-scale values for the symmetric integer scaling
+#define S8_SCALE 127.0f
+#define S16_SCALE 32767.0f
+#define S24_SCALE 8388607.0f
+#define S32_SCALE 2147483647.0
+
+// Bytes per stored sample
+size_t sample_format_bytes(SampleFormat format) {
+    switch (format) {
+        case SAMPLE_FORMAT_U8: return 1;
+        case SAMPLE_FORMAT_S16: return 2;
+        case SAMPLE_FORMAT_S24: return 3;
+        case SAMPLE_FORMAT_S32: return 4;
+        case SAMPLE_FORMAT_F32: return 4;
+        case SAMPLE_FORMAT_F64: return 8;
+    }
+    return 0;
+}
+
+// Human-readable format name
+const char* sample_format_name(SampleFormat format) {
+    switch (format) {
+        case SAMPLE_FORMAT_U8: return "8-bit PCM";
+        case SAMPLE_FORMAT_S16: return "16-bit PCM";
+        case SAMPLE_FORMAT_S24: return "24-bit PCM";
+        case SAMPLE_FORMAT_S32: return "32-bit PCM";
+        case SAMPLE_FORMAT_F32: return "32-bit float";
+        case SAMPLE_FORMAT_F64: return "64-bit float";
+    }
+    return "unknown";
+}
+
+// Decoders
+
+// Convert 8-bit unsigned PCM to float
+void convert_u8_to_f32(const void* src, sample_t* dest, size_t count) {
+    const uint8_t* in = src;
+    for (size_t i = 0; i < count; i++) {
+        dest[i] = (float)((int)in[i] - 128) / S8_SCALE;
+    }
+}
+
+// Convert 16-bit PCM to float
+void convert_s16_to_f32(const void* src, sample_t* dest, size_t count) {
+    const uint8_t* in = src;
+    size_t i = 0;
+    
+#if defined(CONVERT_SSE2)
+    const __m128 scale = _mm_set1_ps(1.0f / S16_SCALE);
+    for (; i + 8 <= count; i += 8) {
+        __m128i v = _mm_loadu_si128((const __m128i*)(in + 2 * i));
+        __m128i lo = _mm_srai_epi32(_mm_unpacklo_epi16(v, v), 16);
+        __m128i hi = _mm_srai_epi32(_mm_unpackhi_epi16(v, v), 16);
+        _mm_storeu_ps(dest + i, _mm_mul_ps(_mm_cvtepi32_ps(lo), scale));
+        _mm_storeu_ps(dest + i + 4, _mm_mul_ps(_mm_cvtepi32_ps(hi), scale));
+    }
+#elif defined(CONVERT_NEON)
+    const float32x4_t scale = vdupq_n_f32(1.0f / S16_SCALE);
+    for (; i + 8 <= count; i += 8) {
+        int16x8_t v = vreinterpretq_s16_u8(vld1q_u8(in + 2 * i));
+        vst1q_f32(dest + i, vmulq_f32(vcvtq_f32_s32(vmovl_s16(vget_low_s16(v))), scale));
+        vst1q_f32(dest + i + 4, vmulq_f32(vcvtq_f32_s32(vmovl_s16(vget_high_s16(v))), scale));
+    }
+#endif
+    
+    for (; i < count; i++) {
+        int16_t sample;
+        memcpy(&sample, in + 2 * i, sizeof(sample));
+        dest[i] = int16_to_float(sample);
+    }
+}
+
+// Convert packed 24-bit PCM to float
+void convert_s24_to_f32(const void* src, sample_t* dest, size_t count) {
+    const uint8_t* in = src;
+    for (size_t i = 0; i < count; i++, in += 3) {
+        // Place the sample in the top three bytes, then shift the sign down
+        int32_t sample = (int32_t)((uint32_t)in[0] << 8 | (uint32_t)in[1] << 16 | (uint32_t)in[2] << 24) >> 8;
+        dest[i] = (float)sample / S24_SCALE;
+    }
+}
+
+// Convert 32-bit PCM to float
+void convert_s32_to_f32(const void* src, sample_t* dest, size_t count) {
+    const uint8_t* in = src;
+    size_t i = 0;
+    
+#if defined(CONVERT_SSE2)
+    const __m128 scale = _mm_set1_ps((float)(1.0 / S32_SCALE));
+    for (; i + 4 <= count; i += 4) {
+        __m128i v = _mm_loadu_si128((const __m128i*)(in + 4 * i));
+        _mm_storeu_ps(dest + i, _mm_mul_ps(_mm_cvtepi32_ps(v), scale));
+    }
+#elif defined(CONVERT_NEON)
+    const float32x4_t scale = vdupq_n_f32((float)(1.0 / S32_SCALE));
+    for (; i + 4 <= count; i += 4) {
+        int32x4_t v = vreinterpretq_s32_u8(vld1q_u8(in + 4 * i));
+        vst1q_f32(dest + i, vmulq_f32(vcvtq_f32_s32(v), scale));
+    }
+#endif
+    
+    for (; i < count; i++) {
+        int32_t sample;
+        memcpy(&sample, in + 4 * i, sizeof(sample));
+        dest[i] = (float)(sample / S32_SCALE);
+    }
+}
+
+// Convert 64-bit float to float
+void convert_f64_to_f32(const void* src, sample_t* dest, size_t count) {
+    const uint8_t* in = src;
+    size_t i = 0;
+    
+#if defined(CONVERT_SSE2)
+    for (; i + 4 <= count; i += 4) {
+        __m128 lo = _mm_cvtpd_ps(_mm_loadu_pd((const double*)(in + 8 * i)));
+        __m128 hi = _mm_cvtpd_ps(_mm_loadu_pd((const double*)(in + 8 * i + 16)));
+        _mm_storeu_ps(dest + i, _mm_movelh_ps(lo, hi));
+    }
+#endif
+    
+    for (; i < count; i++) {
+        double sample;
+        memcpy(&sample, in + 8 * i, sizeof(sample));
+        dest[i] = (float)sample;
+    }
+}
+
+// Encoders
+
+// Convert float to 8-bit unsigned PCM
+void convert_f32_to_u8(const sample_t* src, void* dest, size_t count) {
+    uint8_t* out = dest;
+    for (size_t i = 0; i < count; i++) {
+        out[i] = (uint8_t)((int)(clamp(src[i], -1.0f, 1.0f) * S8_SCALE) + 128);
+    }
+}
+
+// Convert float to 16-bit PCM
+void convert_f32_to_s16(const sample_t* src, void* dest, size_t count) {
+    uint8_t* out = dest;
+    size_t i = 0;
+    
+#if defined(CONVERT_SSE2)
+    const __m128 lo_limit = _mm_set1_ps(-1.0f);
+    const __m128 hi_limit = _mm_set1_ps(1.0f);
+    const __m128 scale = _mm_set1_ps(S16_SCALE);
+    for (; i + 8 <= count; i += 8) {
+        __m128 a = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(src + i), lo_limit), hi_limit);
+        __m128 b = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(src + i + 4), lo_limit), hi_limit);
+        __m128i ia = _mm_cvttps_epi32(_mm_mul_ps(a, scale));
+        __m128i ib = _mm_cvttps_epi32(_mm_mul_ps(b, scale));
+        _mm_storeu_si128((__m128i*)(out + 2 * i), _mm_packs_epi32(ia, ib));
+    }
+#elif defined(CONVERT_NEON)
+    const float32x4_t lo_limit = vdupq_n_f32(-1.0f);
+    const float32x4_t hi_limit = vdupq_n_f32(1.0f);
+    const float32x4_t scale = vdupq_n_f32(S16_SCALE);
+    for (; i + 8 <= count; i += 8) {
+        float32x4_t a = vminq_f32(vmaxq_f32(vld1q_f32(src + i), lo_limit), hi_limit);
+        float32x4_t b = vminq_f32(vmaxq_f32(vld1q_f32(src + i + 4), lo_limit), hi_limit);
+        int16x8_t v = vcombine_s16(vmovn_s32(vcvtq_s32_f32(vmulq_f32(a, scale))),
+                                   vmovn_s32(vcvtq_s32_f32(vmulq_f32(b, scale))));
+        vst1q_u8(out + 2 * i, vreinterpretq_u8_s16(v));
+    }
+#endif
+    
+    for (; i < count; i++) {
+        int16_t sample = float_to_int16(src[i]);
+        memcpy(out + 2 * i, &sample, sizeof(sample));
+    }
+}
+
+// Convert float to packed 24-bit PCM
+void convert_f32_to_s24(const sample_t* src, void* dest, size_t count) {
+    uint8_t* out = dest;
+    for (size_t i = 0; i < count; i++, out += 3) {
+        int32_t sample = (int32_t)(clamp(src[i], -1.0f, 1.0f) * S24_SCALE);
+        out[0] = (uint8_t)(sample & 0xFF);
+        out[1] = (uint8_t)((sample >> 8) & 0xFF);
+        out[2] = (uint8_t)((sample >> 16) & 0xFF);
+    }
+}
+
+// Convert float to 32-bit PCM (scaled in double so full scale stays in range)
+void convert_f32_to_s32(const sample_t* src, void* dest, size_t count) {
+    uint8_t* out = dest;
+    size_t i = 0;
+    
+#if defined(CONVERT_SSE2)
+    const __m128 lo_limit = _mm_set1_ps(-1.0f);
+    const __m128 hi_limit = _mm_set1_ps(1.0f);
+    const __m128d scale = _mm_set1_pd(S32_SCALE);
+    for (; i + 4 <= count; i += 4) {
+        __m128 v = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(src + i), lo_limit), hi_limit);
+        __m128i lo = _mm_cvttpd_epi32(_mm_mul_pd(_mm_cvtps_pd(v), scale));
+        __m128i hi = _mm_cvttpd_epi32(_mm_mul_pd(_mm_cvtps_pd(_mm_movehl_ps(v, v)), scale));
+        _mm_storeu_si128((__m128i*)(out + 4 * i), _mm_unpacklo_epi64(lo, hi));
+    }
+#endif
+    
+    for (; i < count; i++) {
+        int32_t sample = (int32_t)(clamp(src[i], -1.0f, 1.0f) * S32_SCALE);
+        memcpy(out + 4 * i, &sample, sizeof(sample));
+    }
+}
+
+// Convert float to 64-bit float
+void convert_f32_to_f64(const sample_t* src, void* dest, size_t count) {
+    uint8_t* out = dest;
+    size_t i = 0;
+    
+#if defined(CONVERT_SSE2)
+    for (; i + 4 <= count; i += 4) {
+        __m128 v = _mm_loadu_ps(src + i);
+        _mm_storeu_pd((double*)(out + 8 * i), _mm_cvtps_pd(v));
+        _mm_storeu_pd((double*)(out + 8 * i + 16), _mm_cvtps_pd(_mm_movehl_ps(v, v)));
+    }
+#endif
+    
+    for (; i < count; i++) {
+        double sample = src[i];
+        memcpy(out + 8 * i, &sample, sizeof(sample));
+    }
+}
+
+// Dithered 16-bit output
+
+// Initialize dither state
+void dither_init(Dither* dither, DitherMode mode, size_t channels) {
+    if (!dither) return;
+    
+    memset(dither, 0, sizeof(Dither));
+    dither->mode = mode;
+    dither->channels = (channels >= 1 && channels <= MAX_CHANNELS) ? channels : 1;
+    
+    // Distinct non-zero seeds so the SIMD lanes are uncorrelated
+    dither->rng[0] = 0x9E3779B9u;
+    dither->rng[1] = 0x7F4A7C15u;
+    dither->rng[2] = 0x85EBCA6Bu;
+    dither->rng[3] = 0xC2B2AE35u;
+}
+
+static inline uint32_t xorshift32(uint32_t* state) {
+    uint32_t x = *state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *state = x;
+    return x;
+}
+
+// Uniform [0, 1) from the top 24 bits
+static inline float rng_unit(uint32_t* state) {
+    return (float)(xorshift32(state) >> 8) * (1.0f / 16777216.0f);
+}
+
+// Round to the nearest 16-bit value with saturation
+static inline int16_t round_to_s16(float value) {
+    float rounded = floorf(value + 0.5f);
+    if (rounded > 32767.0f) return 32767;
+    if (rounded < -32768.0f) return -32768;
+    return (int16_t)rounded;
+}
+
+// TPDF with second-order error feedback; noise transfer (1 - z^-1)^2
+static void convert_f32_to_s16_shaped(const sample_t* src, int16_t* dest, size_t count, Dither* dither) {
+    size_t ch = dither->next_channel;
+    
+    for (size_t i = 0; i < count; i++) {
+        float* e = dither->error[ch];
+        float wanted = clamp(src[i], -1.0f, 1.0f) * S16_SCALE;
+        float shaped = wanted - 2.0f * e[0] + e[1];
+        float noise = rng_unit(&dither->rng[0]) - rng_unit(&dither->rng[1]);
+        int16_t out = round_to_s16(shaped + noise);
+        
+        e[1] = e[0];
+        e[0] = clamp((float)out - shaped, -2.0f, 2.0f); // Bounded so clipping cannot blow up the loop
+        dest[i] = out;
+        
+        if (++ch == dither->channels) ch = 0;
+    }
+    
+    dither->next_channel = ch;
+}
+
+// Requantize to 16 bits with optional dither
+void convert_f32_to_s16_block(const sample_t* src, int16_t* dest, size_t count, Dither* dither) {
+    if (!src || !dest) return;
+    
+    if (!dither || dither->mode == DITHER_NONE) {
+        convert_f32_to_s16(src, dest, count);
+        return;
+    }
+    
+    if (dither->mode == DITHER_TPDF_SHAPED) {
+        convert_f32_to_s16_shaped(src, dest, count, dither);
+        return;
+    }
+    
+    size_t i = 0;
+    
+#if defined(CONVERT_SSE2)
+    // Four xorshift generators advance in parallel, two draws per sample
+    __m128i state = _mm_loadu_si128((const __m128i*)dither->rng);
+    const __m128 lo_limit = _mm_set1_ps(-1.0f);
+    const __m128 hi_limit = _mm_set1_ps(1.0f);
+    const __m128 scale = _mm_set1_ps(S16_SCALE);
+    const __m128 unit = _mm_set1_ps(1.0f / 16777216.0f);
+    
+    for (; i + 8 <= count; i += 8) {
+        __m128 noise[2];
+        for (int h = 0; h < 2; h++) {
+            __m128 draw[2];
+            for (int d = 0; d < 2; d++) {
+                state = _mm_xor_si128(state, _mm_slli_epi32(state, 13));
+                state = _mm_xor_si128(state, _mm_srli_epi32(state, 17));
+                state = _mm_xor_si128(state, _mm_slli_epi32(state, 5));
+                draw[d] = _mm_mul_ps(_mm_cvtepi32_ps(_mm_srli_epi32(state, 8)), unit);
+            }
+            noise[h] = _mm_sub_ps(draw[0], draw[1]);
+        }
+        
+        __m128 a = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(src + i), lo_limit), hi_limit);
+        __m128 b = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(src + i + 4), lo_limit), hi_limit);
+        __m128i ia = _mm_cvtps_epi32(_mm_add_ps(_mm_mul_ps(a, scale), noise[0]));
+        __m128i ib = _mm_cvtps_epi32(_mm_add_ps(_mm_mul_ps(b, scale), noise[1]));
+        _mm_storeu_si128((__m128i*)(dest + i), _mm_packs_epi32(ia, ib));
+    }
+    
+    _mm_storeu_si128((__m128i*)dither->rng, state);
+#endif
+    
+    for (; i < count; i++) {
+        float noise = rng_unit(&dither->rng[i & 3]) - rng_unit(&dither->rng[(i + 1) & 3]);
+        dest[i] = round_to_s16(clamp(src[i], -1.0f, 1.0f) * S16_SCALE + noise);
+    }
+    
+    // TPDF does not track channels, but keep the position for a later mode switch
+    dither->next_channel = (dither->next_channel + count) % dither->channels;
+}
+
+// Dispatch on format
+
+// Decode count stored samples to float
+void convert_to_float(SampleFormat format, const void* src, sample_t* dest, size_t count) {
+    switch (format) {
+        case SAMPLE_FORMAT_U8: convert_u8_to_f32(src, dest, count); break;
+        case SAMPLE_FORMAT_S16: convert_s16_to_f32(src, dest, count); break;
+        case SAMPLE_FORMAT_S24: convert_s24_to_f32(src, dest, count); break;
+        case SAMPLE_FORMAT_S32: convert_s32_to_f32(src, dest, count); break;
+        case SAMPLE_FORMAT_F32: memcpy(dest, src, count * sizeof(sample_t)); break;
+        case SAMPLE_FORMAT_F64: convert_f64_to_f32(src, dest, count); break;
+    }
+}
+
+// Encode count float samples to the stored format
+void convert_from_float(SampleFormat format, const sample_t* src, void* dest, size_t count) {
+    switch (format) {
+        case SAMPLE_FORMAT_U8: convert_f32_to_u8(src, dest, count); break;
+        case SAMPLE_FORMAT_S16: convert_f32_to_s16(src, dest, count); break;
+        case SAMPLE_FORMAT_S24: convert_f32_to_s24(src, dest, count); break;
+        case SAMPLE_FORMAT_S32: convert_f32_to_s32(src, dest, count); break;
+        case SAMPLE_FORMAT_F32: memcpy(dest, src, count * sizeof(sample_t)); break;
+        case SAMPLE_FORMAT_F64: convert_f32_to_f64(src, dest, count); break;
+    }
+}
@@ -0,0 +1,241 @@
+#include "stft.h"
+
+// Fill dest with a periodic window of size points
+void stft_window_fill(StftWindow window, float* dest, size_t size) {
+    if (!dest) return;
+    
+    for (size_t i = 0; i < size; i++) {
+        const double x = TWO_PI * (double)i / (double)size;
+        double w;
+        switch (window) {
+            case STFT_WINDOW_HANN:
+                w = 0.5 - 0.5 * cos(x);
+                break;
+            case STFT_WINDOW_SQRT_HANN:
+                w = sqrt(0.5 - 0.5 * cos(x));
+                break;
+            case STFT_WINDOW_HAMMING:
+                w = 0.54 - 0.46 * cos(x);
+                break;
+            case STFT_WINDOW_BLACKMAN:
+                w = 0.42 - 0.5 * cos(x) + 0.08 * cos(2.0 * x);
+                break;
+            default:
+                w = 1.0;
+                break;
+        }
+        dest[i] = (float)w;
+    }
+}
+
+// Create STFT
+Stft* stft_create(size_t size, size_t hop, StftWindow window, StftProcessFn process_fn, void* user) {
+    if (size < FFT_MIN_SIZE || size > STFT_MAX_SIZE || (size & (size - 1)) || hop == 0 || hop > size) {
+        audio_log(AUDIO_LOG_ERROR, "stft_create: size must be a power of two in range and hop in [1, size]");
+        return NULL;
+    }
+    
+    Stft* stft = audio_calloc(1, sizeof(Stft));
+    if (!stft) return NULL;
+    
+    stft->size = size;
+    stft->hop = hop;
+    stft->window_type = window;
+    stft->process_fn = process_fn;
+    stft->user = user;
+    stft->plan = fft_plan_acquire(size);
+    stft->analysis_window = audio_malloc(size * sizeof(float));
+    stft->synthesis_window = audio_malloc(size * sizeof(float));
+    stft->input = audio_malloc(size * sizeof(float));
+    stft->output = audio_malloc(size * sizeof(float));
+    stft->frame = audio_malloc(size * sizeof(float));
+    stft->spectrum = audio_malloc(size * sizeof(float));
+    if (!stft->plan || !stft->analysis_window || !stft->synthesis_window || !stft->input || !stft->output ||
+        !stft->frame || !stft->spectrum) {
+        stft_destroy(stft);
+        return NULL;
+    }
+    
+    // Every position n is covered by the frames at offsets n mod hop,
+    // n mod hop + hop, ..., so dividing by the sum of squared windows over
+    // that residue makes analysis times synthesis overlap-add to one
+    float* analysis = stft->analysis_window;
+    stft_window_fill(window, analysis, size);
+    for (size_t n = 0; n < size; n++) {
+        double sum = 0.0;
+        for (size_t m = n % hop; m < size; m += hop) {
+            sum += (double)analysis[m] * analysis[m];
+        }
+        stft->synthesis_window[n] = sum > 1e-12 ? (float)(analysis[n] / (sum * (double)size)) : 0.0f;
+    }
+    
+    stft_reset(stft);
+    return stft;
+}
+
+// Destroy STFT
+void stft_destroy(Stft* stft) {
+    if (stft) {
+        fft_plan_release(stft->plan);
+        audio_free(stft->analysis_window);
+        audio_free(stft->synthesis_window);
+        audio_free(stft->input);
+        audio_free(stft->output);
+        audio_free(stft->frame);
+        audio_free(stft->spectrum);
+        audio_free(stft);
+    }
+}
+
+// Delay of the output in samples
+size_t stft_latency(const Stft* stft) {
+    return stft ? stft->size : 0;
+}
+
+// Window and transform the last size input samples, run the callback and,
+// when resynthesizing, overlap-add the frame after dropping the hop that
+// has been played out
+static void stft_run_frame(Stft* stft, int resynthesize) {
+    const size_t size = stft->size;
+    const size_t hop = stft->hop;
+    
+    for (size_t i = 0; i < size; i++) {
+        stft->frame[i] = stft->input[i] * stft->analysis_window[i];
+    }
+    memmove(stft->input, stft->input + hop, (size - hop) * sizeof(float));
+    
+    fft_real_forward(stft->plan, stft->frame, stft->spectrum);
+    if (stft->process_fn) {
+        stft->process_fn(stft->user, stft->spectrum, stft->plan);
+    }
+    if (!resynthesize) return;
+    
+    fft_real_inverse(stft->plan, stft->spectrum, stft->frame);
+    memmove(stft->output, stft->output + hop, (size - hop) * sizeof(float));
+    memset(stft->output + size - hop, 0, hop * sizeof(float));
+    for (size_t i = 0; i < size; i++) {
+        stft->output[i] += stft->frame[i] * stft->synthesis_window[i];
+    }
+}
+
+// Process single sample
+sample_t stft_process(Stft* stft, sample_t input) {
+    sample_t output;
+    stft_process_block(stft, &input, &output, 1);
+    return output;
+}
+
+// Process a block: each hop of input is collected while the previous hop
+// of output (complete since the last frame) plays out
+void stft_process_block(Stft* stft, const sample_t* in, sample_t* out, size_t n) {
+    if (!stft || !in || !out) return;
+    
+    const size_t hop = stft->hop;
+    const size_t offset = stft->size - hop;
+    size_t done = 0;
+    
+    while (done < n) {
+        size_t count = hop - stft->fill;
+        if (count > n - done) count = n - done;
+        
+        memcpy(stft->input + offset + stft->fill, in + done, count * sizeof(float));
+        memcpy(out + done, stft->output + stft->fill, count * sizeof(float));
+        stft->fill += count;
+        done += count;
+        
+        if (stft->fill == hop) {
+            stft_run_frame(stft, 1);
+            stft->fill = 0;
+        }
+    }
+}
+
+// Analyze a block: the callback sees every frame, nothing is resynthesized
+void stft_analyze_block(Stft* stft, const sample_t* in, size_t n) {
+    if (!stft || !in) return;
+    
+    const size_t hop = stft->hop;
+    const size_t offset = stft->size - hop;
+    size_t done = 0;
+    
+    while (done < n) {
+        size_t count = hop - stft->fill;
+        if (count > n - done) count = n - done;
+        
+        memcpy(stft->input + offset + stft->fill, in + done, count * sizeof(float));
+        stft->fill += count;
+        done += count;
+        
+        if (stft->fill == hop) {
+            stft_run_frame(stft, 0);
+            stft->fill = 0;
+        }
+    }
+}
+
+// Process buffer
+void stft_process_buffer(Stft* stft, AudioBuffer* buffer) {
+    if (!stft || !buffer || !buffer->data) return;
+    
+    stft_process_block(stft, buffer->data, buffer->data, buffer->capacity);
+}
+
+// Block adapter used for per-channel processing
+static void stft_channel_block(void* effect, const sample_t* in, sample_t* out, size_t n) {
+    stft_process_block((Stft*)effect, in, out, n);
+}
+
+// Process each channel of an interleaved buffer with its own STFT instance
+void stft_process_channels(Stft** stfts, AudioBuffer* buffer) {
+    if (!stfts || !buffer || !buffer->data || buffer->channels > MAX_CHANNELS) return;
+    
+    void* instances[MAX_CHANNELS];
+    for (size_t ch = 0; ch < buffer->channels; ch++) {
+        instances[ch] = stfts[ch];
+    }
+    audio_buffer_process_channels(buffer, stft_channel_block, instances);
+}
+
+// Clear STFT history
+void stft_reset(Stft* stft) {
+    if (!stft) return;
+    
+    memset(stft->input, 0, stft->size * sizeof(float));
+    memset(stft->output, 0, stft->size * sizeof(float));
+    stft->fill = 0;
+}
+
+// Effect interface adapters
+static void stft_effect_reset(void* effect) {
+    stft_reset((Stft*)effect);
+}
+
+static int stft_effect_set_param(void* effect, int param, float value) {
+    (void)effect;
+    (void)param;
+    (void)value;
+    return 0;
+}
+
+static size_t stft_effect_latency(const void* effect) {
+    return stft_latency((const Stft*)effect);
+}
+
+static void stft_effect_destroy(void* effect) {
+    stft_destroy((Stft*)effect);
+}
+
+static const EffectVTable stft_vtable = {
+    .name = "stft",
+    .process_block = stft_channel_block,
+    .reset = stft_effect_reset,
+    .set_param = stft_effect_set_param,
+    .latency = stft_effect_latency,
+    .destroy = stft_effect_destroy
+};
+
+// Wrap in the effect interface (no params; the callback owns its state)
+Effect stft_effect(Stft* stft) {
+    Effect effect = { &stft_vtable, stft };
+    return effect;
+}
@@ -1,172 +1,736 @@
+#define _POSIX_C_SOURCE 200112L // mmap, posix_madvise, fileno, fseeko
 #include "wav_io.h"
 
-// Load WAV file into AudioBuffer
-AudioBuffer* wav_load(const char* filename) {
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#define WAV_IO_MMAP 1
+#endif
+
+// Samples converted per pass by the streaming reader and writer
+#define WAV_IO_CHUNK_SAMPLES (AUDIO_CHANNEL_CHUNK * MAX_CHANNELS)
+
+// Stored samples for one pass, sized and aligned for the widest format.
+// The members give each view its own declared type, so reading the bytes
+// as int16_t or double does not break strict aliasing.
+typedef union {
+    double f64[WAV_IO_CHUNK_SAMPLES];
+    int16_t s16[WAV_IO_CHUNK_SAMPLES];
+    uint8_t bytes[WAV_IO_CHUNK_SAMPLES * sizeof(double)];
+} WavChunk;
+
+// Format tags
+#define WAV_TAG_PCM 0x0001
+#define WAV_TAG_FLOAT 0x0003
+#define WAV_TAG_EXTENSIBLE 0xFFFE
+
+// Size field value meaning "see the ds64 chunk"
+#define RF64_SIZE_MARKER 0xFFFFFFFFu
+
+// Size of the ds64 chunk body the writer reserves (riff, data, sample count, table length)
+#define DS64_BODY_SIZE 28
+
+// Little-endian field access
+
+static uint16_t read_u16(const uint8_t* p) {
+    return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+static uint32_t read_u32(const uint8_t* p) {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static uint64_t read_u64(const uint8_t* p) {
+    return (uint64_t)read_u32(p) | ((uint64_t)read_u32(p + 4) << 32);
+}
+
+static uint8_t* put_u16(uint8_t* p, uint16_t v) {
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+    return p + 2;
+}
+
+static uint8_t* put_u32(uint8_t* p, uint32_t v) {
+    for (int i = 0; i < 4; i++) p[i] = (uint8_t)(v >> (8 * i));
+    return p + 4;
+}
+
+static uint8_t* put_u64(uint8_t* p, uint64_t v) {
+    put_u32(p, (uint32_t)v);
+    return put_u32(p + 4, (uint32_t)(v >> 32));
+}
+
+static uint8_t* put_id(uint8_t* p, const char* id) {
+    memcpy(p, id, 4);
+    return p + 4;
+}
+
+// Seek to an absolute offset (64-bit where available)
+static int wav_seek(FILE* file, uint64_t offset) {
+#if defined(WAV_IO_MMAP)
+    return fseeko(file, (off_t)offset, SEEK_SET);
+#else
+    return fseek(file, (long)offset, SEEK_SET);
+#endif
+}
+
+// Length of an open file, or 0 if unknown
+static uint64_t wav_file_length(FILE* file) {
+#if defined(WAV_IO_MMAP)
+    struct stat info;
+    if (fstat(fileno(file), &info) == 0) return (uint64_t)info.st_size;
+    return 0;
+#else
+    long here = ftell(file);
+    if (fseek(file, 0, SEEK_END) != 0) return 0;
+    long end = ftell(file);
+    fseek(file, here, SEEK_SET);
+    return end > 0 ? (uint64_t)end : 0;
+#endif
+}
+
+// Map a format tag and container size to a sample format
+static int wav_sample_format(unsigned tag, unsigned bits, SampleFormat* format) {
+    if (tag == WAV_TAG_PCM) {
+        switch (bits) {
+            case 8: *format = SAMPLE_FORMAT_U8; return 1;
+            case 16: *format = SAMPLE_FORMAT_S16; return 1;
+            case 24: *format = SAMPLE_FORMAT_S24; return 1;
+            case 32: *format = SAMPLE_FORMAT_S32; return 1;
+        }
+    } else if (tag == WAV_TAG_FLOAT) {
+        switch (bits) {
+            case 32: *format = SAMPLE_FORMAT_F32; return 1;
+            case 64: *format = SAMPLE_FORMAT_F64; return 1;
+        }
+    }
+    return 0;
+}
+
+// Parse the body of a "fmt " chunk
+static int wav_parse_fmt(const uint8_t* body, uint32_t size, WavFormat* format) {
+    if (size < 16) {
+        audio_log(AUDIO_LOG_ERROR, "Invalid WAV format chunk");
+        return 0;
+    }
+    
+    unsigned tag = read_u16(body);
+    unsigned channels = read_u16(body + 2);
+    format->sample_rate = read_u32(body + 4);
+    format->block_align = read_u16(body + 12);
+    format->bits_per_sample = read_u16(body + 14);
+    format->valid_bits = format->bits_per_sample;
+    format->channel_mask = 0;
+    
+    // EXTENSIBLE carries the real format tag in the first two bytes of the sub-format GUID
+    if (tag == WAV_TAG_EXTENSIBLE && size >= 40) {
+        format->valid_bits = read_u16(body + 18);
+        format->channel_mask = read_u32(body + 20);
+        tag = read_u16(body + 24);
+    }
+    
+    if (!wav_sample_format(tag, (unsigned)format->bits_per_sample, &format->sample_format)) {
+        audio_log(AUDIO_LOG_ERROR, "Unsupported WAV sample format (tag %u, %d bits)", tag, format->bits_per_sample);
+        return 0;
+    }
+    
+    if (channels == 0 || channels > WAV_IO_CHUNK_SAMPLES) {
+        audio_log(AUDIO_LOG_ERROR, "Unsupported channel count %u", channels);
+        return 0;
+    }
+    format->channels = channels;
+    
+    if (format->block_align != channels * sample_format_bytes(format->sample_format)) {
+        audio_log(AUDIO_LOG_ERROR, "Invalid WAV block alignment");
+        return 0;
+    }
+    
+    return 1;
+}
+
+// Walk the RIFF chunks up to the data chunk
+int wav_read_format(FILE* file, WavFormat* format) {
+    if (!file || !format) return 0;
+    
+    uint8_t riff[12];
+    if (fread(riff, sizeof(riff), 1, file) != 1) {
+        audio_log(AUDIO_LOG_ERROR, "Could not read WAV header");
+        return 0;
+    }
+    
+    int rf64 = (memcmp(riff, "RF64", 4) == 0 || memcmp(riff, "BW64", 4) == 0);
+    if ((memcmp(riff, "RIFF", 4) != 0 && !rf64) || memcmp(riff + 8, "WAVE", 4) != 0) {
+        audio_log(AUDIO_LOG_ERROR, "Invalid WAV file format");
+        return 0;
+    }
+    
+    memset(format, 0, sizeof(WavFormat));
+    format->rf64 = rf64;
+    
+    uint64_t ds64_data_size = 0;
+    uint64_t pos = sizeof(riff);
+    int have_fmt = 0;
+    
+    for (;;) {
+        uint8_t chunk[8];
+        if (fread(chunk, sizeof(chunk), 1, file) != 1) {
+            audio_log(AUDIO_LOG_ERROR, "No data chunk found");
+            return 0;
+        }
+        
+        uint32_t size = read_u32(chunk + 4);
+        pos += sizeof(chunk);
+        
+        if (memcmp(chunk, "data", 4) == 0) {
+            if (!have_fmt) {
+                audio_log(AUDIO_LOG_ERROR, "Data chunk before format chunk");
+                return 0;
+            }
+            format->data_offset = pos;
+            format->data_size = (rf64 && size == RF64_SIZE_MARKER) ? ds64_data_size : size;
+            break;
+        }
+        
+        if (memcmp(chunk, "fmt ", 4) == 0 || (rf64 && memcmp(chunk, "ds64", 4) == 0)) {
+            uint8_t body[40] = {0};
+            size_t len = size < sizeof(body) ? size : sizeof(body);
+            if (fread(body, 1, len, file) != len) {
+                audio_log(AUDIO_LOG_ERROR, "Could not read WAV header");
+                return 0;
+            }
+            
+            if (chunk[0] == 'f') {
+                if (!wav_parse_fmt(body, size, format)) return 0;
+                have_fmt = 1;
+            } else if (size >= 24) {
+                ds64_data_size = read_u64(body + 8);
+            }
+        }
+        
+        // Chunks are word aligned: odd sizes are followed by a pad byte
+        pos += (uint64_t)size + (size & 1);
+        if (wav_seek(file, pos) != 0) {
+            audio_log(AUDIO_LOG_ERROR, "No data chunk found");
+            return 0;
+        }
+    }
+    
+    // Unfinished or truncated files: trust the file length over the header
+    uint64_t length = wav_file_length(file);
+    if (length >= format->data_offset && format->data_size > length - format->data_offset) {
+        format->data_size = length - format->data_offset;
+    }
+    
+    return 1;
+}
+
+// Streaming reader functions
+
+// Allocate a reader for a parsed format
+static WavReader* wav_reader_from_format(const WavFormat* format) {
+    WavReader* reader = audio_malloc(sizeof(WavReader));
+    if (!reader) return NULL;
+    
+    reader->file = NULL;
+    reader->format = *format;
+    reader->channels = format->channels;
+    reader->sample_rate = format->sample_rate;
+    reader->total_frames = (size_t)(format->data_size / format->block_align);
+    reader->frames_remaining = reader->total_frames;
+    reader->mapped = NULL;
+    reader->map_base = NULL;
+    reader->map_size = 0;
+    
+    return reader;
+}
+
+// Open a WAV file and position the reader at the first sample frame
+WavReader* wav_reader_open(const char* filename) {
     FILE* file = fopen(filename, "rb");
     if (!file) {
-        printf("Error: Could not open file %s\n", filename);
+        audio_log(AUDIO_LOG_ERROR, "Could not open file %s", filename);
         return NULL;
     }
     
-    WavHeader header;
-    if (fread(&header, sizeof(WavHeader), 1, file) != 1) {
-        printf("Error: Could not read WAV header\n");
+    WavFormat format;
+    if (!wav_read_format(file, &format)) {
         fclose(file);
         return NULL;
     }
     
-    // Verify WAV header
-    if (strncmp(header.riff_id, "RIFF", 4) != 0 ||
-        strncmp(header.wave_id, "WAVE", 4) != 0 ||
-        strncmp(header.fmt_id, "fmt ", 4) != 0 ||
-        strncmp(header.data_id, "data", 4) != 0) {
-        printf("Error: Invalid WAV file format\n");
+    WavReader* reader = wav_reader_from_format(&format);
+    if (!reader) {
         fclose(file);
         return NULL;
     }
     
-    if (header.format != 1) {
-        printf("Error: Only PCM format is supported\n");
-        fclose(file);
+    reader->file = file;
+    return reader;
+}
+
+// Open a WAV file by mapping it into memory. Samples are read in place
+// from the page cache (shared between processes) with no intermediate
+// copy. Falls back to wav_reader_open where mmap is unavailable.
+WavReader* wav_reader_open_mapped(const char* filename) {
+#if defined(WAV_IO_MMAP)
+    FILE* file = fopen(filename, "rb");
+    if (!file) {
+        audio_log(AUDIO_LOG_ERROR, "Could not open file %s", filename);
         return NULL;
     }
     
-    if (header.bits_per_sample != 16) {
-        printf("Error: Only 16-bit samples are supported\n");
+    WavFormat format;
+    if (!wav_read_format(file, &format)) {
         fclose(file);
         return NULL;
     }
     
-    // Calculate number of samples
-    size_t num_samples = header.data_size / (header.bits_per_sample / 8);
-    size_t samples_per_channel = num_samples / header.channels;
+    // data_offset is past the RIFF header, so the mapping is never empty
+    size_t map_size = (size_t)(format.data_offset + format.data_size);
+    void* base = mmap(NULL, map_size, PROT_READ, MAP_PRIVATE, fileno(file), 0);
+    fclose(file); // The mapping stays valid after the descriptor is closed
+    if (base == MAP_FAILED) {
+        audio_log(AUDIO_LOG_ERROR, "Could not map file %s", filename);
+        return NULL;
+    }
     
-    // Create audio buffer
-    AudioBuffer* buffer = audio_buffer_create(samples_per_channel, header.channels, header.sample_rate);
-    if (!buffer) {
-        printf("Error: Could not create audio buffer\n");
-        fclose(file);
+    WavReader* reader = wav_reader_from_format(&format);
+    if (!reader) {
+        munmap(base, map_size);
         return NULL;
     }
     
-    // Read sample data
-    int16_t* temp_buffer = malloc(num_samples * sizeof(int16_t));
-    if (!temp_buffer) {
-        printf("Error: Could not allocate temporary buffer\n");
-        audio_buffer_destroy(buffer);
-        fclose(file);
+    // Effects consume the data front to back; let the kernel read ahead
+    posix_madvise(base, map_size, POSIX_MADV_SEQUENTIAL);
+    
+    reader->mapped = (const uint8_t*)base + format.data_offset;
+    reader->map_base = base;
+    reader->map_size = map_size;
+    
+    return reader;
+#else
+    return wav_reader_open(filename);
+#endif
+}
+
+// Zero-copy access for mapped readers: the stored frames (in the file's
+// sample format) from the current position. Returns NULL for stream readers.
+const void* wav_reader_frames(const WavReader* reader, size_t* frames_available) {
+    if (!reader || !reader->mapped) {
+        if (frames_available) *frames_available = 0;
         return NULL;
     }
     
-    if (fread(temp_buffer, sizeof(int16_t), num_samples, file) != num_samples) {
-        printf("Error: Could not read sample data\n");
-        free(temp_buffer);
-        audio_buffer_destroy(buffer);
-        fclose(file);
+    if (frames_available) *frames_available = reader->frames_remaining;
+    return reader->mapped + (reader->total_frames - reader->frames_remaining) * reader->format.block_align;
+}
+
+// Read up to frames interleaved frames; returns the number of frames read
+size_t wav_reader_read(WavReader* reader, sample_t* dest, size_t frames) {
+    if (!reader || !dest) return 0;
+    
+    const size_t channels = reader->channels;
+    const SampleFormat format = reader->format.sample_format;
+    size_t done = 0;
+    
+    if (frames > reader->frames_remaining) frames = reader->frames_remaining;
+    
+    // Mapped readers convert straight out of the mapping
+    if (reader->mapped) {
+        convert_to_float(format, wav_reader_frames(reader, NULL), dest, frames * channels);
+        reader->frames_remaining -= frames;
+        return frames;
+    }
+    
+    WavChunk raw;
+    const size_t chunk_frames = WAV_IO_CHUNK_SAMPLES / channels;
+    
+    while (done < frames) {
+        size_t want = frames - done;
+        if (want > chunk_frames) want = chunk_frames;
+        
+        size_t got = fread(raw.bytes, reader->format.block_align, want, reader->file);
+        convert_to_float(format, &raw, dest + done * channels, got * channels);
+        
+        done += got;
+        if (got < want) {
+            // Truncated file: report what was there and stop
+            reader->frames_remaining = 0;
+            return done;
+        }
+    }
+    
+    reader->frames_remaining -= done;
+    return done;
+}
+
+// Fill an AudioBuffer (either layout) with the next block->length frames.
+// A short final block is zero-padded; returns the number of frames read.
+size_t wav_reader_read_buffer(WavReader* reader, AudioBuffer* block) {
+    if (!reader || !block || !block->data || block->channels != reader->channels) return 0;
+    
+    size_t done = 0;
+    
+    if (block->layout == AUDIO_LAYOUT_PLANAR) {
+        // Read a chunk of frames at a time, then split it into the planes
+        sample_t scratch[WAV_IO_CHUNK_SAMPLES];
+        sample_t* planes[MAX_CHANNELS];
+        const size_t chunk_frames = WAV_IO_CHUNK_SAMPLES / block->channels;
+        
+        while (done < block->length) {
+            size_t want = block->length - done;
+            if (want > chunk_frames) want = chunk_frames;
+            
+            size_t got = wav_reader_read(reader, scratch, want);
+            if (got == 0) break;
+            
+            for (size_t ch = 0; ch < block->channels; ch++) {
+                planes[ch] = block->planes[ch] + done;
+            }
+            audio_deinterleave(scratch, block->channels, planes, got);
+            done += got;
+        }
+        
+        for (size_t ch = 0; ch < block->channels; ch++) {
+            memset(block->planes[ch] + done, 0, (block->length - done) * sizeof(sample_t));
+        }
+    } else {
+        done = wav_reader_read(reader, block->data, block->length);
+        memset(block->data + done * block->channels, 0,
+               (block->length - done) * block->channels * sizeof(sample_t));
+    }
+    
+    return done;
+}
+
+// Close the reader and its file
+void wav_reader_close(WavReader* reader) {
+    if (reader) {
+        if (reader->file) {
+            fclose(reader->file);
+        }
+#if defined(WAV_IO_MMAP)
+        if (reader->map_base) {
+            munmap(reader->map_base, reader->map_size);
+        }
+#endif
+        audio_free(reader);
+    }
+}
+
+// Streaming writer functions
+
+// Default speaker mask for a channel count
+static uint32_t wav_channel_mask(size_t channels) {
+    switch (channels) {
+        case 1: return 0x4;   // Front center
+        case 2: return 0x3;   // Front left, front right
+        case 6: return 0x3F;  // 5.1
+        case 8: return 0x63F; // 7.1
+        default: return channels < 32 ? (1u << channels) - 1 : 0;
+    }
+}
+
+// Build the header for the writer's format. RIFF files carry a JUNK chunk
+// where RF64 files carry ds64, so both layouts have the same size.
+// Returns the header length in bytes.
+static size_t wav_build_header(const WavWriter* writer, uint64_t data_size, uint8_t* header) {
+    const int is_float = (writer->sample_format == SAMPLE_FORMAT_F32 ||
+                          writer->sample_format == SAMPLE_FORMAT_F64);
+    const unsigned bits = (unsigned)sample_format_bytes(writer->sample_format) * 8;
+    const int extensible = (writer->channels > 2 || bits > (is_float ? 32u : 16u));
+    const uint32_t fmt_size = extensible ? 40 : (is_float ? 18 : 16);
+    const uint64_t frames = writer->frames_written;
+    
+    size_t header_size = 12 + (8 + DS64_BODY_SIZE) + (8 + fmt_size) + (is_float ? 12 : 0) + 8;
+    uint64_t riff_size = header_size - 8 + data_size + (data_size & 1);
+    int rf64 = riff_size > 0xFFFFFFFFu;
+    
+    uint8_t* p = header;
+    p = put_id(p, rf64 ? "RF64" : "RIFF");
+    p = put_u32(p, rf64 ? RF64_SIZE_MARKER : (uint32_t)riff_size);
+    p = put_id(p, "WAVE");
+    
+    p = put_id(p, rf64 ? "ds64" : "JUNK");
+    p = put_u32(p, DS64_BODY_SIZE);
+    memset(p, 0, DS64_BODY_SIZE);
+    if (rf64) {
+        put_u64(p, riff_size);
+        put_u64(p + 8, data_size);
+        put_u64(p + 16, frames);
+    }
+    p += DS64_BODY_SIZE;
+    
+    p = put_id(p, "fmt ");
+    p = put_u32(p, fmt_size);
+    p = put_u16(p, extensible ? WAV_TAG_EXTENSIBLE : (is_float ? WAV_TAG_FLOAT : WAV_TAG_PCM));
+    p = put_u16(p, (uint16_t)writer->channels);
+    p = put_u32(p, (uint32_t)writer->sample_rate);
+    p = put_u32(p, (uint32_t)(writer->sample_rate * writer->block_align));
+    p = put_u16(p, (uint16_t)writer->block_align);
+    p = put_u16(p, (uint16_t)bits);
+    if (fmt_size > 16) {
+        p = put_u16(p, (uint16_t)(fmt_size - 18)); // Extension size
+    }
+    if (extensible) {
+        // Sub-format GUID: format tag followed by the standard KSDATAFORMAT suffix
+        static const uint8_t guid_suffix[14] = {0x00, 0x00, 0x00, 0x00, 0x10, 0x00, 0x80,
+                                                0x00, 0x00, 0xAA, 0x00, 0x38, 0x9B, 0x71};
+        p = put_u16(p, (uint16_t)bits);
+        p = put_u32(p, wav_channel_mask(writer->channels));
+        p = put_u16(p, is_float ? WAV_TAG_FLOAT : WAV_TAG_PCM);
+        memcpy(p, guid_suffix, sizeof(guid_suffix));
+        p += sizeof(guid_suffix);
+    }
+    
+    if (is_float) {
+        p = put_id(p, "fact");
+        p = put_u32(p, 4);
+        p = put_u32(p, frames > 0xFFFFFFFFu ? RF64_SIZE_MARKER : (uint32_t)frames);
+    }
+    
+    p = put_id(p, "data");
+    p = put_u32(p, rf64 ? RF64_SIZE_MARKER : (uint32_t)data_size);
+    
+    return (size_t)(p - header);
+}
+
+// Create a WAV file in the given sample format; sizes are filled in by wav_writer_close
+WavWriter* wav_writer_open_format(const char* filename, size_t channels, size_t sample_rate,
+                                  SampleFormat format) {
+    if (channels == 0 || channels > WAV_IO_CHUNK_SAMPLES) {
+        audio_log(AUDIO_LOG_ERROR, "Unsupported channel count %zu", channels);
         return NULL;
     }
     
-    // Convert to float samples
-    for (size_t i = 0; i < num_samples; i++) {
-        buffer->data[i] = int16_to_float(temp_buffer[i]);
+    WavWriter* writer = audio_malloc(sizeof(WavWriter));
+    if (!writer) return NULL;
+    
+    writer->file = fopen(filename, "wb");
+    if (!writer->file) {
+        audio_log(AUDIO_LOG_ERROR, "Could not create file %s", filename);
+        audio_free(writer);
+        return NULL;
     }
     
-    free(temp_buffer);
-    fclose(file);
+    writer->channels = channels;
+    writer->sample_rate = sample_rate;
+    writer->sample_format = format;
+    writer->block_align = channels * sample_format_bytes(format);
+    writer->frames_written = 0;
+    writer->error = 0;
+    dither_init(&writer->dither, DITHER_NONE, channels);
     
-    printf("Loaded %s: %zu samples, %zu channels, %zu Hz\n", 
-           filename, samples_per_channel, buffer->channels, buffer->sample_rate);
+    // Placeholder header, patched once the length is known
+    uint8_t header[128];
+    writer->header_size = wav_build_header(writer, 0, header);
+    if (fwrite(header, writer->header_size, 1, writer->file) != 1) {
+        audio_log(AUDIO_LOG_ERROR, "Could not write WAV header");
+        fclose(writer->file);
+        audio_free(writer);
+        return NULL;
+    }
     
-    return buffer;
+    return writer;
 }
 
-// Save AudioBuffer to WAV file
-int wav_save(const char* filename, AudioBuffer* buffer) {
-    if (!buffer || !buffer->data) {
-        printf("Error: Invalid audio buffer\n");
-        return 0;
+// Create a 16-bit PCM WAV file
+WavWriter* wav_writer_open(const char* filename, size_t channels, size_t sample_rate) {
+    return wav_writer_open_format(filename, channels, sample_rate, SAMPLE_FORMAT_S16);
+}
+
+// Select dither for 16-bit output (other formats ignore it)
+void wav_writer_set_dither(WavWriter* writer, DitherMode mode) {
+    if (!writer) return;
+    
+    // Shaping needs per-channel history; wider streams fall back to plain TPDF
+    if (mode == DITHER_TPDF_SHAPED && writer->channels > MAX_CHANNELS) mode = DITHER_TPDF;
+    dither_init(&writer->dither, mode, writer->channels);
+}
+
+// Append interleaved frames; returns the number of frames written
+size_t wav_writer_write(WavWriter* writer, const sample_t* src, size_t frames) {
+    if (!writer || !src || writer->error) return 0;
+    
+    WavChunk raw;
+    const size_t channels = writer->channels;
+    const size_t chunk_frames = WAV_IO_CHUNK_SAMPLES / channels;
+    size_t done = 0;
+    
+    while (done < frames) {
+        size_t count = frames - done;
+        if (count > chunk_frames) count = chunk_frames;
+        
+        if (writer->sample_format == SAMPLE_FORMAT_S16 && writer->dither.mode != DITHER_NONE) {
+            convert_f32_to_s16_block(src + done * channels, raw.s16, count * channels, &writer->dither);
+        } else {
+            convert_from_float(writer->sample_format, src + done * channels, &raw, count * channels);
+        }
+        
+        size_t put = fwrite(raw.bytes, writer->block_align, count, writer->file);
+        done += put;
+        if (put < count) {
+            audio_log(AUDIO_LOG_ERROR, "Could not write sample data");
+            writer->error = 1;
+            break;
+        }
     }
     
-    FILE* file = fopen(filename, "wb");
-    if (!file) {
-        printf("Error: Could not create file %s\n", filename);
-        return 0;
+    writer->frames_written += done;
+    return done;
+}
+
+// Append the first frames frames of an AudioBuffer (either layout)
+size_t wav_writer_write_buffer(WavWriter* writer, const AudioBuffer* block, size_t frames) {
+    if (!writer || !block || !block->data || block->channels != writer->channels) return 0;
+    
+    if (frames > block->length) frames = block->length;
+    
+    if (block->layout != AUDIO_LAYOUT_PLANAR) {
+        return wav_writer_write(writer, block->data, frames);
     }
     
-    // Prepare WAV header
-    WavHeader header;
-    memcpy(header.riff_id, "RIFF", 4);
-    memcpy(header.wave_id, "WAVE", 4);
-    memcpy(header.fmt_id, "fmt ", 4);
-    memcpy(header.data_id, "data", 4);
-    
-    header.fmt_size = 16;
-    header.format = 1; // PCM
-    header.channels = (uint16_t)buffer->channels;
-    header.sample_rate = (uint32_t)buffer->sample_rate;
-    header.bits_per_sample = 16;
-    header.block_align = (header.channels * header.bits_per_sample) / 8;
-    header.byte_rate = header.sample_rate * header.block_align;
-    header.data_size = (uint32_t)(buffer->capacity * sizeof(int16_t));
-    header.file_size = sizeof(WavHeader) - 8 + header.data_size;
-    
-    // Write header
-    if (fwrite(&header, sizeof(WavHeader), 1, file) != 1) {
-        printf("Error: Could not write WAV header\n");
-        fclose(file);
-        return 0;
+    // Interleave a chunk of frames at a time, then write it
+    sample_t scratch[WAV_IO_CHUNK_SAMPLES];
+    sample_t* planes[MAX_CHANNELS];
+    const size_t chunk_frames = WAV_IO_CHUNK_SAMPLES / block->channels;
+    size_t done = 0;
+    
+    while (done < frames) {
+        size_t count = frames - done;
+        if (count > chunk_frames) count = chunk_frames;
+        
+        for (size_t ch = 0; ch < block->channels; ch++) {
+            planes[ch] = block->planes[ch] + done;
+        }
+        audio_interleave(planes, block->channels, scratch, count);
+        
+        size_t put = wav_writer_write(writer, scratch, count);
+        done += put;
+        if (put < count) break;
     }
     
-    // Convert and write sample data
-    int16_t* temp_buffer = malloc(buffer->capacity * sizeof(int16_t));
-    if (!temp_buffer) {
-        printf("Error: Could not allocate temporary buffer\n");
-        fclose(file);
-        return 0;
+    return done;
+}
+
+// Patch the header sizes and close the file; returns 1 on success
+int wav_writer_close(WavWriter* writer) {
+    if (!writer) return 0;
+    
+    int ok = !writer->error;
+    uint64_t data_size = (uint64_t)writer->frames_written * writer->block_align;
+    
+    // Odd-sized data chunks get a pad byte
+    if (ok && (data_size & 1) && fputc(0, writer->file) == EOF) {
+        ok = 0;
     }
     
-    for (size_t i = 0; i < buffer->capacity; i++) {
-        temp_buffer[i] = float_to_int16(buffer->data[i]);
+    uint8_t header[128];
+    size_t header_size = wav_build_header(writer, data_size, header);
+    if (ok && (wav_seek(writer->file, 0) != 0 ||
+               fwrite(header, header_size, 1, writer->file) != 1)) {
+        audio_log(AUDIO_LOG_ERROR, "Could not update WAV header");
+        ok = 0;
     }
     
-    if (fwrite(temp_buffer, sizeof(int16_t), buffer->capacity, file) != buffer->capacity) {
-        printf("Error: Could not write sample data\n");
-        free(temp_buffer);
-        fclose(file);
+    if (fclose(writer->file) != 0) ok = 0;
+    audio_free(writer);
+    
+    return ok;
+}
+
+// Load WAV file into an AudioBuffer with the requested layout
+static AudioBuffer* wav_load_layout(const char* filename, AudioLayout layout, int mapped) {
+    WavReader* reader = mapped ? wav_reader_open_mapped(filename) : wav_reader_open(filename);
+    if (!reader) return NULL;
+    
+    // Create audio buffer
+    AudioBuffer* buffer = (layout == AUDIO_LAYOUT_PLANAR)
+                          ? audio_buffer_create_planar(reader->total_frames, reader->channels, reader->sample_rate)
+                          : audio_buffer_create(reader->total_frames, reader->channels, reader->sample_rate);
+    if (!buffer) {
+        audio_log(AUDIO_LOG_ERROR, "Could not create audio buffer");
+        wav_reader_close(reader);
+        return NULL;
+    }
+    
+    // Samples are decoded straight into the buffer, a chunk at a time
+    if (wav_reader_read_buffer(reader, buffer) != buffer->length) {
+        audio_log(AUDIO_LOG_ERROR, "Could not read sample data");
+        audio_buffer_destroy(buffer);
+        wav_reader_close(reader);
+        return NULL;
+    }
+    
+    wav_reader_close(reader);
+    
+    audio_log(AUDIO_LOG_INFO, "Loaded %s: %zu samples, %zu channels, %zu Hz",
+           filename, buffer->length, buffer->channels, buffer->sample_rate);
+    
+    return buffer;
+}
+
+// Load WAV file into an interleaved AudioBuffer
+AudioBuffer* wav_load(const char* filename) {
+    return wav_load_layout(filename, AUDIO_LAYOUT_INTERLEAVED, 0);
+}
+
+// Load WAV file into a planar AudioBuffer
+AudioBuffer* wav_load_planar(const char* filename) {
+    return wav_load_layout(filename, AUDIO_LAYOUT_PLANAR, 0);
+}
+
+// Load WAV file into an interleaved AudioBuffer through a memory mapping
+AudioBuffer* wav_load_mapped(const char* filename) {
+    return wav_load_layout(filename, AUDIO_LAYOUT_INTERLEAVED, 1);
+}
+
+// Save AudioBuffer to a WAV file in the given sample format
+int wav_save_format(const char* filename, AudioBuffer* buffer, SampleFormat format) {
+    if (!buffer || !buffer->data) {
+        audio_log(AUDIO_LOG_ERROR, "Invalid audio buffer");
         return 0;
     }
     
-    free(temp_buffer);
-    fclose(file);
+    WavWriter* writer = wav_writer_open_format(filename, buffer->channels, buffer->sample_rate, format);
+    if (!writer) return 0;
     
-    printf("Saved %s: %zu samples, %zu channels, %zu Hz\n", 
+    wav_writer_write_buffer(writer, buffer, buffer->length);
+    if (!wav_writer_close(writer)) return 0;
+    
+    audio_log(AUDIO_LOG_INFO, "Saved %s: %zu samples, %zu channels, %zu Hz",
            filename, buffer->length, buffer->channels, buffer->sample_rate);
     
     return 1;
 }
 
+// Save AudioBuffer to a 16-bit PCM WAV file
+int wav_save(const char* filename, AudioBuffer* buffer) {
+    return wav_save_format(filename, buffer, SAMPLE_FORMAT_S16);
+}
+
 // Print WAV file information
 void print_wav_info(const char* filename) {
     FILE* file = fopen(filename, "rb");
     if (!file) {
-        printf("Error: Could not open file %s\n", filename);
+        audio_log(AUDIO_LOG_ERROR, "Could not open file %s", filename);
         return;
     }
     
-    WavHeader header;
-    if (fread(&header, sizeof(WavHeader), 1, file) != 1) {
-        printf("Error: Could not read WAV header\n");
+    WavFormat format;
+    if (!wav_read_format(file, &format)) {
         fclose(file);
         return;
     }
     
     printf("WAV File Info for %s:\n", filename);
-    printf("  Format: %s\n", (header.format == 1) ? "PCM" : "Unknown");
-    printf("  Channels: %u\n", header.channels);
-    printf("  Sample Rate: %u Hz\n", header.sample_rate);
-    printf("  Bit Depth: %u bits\n", header.bits_per_sample);
-    printf("  Duration: %.2f seconds\n", 
-           (float)header.data_size / (header.sample_rate * header.channels * (header.bits_per_sample / 8)));
+    printf("  Format: %s%s\n", sample_format_name(format.sample_format), format.rf64 ? " (RF64)" : "");
+    printf("  Channels: %zu\n", format.channels);
+    printf("  Sample Rate: %zu Hz\n", format.sample_rate);
+    printf("  Bit Depth: %d bits\n", format.valid_bits);
+    printf("  Duration: %.2f seconds\n",
+           (double)format.data_size / ((double)format.sample_rate * format.block_align));
     
     fclose(file);
-}
\ No newline at end of file
+}